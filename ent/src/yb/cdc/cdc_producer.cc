@@ -22,6 +22,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/docdb.pb.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/value_type.h"
@@ -81,6 +82,26 @@ void AddPrimaryKey(const docdb::SubDocKey& decoded_key,
   }
 }
 
+// Adds a change for each column stored in the packed row. Columns that are NULL are not stored in
+// the packed row, so there are no changes for them.
+CHECKED_STATUS AddPackedRowColumns(const Slice& packed_row,
+                                   const Schema& tablet_schema,
+                                   CDCRecordPB* record) {
+  docdb::PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_row));
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    auto col = tablet_schema.column_by_id(decoder.column_id(i));
+    if (!col.ok()) {
+      // The column was dropped after the row was packed.
+      continue;
+    }
+    PrimitiveValue value;
+    RETURN_NOT_OK(value.DecodeFromValue(decoder.value(i)));
+    AddColumnToMap(*col, value, record->add_changes());
+  }
+  return Status::OK();
+}
+
 // Set committed record information including commit time for record.
 // This will look at transaction status to determine commit time to be used for CDC record.
 // Returns true if we need to stop processing WAL records beyond this, false otherwise.
@@ -315,7 +336,11 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
 
     Slice value = write_pair.value();
     docdb::Value decoded_value;
-    RETURN_NOT_OK(decoded_value.Decode(value));
+    RETURN_NOT_OK(decoded_value.DecodeControlFields(&value));
+    const bool is_packed_row = docdb::IsPackedRow(value);
+    if (!is_packed_row) {
+      RETURN_NOT_OK(decoded_value.mutable_primitive_value()->DecodeFromValue(value));
+    }
 
     // Compare key hash with previously seen key hash to determine whether the write pair
     // is part of the same row or not.
@@ -367,6 +392,8 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
       auto kv_pair = record->add_changes();
       kv_pair->set_key(write_pair.key());
       kv_pair->mutable_value()->set_binary_value(write_pair.value());
+    } else if (is_packed_row) {
+      RETURN_NOT_OK(AddPackedRowColumns(value, schema, record));
     } else if (record->operation() == CDCRecordPB_OperationType_WRITE) {
       PrimitiveValue column_id;
       Slice key_column = write_pair.key().data() + key_size;
@@ -87,6 +87,7 @@ DECLARE_bool(enable_ysql);
 DECLARE_bool(hide_pg_catalog_table_creation_logs);
 DECLARE_bool(master_auto_run_initdb);
 DECLARE_int32(pggate_rpc_timeout_secs);
+DECLARE_bool(ysql_enable_packed_row);
 
 namespace yb {
 
@@ -494,6 +495,31 @@ TEST_P(TwoDCYsqlTest, SimpleReplication) {
   Destroy();
 }
 
+// Rows inserted in the packed format are decoded by the CDC producer and replicated as is.
+TEST_P(TwoDCYsqlTest, PackedRowReplication) {
+  YB_SKIP_TEST_IN_TSAN();
+  FLAGS_ysql_enable_packed_row = true;
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {1}, 1));
+  const string kUniverseId = ASSERT_RESULT(GetUniverseId(&producer_cluster_));
+  // tables contains the producer table followed by the consumer table.
+  const auto& producer_table = tables[0];
+  const auto& consumer_table = tables[1];
+
+  WriteWorkload(0, 100, &producer_cluster_, producer_table->name());
+  ASSERT_OK(SetupUniverseReplication(producer_cluster(), consumer_cluster(), consumer_client(),
+                                     kUniverseId, {producer_table}));
+  master::GetUniverseReplicationResponsePB get_universe_replication_resp;
+  ASSERT_OK(VerifyUniverseReplication(consumer_cluster(), consumer_client(), kUniverseId,
+      &get_universe_replication_resp));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+  ASSERT_OK(VerifyWrittenRecords(producer_table->name(), consumer_table->name()));
+
+  WriteWorkload(100, 105, &producer_cluster_, producer_table->name());
+  ASSERT_OK(VerifyNumRecords(consumer_table->name(), &consumer_cluster_, 105));
+  ASSERT_OK(VerifyWrittenRecords(producer_table->name(), consumer_table->name()));
+  Destroy();
+}
+
 TEST_P(TwoDCYsqlTest, SetupUniverseReplicationWithProducerBootstrapId) {
   YB_SKIP_TEST_IN_TSAN();
   constexpr int kNTabletsPerTable = 1;
@@ -612,6 +612,25 @@ TEST_F(ClientTest, TestLookupAllTablets) {
   ASSERT_EQ(tablets.size(), 8);
 }
 
+// Tablet locations received while opening the table or prefetched are served from the cache.
+TEST_F(ClientTest, TestPrefetchTabletLocations) {
+  ASSERT_NO_FATALS(CreateTable(kTable3Name, kNumTabletsPerTable, &client_table3_));
+
+  auto table = ASSERT_RESULT(client_->OpenTable(kTable3Name));
+  const auto deadline = CoarseMonoClock::Now() + MonoDelta::FromSeconds(kLookupWaitTimeSecs);
+  ASSERT_OK(client_->PrefetchTabletLocations({table}, deadline));
+
+  const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+  const auto partitions = table->GetPartitionsCopy();
+  ASSERT_EQ(partitions.size(), kNumTabletsPerTable);
+  for (const auto& partition_key : partitions) {
+    auto tablet = ASSERT_RESULT(
+        client_->LookupTabletByKeyFuture(table, partition_key, deadline).get());
+    ASSERT_EQ(tablet->partition().partition_key_start(), partition_key);
+  }
+  ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+}
+
 TEST_F(ClientTest, TestPointThenRangeLookup) {
   ASSERT_NO_FATALS(CreateTable(kTable3Name, kNumTabletsPerTable, &client_table3_));
 
@@ -2626,8 +2645,9 @@ TEST_F(ClientTest, ColocatedTablesLookupTablet) {
     }
   }
 
+  // Tablet locations are received while opening tables, so no lookups are sent to the master.
   const auto lookup_serial_stop = client::internal::TEST_GetLookupSerial();
-  ASSERT_EQ(lookup_serial_stop, lookup_serial_start + 1);
+  ASSERT_EQ(lookup_serial_stop, lookup_serial_start);
 }
 
 class ClientTestWithHashAndRangePk : public ClientTest {
@@ -487,6 +487,7 @@ Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBCli
   }
 
   c->data_->meta_cache_.reset(new MetaCache(c.get()));
+  c->data_->meta_cache_->StartRefresher();
 
   // Init local host names used for locality decisions.
   RETURN_NOT_OK_PREPEND(c->data_->InitLocalHostNames(),
@@ -529,6 +530,9 @@ YBClient::~YBClient() {
 
 void YBClient::Shutdown() {
   data_->StartShutdown();
+  if (data_->meta_cache_) {
+    data_->meta_cache_->Shutdown();
+  }
   if (data_->messenger_holder_) {
     data_->messenger_holder_->Shutdown();
   }
@@ -1885,6 +1889,25 @@ std::future<Result<internal::RemoteTabletPtr>> YBClient::LookupTabletByKeyFuture
   return data_->meta_cache_->LookupTabletByKeyFuture(table, partition_key, deadline);
 }
 
+void YBClient::PrefetchTabletLocations(const std::vector<std::shared_ptr<const YBTable>>& tables,
+                                       CoarseTimePoint deadline,
+                                       StdStatusCallback callback) {
+  data_->meta_cache_->PrefetchAllTablets(tables, deadline, std::move(callback));
+}
+
+Status YBClient::PrefetchTabletLocations(
+    const std::vector<std::shared_ptr<const YBTable>>& tables, CoarseTimePoint deadline) {
+  return MakeFuture<Status>([this, &tables, deadline](auto callback) {
+    this->PrefetchTabletLocations(tables, deadline, std::move(callback));
+  }).get();
+}
+
+void YBClient::ProcessTableLocations(
+    const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+    const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations) {
+  data_->meta_cache_->ProcessTableLocations(table_id, partitions, locations);
+}
+
 std::future<Result<std::vector<internal::RemoteTabletPtr>>> YBClient::LookupAllTabletsFuture(
     const std::shared_ptr<const YBTable>& table,
     CoarseTimePoint deadline) {
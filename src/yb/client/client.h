@@ -748,6 +748,21 @@ class YBClient {
       const std::shared_ptr<const YBTable>& table,
       CoarseTimePoint deadline);
 
+  // Fetches locations of all tablets of the specified tables into the meta cache, so the first
+  // operations on these tables don't wait for tablet lookups.
+  void PrefetchTabletLocations(const std::vector<std::shared_ptr<const YBTable>>& tables,
+                               CoarseTimePoint deadline,
+                               StdStatusCallback callback);
+
+  CHECKED_STATUS PrefetchTabletLocations(
+      const std::vector<std::shared_ptr<const YBTable>>& tables, CoarseTimePoint deadline);
+
+  // Adds locations of all tablets of the table, received along with its partition list, to the
+  // meta cache.
+  void ProcessTableLocations(
+      const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+      const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations);
+
   rpc::Messenger* messenger() const;
 
   const scoped_refptr<MetricEntity>& metric_entity() const;
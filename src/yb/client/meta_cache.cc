@@ -62,6 +62,7 @@
 
 #include "yb/master/master_client.proxy.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tserver/local_tablet_server.h"
@@ -106,6 +107,11 @@ DEFINE_int64(meta_cache_lookup_throttling_step_ms, 5,
 DEFINE_int64(meta_cache_lookup_throttling_max_delay_ms, 1000,
              "Max delay between calls during lookup throttling.");
 
+DEFINE_int32(meta_cache_refresh_interval_ms, 10000,
+             "Interval of the background refresh of tables that have stale, split or leaderless "
+             "tablets in the meta cache. 0 to disable.");
+TAG_FLAG(meta_cache_refresh_interval_ms, advanced);
+
 DEFINE_test_flag(bool, force_master_lookup_all_tablets, false,
                  "If set, force the client to go to the master for all tablet lookup "
                  "instead of reading from cache.");
@@ -1113,8 +1119,11 @@ std::unordered_map<TableId, TableData>::iterator MetaCache::InitTableDataUnlocke
 }
 
 void MetaCache::InvalidateTableCache(const YBTable& table) {
-  const auto& table_id = table.id();
-  const auto table_partition_list = table.GetVersionedPartitions();
+  InvalidateTableCache(table.id(), table.GetVersionedPartitions());
+}
+
+void MetaCache::InvalidateTableCache(
+    const TableId& table_id, const VersionedTablePartitionListPtr& table_partition_list) {
   VLOG_WITH_PREFIX_AND_FUNC(1) << Format(
       "table: $0, table.partition_list.version: $1", table_id, table_partition_list->version);
 
@@ -1185,6 +1194,130 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
   }
 }
 
+void MetaCache::ProcessTableLocations(
+    const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+    const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations) {
+  // Makes sure that TableData exists and corresponds to at least the received partition list.
+  InvalidateTableCache(table_id, partitions);
+  // Locations are only cached when TableData has exactly the received partition list version,
+  // otherwise they are just ignored.
+  auto status = ProcessTabletLocations(locations, partitions->version, /* lookup_rpc= */ nullptr);
+  VLOG_WITH_PREFIX_AND_FUNC(2)
+      << "Table: " << table_id << ", partition_list_version: " << partitions->version
+      << ", tablets: " << locations.size() << ", status: " << status;
+}
+
+void MetaCache::PrefetchAllTablets(
+    const std::vector<std::shared_ptr<const YBTable>>& tables, CoarseTimePoint deadline,
+    StdStatusCallback callback) {
+  if (tables.empty()) {
+    callback(Status::OK());
+    return;
+  }
+
+  struct PrefetchState {
+    std::atomic<size_t> pending;
+    std::mutex mutex;
+    Status status;
+    StdStatusCallback callback;
+  };
+  auto state = std::make_shared<PrefetchState>();
+  state->pending = tables.size();
+  state->callback = std::move(callback);
+  for (const auto& table : tables) {
+    LookupAllTablets(table, deadline, [state, table](const auto& result) {
+      if (!result.ok()) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->status.ok()) {
+          state->status = result.status().CloneAndPrepend(
+              Format("Failed to prefetch tablets of $0", table->ToString()));
+        }
+      }
+      if (state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        state->callback(state->status);
+      }
+    });
+  }
+}
+
+void MetaCache::StartRefresher() {
+  std::lock_guard<std::mutex> lock(refresh_mutex_);
+  ScheduleRefresh();
+}
+
+void MetaCache::Shutdown() {
+  rpc::ScheduledTaskId task_id;
+  {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    closing_ = true;
+    task_id = refresh_task_id_;
+    refresh_task_id_ = rpc::kInvalidTaskId;
+  }
+  if (task_id != rpc::kInvalidTaskId) {
+    client_->messenger()->AbortOnReactor(task_id);
+  }
+}
+
+void MetaCache::ScheduleRefresh() {
+  if (closing_ || FLAGS_meta_cache_refresh_interval_ms <= 0) {
+    return;
+  }
+  scoped_refptr<MetaCache> self(this);
+  refresh_task_id_ = client_->messenger()->ScheduleOnReactor(
+      [self](const Status& status) { self->RefreshTables(status); },
+      MonoDelta::FromMilliseconds(FLAGS_meta_cache_refresh_interval_ms), SOURCE_LOCATION(),
+      client_->messenger());
+}
+
+bool MetaCache::NeedsRefreshUnlocked(const TableData& table_data) {
+  for (const auto& partition_and_tablet : table_data.tablets_by_partition) {
+    const auto& tablet = *partition_and_tablet.second;
+    if (tablet.stale() || tablet.is_split() || !tablet.HasLeader()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MetaCache::RefreshTables(const Status& status) {
+  // Held while refresh is started, so Shutdown waits for it.
+  std::lock_guard<std::mutex> lock(refresh_mutex_);
+  refresh_task_id_ = rpc::kInvalidTaskId;
+  if (!status.ok() || closing_) {
+    return;
+  }
+
+  std::vector<TableId> tables;
+  {
+    SharedLock<decltype(mutex_)> tables_lock(mutex_);
+    std::lock_guard<simple_spinlock> refreshing_lock(refreshing_tables_mutex_);
+    for (const auto& id_and_data : tables_) {
+      if (!refreshing_tables_.count(id_and_data.first) &&
+          NeedsRefreshUnlocked(id_and_data.second)) {
+        tables.push_back(id_and_data.first);
+        refreshing_tables_.insert(id_and_data.first);
+      }
+    }
+  }
+
+  for (const auto& table_id : tables) {
+    VLOG_WITH_PREFIX(1) << "Refreshing locations of table " << table_id;
+    // Received locations are added to the cache by YBTable::FetchPartitions.
+    scoped_refptr<MetaCache> self(this);
+    YBTable::FetchPartitions(
+        client_, table_id, [self, table_id](const FetchPartitionsResult& result) {
+      if (!result.ok()) {
+        VLOG(1) << self->LogPrefix() << "Failed to refresh locations of table " << table_id
+                << ": " << result.status();
+      }
+      std::lock_guard<simple_spinlock> refreshing_lock(self->refreshing_tables_mutex_);
+      self->refreshing_tables_.erase(table_id);
+    });
+  }
+
+  ScheduleRefresh();
+}
+
 class MetaCache::CallbackNotifier {
  public:
   explicit CallbackNotifier(const Status& status) : status_(status) {}
@@ -1366,8 +1499,8 @@ class LookupFullTableRpc : public LookupRpc {
   void CallRemoteMethod() override {
     // Fill out the request.
     req_.mutable_table()->set_table_id(table()->id());
-    // The end partition key is left unset intentionally so that we'll prefetch
-    // some additional tablets.
+    // Fetch the whole partition map with a single request.
+    req_.set_max_returned_locations(std::numeric_limits<int32_t>::max());
     master_client_proxy()->GetTableLocationsAsync(
         req_, &resp_, mutable_retrier()->mutable_controller(),
         std::bind(&LookupFullTableRpc::Finished, this, Status::OK()));
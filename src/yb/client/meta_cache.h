@@ -35,9 +35,11 @@
 
 #include <shared_mutex>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/variant.hpp>
@@ -72,6 +74,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/semaphore.h"
 #include "yb/util/status_fwd.h"
+#include "yb/util/status_callback.h"
 #include "yb/util/memory/arena.h"
 #include "yb/util/net/net_util.h"
 
@@ -517,6 +520,26 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                         CoarseTimePoint deadline,
                         LookupTabletRangeCallback callback);
 
+  // Fetches locations of all tablets of the specified tables, so subsequent lookups of these
+  // tables are served from the cache. Tables are looked up concurrently, with a single master
+  // request per table. Callback is invoked with the first failure, if any, after all lookups
+  // complete.
+  void PrefetchAllTablets(const std::vector<std::shared_ptr<const YBTable>>& tables,
+                          CoarseTimePoint deadline,
+                          StdStatusCallback callback);
+
+  // Fills the cache with locations of all tablets of the table, received from the master along
+  // with its partition list. Invalidates cached data for an older partition list version.
+  void ProcessTableLocations(
+      const TableId& table_id, const VersionedTablePartitionListPtr& partitions,
+      const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations);
+
+  // Starts periodic background refresh of tables that have stale, split or leaderless tablets,
+  // so their locations are updated before the next operation on them fails.
+  void StartRefresher();
+
+  void Shutdown();
+
   // If table is specified and cache is not used or has no tablet leader also checks whether table
   // partitions are stale and returns ClientErrorCode::kTablePartitionListIsStale in that case.
   void LookupTabletById(const TabletId& tablet_id,
@@ -558,6 +581,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   void InvalidateTableCache(const YBTable& table);
 
+  void InvalidateTableCache(
+      const TableId& table_id, const VersionedTablePartitionListPtr& table_partition_list);
+
   const std::string& LogPrefix() const { return log_prefix_; }
 
  private:
@@ -657,6 +683,13 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                           CoarseTimePoint deadline,
                           LookupTabletRangeCallback* callback);
 
+  void ScheduleRefresh() REQUIRES(refresh_mutex_);
+
+  void RefreshTables(const Status& status);
+
+  // Returns true if the table has tablets whose cached locations are not usable.
+  bool NeedsRefreshUnlocked(const TableData& table_data) REQUIRES_SHARED(mutex_);
+
   YBClient* const client_;
 
   std::shared_timed_mutex mutex_;
@@ -688,6 +721,14 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   const std::string log_prefix_;
 
+  std::mutex refresh_mutex_;
+  bool closing_ GUARDED_BY(refresh_mutex_) = false;
+  rpc::ScheduledTaskId refresh_task_id_ GUARDED_BY(refresh_mutex_) = rpc::kInvalidTaskId;
+
+  simple_spinlock refreshing_tables_mutex_;
+  // Tables with refresh in progress.
+  std::unordered_set<TableId> refreshing_tables_ GUARDED_BY(refreshing_tables_mutex_);
+
   DISALLOW_COPY_AND_ASSIGN(MetaCache);
 };
 
@@ -281,7 +281,7 @@ void YBTable::FetchPartitions(
   client->GetTableLocations(
       table_id, /* max_tablets = */ std::numeric_limits<int32_t>::max(),
       RequireTabletsRunning::kTrue,
-      [table_id, callback = std::move(callback)]
+      [client, table_id, callback = std::move(callback)]
           (const Result<master::GetTableLocationsResponsePB*>& result) {
         if (!result.ok()) {
           callback(result.status());
@@ -301,6 +301,10 @@ void YBTable::FetchPartitions(
         }
         std::sort(partitions->keys.begin(), partitions->keys.end());
 
+        // Locations of all tablets are already here, so fill the meta cache with them to avoid
+        // separate lookups of the table tablets.
+        client->ProcessTableLocations(table_id, partitions, resp.tablet_locations());
+
         callback(partitions);
       });
 }
@@ -21,5 +21,10 @@ const std::string kPgsqlErrorCategoryName = "pgsql error";
 StatusCategoryRegisterer pgsql_error_category_registerer(
     StatusCategoryDescription::Make<PgsqlErrorTag>(&kPgsqlErrorCategoryName));
 
+const std::string kPgsqlRequestStatusCategoryName = "pgsql request status";
+
+StatusCategoryRegisterer pgsql_request_status_category_registerer(
+    StatusCategoryDescription::Make<PgsqlRequestStatusTag>(&kPgsqlRequestStatusCategoryName));
+
 } // namespace
 } // namespace yb
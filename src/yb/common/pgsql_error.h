@@ -14,6 +14,8 @@
 #ifndef YB_COMMON_PGSQL_ERROR_H
 #define YB_COMMON_PGSQL_ERROR_H
 
+#include "yb/common/pgsql_protocol.pb.h"
+
 #include "yb/util/status_fwd.h"
 #include "yb/util/status_ec.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -36,6 +38,19 @@ struct PgsqlErrorTag : IntegralErrorTag<YBPgErrorCode> {
 
 typedef StatusErrorCodeImpl<PgsqlErrorTag> PgsqlError;
 
+// Status of the request to be reported in PgsqlResponsePB when the read or write operation fails,
+// e.g. PGSQL_STATUS_SCHEMA_VERSION_MISMATCH to make pggate refresh the table schema and retry.
+struct PgsqlRequestStatusTag : IntegralErrorTag<PgsqlResponsePB::RequestStatus> {
+  // It is part of the wire protocol and should not be changed once released.
+  static constexpr uint8_t kCategory = 16;
+
+  static std::string ToMessage(Value value) {
+    return PgsqlResponsePB::RequestStatus_Name(value);
+  }
+};
+
+typedef StatusErrorCodeImpl<PgsqlRequestStatusTag> PgsqlRequestStatus;
+
 } // namespace yb
 
 #endif // YB_COMMON_PGSQL_ERROR_H
@@ -148,6 +148,9 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_retain_delete_markers(retain_delete_markers_);
+  if (packed_row_) {
+    pb->set_packed_row(packed_row_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -179,6 +182,9 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_retain_delete_markers()) {
     table_properties.SetRetainDeleteMarkers(pb.retain_delete_markers());
   }
+  if (pb.has_packed_row()) {
+    table_properties.SetPackedRow(pb.packed_row());
+  }
   return table_properties;
 }
 
@@ -219,6 +225,7 @@ void TableProperties::Reset() {
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
   retain_delete_markers_ = false;
+  packed_row_ = false;
 }
 
 string TableProperties::ToString() const {
@@ -231,6 +238,9 @@ string TableProperties::ToString() const {
   if (HasCopartitionTableId()) {
     result += Format("copartition_table_id: $0 ", copartition_table_id_);
   }
+  if (packed_row_) {
+    result += "packed_row: true ";
+  }
   return result + Format(
       "consistency_level: $0 is_ysql_catalog_table: $1 }",
       consistency_level_,
@@ -307,6 +307,7 @@ class TableProperties {
     // Ignoring num_tablets_.
     // Ignoring retain_delete_markers_.
     // Ignoring wal_retention_secs_.
+    // Ignoring packed_row_.
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -338,6 +339,7 @@ class TableProperties {
     // Ignoring contain_counters_.
     // Ignoring retain_delete_markers_.
     // Ignoring wal_retention_secs_.
+    // Ignoring packed_row_.
     return true;
   }
 
@@ -425,6 +427,16 @@ class TableProperties {
     retain_delete_markers_ = retain_delete_markers;
   }
 
+  // Packed row format is chosen when the table is created and is never altered, so readers could
+  // skip probing for packed rows in tables that never stored them.
+  bool packed_row() const {
+    return packed_row_;
+  }
+
+  void SetPackedRow(bool packed_row) {
+    packed_row_ = packed_row;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -451,6 +463,7 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  bool packed_row_ = false;
 };
 
 // The schema for a set of rows.
@@ -633,6 +646,10 @@ class Schema {
     table_properties_.SetRetainDeleteMarkers(retain_delete_markers);
   }
 
+  void SetPackedRow(bool packed_row) {
+    table_properties_.SetPackedRow(packed_row);
+  }
+
   // Return the column index corresponding to the given column,
   // or kColumnNotFound if the column is not in this schema.
   int find_column(const GStringPiece col_name) const {
@@ -345,6 +345,7 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     performing_update_lock.unlock();
     performing_heartbeat_lock.release();
     multi_raft_batcher_->AddRequestToBatch(&heartbeat_request_, &heartbeat_response_,
+                                           HeartbeatOnly::kTrue,
                                            std::bind(&Peer::ProcessHeartbeatResponse,
                                                      retain_self, _1));
     return;
@@ -360,6 +361,19 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
   processing_lock.unlock();
   performing_update_lock.release();
+
+  // Small updates, either data-bearing or commit-only, are coalesced with requests of other
+  // tablets to the same server, the response is processed as if it was received for a separate
+  // request.
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      multi_raft_batcher_->CanCoalesce(update_request_)) {
+    multi_raft_batcher_->AddRequestToBatch(&update_request_, &update_response_,
+                                           HeartbeatOnly::kFalse,
+                                           std::bind(&Peer::ProcessUpdateResponse,
+                                                     retain_self, _1));
+    return;
+  }
+
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(&update_request_, trigger_mode, &update_response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
@@ -444,12 +458,16 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
 }
 
 void Peer::ProcessResponse() {
-  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
   auto status = controller_.status();
   if (status.ok()) {
     status = controller_.thread_pool_failure();
   }
   controller_.Reset();
+  ProcessUpdateResponse(status);
+}
+
+void Peer::ProcessUpdateResponse(const Status& status) {
+  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
   CleanRequestOps(&update_request_);
 
   auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
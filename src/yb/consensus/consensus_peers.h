@@ -186,6 +186,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // requires IO or may block.
   void ProcessResponse();
 
+  // Handles response to the update request, which was either sent separately or as part of a
+  // multi-raft batch.
+  void ProcessUpdateResponse(const Status& status);
+
   // Signals that a heartbeat response was received from the peer.
   void ProcessHeartbeatResponse(const Status& status);
 
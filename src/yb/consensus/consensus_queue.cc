@@ -370,6 +370,7 @@ void PeerMessageQueue::LocalPeerAppendFinished(const OpId& id, const Status& sta
     queue_state_.last_applied_op_id.ToPB(fake_response.mutable_status()->mutable_last_applied());
 
     if (queue_state_.mode != Mode::LEADER) {
+      log_cache_.SetMaxUnneededOpIndex(id.index);
       log_cache_.EvictThroughOp(id.index);
 
       UpdateMetrics();
@@ -1245,6 +1246,11 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     auto evict_index = GetCDCConsumerOpIdToEvict().index;
 
+    // Operations evicted before they were replicated to lagging followers are kept in the
+    // compressed tier of the log cache.
+    log_cache_.SetMaxUnneededOpIndex(
+        std::min(evict_index, queue_state_.all_replicated_op_id.index));
+
     int32_t lagging_follower_threshold = FLAGS_consensus_lagging_follower_threshold;
     if (lagging_follower_threshold > 0) {
       UpdateAllNonLaggingReplicatedOpId(lagging_follower_threshold);
@@ -1594,6 +1600,14 @@ size_t PeerMessageQueue::EvictLogCache(size_t bytes_to_evict) {
   return log_cache_.EvictThroughOp(std::numeric_limits<int64_t>::max(), bytes_to_evict);
 }
 
+size_t PeerMessageQueue::CompressedLogCacheSize() {
+  return log_cache_.CompressedBytesUsed();
+}
+
+size_t PeerMessageQueue::EvictCompressedLogCache(size_t bytes_to_evict) {
+  return log_cache_.EvictCompressed(bytes_to_evict);
+}
+
 Status PeerMessageQueue::FlushLogIndex() {
   return log_cache_.FlushIndex();
 }
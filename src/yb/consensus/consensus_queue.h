@@ -365,6 +365,8 @@ class PeerMessageQueue {
 
   size_t LogCacheSize();
   size_t EvictLogCache(size_t bytes_to_evict);
+  size_t CompressedLogCacheSize();
+  size_t EvictCompressedLogCache(size_t bytes_to_evict);
 
   CHECKED_STATUS FlushLogIndex();
 
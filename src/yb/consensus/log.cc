@@ -51,6 +51,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/log_util.h"
 
 #include "yb/fs/fs_manager.h"
@@ -937,7 +938,11 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        if (options_.sync_group) {
+          RETURN_NOT_OK(options_.sync_group->Sync(active_segment_.get()));
+        } else {
+          RETURN_NOT_OK(active_segment_->Sync());
+        }
       }
     }
   }
@@ -373,6 +373,46 @@ TEST_F(LogCacheTest, TestReplaceMessages) {
             cache_->ToString());
 }
 
+// Tests that evicted operations which are still needed are served from the compressed tier.
+TEST_F(LogCacheTest, TestCompressedTier) {
+  constexpr int kMessages = 20;
+  constexpr int kUnneededIndex = 5;
+  constexpr int kEvictIndex = 15;
+
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kMessages, 1_KB));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+
+  cache_->SetMaxUnneededOpIndex(kUnneededIndex);
+  cache_->EvictThroughOp(kEvictIndex);
+  ASSERT_EQ(kMessages - kEvictIndex, cache_->metrics_.num_ops->value());
+  ASSERT_EQ(kEvictIndex - kUnneededIndex, cache_->metrics_.compressed_num_ops->value());
+  ASSERT_GT(cache_->CompressedBytesUsed(), 0);
+  ASSERT_EQ(cache_->CompressedBytesUsed(), cache_->metrics_.compressed_size->value());
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(kUnneededIndex, 8_MB));
+  ASSERT_EQ(kMessages - kUnneededIndex, read_result.messages.size());
+  for (int i = 0; i != kMessages - kUnneededIndex; ++i) {
+    EXPECT_EQ(OpIdStrForIndex(kUnneededIndex + 1 + i),
+              OpIdToString(read_result.messages[i]->id()));
+  }
+  EXPECT_EQ(kEvictIndex - kUnneededIndex, cache_->metrics_.compressed_reads->value());
+  EXPECT_EQ(0, cache_->metrics_.disk_reads->value());
+
+  // Only unneeded operations are read from disk.
+  read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kMessages, read_result.messages.size());
+  EXPECT_EQ(kUnneededIndex, cache_->metrics_.disk_reads->value());
+  auto op_id = ASSERT_RESULT(cache_->LookupOpId(kEvictIndex));
+  EXPECT_EQ(OpIdStrForIndex(kEvictIndex), OpIdToString(op_id));
+
+  cache_->SetMaxUnneededOpIndex(kEvictIndex - 1);
+  ASSERT_EQ(1, cache_->metrics_.compressed_num_ops->value());
+
+  ASSERT_GT(cache_->EvictCompressed(std::numeric_limits<int64_t>::max()), 0);
+  ASSERT_EQ(0, cache_->metrics_.compressed_num_ops->value());
+  ASSERT_EQ(0, cache_->CompressedBytesUsed());
+}
+
 TEST_F(LogCacheTest, TestMTReadAndWrite) {
   atomic<bool> stop { false };
   bool stopped = false;
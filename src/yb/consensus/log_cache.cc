@@ -37,6 +37,8 @@
 #include <mutex>
 #include <vector>
 
+#include <lz4.h>
+
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_reader.h"
@@ -46,6 +48,7 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 
+#include "yb/util/cast.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/locks.h"
@@ -76,6 +79,12 @@ DEFINE_int32(global_log_cache_size_limit_percentage, 5,
              "entries across all tablets. Default is 5.");
 TAG_FLAG(global_log_cache_size_limit_percentage, advanced);
 
+DEFINE_int32(global_log_cache_compressed_size_limit_mb, 256,
+             "Server-wide limit of memory used for keeping LZ4-compressed log entries that were "
+             "evicted from log caches, but are still needed by lagging followers or CDC "
+             "consumers. 0 to disable the compressed tier.");
+TAG_FLAG(global_log_cache_compressed_size_limit_mb, advanced);
+
 DEFINE_test_flag(bool, log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -90,6 +99,16 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
 METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
                       yb::MetricUnit::kEntries,
                       "Amount of operations read from disk.");
+METRIC_DEFINE_gauge_int64(tablet, log_cache_compressed_num_ops,
+                          "Log Cache Compressed Operation Count",
+                          yb::MetricUnit::kOperations,
+                          "Number of operations in the compressed tier of the log cache.");
+METRIC_DEFINE_gauge_int64(tablet, log_cache_compressed_size, "Log Cache Compressed Memory Usage",
+                          yb::MetricUnit::kBytes,
+                          "Amount of memory in use for keeping compressed evicted log entries.");
+METRIC_DEFINE_counter(tablet, log_cache_compressed_reads, "Log Cache Compressed Reads",
+                      yb::MetricUnit::kEntries,
+                      "Amount of operations read from the compressed tier of the log cache.");
 
 DECLARE_bool(get_changes_honor_deadline);
 
@@ -99,6 +118,7 @@ namespace consensus {
 namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
+const std::string kCompressedMemTrackerId = "log_cache_compressed"s;
 
 }
 
@@ -128,6 +148,11 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
       AddToParent::kTrue, CreateMetrics::kFalse);
   tracker_->SetMetricEntity(metric_entity, kParentMemTrackerId);
 
+  compressed_parent_tracker_ = GetServerCompressedMemTracker(server_tracker);
+  compressed_tracker_ = MemTracker::CreateTracker(
+      Format("$0-$1", kCompressedMemTrackerId, tablet_id), compressed_parent_tracker_,
+      AddToParent::kTrue, CreateMetrics::kFalse);
+
   // Put a fake message at index 0, since this simplifies a lot of our code paths elsewhere.
   auto zero_op = std::make_shared<ReplicateMsg>();
   *zero_op->mutable_id() = MinimumOpId();
@@ -150,11 +175,20 @@ MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker)
       global_max_ops_size_bytes, kParentMemTrackerId, server_tracker);
 }
 
+MemTrackerPtr LogCache::GetServerCompressedMemTracker(const MemTrackerPtr& server_tracker) {
+  return MemTracker::FindOrCreateTracker(
+      FLAGS_global_log_cache_compressed_size_limit_mb * 1_MB, kCompressedMemTrackerId,
+      server_tracker);
+}
+
 LogCache::~LogCache() {
   tracker_->Release(tracker_->consumption());
   cache_.clear();
+  compressed_tracker_->Release(compressed_tracker_->consumption());
+  compressed_cache_.clear();
 
   tracker_->UnregisterFromParent();
+  compressed_tracker_->UnregisterFromParent();
 }
 
 void LogCache::Init(const OpIdPB& preceding_op) {
@@ -194,6 +228,10 @@ LogCache::PrepareAppendResult LogCache::PrepareAppendOperations(const ReplicateM
         cache_.erase(it);
       }
     }
+    for (auto it = compressed_cache_.lower_bound(first_idx_in_batch);
+         it != compressed_cache_.end();) {
+      EraseCompressedUnlocked(it++);
+    }
   }
 
   for (auto& e : entries_to_insert) {
@@ -271,6 +309,10 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
     if (iter != cache_.end()) {
       return yb::OpId::FromPB(iter->second.msg->id());
     }
+    auto compressed_iter = compressed_cache_.find(op_index);
+    if (compressed_iter != compressed_cache_.end()) {
+      return compressed_iter->second.op_id;
+    }
   }
 
   // If it misses, read from the log.
@@ -338,6 +380,29 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         up_to = std::min(iter->first - 1, static_cast<uint64_t>(to_index - 1));
       }
 
+      // Prefer the compressed tier to the disk.
+      auto compressed_msgs = VERIFY_RESULT(ReadCompressedOps(
+          next_index, up_to, remaining_space, &l));
+      if (!compressed_msgs.empty()) {
+        metrics_.compressed_reads->IncrementBy(compressed_msgs.size());
+        for (auto& msg : compressed_msgs) {
+          auto current_message_size = TotalByteSizeForMessage(*msg);
+          remaining_space -= current_message_size;
+          if (remaining_space < 0 && !result.messages.empty()) {
+            break;
+          }
+          result.messages.push_back(std::move(msg));
+          next_index++;
+        }
+        continue;
+      }
+
+      // Don't read from the disk operations available in the compressed tier.
+      auto compressed_iter = compressed_cache_.upper_bound(next_index);
+      if (compressed_iter != compressed_cache_.end()) {
+        up_to = std::min(up_to, compressed_iter->first - 1);
+      }
+
       l.unlock();
 
       ReplicateMsgs raw_replicate_ptrs;
@@ -390,11 +455,18 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
 }
 
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
-  std::lock_guard<simple_spinlock> lock(lock_);
-  return EvictSomeUnlocked(index, bytes_to_evict);
+  ReplicateMsgs to_compress;
+  size_t result;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    result = EvictSomeUnlocked(index, bytes_to_evict, &to_compress);
+  }
+  AddToCompressedTier(to_compress);
+  return result;
 }
 
-size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evict) {
+size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evict,
+                                   ReplicateMsgs* to_compress) {
   DCHECK(lock_.is_locked());
   VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting log cache index <= "
                       << stop_after_index
@@ -422,6 +494,9 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
     }
 
     VLOG_WITH_PREFIX_UNLOCKED(2) << "Evicting cache. Removing: " << msg->id();
+    if (msg_index > max_unneeded_op_index_ && compressed_parent_tracker_->limit() > 0) {
+      to_compress->push_back(msg);
+    }
     AccountForMessageRemovalUnlocked(entry);
     bytes_evicted += entry.mem_usage;
     cache_.erase(iter++);
@@ -435,6 +510,116 @@ size_t LogCache::EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_ev
   return bytes_evicted;
 }
 
+void LogCache::AddToCompressedTier(const ReplicateMsgs& msgs) {
+  if (msgs.empty()) {
+    return;
+  }
+
+  std::string buffer;
+  for (const auto& msg : msgs) {
+    CompressedEntry entry;
+    entry.op_id = yb::OpId::FromPB(msg->id());
+    entry.uncompressed_size = msg->ByteSizeLong();
+    buffer.resize(entry.uncompressed_size);
+    msg->SerializeWithCachedSizesToArray(pointer_cast<uint8_t*>(&buffer[0]));
+    entry.data.resize(LZ4_compressBound(static_cast<int>(buffer.size())));
+    int compressed_size = LZ4_compress(buffer.data(), &entry.data[0], buffer.size());
+    if (compressed_size <= 0) {
+      LOG_WITH_PREFIX_UNLOCKED(DFATAL) << "Failed to compress " << entry.op_id;
+      continue;
+    }
+    entry.data.resize(compressed_size);
+    entry.data.shrink_to_fit();
+    entry.mem_usage = entry.data.capacity() + sizeof(CompressedEntry);
+
+    // Consuming memory could evict older compressed entries of this or other tablets, so it should
+    // be done without lock.
+    if (!compressed_tracker_->TryConsume(entry.mem_usage)) {
+      VLOG_WITH_PREFIX_UNLOCKED(2) << "No room in the compressed tier for " << entry.op_id;
+      continue;
+    }
+
+    std::lock_guard<simple_spinlock> lock(lock_);
+    // The operation could become unneeded, get overwritten or be cached again meanwhile.
+    if (entry.op_id.index <= max_unneeded_op_index_ ||
+        entry.op_id.index >= next_sequential_op_index_ ||
+        cache_.count(entry.op_id.index) ||
+        compressed_cache_.count(entry.op_id.index)) {
+      compressed_tracker_->Release(entry.mem_usage);
+      continue;
+    }
+    metrics_.compressed_size->IncrementBy(entry.mem_usage);
+    metrics_.compressed_num_ops->Increment();
+    compressed_cache_.emplace(entry.op_id.index, std::move(entry));
+  }
+}
+
+Result<ReplicateMsgs> LogCache::ReadCompressedOps(
+    int64_t next_index, int64_t up_to, int64_t max_size_bytes,
+    std::unique_lock<simple_spinlock>* lock) {
+  std::vector<CompressedEntry> entries;
+  int64_t total_size = 0;
+  for (auto it = compressed_cache_.find(next_index);
+       it != compressed_cache_.end() && it->first <= up_to && total_size <= max_size_bytes &&
+           it->first == next_index + static_cast<int64_t>(entries.size());
+       ++it) {
+    total_size += it->second.uncompressed_size;
+    entries.push_back(it->second);
+  }
+
+  ReplicateMsgs result;
+  if (entries.empty()) {
+    return result;
+  }
+
+  lock->unlock();
+  std::string buffer;
+  result.reserve(entries.size());
+  for (const auto& entry : entries) {
+    buffer.resize(entry.uncompressed_size);
+    int size = LZ4_decompress_safe(
+        entry.data.data(), &buffer[0], entry.data.size(), entry.uncompressed_size);
+    auto msg = std::make_shared<ReplicateMsg>();
+    if (size != static_cast<int>(entry.uncompressed_size) ||
+        !msg->ParseFromArray(buffer.data(), size)) {
+      lock->lock();
+      return STATUS_FORMAT(Corruption, "Failed to decompress cached operation $0", entry.op_id);
+    }
+    result.push_back(std::move(msg));
+  }
+  lock->lock();
+  return result;
+}
+
+void LogCache::SetMaxUnneededOpIndex(int64_t index) {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  if (index <= max_unneeded_op_index_) {
+    return;
+  }
+  max_unneeded_op_index_ = index;
+  for (auto it = compressed_cache_.begin();
+       it != compressed_cache_.end() && it->first <= index;) {
+    EraseCompressedUnlocked(it++);
+  }
+}
+
+size_t LogCache::EvictCompressed(int64_t bytes_to_evict) {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < bytes_to_evict && !compressed_cache_.empty()) {
+    bytes_evicted += compressed_cache_.begin()->second.mem_usage;
+    EraseCompressedUnlocked(compressed_cache_.begin());
+  }
+  return bytes_evicted;
+}
+
+void LogCache::EraseCompressedUnlocked(std::map<int64_t, CompressedEntry>::iterator it) {
+  compressed_tracker_->Release(it->second.mem_usage);
+  metrics_.compressed_size->DecrementBy(it->second.mem_usage);
+  metrics_.compressed_num_ops->Decrement();
+  compressed_cache_.erase(it);
+}
+
 Status LogCache::FlushIndex() {
   return log_->FlushIndex();
 }
@@ -451,6 +636,10 @@ int64_t LogCache::BytesUsed() const {
   return tracker_->consumption();
 }
 
+int64_t LogCache::CompressedBytesUsed() const {
+  return compressed_tracker_->consumption();
+}
+
 Result<OpId> LogCache::TEST_GetLastOpIdWithType(int64_t max_allowed_index, OperationType op_type) {
   constexpr int kStepSize = 20;
   for (auto end = max_allowed_index; end > 0; end -= kStepSize) {
@@ -542,7 +731,8 @@ void LogCache::TrackOperationsMemory(const OpIds& op_ids) {
     return;
   }
 
-  std::lock_guard<simple_spinlock> lock(lock_);
+  ReplicateMsgs to_compress;
+  std::unique_lock<simple_spinlock> lock(lock_);
 
   int mem_required = 0;
   for (const auto& op_id : op_ids) {
@@ -572,8 +762,10 @@ void LogCache::TrackOperationsMemory(const OpIds& op_ids) {
 
     // TODO: we should also try to evict from other tablets - probably better to evict really old
     // ops from another tablet than evict recent ops from this one.
-    EvictSomeUnlocked(min_pinned_op_index_, need_to_free);
+    EvictSomeUnlocked(min_pinned_op_index_, need_to_free, &to_compress);
   }
+  lock.unlock();
+  AddToCompressedTier(to_compress);
 }
 
 int64_t LogCache::num_cached_ops() const {
@@ -585,7 +777,10 @@ int64_t LogCache::num_cached_ops() const {
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : INSTANTIATE_METRIC(num_ops, 0),
     INSTANTIATE_METRIC(size, 0),
-    INSTANTIATE_METRIC(disk_reads) {
+    INSTANTIATE_METRIC(disk_reads),
+    INSTANTIATE_METRIC(compressed_num_ops, 0),
+    INSTANTIATE_METRIC(compressed_size, 0),
+    INSTANTIATE_METRIC(compressed_reads) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -82,6 +82,10 @@ struct ReadOpsResult {
 // This stores a set of log messages by their index. New operations can be appended to the end as
 // they are written to the log. Readers fetch entries that were explicitly appended, or they can
 // fetch older entries which are asynchronously fetched from the disk.
+//
+// Operations evicted because of memory pressure, that are still needed by lagging followers or
+// CDC consumers, are kept LZ4-compressed in the second tier of the cache. The second tier is
+// limited by a server-wide memory budget, shared across tablets by the tablet memory manager.
 class LogCache {
  public:
   LogCache(const scoped_refptr<MetricEntity>& metric_entity,
@@ -94,6 +98,10 @@ class LogCache {
   static std::shared_ptr<MemTracker> GetServerMemTracker(
       const std::shared_ptr<MemTracker>& server_tracker);
 
+  // Returns the server-wide tracker of the compressed tier.
+  static std::shared_ptr<MemTracker> GetServerCompressedMemTracker(
+      const std::shared_ptr<MemTracker>& server_tracker);
+
   // Initialize the cache.
   //
   // 'preceding_op' is the current latest op. The next AppendOperation() call must follow this op.
@@ -142,12 +150,24 @@ class LogCache {
   bool HasOpBeenWritten(int64_t log_index) const;
 
   // Evict any operations with op index <= 'index'.
+  // Evicted operations with index above the one passed to SetMaxUnneededOpIndex are moved to the
+  // compressed tier.
   size_t EvictThroughOp(
       int64_t index, int64_t bytes_to_evict = std::numeric_limits<int64_t>::max());
 
+  // Notifies the cache that operations with op index <= 'index' are not needed by any follower or
+  // CDC consumer, so they are removed from the compressed tier and are not compressed on eviction.
+  void SetMaxUnneededOpIndex(int64_t index);
+
+  // Evict the oldest operations from the compressed tier until 'bytes_to_evict' bytes are freed.
+  size_t EvictCompressed(int64_t bytes_to_evict);
+
   // Return the number of bytes of memory currently in use by the cache.
   int64_t BytesUsed() const;
 
+  // Return the number of bytes of memory currently in use by the compressed tier of the cache.
+  int64_t CompressedBytesUsed() const;
+
   int64_t num_cached_ops() const;
 
   int64_t earliest_op_index() const;
@@ -184,6 +204,7 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitMB);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitPercentage);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestCompressedTier);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -197,10 +218,33 @@ class LogCache {
     bool tracked = false;
   };
 
+  // An entry in the compressed tier of the cache.
+  struct CompressedEntry {
+    yb::OpId op_id;
+    // LZ4-compressed serialized ReplicateMsg.
+    std::string data;
+    size_t uncompressed_size = 0;
+    int64_t mem_usage = 0;
+  };
+
   // Try to evict the oldest operations from the queue, stopping either when
   // 'bytes_to_evict' bytes have been evicted, or the op with index
   // 'stop_after_index' has been evicted, whichever comes first.
-  size_t EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evict);
+  // Evicted operations that should be moved to the compressed tier are added to 'to_compress'.
+  size_t EvictSomeUnlocked(int64_t stop_after_index, int64_t bytes_to_evict,
+                           ReplicateMsgs* to_compress);
+
+  // Compresses evicted operations and adds them to the compressed tier, while its memory budget
+  // allows. Should be invoked without lock_ held, since consuming memory could trigger eviction.
+  void AddToCompressedTier(const ReplicateMsgs& msgs);
+
+  // Reads contiguous operations starting from 'next_index' from the compressed tier.
+  // Temporarily releases 'lock' while decompressing.
+  Result<ReplicateMsgs> ReadCompressedOps(
+      int64_t next_index, int64_t up_to, int64_t max_size_bytes,
+      std::unique_lock<simple_spinlock>* lock);
+
+  void EraseCompressedUnlocked(std::map<int64_t, CompressedEntry>::iterator it);
 
   // Update metrics and MemTracker to account for the removal of the
   // given message.
@@ -243,6 +287,12 @@ class LogCache {
   typedef std::map<uint64_t, CacheEntry> MessageCache;
   MessageCache cache_;
 
+  // The compressed tier, maps from log index -> CompressedEntry.
+  std::map<int64_t, CompressedEntry> compressed_cache_;
+
+  // Operations with index <= max_unneeded_op_index_ are not needed by any follower or CDC consumer.
+  int64_t max_unneeded_op_index_ = 0;
+
   // The next log index to append. Each append operation must either start with this log index, or
   // go backward (but never skip forward).
   int64_t next_sequential_op_index_;
@@ -262,6 +312,12 @@ class LogCache {
   // A MemTracker for this instance.
   std::shared_ptr<MemTracker> tracker_;
 
+  // Parent tracker for compressed tiers of all log caches, with the server-wide limit.
+  std::shared_ptr<MemTracker> compressed_parent_tracker_;
+
+  // A MemTracker for the compressed tier of this instance.
+  std::shared_ptr<MemTracker> compressed_tracker_;
+
   struct Metrics {
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
 
@@ -272,6 +328,14 @@ class LogCache {
     scoped_refptr<AtomicGauge<int64_t>> size;
 
     scoped_refptr<Counter> disk_reads;
+
+    // Keeps track of the number of operations in the compressed tier.
+    scoped_refptr<AtomicGauge<int64_t>> compressed_num_ops;
+
+    // Keeps track of the memory consumed by the compressed tier, in bytes.
+    scoped_refptr<AtomicGauge<int64_t>> compressed_size;
+
+    scoped_refptr<Counter> compressed_reads;
   };
   Metrics metrics_;
 
@@ -31,6 +31,8 @@ class LogIndex;
 class LogReader;
 class LogSegmentFooterPB;
 class LogSegmentHeaderPB;
+class LogSyncGroup;
+class LogSyncGroups;
 class ReadableLogSegment;
 class WritableLogSegment;
 
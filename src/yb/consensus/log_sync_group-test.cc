@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_group.h"
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/env.h"
+#include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
+#include "yb/util/path_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(TEST_log_sync_group_delay_ms);
+
+METRIC_DECLARE_counter(log_group_sync_fsyncs);
+METRIC_DECLARE_histogram(log_group_sync_group_size);
+
+namespace yb {
+namespace log {
+
+class LogSyncGroupTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    metric_entity_ = METRIC_ENTITY_server.Instantiate(&metric_registry_, "log_sync_group-test");
+    groups_ = std::make_unique<LogSyncGroups>(metric_entity_);
+  }
+
+  Result<std::unique_ptr<WritableLogSegment>> CreateSegment(const std::string& name) {
+    auto path = JoinPathSegments(GetTestDataDirectory(), name);
+    std::unique_ptr<WritableFile> file;
+    RETURN_NOT_OK(env_->NewWritableFile(path, &file));
+    return std::make_unique<WritableLogSegment>(path, std::move(file));
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  std::unique_ptr<LogSyncGroups> groups_;
+};
+
+TEST_F(LogSyncGroupTest, GroupPerDir) {
+  auto* group = groups_->Get("/wal1");
+  ASSERT_EQ("/wal1", group->dir());
+  ASSERT_EQ(group, groups_->Get("/wal1"));
+  ASSERT_NE(group, groups_->Get("/wal2"));
+}
+
+// Each thread syncs its own segment, as logs of different tablets do. Syncs of threads that are
+// waiting at the same time share a single file system sync.
+TEST_F(LogSyncGroupTest, ConcurrentSyncs) {
+  constexpr int kNumThreads = 16;
+  constexpr int kSyncsPerThread = 20;
+  constexpr int kSyncDelayMs = 10;
+
+  auto* group = groups_->Get(GetTestDataDirectory());
+  if (!group->shared_sync_enabled()) {
+    LOG(INFO) << "Shared sync is not supported";
+    return;
+  }
+  FLAGS_TEST_log_sync_group_delay_ms = kSyncDelayMs;
+
+  std::vector<std::unique_ptr<WritableLogSegment>> segments;
+  for (int i = 0; i != kNumThreads; ++i) {
+    segments.push_back(ASSERT_RESULT(CreateSegment(Format("segment-$0", i))));
+  }
+
+  std::atomic<int64_t> max_latency_us{0};
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumThreads; ++i) {
+    auto* segment = segments[i].get();
+    thread_holder.AddThreadFunctor([group, segment, &max_latency_us] {
+      for (int j = 0; j != kSyncsPerThread; ++j) {
+        auto start = MonoTime::Now();
+        ASSERT_OK(group->Sync(segment));
+        UpdateAtomicMax(&max_latency_us, (MonoTime::Now() - start).ToMicroseconds());
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  const int64_t kNumRequests = kNumThreads * kSyncsPerThread;
+  auto fsyncs = METRIC_log_group_sync_fsyncs.Instantiate(metric_entity_)->value();
+  auto group_size = METRIC_log_group_sync_group_size.Instantiate(metric_entity_);
+  auto num_groups = static_cast<int64_t>(group_size->TotalCount());
+  LOG(INFO) << "Groups: " << num_groups << ", fsyncs: " << fsyncs << ", max latency: "
+            << max_latency_us.load() << "us";
+
+  // Every request is part of exactly one group.
+  ASSERT_EQ(kNumRequests, static_cast<int64_t>(group_size->histogram()->TotalSum()));
+  // Every group syncs the file system once, for all of its segments.
+  ASSERT_EQ(num_groups, fsyncs);
+  // Threads request syncs faster than the file system is synced, so groups contain several
+  // requests.
+  ASSERT_LE(fsyncs, kNumRequests / 4);
+  // Request waits for the group that is in progress and then for its own group, it never waits for
+  // syncs of other segments one after another.
+  ASSERT_LT(max_latency_us.load(), 1000 * (2 * kSyncDelayMs + 500));
+}
+
+} // namespace log
+} // namespace yb
@@ -0,0 +1,194 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_group.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/utsname.h>
+#endif
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status.h"
+
+DEFINE_bool(log_group_sync_across_tablets, false,
+            "Sync WAL segments of tablets located on the same WAL disk in groups, with a single "
+            "file system sync per group instead of an fsync per tablet. The file system sync "
+            "also flushes other files of the file system, so it should be used only when WAL "
+            "directories are located on dedicated disks. Requires Linux kernel 5.8 or later, "
+            "since older kernels do not report writeback errors from syncfs. On older kernels "
+            "and other platforms every tablet syncs its own WAL segment.");
+TAG_FLAG(log_group_sync_across_tablets, advanced);
+
+DEFINE_test_flag(int32, log_sync_group_delay_ms, 0,
+                 "Delay in milliseconds added to each file system sync of a log sync group.");
+
+METRIC_DEFINE_counter(server, log_group_sync_fsyncs, "Log Group Sync Fsyncs",
+                      yb::MetricUnit::kOperations,
+                      "Number of file system syncs performed by log sync groups");
+
+METRIC_DEFINE_coarse_histogram(server, log_group_sync_group_size, "Log Group Sync Group Size",
+                               yb::MetricUnit::kRequests,
+                               "Number of sync requests from tablet logs in a log sync group");
+
+namespace yb {
+namespace log {
+
+namespace {
+
+#if defined(__linux__)
+// syncfs reports writeback errors only since Linux 5.8, before that it returns 0 even when data
+// failed to reach the disk. So it could not be used to make WAL durable on older kernels.
+bool SyncfsReportsErrors() {
+  struct utsname uts_name;
+  if (uname(&uts_name) == -1) {
+    LOG(WARNING) << "Failed to get kernel name information: " << STATUS_FROM_ERRNO("uname", errno);
+    return false;
+  }
+
+  int major_version = 0;
+  int minor_version = 0;
+  char garbage;
+  std::stringstream version_stream;
+  version_stream << uts_name.release;
+  version_stream >> major_version >> garbage >> minor_version;
+
+  auto combined_version = major_version * 1000 + minor_version;
+  if (combined_version < 5008) {
+    LOG(WARNING) << "syncfs does not report writeback errors on kernel " << uts_name.release
+                 << ", WAL segments will be synced separately";
+    return false;
+  }
+  return true;
+}
+#endif
+
+} // namespace
+
+struct LogSyncGroup::Request {
+  Status status;
+  bool done = false;
+};
+
+LogSyncGroup::LogSyncGroup(std::string dir,
+                           scoped_refptr<Counter> fsyncs,
+                           scoped_refptr<Histogram> group_size)
+    : dir_(std::move(dir)), fsyncs_(std::move(fsyncs)), group_size_(std::move(group_size)) {
+#if defined(__linux__)
+  static const bool syncfs_reports_errors = SyncfsReportsErrors();
+  if (!syncfs_reports_errors) {
+    return;
+  }
+  dir_fd_ = open(dir_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dir_fd_ < 0) {
+    LOG(WARNING) << "Failed to open WAL root directory " << dir_ << ", logs in it will be synced "
+                 << "separately: " << STATUS_FROM_ERRNO(dir_, errno);
+  }
+#endif
+}
+
+LogSyncGroup::~LogSyncGroup() {
+  if (dir_fd_ >= 0) {
+    close(dir_fd_);
+  }
+}
+
+Status LogSyncGroup::Sync(WritableLogSegment* segment) {
+  if (!shared_sync_enabled()) {
+    return segment->Sync();
+  }
+
+  // Data buffered by the segment should reach the file system before the sync that the request
+  // joins is started.
+  RETURN_NOT_OK(segment->Flush());
+
+  Request request;
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.push_back(&request);
+  while (sync_in_progress_ && !request.done) {
+    cond_.wait(lock);
+  }
+  if (request.done) {
+    return request.status;
+  }
+
+  // There is no group in progress, so this thread becomes the leader of the next group, that
+  // contains all requests received so far.
+  sync_in_progress_ = true;
+  std::vector<Request*> group;
+  group.swap(pending_);
+  lock.unlock();
+
+  if (group_size_) {
+    group_size_->Increment(group.size());
+  }
+  auto status = SyncFileSystem();
+
+  lock.lock();
+  for (auto* group_request : group) {
+    group_request->status = status;
+    group_request->done = true;
+  }
+  sync_in_progress_ = false;
+  lock.unlock();
+  cond_.notify_all();
+  return status;
+}
+
+Status LogSyncGroup::SyncFileSystem() {
+  auto delay_ms = FLAGS_TEST_log_sync_group_delay_ms;
+  if (delay_ms > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+  }
+  if (fsyncs_) {
+    fsyncs_->Increment();
+  }
+#if defined(__linux__)
+  if (syncfs(dir_fd_) != 0) {
+    return STATUS_FROM_ERRNO(dir_, errno);
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "File system sync is not supported");
+#endif
+}
+
+LogSyncGroups::LogSyncGroups(const scoped_refptr<MetricEntity>& metric_entity) {
+  if (metric_entity) {
+    fsyncs_ = METRIC_log_group_sync_fsyncs.Instantiate(metric_entity);
+    group_size_ = METRIC_log_group_sync_group_size.Instantiate(metric_entity);
+  }
+}
+
+LogSyncGroups::~LogSyncGroups() = default;
+
+LogSyncGroup* LogSyncGroups::Get(const std::string& wal_root_dir) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& group = groups_[wal_root_dir];
+  if (!group) {
+    group = std::make_unique<LogSyncGroup>(wal_root_dir, fsyncs_, group_size_);
+  }
+  return group.get();
+}
+
+} // namespace log
+} // namespace yb
@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_SYNC_GROUP_H
+#define YB_CONSENSUS_LOG_SYNC_GROUP_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/log_fwd.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+class Counter;
+class Histogram;
+class MetricEntity;
+
+namespace log {
+
+// Syncs WAL segments of logs that are located on the same disk, in groups.
+//
+// Each tablet has its own log with its own segments, so without grouping every log syncs its
+// active segment independently, and a server with many active tablets issues many fsyncs to the
+// same disk, each of them committing the file system journal and flushing the disk cache.
+//
+// With grouping, each log writes its buffered data to the file system and then requests a sync.
+// A thread that requests a sync while another group is being synced waits for that group to
+// complete. Then one of the waiting threads becomes the leader of the next group and syncs the
+// whole file system containing the WAL root directory once (syncfs), making data of all logs in
+// the group durable, while the other threads just wait for the result.
+//
+// syncfs also flushes dirty data of other files on the same file system, so grouping is intended
+// for WAL directories on dedicated disks. Before Linux 5.8 syncfs does not report writeback errors,
+// so on such kernels, where syncfs is not available, or where the WAL root directory could not be
+// opened, every log syncs its own segment.
+class LogSyncGroup {
+ public:
+  LogSyncGroup(std::string dir,
+               scoped_refptr<Counter> fsyncs,
+               scoped_refptr<Histogram> group_size);
+  ~LogSyncGroup();
+
+  // Syncs the segment as part of a group. Returns after the segment is synced.
+  CHECKED_STATUS Sync(WritableLogSegment* segment);
+
+  const std::string& dir() const {
+    return dir_;
+  }
+
+  // Whether segments are synced by a single file system sync per group.
+  bool shared_sync_enabled() const {
+    return dir_fd_ >= 0;
+  }
+
+ private:
+  struct Request;
+
+  // Syncs the file system containing the WAL root directory.
+  CHECKED_STATUS SyncFileSystem();
+
+  const std::string dir_;
+  scoped_refptr<Counter> fsyncs_;
+  scoped_refptr<Histogram> group_size_;
+  // Descriptor of the WAL root directory used for syncfs, -1 if shared sync is not used.
+  int dir_fd_ = -1;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  // Whether there is a group leader that is syncing the file system now.
+  bool sync_in_progress_ = false;
+  // Requests that wait for the next group.
+  std::vector<Request*> pending_;
+};
+
+// Sync groups of a server, one per WAL root directory.
+class LogSyncGroups {
+ public:
+  explicit LogSyncGroups(const scoped_refptr<MetricEntity>& metric_entity);
+  ~LogSyncGroups();
+
+  // Returns the sync group for logs in specified WAL root directory, creating it if necessary.
+  LogSyncGroup* Get(const std::string& wal_root_dir);
+
+ private:
+  scoped_refptr<Counter> fsyncs_;
+  scoped_refptr<Histogram> group_size_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<LogSyncGroup>> groups_;
+};
+
+} // namespace log
+} // namespace yb
+
+#endif // YB_CONSENSUS_LOG_SYNC_GROUP_H
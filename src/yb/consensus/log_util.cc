@@ -892,6 +892,10 @@ Status WritableLogSegment::Sync() {
   return writable_file_->Sync();
 }
 
+Status WritableLogSegment::Flush() {
+  return writable_file_->Flush(WritableFile::FLUSH_ASYNC);
+}
+
 // Creates a LogEntryBatchPB from pre-allocated ReplicateMsgs managed using shared pointers. The
 // caller has to ensure these messages are not deleted twice, both by LogEntryBatchPB and by
 // the shared pointers.
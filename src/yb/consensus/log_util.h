@@ -111,6 +111,10 @@ struct LogOptions {
 
   uint64_t initial_active_segment_sequence_number = 0;
 
+  // If set, syncs of the active segment are performed as part of this group, shared with logs of
+  // other tablets on the same disk.
+  LogSyncGroup* sync_group = nullptr;
+
   LogOptions();
 };
 
@@ -403,6 +407,10 @@ class WritableLogSegment {
   // Makes sure the I/O buffers in the underlying writable file are flushed.
   CHECKED_STATUS Sync();
 
+  // Writes buffered data of the underlying writable file to the file system, without waiting for
+  // it to become durable.
+  CHECKED_STATUS Flush();
+
   // Returns true if the segment header has already been written to disk.
   bool IsHeaderWritten() const {
     return is_header_written_;
@@ -0,0 +1,298 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.service.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/proxy.h"
+#include "yb/rpc/rpc_context.h"
+#include "yb/rpc/service_pool.h"
+#include "yb/rpc/thread_pool.h"
+#include "yb/rpc/yb_rpc.h"
+
+#include "yb/util/countdown_latch.h"
+#include "yb/util/format.h"
+#include "yb/util/metrics.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(multi_raft_heartbeat_interval_ms);
+DECLARE_int32(multi_raft_batch_size);
+DECLARE_int32(multi_raft_batch_min_delay_us);
+DECLARE_int32(multi_raft_batch_max_delay_us);
+
+METRIC_DECLARE_histogram(multi_raft_batch_fill_ratio);
+METRIC_DECLARE_histogram(multi_raft_batch_added_delay);
+METRIC_DECLARE_counter(multi_raft_coalesced_data_requests);
+
+namespace yb {
+namespace consensus {
+
+namespace {
+
+// Consensus service that records tablets of requests in received batches, and responds to each
+// request with the tablet id as responder uuid.
+class RecordingConsensusService : public ConsensusServiceIf {
+ public:
+  explicit RecordingConsensusService(const scoped_refptr<MetricEntity>& metric_entity)
+      : ConsensusServiceIf(metric_entity) {}
+
+  void MultiRaftUpdateConsensus(const MultiRaftConsensusRequestPB* req,
+                                MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override {
+    std::vector<std::string> batch;
+    for (const auto& request : req->consensus_request()) {
+      batch.push_back(request.tablet_id());
+      resp->add_consensus_response()->set_responder_uuid(request.tablet_id());
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batches_.push_back(std::move(batch));
+    }
+    context.RespondSuccess();
+  }
+
+  std::vector<std::vector<std::string>> batches() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_;
+  }
+
+#define YB_UNSUPPORTED_CONSENSUS_METHOD(method) \
+  void method(const method ## RequestPB* req, method ## ResponsePB* resp, \
+              rpc::RpcContext context) override { \
+    context.RespondFailure(STATUS(NotSupported, #method)); \
+  }
+
+  void UpdateConsensus(const ConsensusRequestPB* req, ConsensusResponsePB* resp,
+                       rpc::RpcContext context) override {
+    context.RespondFailure(STATUS(NotSupported, "UpdateConsensus"));
+  }
+
+  void RequestConsensusVote(const VoteRequestPB* req, VoteResponsePB* resp,
+                            rpc::RpcContext context) override {
+    context.RespondFailure(STATUS(NotSupported, "RequestConsensusVote"));
+  }
+
+  YB_UNSUPPORTED_CONSENSUS_METHOD(ChangeConfig)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(GetNodeInstance)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(RunLeaderElection)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(LeaderElectionLost)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(LeaderStepDown)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(GetLastOpId)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(GetConsensusState)
+  YB_UNSUPPORTED_CONSENSUS_METHOD(StartRemoteBootstrap)
+
+#undef YB_UNSUPPORTED_CONSENSUS_METHOD
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::vector<std::string>> batches_;
+};
+
+// Request of a single tablet added to the batcher, with the status of its callback.
+struct TestRequest {
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  Status status;
+};
+
+} // namespace
+
+class MultiRaftBatcherTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+
+    // Heartbeats should not be sent during the test unless the batch is full.
+    FLAGS_multi_raft_heartbeat_interval_ms = 60000;
+    FLAGS_multi_raft_batch_size = 100;
+    FLAGS_multi_raft_batch_min_delay_us = 20000;
+    FLAGS_multi_raft_batch_max_delay_us = 20000;
+
+    metric_entity_ = METRIC_ENTITY_server.Instantiate(
+        &metric_registry_, "multi_raft_batcher-test");
+
+    server_messenger_ = ASSERT_RESULT(rpc::MessengerBuilder("server").Build());
+    Endpoint endpoint;
+    ASSERT_OK(server_messenger_->ListenAddress(
+        rpc::CreateConnectionContextFactory<rpc::YBInboundConnectionContext>(), Endpoint(),
+        &endpoint));
+    auto service = std::make_unique<RecordingConsensusService>(metric_entity_);
+    service_ = service.get();
+    auto service_name = service->service_name();
+    thread_pool_ = std::make_unique<rpc::ThreadPool>("test", 100, 2);
+    service_pool_ = make_scoped_refptr<rpc::ServicePool>(
+        100, thread_pool_.get(), &server_messenger_->scheduler(), std::move(service),
+        metric_entity_);
+    ASSERT_OK(server_messenger_->RegisterService(service_name, service_pool_));
+    ASSERT_OK(server_messenger_->StartAcceptor());
+
+    client_messenger_ = ASSERT_RESULT(rpc::MessengerBuilder("client").Build());
+    proxy_cache_ = std::make_unique<rpc::ProxyCache>(client_messenger_.get());
+    batcher_ = std::make_shared<MultiRaftHeartbeatBatcher>(
+        HostPort::FromBoundEndpoint(endpoint), proxy_cache_.get(), client_messenger_.get(),
+        metric_entity_);
+    batcher_->Start();
+  }
+
+  void TearDown() override {
+    batcher_.reset();
+    client_messenger_->Shutdown();
+    server_messenger_->UnregisterAllServices();
+    service_pool_->Shutdown();
+    thread_pool_->Shutdown();
+    server_messenger_->Shutdown();
+    YBTest::TearDown();
+  }
+
+  std::unique_ptr<TestRequest> MakeRequest(const std::string& tablet_id, int num_ops) {
+    auto result = std::make_unique<TestRequest>();
+    auto& request = result->request;
+    request.set_tablet_id(tablet_id);
+    request.set_caller_uuid("leader");
+    request.set_caller_term(1);
+    request.mutable_committed_op_id()->set_term(1);
+    request.mutable_committed_op_id()->set_index(1);
+    for (int i = 0; i != num_ops; ++i) {
+      auto* op = request.add_ops();
+      op->mutable_id()->set_term(1);
+      op->mutable_id()->set_index(i + 2);
+      op->set_hybrid_time(0);
+      op->set_op_type(NO_OP);
+    }
+    return result;
+  }
+
+  void AddRequest(TestRequest* request, HeartbeatOnly heartbeat_only, CountDownLatch* latch) {
+    batcher_->AddRequestToBatch(
+        &request->request, &request->response, heartbeat_only,
+        [request, latch](const Status& status) {
+      request->status = status;
+      latch->CountDown();
+    });
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  std::unique_ptr<rpc::Messenger> server_messenger_;
+  std::unique_ptr<rpc::ThreadPool> thread_pool_;
+  scoped_refptr<rpc::ServicePool> service_pool_;
+  RecordingConsensusService* service_ = nullptr;
+  std::unique_ptr<rpc::Messenger> client_messenger_;
+  std::unique_ptr<rpc::ProxyCache> proxy_cache_;
+  MultiRaftHeartbeatBatcherPtr batcher_;
+};
+
+// Updates added within the coalescing window are sent in a single batch, without waiting for the
+// heartbeat interval.
+TEST_F(MultiRaftBatcherTest, CoalescingWindow) {
+  constexpr int kNumRequests = 3;
+
+  std::vector<std::unique_ptr<TestRequest>> requests;
+  CountDownLatch latch(kNumRequests);
+  auto start = MonoTime::Now();
+  for (int i = 0; i != kNumRequests; ++i) {
+    requests.push_back(MakeRequest(Format("tablet-$0", i), 1));
+    AddRequest(requests.back().get(), HeartbeatOnly::kFalse, &latch);
+  }
+  ASSERT_TRUE(latch.WaitFor(10s));
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "Batch sent in " << passed;
+  // The batch waited for the coalescing window.
+  ASSERT_GE(passed.ToMicroseconds(), FLAGS_multi_raft_batch_min_delay_us / 2);
+
+  auto batches = service_->batches();
+  ASSERT_EQ(1U, batches.size());
+  ASSERT_EQ(static_cast<size_t>(kNumRequests), batches[0].size());
+  for (int i = 0; i != kNumRequests; ++i) {
+    auto& request = *requests[i];
+    ASSERT_OK(request.status);
+    // The response of each request is swapped back to its owner, as well as the request itself.
+    ASSERT_EQ(request.request.tablet_id(), request.response.responder_uuid());
+    ASSERT_EQ(1, request.request.ops_size());
+  }
+}
+
+// Commit-only updates don't carry ops, but are sent once the window elapses like data-bearing
+// updates.
+TEST_F(MultiRaftBatcherTest, CommitOnly) {
+  auto request = MakeRequest("tablet", 0);
+  CountDownLatch latch(1);
+  AddRequest(request.get(), HeartbeatOnly::kFalse, &latch);
+  ASSERT_TRUE(latch.WaitFor(10s));
+  ASSERT_OK(request->status);
+  ASSERT_EQ(1U, service_->batches().size());
+}
+
+// Heartbeats added before an update are sent together with it, while heartbeats alone wait for
+// the heartbeat interval.
+TEST_F(MultiRaftBatcherTest, MixedBatch) {
+  auto heartbeat = MakeRequest("heartbeat", 0);
+  CountDownLatch heartbeat_latch(1);
+  AddRequest(heartbeat.get(), HeartbeatOnly::kTrue, &heartbeat_latch);
+  ASSERT_FALSE(heartbeat_latch.WaitFor(200ms));
+  ASSERT_EQ(0U, service_->batches().size());
+
+  auto update = MakeRequest("update", 2);
+  CountDownLatch update_latch(1);
+  AddRequest(update.get(), HeartbeatOnly::kFalse, &update_latch);
+  ASSERT_TRUE(update_latch.WaitFor(10s));
+  ASSERT_TRUE(heartbeat_latch.WaitFor(10s));
+
+  auto batches = service_->batches();
+  ASSERT_EQ(1U, batches.size());
+  ASSERT_EQ((std::vector<std::string>{"heartbeat", "update"}), batches[0]);
+  ASSERT_OK(heartbeat->status);
+  ASSERT_OK(update->status);
+  ASSERT_EQ("heartbeat", heartbeat->response.responder_uuid());
+  ASSERT_EQ("update", update->response.responder_uuid());
+}
+
+TEST_F(MultiRaftBatcherTest, Metrics) {
+  constexpr int kNumDataRequests = 4;
+
+  std::vector<std::unique_ptr<TestRequest>> requests;
+  CountDownLatch latch(kNumDataRequests + 1);
+  requests.push_back(MakeRequest("heartbeat", 0));
+  AddRequest(requests.back().get(), HeartbeatOnly::kTrue, &latch);
+  for (int i = 0; i != kNumDataRequests; ++i) {
+    requests.push_back(MakeRequest(Format("tablet-$0", i), 1));
+    AddRequest(requests.back().get(), HeartbeatOnly::kFalse, &latch);
+  }
+  ASSERT_TRUE(latch.WaitFor(10s));
+  ASSERT_EQ(1U, service_->batches().size());
+
+  auto coalesced = METRIC_multi_raft_coalesced_data_requests.Instantiate(metric_entity_);
+  ASSERT_EQ(kNumDataRequests, coalesced->value());
+
+  auto fill_ratio = METRIC_multi_raft_batch_fill_ratio.Instantiate(metric_entity_);
+  ASSERT_EQ(1U, fill_ratio->TotalCount());
+  // 5 requests out of 100.
+  ASSERT_EQ(5U, fill_ratio->histogram()->MaxValue());
+
+  // The batch waited for the coalescing window, but not for the heartbeat interval.
+  auto added_delay = METRIC_multi_raft_batch_added_delay.Instantiate(metric_entity_);
+  ASSERT_EQ(1U, added_delay->TotalCount());
+  auto max_delay_us = added_delay->histogram()->MaxValue();
+  LOG(INFO) << "Added delay: " << max_delay_us << "us";
+  ASSERT_GE(max_delay_us, static_cast<uint64_t>(FLAGS_multi_raft_batch_min_delay_us) / 2);
+  ASSERT_LT(max_delay_us, static_cast<uint64_t>(FLAGS_multi_raft_heartbeat_interval_ms) * 1000);
+}
+
+} // namespace consensus
+} // namespace yb
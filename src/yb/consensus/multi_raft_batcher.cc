@@ -18,12 +18,17 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus.proxy.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/periodic.h"
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/source_location.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 // NOTE: For tests set this value to ~10ms
 DEFINE_int32(multi_raft_heartbeat_interval_ms, 10,
@@ -43,8 +48,47 @@ DEFINE_int32(multi_raft_batch_size, 1,
 TAG_FLAG(multi_raft_batch_size, experimental);
 TAG_FLAG(multi_raft_batch_size, hidden);
 
+DEFINE_uint64(multi_raft_batch_max_request_bytes, 16_KB,
+              "Data-bearing consensus requests up to this size are coalesced with requests of "
+              "other tablets to the same server. 0 to batch heartbeats only.");
+TAG_FLAG(multi_raft_batch_max_request_bytes, experimental);
+TAG_FLAG(multi_raft_batch_max_request_bytes, hidden);
+
+DEFINE_uint64(multi_raft_batch_max_bytes, 1_MB,
+              "A multi-raft batch containing data-bearing requests is sent once it reaches this "
+              "size.");
+TAG_FLAG(multi_raft_batch_max_bytes, experimental);
+TAG_FLAG(multi_raft_batch_max_bytes, hidden);
+
+DEFINE_int32(multi_raft_batch_min_delay_us, 50,
+             "Lower bound of the adaptive window data-bearing requests wait for other requests "
+             "to the same server.");
+TAG_FLAG(multi_raft_batch_min_delay_us, experimental);
+TAG_FLAG(multi_raft_batch_min_delay_us, hidden);
+
+DEFINE_int32(multi_raft_batch_max_delay_us, 1000,
+             "Upper bound of the adaptive window data-bearing requests wait for other requests "
+             "to the same server, i.e. the latency budget of coalescing.");
+TAG_FLAG(multi_raft_batch_max_delay_us, experimental);
+TAG_FLAG(multi_raft_batch_max_delay_us, hidden);
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
+METRIC_DEFINE_coarse_histogram(server, multi_raft_batch_fill_ratio,
+                               "Multi-Raft Batch Fill Ratio", yb::MetricUnit::kUnits,
+                               "Percentage of the request count or byte size limit, whichever is "
+                               "higher, used by sent multi-raft batches.");
+
+METRIC_DEFINE_coarse_histogram(server, multi_raft_batch_added_delay,
+                               "Multi-Raft Batch Added Delay", yb::MetricUnit::kMicroseconds,
+                               "Time the first request of a multi-raft batch waited before the "
+                               "batch was sent.");
+
+METRIC_DEFINE_counter(server, multi_raft_coalesced_data_requests,
+                      "Multi-Raft Coalesced Data Requests", yb::MetricUnit::kRequests,
+                      "Number of data-bearing consensus requests sent as part of multi-raft "
+                      "batches.");
+
 namespace yb {
 namespace consensus {
 
@@ -55,14 +99,44 @@ struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
   MultiRaftConsensusResponsePB batch_res;
   rpc::RpcController controller;
   std::vector<ResponseCallbackData> response_callback_data;
+  // Time the first request was added to the batch.
+  MonoTime start_time;
+  // Number of requests that are not heartbeats.
+  size_t updates = 0;
+  // Number of requests that carry ops.
+  size_t data_requests = 0;
+  size_t bytes = 0;
 };
 
-MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(const yb::HostPort& hostport,
-                                                     rpc::ProxyCache* proxy_cache,
-                                                     rpc::Messenger* messenger):
+namespace {
+
+MonoDelta MinCoalescingWindow() {
+  return MonoDelta::FromMicroseconds(FLAGS_multi_raft_batch_min_delay_us);
+}
+
+MonoDelta MaxCoalescingWindow() {
+  return MonoDelta::FromMicroseconds(
+      std::max(FLAGS_multi_raft_batch_max_delay_us, FLAGS_multi_raft_batch_min_delay_us));
+}
+
+} // namespace
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const yb::HostPort& hostport,
+    rpc::ProxyCache* proxy_cache,
+    rpc::Messenger* messenger,
+    const scoped_refptr<MetricEntity>& metric_entity):
     messenger_(messenger),
     consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
-    current_batch_(std::make_shared<MultiRaftConsensusData>()) {}
+    current_batch_(std::make_shared<MultiRaftConsensusData>()),
+    coalescing_window_(MinCoalescingWindow()) {
+  if (metric_entity) {
+    fill_ratio_histogram_ = METRIC_multi_raft_batch_fill_ratio.Instantiate(metric_entity);
+    added_delay_histogram_ = METRIC_multi_raft_batch_added_delay.Instantiate(metric_entity);
+    coalesced_data_requests_ =
+        METRIC_multi_raft_coalesced_data_requests.Instantiate(metric_entity);
+  }
+}
 
 void MultiRaftHeartbeatBatcher::Start() {
   std::weak_ptr<MultiRaftHeartbeatBatcher> weak_peer = shared_from_this();
@@ -79,28 +153,91 @@ void MultiRaftHeartbeatBatcher::Start() {
 
 MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() = default;
 
+bool MultiRaftHeartbeatBatcher::CanCoalesce(const ConsensusRequestPB& request) const {
+  return FLAGS_multi_raft_batch_max_request_bytes > 0 &&
+         request.ByteSizeLong() <= FLAGS_multi_raft_batch_max_request_bytes;
+}
+
 void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
                                                   ConsensusResponsePB* response,
+                                                  HeartbeatOnly heartbeat_only,
                                                   HeartbeatResponseCallback callback) {
+  const bool has_data = request->ops_size() != 0;
+  const size_t request_bytes = request->ByteSizeLong();
   std::shared_ptr<MultiRaftConsensusData> data = nullptr;
+  std::weak_ptr<MultiRaftConsensusData> schedule_window_for;
+  MonoDelta window;
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (current_batch_->response_callback_data.empty()) {
+      current_batch_->start_time = MonoTime::Now();
+    }
     current_batch_->response_callback_data.push_back({
+      request,
       response,
       std::move(callback)
     });
     // Add a ConsensusRequestPB to the batch
     current_batch_->batch_req.add_consensus_request()->Swap(request);
-    if (FLAGS_multi_raft_batch_size > 0
-        && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    current_batch_->bytes += request_bytes;
+    if (has_data) {
+      ++current_batch_->data_requests;
+    }
+    if (!heartbeat_only && ++current_batch_->updates == 1) {
+      // The first update in the batch, it should not wait for the next heartbeat interval.
+      schedule_window_for = current_batch_;
+      window = coalescing_window_;
+    }
+    if ((FLAGS_multi_raft_batch_size > 0
+         && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) ||
+        (current_batch_->data_requests != 0 &&
+         current_batch_->bytes >= FLAGS_multi_raft_batch_max_bytes)) {
       data = PrepareNextBatchRequest();
     }
   }
   if (data) {
     SendBatchRequest(data);
+  } else if (window) {
+    std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+    // Aborted tasks also send the batch, so requests are not stuck until the next period.
+    auto task_id = messenger_->ScheduleOnReactor(
+        [weak_self, schedule_window_for](const Status&) {
+          if (auto self = weak_self.lock()) {
+            self->CoalescingWindowElapsed(schedule_window_for);
+          }
+        },
+        window, SOURCE_LOCATION(), messenger_);
+    if (task_id == rpc::kInvalidTaskId) {
+      CoalescingWindowElapsed(schedule_window_for);
+    }
   }
 }
 
+void MultiRaftHeartbeatBatcher::CoalescingWindowElapsed(
+    const std::weak_ptr<MultiRaftConsensusData>& weak_batch) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto batch = weak_batch.lock();
+    if (batch != current_batch_) {
+      // The batch was already sent because it was full or because of the periodic timer.
+      return;
+    }
+    // Adapt the window to the rate of updates to this server. A window that collected several
+    // updates could collect more when extended, while a window that only delayed a single update
+    // costs latency without saving RPCs.
+    if (batch->updates > 1) {
+      coalescing_window_ = std::min(coalescing_window_ + coalescing_window_ / 4 +
+                                        MinCoalescingWindow(),
+                                    MaxCoalescingWindow());
+    } else {
+      coalescing_window_ = std::max(coalescing_window_ / 2, MinCoalescingWindow());
+    }
+    data = PrepareNextBatchRequest();
+  }
+  SendBatchRequest(data);
+}
+
 void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   std::shared_ptr<MultiRaftConsensusData> data;
   {
@@ -126,9 +263,29 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
     return;
   }
 
+  const auto num_requests = data->batch_req.consensus_request_size();
+  if (fill_ratio_histogram_) {
+    auto fill_ratio = data->data_requests == 0 || FLAGS_multi_raft_batch_max_bytes == 0
+        ? 0 : data->bytes * 100 / FLAGS_multi_raft_batch_max_bytes;
+    if (FLAGS_multi_raft_batch_size > 0) {
+      fill_ratio = std::max<uint64_t>(fill_ratio, num_requests * 100 / FLAGS_multi_raft_batch_size);
+    }
+    fill_ratio_histogram_->Increment(std::min<uint64_t>(fill_ratio, 100));
+    added_delay_histogram_->Increment((MonoTime::Now() - data->start_time).ToMicroseconds());
+    coalesced_data_requests_->IncrementBy(data->data_requests);
+  }
+
   data->controller.Reset();
-  data->controller.set_timeout(MonoDelta::FromMilliseconds(
-    FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
+  if (data->data_requests != 0) {
+    // The server performs data-bearing updates concurrently, so the batch takes about as long as
+    // a separate update.
+    data->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+    // Responses to data requests make peers send the next ops, same as for separate requests.
+    data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  } else {
+    data->controller.set_timeout(MonoDelta::FromMilliseconds(
+      FLAGS_consensus_rpc_timeout_ms * num_requests));
+  }
   consensus_proxy_->MultiRaftUpdateConsensusAsync(
     data->batch_req, &data->batch_res, &data->controller,
     std::bind(&MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback,
@@ -139,7 +296,9 @@ void MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback(
     std::shared_ptr<MultiRaftConsensusData> data) {
   auto status = data->controller.status();
   for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
-    auto callback_data = data->response_callback_data[i];
+    auto& callback_data = data->response_callback_data[i];
+    // Return the request to the peer, so it could release ops referenced by it.
+    callback_data.req->Swap(data->batch_req.mutable_consensus_request(i));
     if (status.ok()) {
       callback_data.resp->Swap(data->batch_res.mutable_consensus_response(i));
     }
@@ -149,9 +308,11 @@ void MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback(
 
 MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger,
                                    rpc::ProxyCache* proxy_cache,
-                                   CloudInfoPB local_peer_cloud_info_pb):
+                                   CloudInfoPB local_peer_cloud_info_pb,
+                                   scoped_refptr<MetricEntity> metric_entity):
     messenger_(messenger), proxy_cache_(proxy_cache),
-    local_peer_cloud_info_pb_(std::move(local_peer_cloud_info_pb)) {}
+    local_peer_cloud_info_pb_(std::move(local_peer_cloud_info_pb)),
+    metric_entity_(std::move(metric_entity)) {}
 
 MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB& remote_peer_pb) {
   if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
@@ -168,7 +329,8 @@ MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB&
   if (res != batchers_.end() && (batcher = res->second.lock())) {
     return batcher;
   }
-  batcher = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+  batcher = std::make_shared<MultiRaftHeartbeatBatcher>(
+      hostport, proxy_cache_, messenger_, metric_entity_);
   batchers_[hostport] = batcher;
   batcher->Start();
   return batcher;
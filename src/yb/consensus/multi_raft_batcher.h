@@ -19,12 +19,20 @@
 
 #include "yb/consensus/consensus_fwd.h"
 
+#include "yb/gutil/ref_counted.h"
+
 #include "yb/rpc/rpc_controller.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
 
+class Counter;
+class Histogram;
+class MetricEntity;
+
 namespace rpc {
 class Messenger;
 class PeriodicTimer;
@@ -34,6 +42,8 @@ namespace consensus {
 
 using HeartbeatResponseCallback = std::function<void(const Status&)>;
 
+YB_STRONGLY_TYPED_BOOL(HeartbeatOnly);
+
 
 // - MultiRaftHeartbeatBatcher is responsible for the batching of heartbeats
 //   among peers that are communicating with remote peers at the same tserver
@@ -42,30 +52,48 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 // - A heartbeat is added to a batch upon calling AddRequestToBatch and a batch is sent
 //   out every FLAGS_multi_raft_heartbeat_interval_ms ms or once the batch size reaches
 //   FLAGS_multi_raft_batch_size
+// - Small update requests (up to FLAGS_multi_raft_batch_max_request_bytes), i.e. requests that
+//   carry ops or advance the committed op id, are also coalesced across tablets. The batch
+//   containing them is sent once the coalescing window elapses, which adapts between
+//   FLAGS_multi_raft_batch_min_delay_us and FLAGS_multi_raft_batch_max_delay_us: it grows while
+//   windows collect several updates and shrinks when they don't, so idle destinations don't pay
+//   for batching
+// - The receiving server performs data-bearing updates of a batch concurrently, so a batch waits
+//   for the slowest WAL write instead of the sum of them
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
  public:
   MultiRaftHeartbeatBatcher(const yb::HostPort& hostport,
                             rpc::ProxyCache* proxy_cache,
-                            rpc::Messenger* messenger);
+                            rpc::Messenger* messenger,
+                            const scoped_refptr<MetricEntity>& metric_entity);
 
   ~MultiRaftHeartbeatBatcher();
 
   // Required to start a periodic timer to send out batches.
   void Start();
 
-  // When called adds the request to a batch (request data will be swapped).
+  // Whether an update request is small enough to be coalesced with requests of other
+  // tablets instead of being sent separately.
+  bool CanCoalesce(const ConsensusRequestPB& request) const;
+
+  // When called adds the request to a batch (request data will be swapped into the batch and
+  // swapped back before the callback is executed).
+  // Heartbeats wait for the next heartbeat interval, while other requests are sent once the
+  // coalescing window elapses.
   // If the batch executes sucessfully then the response is populated and the callback is executed.
   // If the batch rpc call fails the response will NOT be populated and the callback will be
   // executed with an error status.
   void AddRequestToBatch(ConsensusRequestPB* request,
                          ConsensusResponsePB* response,
+                         HeartbeatOnly heartbeat_only,
                          HeartbeatResponseCallback callback);
 
  private:
-  // Tracks a single peers ConsensusResponsePB as well as its ProcessResponse callback.
+  // Tracks a single peers request and ConsensusResponsePB as well as its ProcessResponse callback.
   struct ResponseCallbackData {
+    ConsensusRequestPB* req;
     ConsensusResponsePB* resp;
     HeartbeatResponseCallback callback;
   };
@@ -76,6 +104,9 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void PrepareAndSendBatchRequest();
 
+  // Invoked when the coalescing window of the batch containing update requests elapses.
+  void CoalescingWindowElapsed(const std::weak_ptr<MultiRaftConsensusData>& weak_batch);
+
   // This method will return a nullptr if the current batch is empty.
   std::shared_ptr<MultiRaftConsensusData> PrepareNextBatchRequest() REQUIRES(mutex_);
 
@@ -88,11 +119,18 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   ConsensusServiceProxyPtr consensus_proxy_;
 
+  scoped_refptr<Histogram> fill_ratio_histogram_;
+  scoped_refptr<Histogram> added_delay_histogram_;
+  scoped_refptr<Counter> coalesced_data_requests_;
+
   std::shared_ptr<rpc::PeriodicTimer> batch_sender_;
 
   std::mutex mutex_;
 
   std::shared_ptr<MultiRaftConsensusData> current_batch_ GUARDED_BY(mutex_);
+
+  // How long the first data request of a batch waits for requests of other tablets.
+  MonoDelta coalescing_window_ GUARDED_BY(mutex_);
 };
 
 
@@ -104,7 +142,8 @@ class MultiRaftManager: public std::enable_shared_from_this<MultiRaftManager> {
  public:
   MultiRaftManager(rpc::Messenger* messenger,
                    rpc::ProxyCache* proxy_cache,
-                   CloudInfoPB local_peer_cloud_info_pb);
+                   CloudInfoPB local_peer_cloud_info_pb,
+                   scoped_refptr<MetricEntity> metric_entity);
 
   // Add a batcher with the given hostport (if one does not already exist)
   // and returns the newly created batcher.
@@ -117,6 +156,8 @@ class MultiRaftManager: public std::enable_shared_from_this<MultiRaftManager> {
 
   CloudInfoPB local_peer_cloud_info_pb_;
 
+  scoped_refptr<MetricEntity> metric_entity_;
+
   std::mutex mutex_;
 
   // Uses a weak_ptr value in the map to allow for deallocation of unneeded batchers
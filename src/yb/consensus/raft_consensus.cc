@@ -3336,6 +3336,14 @@ size_t RaftConsensus::EvictLogCache(size_t bytes_to_evict) {
   return queue_->EvictLogCache(bytes_to_evict);
 }
 
+size_t RaftConsensus::CompressedLogCacheSize() {
+  return queue_->CompressedLogCacheSize();
+}
+
+size_t RaftConsensus::EvictCompressedLogCache(size_t bytes_to_evict) {
+  return queue_->EvictCompressedLogCache(bytes_to_evict);
+}
+
 RetryableRequestsCounts RaftConsensus::TEST_CountRetryableRequests() {
   return state_->TEST_CountRetryableRequests();
 }
@@ -0,0 +1,426 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/column_aggregate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <boost/preprocessor/cat.hpp>
+
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/column_batch.h"
+
+#include "yb/gutil/cpu.h"
+#include "yb/gutil/macros.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/result.h"
+#include "yb/util/status.h"
+#include "yb/util/status_format.h"
+
+DEFINE_bool(enable_simd_aggregates, true,
+            "Whether batch aggregates over fixed-width columns should use AVX2 kernels when the "
+            "CPU supports them.");
+TAG_FLAG(enable_simd_aggregates, advanced);
+TAG_FLAG(enable_simd_aggregates, runtime);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Orders values the same way as QLValue does, i.e. NaN is greater than any other floating point
+// value and equal to another NaN.
+template <class T>
+typename std::enable_if<!std::is_floating_point<T>::value, bool>::type QLValueLess(T lhs, T rhs) {
+  return lhs < rhs;
+}
+
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type QLValueLess(T lhs, T rhs) {
+  if (std::isnan(lhs)) {
+    return false;
+  }
+  return std::isnan(rhs) || lhs < rhs;
+}
+
+struct QLValueLessThan {
+  template <class T>
+  bool operator()(T lhs, T rhs) const {
+    return QLValueLess(lhs, rhs);
+  }
+};
+
+struct QLValueGreaterThan {
+  template <class T>
+  bool operator()(T lhs, T rhs) const {
+    return QLValueLess(rhs, lhs);
+  }
+};
+
+template <class T, class Acc>
+Acc SumValuesScalar(const T* values, size_t size) {
+  Acc result = 0;
+  for (size_t i = 0; i != size; ++i) {
+    result += values[i];
+  }
+  return result;
+}
+
+template <class T, class Less>
+T ExtremumScalar(const T* values, size_t size, const Less& less) {
+  T result = values[0];
+  for (size_t i = 1; i != size; ++i) {
+    if (less(values[i], result)) {
+      result = values[i];
+    }
+  }
+  return result;
+}
+
+#if defined(__x86_64__)
+
+// The tree is compiled with -mno-avx so that binaries run on older CPUs, so AVX2 kernels are
+// compiled for that target explicitly and only called after checking CPU support at runtime.
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET int64_t HorizontalSumInt64(__m256i value) {
+  alignas(32) int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Adds 8 int32 lanes to 4 int64 lanes of acc.
+AVX2_TARGET __m256i AddWidenedInt32(__m256i acc, __m256i value) {
+  acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+  return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+}
+
+AVX2_TARGET int64_t SumAvx2(const int8_t* values, size_t size) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    // Widen to int16 and add adjacent pairs into int32 lanes.
+    acc = AddWidenedInt32(acc, _mm256_madd_epi16(_mm256_cvtepi8_epi16(chunk), ones));
+  }
+  return HorizontalSumInt64(acc) + SumValuesScalar<int8_t, int64_t>(values + i, size - i);
+}
+
+AVX2_TARGET int64_t SumAvx2(const int16_t* values, size_t size) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    acc = AddWidenedInt32(acc, _mm256_madd_epi16(chunk, ones));
+  }
+  return HorizontalSumInt64(acc) + SumValuesScalar<int16_t, int64_t>(values + i, size - i);
+}
+
+AVX2_TARGET int64_t SumAvx2(const int32_t* values, size_t size) {
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc = AddWidenedInt32(
+        acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+  }
+  return HorizontalSumInt64(acc) + SumValuesScalar<int32_t, int64_t>(values + i, size - i);
+}
+
+AVX2_TARGET int64_t SumAvx2(const int64_t* values, size_t size) {
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc0 = _mm256_add_epi64(
+        acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+    acc1 = _mm256_add_epi64(
+        acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+  }
+  return HorizontalSumInt64(_mm256_add_epi64(acc0, acc1)) +
+         SumValuesScalar<int64_t, int64_t>(values + i, size - i);
+}
+
+// Floating point sums are accumulated in 4 or 8 independent lanes, so the result could differ from
+// the row by row evaluation in the last bits, the same way as it differs between parallel scans of
+// different tablets.
+AVX2_TARGET double SumAvx2(const double* values, size_t size) {
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc = _mm256_add_pd(acc, _mm256_loadu_pd(values + i));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         SumValuesScalar<double, double>(values + i, size - i);
+}
+
+AVX2_TARGET float SumAvx2(const float* values, size_t size) {
+  __m256 acc = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc = _mm256_add_ps(acc, _mm256_loadu_ps(values + i));
+  }
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, acc);
+  float result = SumValuesScalar<float, float>(values + i, size - i);
+  for (float lane : lanes) {
+    result += lane;
+  }
+  return result;
+}
+
+// Lane operations used by the generic MIN/MAX kernel. Floating point columns are not vectorized,
+// since SIMD min/max instructions do not follow the QLValue ordering of NaN.
+template <class T>
+struct Avx2IntOps;
+
+#define YB_DEFINE_AVX2_INT_OPS(type, suffix) \
+  template <> \
+  struct Avx2IntOps<type> { \
+    static constexpr size_t kLanes = sizeof(__m256i) / sizeof(type); \
+    AVX2_TARGET static __m256i Min(__m256i lhs, __m256i rhs) { \
+      return BOOST_PP_CAT(_mm256_min_, suffix)(lhs, rhs); \
+    } \
+    AVX2_TARGET static __m256i Max(__m256i lhs, __m256i rhs) { \
+      return BOOST_PP_CAT(_mm256_max_, suffix)(lhs, rhs); \
+    } \
+  };
+
+YB_DEFINE_AVX2_INT_OPS(int8_t, epi8)
+YB_DEFINE_AVX2_INT_OPS(int16_t, epi16)
+YB_DEFINE_AVX2_INT_OPS(int32_t, epi32)
+
+#undef YB_DEFINE_AVX2_INT_OPS
+
+// AVX2 does not have 64 bit min/max, so they are emulated with compare and blend.
+template <>
+struct Avx2IntOps<int64_t> {
+  static constexpr size_t kLanes = 4;
+  AVX2_TARGET static __m256i Min(__m256i lhs, __m256i rhs) {
+    return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs));
+  }
+  AVX2_TARGET static __m256i Max(__m256i lhs, __m256i rhs) {
+    return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(rhs, lhs));
+  }
+};
+
+template <class T>
+using HasAvx2Extremum = std::integral_constant<
+    bool, std::is_integral<T>::value && !std::is_same<T, bool>::value>;
+
+template <class T, bool kMin>
+typename std::enable_if<!HasAvx2Extremum<T>::value, bool>::type ExtremumAvx2(
+    const T* values, size_t size, T* out) {
+  return false;
+}
+
+// Stores the min or max of the values to out.
+template <class T, bool kMin>
+AVX2_TARGET typename std::enable_if<HasAvx2Extremum<T>::value, bool>::type ExtremumAvx2(
+    const T* values, size_t size, T* out) {
+  using Ops = Avx2IntOps<T>;
+  constexpr size_t kLanes = Ops::kLanes;
+  if (size < kLanes) {
+    *out = kMin ? ExtremumScalar(values, size, std::less<T>())
+                : ExtremumScalar(values, size, std::greater<T>());
+    return true;
+  }
+  __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  size_t i = kLanes;
+  for (; i + kLanes <= size; i += kLanes) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    acc = kMin ? Ops::Min(acc, chunk) : Ops::Max(acc, chunk);
+  }
+  // Process the tail by reloading the last full vector, overlapping values do not affect the
+  // result.
+  if (i != size) {
+    const __m256i chunk = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(values + size - kLanes));
+    acc = kMin ? Ops::Min(acc, chunk) : Ops::Max(acc, chunk);
+  }
+  alignas(32) T lanes[kLanes];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  *out = kMin ? ExtremumScalar(lanes, kLanes, std::less<T>())
+              : ExtremumScalar(lanes, kLanes, std::greater<T>());
+  return true;
+}
+
+#undef AVX2_TARGET
+
+bool UseAvx2() {
+  static const bool has_avx2 = base::CPU().has_avx2();
+  return has_avx2 && FLAGS_enable_simd_aggregates;
+}
+
+#else
+
+bool UseAvx2() {
+  return false;
+}
+
+template <class T, bool kMin>
+bool ExtremumAvx2(const T* values, size_t size, T* out) {
+  return false;
+}
+
+#endif
+
+template <class T, class Acc>
+Acc SumValues(const ColumnVector& column) {
+  // Null slots hold zero, so they do not affect the sum.
+  const T* values = column.data<T>();
+  const size_t size = column.size();
+#if defined(__x86_64__)
+  if (UseAvx2()) {
+    return SumAvx2(values, size);
+  }
+#endif
+  return SumValuesScalar<T, Acc>(values, size);
+}
+
+// Returns index of the min (when Less is QLValueLessThan) value among non NULL values of the
+// column. The column should have at least one non NULL value.
+template <class T, class Less>
+size_t FindTypedExtremum(const ColumnVector& column, const Less& less) {
+  const T* values = column.data<T>();
+  // Null slots hold zero, which could become the extremum, so only columns without NULLs are
+  // vectorized.
+  if (column.null_count() == 0 && UseAvx2()) {
+    constexpr bool kMin = std::is_same<Less, QLValueLessThan>::value;
+    static_assert(kMin || std::is_same<Less, QLValueGreaterThan>::value, "Unexpected comparator");
+    T value;
+    if (ExtremumAvx2<T, kMin>(values, column.size(), &value)) {
+      return std::find(values, values + column.size(), value) - values;
+    }
+  }
+  size_t result = 0;
+  while (column.IsNull(result)) {
+    ++result;
+  }
+  for (size_t i = result + 1, size = column.size(); i != size; ++i) {
+    if (!column.IsNull(i) && less(values[i], values[result])) {
+      result = i;
+    }
+  }
+  return result;
+}
+
+template <class Less>
+Result<size_t> FindExtremum(const ColumnVector& column, const Less& less) {
+  switch (column.type()) {
+    case DataType::INT8: return FindTypedExtremum<int8_t>(column, less);
+    case DataType::INT16: return FindTypedExtremum<int16_t>(column, less);
+    case DataType::INT32: return FindTypedExtremum<int32_t>(column, less);
+    case DataType::INT64: return FindTypedExtremum<int64_t>(column, less);
+    case DataType::FLOAT: return FindTypedExtremum<float>(column, less);
+    case DataType::DOUBLE: return FindTypedExtremum<double>(column, less);
+    case DataType::BOOL: return FindTypedExtremum<bool>(column, less);
+    default: break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Unsupported column type for MIN/MAX: $0", DataType_Name(column.type()));
+}
+
+bool AllNull(const ColumnVector& column) {
+  return column.null_count() == column.size();
+}
+
+} // namespace
+
+void AggregateCount(const ColumnVector& column, QLValue* aggr_count) {
+  AggregateCountRows(column.size() - column.null_count(), aggr_count);
+}
+
+void AggregateCountRows(size_t num_rows, QLValue* aggr_count) {
+  if (num_rows == 0) {
+    return;
+  }
+  const auto delta = static_cast<int64_t>(num_rows);
+  aggr_count->set_int64_value(aggr_count->IsNull() ? delta : aggr_count->int64_value() + delta);
+}
+
+Status AggregateSum(const ColumnVector& column, QLValue* aggr_sum) {
+  if (AllNull(column)) {
+    return Status::OK();
+  }
+  switch (column.type()) {
+    case DataType::INT8: FALLTHROUGH_INTENDED;
+    case DataType::INT16: FALLTHROUGH_INTENDED;
+    case DataType::INT32: FALLTHROUGH_INTENDED;
+    case DataType::INT64: {
+      int64_t sum;
+      switch (column.type()) {
+        case DataType::INT8: sum = SumValues<int8_t, int64_t>(column); break;
+        case DataType::INT16: sum = SumValues<int16_t, int64_t>(column); break;
+        case DataType::INT32: sum = SumValues<int32_t, int64_t>(column); break;
+        default: sum = SumValues<int64_t, int64_t>(column); break;
+      }
+      aggr_sum->set_int64_value(aggr_sum->IsNull() ? sum : aggr_sum->int64_value() + sum);
+      return Status::OK();
+    }
+    case DataType::FLOAT: {
+      const auto sum = SumValues<float, float>(column);
+      aggr_sum->set_float_value(aggr_sum->IsNull() ? sum : aggr_sum->float_value() + sum);
+      return Status::OK();
+    }
+    case DataType::DOUBLE: {
+      const auto sum = SumValues<double, double>(column);
+      aggr_sum->set_double_value(aggr_sum->IsNull() ? sum : aggr_sum->double_value() + sum);
+      return Status::OK();
+    }
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Unsupported column type for SUM: $0", DataType_Name(column.type()));
+}
+
+Status AggregateMin(const ColumnVector& column, QLValue* aggr_min) {
+  if (AllNull(column)) {
+    return Status::OK();
+  }
+  const auto idx = VERIFY_RESULT(FindExtremum(column, QLValueLessThan()));
+  QLValuePB value;
+  column.GetValue(idx, &value);
+  if (aggr_min->IsNull() || aggr_min->value() > value) {
+    *aggr_min = value;
+  }
+  return Status::OK();
+}
+
+Status AggregateMax(const ColumnVector& column, QLValue* aggr_max) {
+  if (AllNull(column)) {
+    return Status::OK();
+  }
+  const auto idx = VERIFY_RESULT(FindExtremum(column, QLValueGreaterThan()));
+  QLValuePB value;
+  column.GetValue(idx, &value);
+  if (aggr_max->IsNull() || aggr_max->value() < value) {
+    *aggr_max = value;
+  }
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,48 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_COLUMN_AGGREGATE_H
+#define YB_DOCDB_COLUMN_AGGREGATE_H
+
+#include "yb/common/common_fwd.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+class ColumnVector;
+
+// Aggregate kernels over a ColumnVector. Each of them merges all values of the column into the
+// running aggregate value, producing the same result as DocExprExecutor does row by row: NULL
+// values are skipped and the aggregate stays NULL until the first non NULL value is seen.
+
+// COUNT(column): adds the number of non NULL values to aggr_count.
+void AggregateCount(const ColumnVector& column, QLValue* aggr_count);
+
+// COUNT(*): adds num_rows to aggr_count.
+void AggregateCountRows(size_t num_rows, QLValue* aggr_count);
+
+// SUM(column): integer columns are summed into int64, FLOAT and DOUBLE into the column type.
+CHECKED_STATUS AggregateSum(const ColumnVector& column, QLValue* aggr_sum);
+
+CHECKED_STATUS AggregateMin(const ColumnVector& column, QLValue* aggr_min);
+
+CHECKED_STATUS AggregateMax(const ColumnVector& column, QLValue* aggr_max);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_COLUMN_AGGREGATE_H
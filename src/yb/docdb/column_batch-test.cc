@@ -0,0 +1,301 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <cmath>
+#include <limits>
+
+#include "yb/bfpg/tserver_opcodes.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/column_aggregate.h"
+#include "yb/docdb/column_batch.h"
+#include "yb/docdb/doc_expr.h"
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/random.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_util.h"
+
+DECLARE_bool(enable_simd_aggregates);
+
+namespace yb {
+namespace docdb {
+
+class ColumnBatchTest : public YBTest {
+ protected:
+  // Fills column with num_values random values, every null_period-th value is NULL. Floating point
+  // columns get small integral values, so that sums are exact regardless of the evaluation order,
+  // mixed with -0, +0 and NaN.
+  template <class T>
+  void FillRandom(size_t num_values, size_t null_period, ColumnVector* column) {
+    Random r(1);
+    column->Clear();
+    for (size_t i = 0; i != num_values; ++i) {
+      if (null_period && i % null_period == 0) {
+        ASSERT_OK(column->Append(nullptr));
+        continue;
+      }
+      QLValuePB value;
+      T raw;
+      if (std::is_floating_point<T>::value) {
+        raw = static_cast<T>(static_cast<int>(r.Uniform(2000)) - 1000);
+        if (i % 7 == 3) {
+          const double specials[] = { -0.0, 0.0, std::numeric_limits<double>::quiet_NaN() };
+          raw = static_cast<T>(specials[(i / 7) % 3]);
+        }
+      } else {
+        raw = static_cast<T>(r.Next64());
+      }
+      switch (column->type()) {
+        case DataType::INT8: value.set_int8_value(raw); break;
+        case DataType::INT16: value.set_int16_value(raw); break;
+        case DataType::INT32: value.set_int32_value(raw); break;
+        case DataType::INT64: value.set_int64_value(raw); break;
+        case DataType::FLOAT: value.set_float_value(raw); break;
+        case DataType::DOUBLE: value.set_double_value(raw); break;
+        default: FAIL() << "Unexpected type: " << DataType_Name(column->type());
+      }
+      ASSERT_OK(column->Append(value));
+    }
+  }
+
+  // Evaluates all aggregates over the column, returns them as COUNT, SUM, MIN, MAX.
+  std::vector<QLValue> Aggregate(const ColumnVector& column) {
+    std::vector<QLValue> result(4);
+    AggregateCount(column, &result[0]);
+    EXPECT_OK(AggregateSum(column, &result[1]));
+    EXPECT_OK(AggregateMin(column, &result[2]));
+    EXPECT_OK(AggregateMax(column, &result[3]));
+    return result;
+  }
+
+  template <class T>
+  void TestSimdMatchesScalar(DataType type) {
+    // Sizes around the vector width check that tails are handled.
+    for (size_t num_values : {1, 3, 15, 16, 17, 33, 1000, 1024}) {
+      for (size_t null_period : {0, 5}) {
+        ColumnVector column(ColumnId(kFirstColumnId), type);
+        FillRandom<T>(num_values, null_period, &column);
+        FLAGS_enable_simd_aggregates = false;
+        auto expected = Aggregate(column);
+        FLAGS_enable_simd_aggregates = true;
+        auto actual = Aggregate(column);
+        for (size_t i = 0; i != expected.size(); ++i) {
+          ASSERT_EQ(expected[i].ToString(), actual[i].ToString())
+              << "Type: " << DataType_Name(type) << ", values: " << num_values
+              << ", null period: " << null_period << ", aggregate: " << i;
+        }
+      }
+    }
+  }
+};
+
+TEST_F(ColumnBatchTest, TestAppend) {
+  ColumnVector column(ColumnId(kFirstColumnId), DataType::INT32);
+  constexpr int kNumValues = 200;
+  for (int i = 0; i != kNumValues; ++i) {
+    if (i % 7 == 0) {
+      ASSERT_OK(column.Append(nullptr));
+    } else {
+      auto value = PrimitiveValue::Int32(i);
+      ASSERT_OK(column.Append(&value));
+    }
+  }
+  ASSERT_EQ(kNumValues, static_cast<int>(column.size()));
+  ASSERT_EQ((kNumValues + 6) / 7U, column.null_count());
+  for (int i = 0; i != kNumValues; ++i) {
+    ASSERT_EQ(i % 7 == 0, column.IsNull(i)) << "Value: " << i;
+    QLValuePB value;
+    column.GetValue(i, &value);
+    if (i % 7 == 0) {
+      ASSERT_TRUE(QLValue::IsNull(value));
+    } else {
+      ASSERT_EQ(i, value.int32_value());
+    }
+  }
+
+  // Values of other types should not be silently converted.
+  auto string_value = PrimitiveValue("string");
+  ASSERT_NOK(column.Append(&string_value));
+
+  column.Clear();
+  ASSERT_EQ(0U, column.size());
+  ASSERT_EQ(0U, column.null_count());
+}
+
+TEST_F(ColumnBatchTest, TestAggregates) {
+  ColumnVector column(ColumnId(kFirstColumnId), DataType::INT64);
+  QLValue count, sum, min, max;
+
+  // Aggregates of an all NULL column stay NULL, the same way as row by row evaluation does.
+  ASSERT_OK(column.Append(nullptr));
+  AggregateCount(column, &count);
+  ASSERT_OK(AggregateSum(column, &sum));
+  ASSERT_OK(AggregateMin(column, &min));
+  ASSERT_OK(AggregateMax(column, &max));
+  ASSERT_TRUE(count.IsNull());
+  ASSERT_TRUE(sum.IsNull());
+  ASSERT_TRUE(min.IsNull());
+  ASSERT_TRUE(max.IsNull());
+
+  // Aggregates should be merged across several batches.
+  int64_t expected_sum = 0;
+  for (int batch = 0; batch != 3; ++batch) {
+    column.Clear();
+    for (int64_t i = -100; i <= 100; ++i) {
+      if (i % 10 == 0) {
+        ASSERT_OK(column.Append(nullptr));
+        continue;
+      }
+      auto value = PrimitiveValue(i * (batch + 1));
+      ASSERT_OK(column.Append(&value));
+      expected_sum += i * (batch + 1);
+    }
+    AggregateCount(column, &count);
+    ASSERT_OK(AggregateSum(column, &sum));
+    ASSERT_OK(AggregateMin(column, &min));
+    ASSERT_OK(AggregateMax(column, &max));
+  }
+  ASSERT_EQ(3 * 180, count.int64_value());
+  ASSERT_EQ(expected_sum, sum.int64_value());
+  ASSERT_EQ(-297, min.int64_value());
+  ASSERT_EQ(297, max.int64_value());
+
+  QLValue rows;
+  AggregateCountRows(10, &rows);
+  AggregateCountRows(5, &rows);
+  ASSERT_EQ(15, rows.int64_value());
+}
+
+TEST_F(ColumnBatchTest, TestDoubleAggregates) {
+  ColumnVector column(ColumnId(kFirstColumnId), DataType::DOUBLE);
+  for (double value : {1.5, -2.25, 4.0}) {
+    auto primitive_value = PrimitiveValue::Double(value);
+    ASSERT_OK(column.Append(&primitive_value));
+  }
+  QLValue sum, min, max;
+  ASSERT_OK(AggregateSum(column, &sum));
+  ASSERT_OK(AggregateMin(column, &min));
+  ASSERT_OK(AggregateMax(column, &max));
+  ASSERT_DOUBLE_EQ(3.25, sum.double_value());
+  ASSERT_DOUBLE_EQ(-2.25, min.double_value());
+  ASSERT_DOUBLE_EQ(4.0, max.double_value());
+}
+
+// MIN and MAX of floating point columns follow the QLValue ordering, where NaN is greater than any
+// other value, the same way as the row by row evaluation does.
+TEST_F(ColumnBatchTest, TestNaNAggregates) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  ColumnVector double_column(ColumnId(kFirstColumnId), DataType::DOUBLE);
+  ColumnVector float_column(ColumnId(kFirstColumnId), DataType::FLOAT);
+  for (double value : {1.5, nan, -2.25, 4.0}) {
+    auto double_value = PrimitiveValue::Double(value);
+    ASSERT_OK(double_column.Append(&double_value));
+    auto float_value = PrimitiveValue::Float(static_cast<float>(value));
+    ASSERT_OK(float_column.Append(&float_value));
+  }
+  QLValue double_min, double_max, float_min, float_max;
+  ASSERT_OK(AggregateMin(double_column, &double_min));
+  ASSERT_OK(AggregateMax(double_column, &double_max));
+  ASSERT_OK(AggregateMin(float_column, &float_min));
+  ASSERT_OK(AggregateMax(float_column, &float_max));
+  ASSERT_DOUBLE_EQ(-2.25, double_min.double_value());
+  ASSERT_TRUE(std::isnan(double_max.double_value()));
+  ASSERT_FLOAT_EQ(-2.25, float_min.float_value());
+  ASSERT_TRUE(std::isnan(float_max.float_value()));
+
+  // A NaN in a later batch does not replace the minimum, and a number does not replace NaN as the
+  // maximum.
+  double_column.Clear();
+  for (double value : {nan, 100.0}) {
+    auto double_value = PrimitiveValue::Double(value);
+    ASSERT_OK(double_column.Append(&double_value));
+  }
+  ASSERT_OK(AggregateMin(double_column, &double_min));
+  ASSERT_OK(AggregateMax(double_column, &double_max));
+  ASSERT_DOUBLE_EQ(-2.25, double_min.double_value());
+  ASSERT_TRUE(std::isnan(double_max.double_value()));
+
+  // A column of NaN values only.
+  double_column.Clear();
+  auto nan_value = PrimitiveValue::Double(nan);
+  ASSERT_OK(double_column.Append(&nan_value));
+  QLValue nan_min;
+  ASSERT_OK(AggregateMin(double_column, &nan_min));
+  ASSERT_TRUE(std::isnan(nan_min.double_value()));
+}
+
+TEST_F(ColumnBatchTest, TestSimdMatchesScalar) {
+  TestSimdMatchesScalar<int8_t>(DataType::INT8);
+  TestSimdMatchesScalar<int16_t>(DataType::INT16);
+  TestSimdMatchesScalar<int32_t>(DataType::INT32);
+  TestSimdMatchesScalar<int64_t>(DataType::INT64);
+  TestSimdMatchesScalar<float>(DataType::FLOAT);
+  TestSimdMatchesScalar<double>(DataType::DOUBLE);
+}
+
+// Compares SUM over an INT64 column evaluated row by row through DocExprExecutor, the way
+// PgsqlReadOperation::EvalAggregate does, with the batch kernels with and without SIMD.
+TEST_F(ColumnBatchTest, BenchmarkSum) {
+  constexpr size_t kBatchSize = 1024;
+  const size_t num_batches = AllowSlowTests() ? 100000 : 1000;
+  ColumnVector column(ColumnId(kFirstColumnId), DataType::INT64);
+  FillRandom<int32_t>(kBatchSize, 0, &column);
+
+  PgsqlBCallPB tscall;
+  tscall.set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kSumInt64));
+  tscall.add_operands()->set_column_id(kFirstColumnId.rep());
+
+  QLValue row_result;
+  Stopwatch sw;
+  sw.start();
+  {
+    DocExprExecutor executor;
+    QLTableRow row;
+    auto& value = row.AllocColumn(kFirstColumnId).value;
+    for (size_t batch = 0; batch != num_batches; ++batch) {
+      for (size_t i = 0; i != kBatchSize; ++i) {
+        column.GetValue(i, &value);
+        ASSERT_OK(executor.EvalTSCall(tscall, row, &row_result, nullptr));
+      }
+    }
+  }
+  sw.stop();
+  const auto row_time = sw.elapsed();
+
+  std::vector<QLValue> batch_results(2);
+  std::vector<CpuTimes> batch_times;
+  for (bool simd : {false, true}) {
+    FLAGS_enable_simd_aggregates = simd;
+    auto& result = batch_results[simd];
+    sw.start();
+    for (size_t batch = 0; batch != num_batches; ++batch) {
+      ASSERT_OK(AggregateSum(column, &result));
+    }
+    sw.stop();
+    batch_times.push_back(sw.elapsed());
+  }
+
+  ASSERT_EQ(row_result.ToString(), batch_results[0].ToString());
+  ASSERT_EQ(row_result.ToString(), batch_results[1].ToString());
+
+  const auto num_rows = num_batches * kBatchSize;
+  LOG(INFO) << "SUM of " << num_rows << " rows, row by row: " << row_time.wall_millis()
+            << "ms, batch: " << batch_times[0].wall_millis() << "ms, batch with SIMD: "
+            << batch_times[1].wall_millis() << "ms";
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,253 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/column_batch.h"
+
+#include <cstring>
+
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/gutil/macros.h"
+
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+size_t ElementSize(DataType type) {
+  switch (type) {
+    case DataType::INT8: return sizeof(int8_t);
+    case DataType::INT16: return sizeof(int16_t);
+    case DataType::INT32: return sizeof(int32_t);
+    case DataType::INT64: return sizeof(int64_t);
+    case DataType::FLOAT: return sizeof(float);
+    case DataType::DOUBLE: return sizeof(double);
+    case DataType::BOOL: return sizeof(bool);
+    default: return 0;
+  }
+}
+
+} // namespace
+
+ColumnVector::ColumnVector(ColumnId column_id, DataType type)
+    : column_id_(column_id), type_(type), element_size_(ElementSize(type)) {
+  DCHECK(IsSupportedType(type)) << DataType_Name(type);
+}
+
+bool ColumnVector::IsSupportedType(DataType type) {
+  return ElementSize(type) != 0;
+}
+
+void ColumnVector::Clear() {
+  size_ = 0;
+  null_count_ = 0;
+  data_.clear();
+  null_bitmap_.clear();
+}
+
+void ColumnVector::AppendNull() {
+  data_.resize(data_.size() + element_size_);
+  if (size_ % kBitsPerWord == 0) {
+    null_bitmap_.push_back(0);
+  }
+  null_bitmap_.back() |= 1ULL << (size_ % kBitsPerWord);
+  ++null_count_;
+  ++size_;
+}
+
+template <class T>
+void ColumnVector::AppendValue(T value) {
+  DCHECK_EQ(sizeof(T), element_size_);
+  const auto old_size = data_.size();
+  data_.resize(old_size + sizeof(T));
+  memcpy(data_.data() + old_size, &value, sizeof(T));
+  if (size_ % kBitsPerWord == 0) {
+    null_bitmap_.push_back(0);
+  }
+  ++size_;
+}
+
+Status ColumnVector::Append(const PrimitiveValue* value) {
+  if (!value) {
+    AppendNull();
+    return Status::OK();
+  }
+  const auto value_type = value->value_type();
+  switch (value_type) {
+    case ValueType::kInvalid: FALLTHROUGH_INTENDED;
+    case ValueType::kTombstone: FALLTHROUGH_INTENDED;
+    case ValueType::kNullLow: FALLTHROUGH_INTENDED;
+    case ValueType::kNullHigh:
+      AppendNull();
+      return Status::OK();
+    case ValueType::kInt32: FALLTHROUGH_INTENDED;
+    case ValueType::kInt32Descending:
+      // DocDB stores all integer types narrower than 64 bits as 32 bit integers.
+      switch (type_) {
+        case DataType::INT8:
+          AppendValue(static_cast<int8_t>(value->GetInt32()));
+          return Status::OK();
+        case DataType::INT16:
+          AppendValue(static_cast<int16_t>(value->GetInt32()));
+          return Status::OK();
+        case DataType::INT32:
+          AppendValue(value->GetInt32());
+          return Status::OK();
+        default:
+          break;
+      }
+      break;
+    case ValueType::kInt64: FALLTHROUGH_INTENDED;
+    case ValueType::kInt64Descending:
+      if (type_ == DataType::INT64) {
+        AppendValue(value->GetInt64());
+        return Status::OK();
+      }
+      break;
+    case ValueType::kFloat: FALLTHROUGH_INTENDED;
+    case ValueType::kFloatDescending:
+      if (type_ == DataType::FLOAT) {
+        AppendValue(value->GetFloat());
+        return Status::OK();
+      }
+      break;
+    case ValueType::kDouble: FALLTHROUGH_INTENDED;
+    case ValueType::kDoubleDescending:
+      if (type_ == DataType::DOUBLE) {
+        AppendValue(value->GetDouble());
+        return Status::OK();
+      }
+      break;
+    case ValueType::kTrue: FALLTHROUGH_INTENDED;
+    case ValueType::kTrueDescending: FALLTHROUGH_INTENDED;
+    case ValueType::kFalse: FALLTHROUGH_INTENDED;
+    case ValueType::kFalseDescending:
+      if (type_ == DataType::BOOL) {
+        AppendValue(value_type == ValueType::kTrue || value_type == ValueType::kTrueDescending);
+        return Status::OK();
+      }
+      break;
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      Corruption, "Unexpected value $0 for column $1 of type $2",
+      value->ToString(), column_id_, DataType_Name(type_));
+}
+
+Status ColumnVector::Append(const QLValuePB& value) {
+  if (QLValue::IsNull(value)) {
+    AppendNull();
+    return Status::OK();
+  }
+  switch (type_) {
+    case DataType::INT8:
+      AppendValue(static_cast<int8_t>(value.int8_value()));
+      return Status::OK();
+    case DataType::INT16:
+      AppendValue(static_cast<int16_t>(value.int16_value()));
+      return Status::OK();
+    case DataType::INT32:
+      AppendValue(value.int32_value());
+      return Status::OK();
+    case DataType::INT64:
+      AppendValue(value.int64_value());
+      return Status::OK();
+    case DataType::FLOAT:
+      AppendValue(value.float_value());
+      return Status::OK();
+    case DataType::DOUBLE:
+      AppendValue(value.double_value());
+      return Status::OK();
+    case DataType::BOOL:
+      AppendValue(value.bool_value());
+      return Status::OK();
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Column $0 of type $1 could not be stored in a column vector",
+      column_id_, DataType_Name(type_));
+}
+
+void ColumnVector::GetValue(size_t idx, QLValuePB* out) const {
+  if (IsNull(idx)) {
+    out->Clear();
+    return;
+  }
+  switch (type_) {
+    case DataType::INT8:
+      out->set_int8_value(data<int8_t>()[idx]);
+      return;
+    case DataType::INT16:
+      out->set_int16_value(data<int16_t>()[idx]);
+      return;
+    case DataType::INT32:
+      out->set_int32_value(data<int32_t>()[idx]);
+      return;
+    case DataType::INT64:
+      out->set_int64_value(data<int64_t>()[idx]);
+      return;
+    case DataType::FLOAT:
+      out->set_float_value(data<float>()[idx]);
+      return;
+    case DataType::DOUBLE:
+      out->set_double_value(data<double>()[idx]);
+      return;
+    case DataType::BOOL:
+      out->set_bool_value(data<bool>()[idx]);
+      return;
+    default:
+      break;
+  }
+  LOG(DFATAL) << "Unsupported column vector type: " << DataType_Name(type_);
+  out->Clear();
+}
+
+Status ColumnarRowBatch::AddColumn(const Schema& schema, ColumnId column_id) {
+  const auto& column = VERIFY_RESULT(schema.column_by_id(column_id));
+  const auto type = column.type()->main();
+  if (!ColumnVector::IsSupportedType(type)) {
+    return STATUS_FORMAT(
+        NotSupported, "Column $0 of type $1 could not be stored in a column vector",
+        column_id, DataType_Name(type));
+  }
+  columns_.emplace_back(column_id, type);
+  return Status::OK();
+}
+
+int ColumnarRowBatch::ColumnIndex(ColumnId column_id) const {
+  for (size_t i = 0; i != columns_.size(); ++i) {
+    if (columns_[i].column_id() == column_id) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void ColumnarRowBatch::Clear() {
+  for (auto& column : columns_) {
+    column.Clear();
+  }
+  num_rows_ = 0;
+}
+
+}  // namespace docdb
+}  // namespace yb
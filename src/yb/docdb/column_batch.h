@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_COLUMN_BATCH_H
+#define YB_DOCDB_COLUMN_BATCH_H
+
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "yb/common/column_id.h"
+#include "yb/common/common_fwd.h"
+#include "yb/common/value.pb.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Values of a single fixed-width column for a batch of rows, stored as a plain array of the native
+// type plus a null bitmap. Null slots hold zero in the value array, so kernels that are not null
+// aware could process the array as is when zero is neutral for them (e.g. SUM).
+class ColumnVector {
+ public:
+  ColumnVector(ColumnId column_id, DataType type);
+
+  // Returns true if values of the specified type could be stored in a ColumnVector.
+  static bool IsSupportedType(DataType type);
+
+  ColumnId column_id() const { return column_id_; }
+
+  DataType type() const { return type_; }
+
+  size_t size() const { return size_; }
+
+  size_t null_count() const { return null_count_; }
+
+  bool IsNull(size_t idx) const {
+    return (null_bitmap_[idx / kBitsPerWord] >> (idx % kBitsPerWord)) & 1;
+  }
+
+  // Bit i of the bitmap is set when value i is NULL.
+  const uint64_t* null_bitmap() const { return null_bitmap_.data(); }
+
+  // Returns values as an array of T. T should match the storage type of the column type, i.e.
+  // int8_t for INT8, int16_t for INT16, ..., bool for BOOL.
+  template <class T>
+  const T* data() const {
+    DCHECK_EQ(sizeof(T), element_size_);
+    return reinterpret_cast<const T*>(data_.data());
+  }
+
+  void Clear();
+
+  // Appends a value read from DocDB. nullptr, tombstone and invalid values are treated as NULL.
+  CHECKED_STATUS Append(const PrimitiveValue* value);
+
+  CHECKED_STATUS Append(const QLValuePB& value);
+
+  // Converts the value at the specified position back to the QL representation.
+  void GetValue(size_t idx, QLValuePB* out) const;
+
+ private:
+  static constexpr size_t kBitsPerWord = 64;
+
+  void AppendNull();
+
+  template <class T>
+  void AppendValue(T value);
+
+  ColumnId column_id_;
+  DataType type_;
+  size_t element_size_;
+  size_t size_ = 0;
+  size_t null_count_ = 0;
+  std::vector<char> data_;
+  std::vector<uint64_t> null_bitmap_;
+};
+
+// A batch of rows read from a table in columnar form: one ColumnVector per requested column.
+class ColumnarRowBatch {
+ public:
+  ColumnarRowBatch() = default;
+
+  // Requests that values of the specified column should be materialized in this batch. Returns
+  // NotSupported if the column type is not fixed-width.
+  CHECKED_STATUS AddColumn(const Schema& schema, ColumnId column_id);
+
+  size_t num_columns() const { return columns_.size(); }
+
+  size_t num_rows() const { return num_rows_; }
+
+  const ColumnVector& column(size_t idx) const { return columns_[idx]; }
+
+  ColumnVector* mutable_column(size_t idx) { return &columns_[idx]; }
+
+  // Returns index of the column with specified id in this batch, or -1 if it is not present.
+  int ColumnIndex(ColumnId column_id) const;
+
+  // Should be called after values of the current row were appended to all columns.
+  void RowAppended() { ++num_rows_; }
+
+  // Removes all rows from the batch, keeping the set of columns.
+  void Clear();
+
+ private:
+  std::vector<ColumnVector> columns_;
+  size_t num_rows_ = 0;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_COLUMN_BATCH_H
@@ -14,6 +14,7 @@
 
 #include <map>
 
+#include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/common/row_mark.h"
 #include "yb/common/transaction.h"
@@ -24,8 +25,10 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/lock_batch.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/wait_queue.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
@@ -35,11 +38,18 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DECLARE_bool(enable_wait_queues);
+
 namespace yb {
 namespace docdb {
 
 namespace {
 
+// Bounds of the delay between attempts to reacquire locks, after waiting for conflicting
+// transactions.
+constexpr auto kMinRelockDelay = 1ms;
+constexpr auto kMaxRelockDelay = 50ms;
+
 using TransactionIdMap = std::unordered_map<TransactionId, WaitPolicy, TransactionIdHash>;
 
 struct TransactionData {
@@ -93,6 +103,14 @@ class ConflictResolverContext {
 
   virtual HybridTime GetResolutionHt() = 0;
 
+  // Returns error when the operation should be restarted, instead of reading conflicts again after
+  // conflicting transactions have finished.
+  virtual CHECKED_STATUS CheckRestartAfterWait() = 0;
+
+  // Invoked before conflicts are read again, after waiting for conflicting transactions.
+  // resolution_ht - new hybrid time of conflict resolution, picked after locks were reacquired.
+  virtual void ResetConflicts(HybridTime resolution_ht) = 0;
+
   virtual bool IgnoreConflictsWith(const TransactionId& other) = 0;
 
   virtual TransactionId transaction_id() const = 0;
@@ -117,6 +135,17 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
         partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
         callback_(std::move(callback)) {}
 
+  // Allows resolver to wait in wait_queue for conflicting transactions, instead of aborting them.
+  // Locks of lock_batch are released while waiting. Clock is used to pick new resolution time
+  // after waiting.
+  void EnableWaiting(WaitQueue* wait_queue, LockBatch* lock_batch, ClockBase* clock,
+                     CoarseTimePoint deadline) {
+    wait_queue_ = wait_queue;
+    lock_batch_ = lock_batch;
+    clock_ = clock;
+    deadline_ = deadline;
+  }
+
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
   }
@@ -320,6 +349,11 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
+    if (ShouldWait()) {
+      WaitForRemainingTransactions();
+      return false;
+    }
+
     RETURN_NOT_OK(context_->CheckPriority(this, RemainingTransactions()));
 
     AbortTransactions();
@@ -484,6 +518,95 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     DoResolveConflicts();
   }
 
+  bool ShouldWait() {
+    if (!wait_queue_ || wait_failed_ || !FLAGS_enable_wait_queues) {
+      return false;
+    }
+    for (const auto& transaction : RemainingTransactions()) {
+      // Transactions that requested to skip locked rows should not wait.
+      if (transaction.wait_policy == WAIT_SKIP) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void WaitForRemainingTransactions() {
+    std::vector<TransactionId> blockers;
+    blockers.reserve(remaining_transactions_);
+    for (const auto& transaction : RemainingTransactions()) {
+      blockers.push_back(transaction.id);
+    }
+    TRACE("Waiting for $0", yb::ToString(blockers));
+    VLOG_WITH_PREFIX(4) << "Waiting for " << yb::ToString(blockers);
+    // Release locks while waiting, so conflicting transactions could continue writing to the same
+    // keys on this tablet.
+    lock_batch_->Unlock();
+    auto self = shared_from_this();
+    wait_queue_->WaitOn(
+        context_->transaction_id(), std::move(blockers), deadline_,
+        [self](const Status& status) {
+      self->WaitDone(status);
+    });
+  }
+
+  void WaitDone(const Status& wait_status) {
+    TRACE("Wait done: $0", wait_status.ToString());
+    VLOG_WITH_PREFIX(4) << "Wait done: " << wait_status;
+    if (wait_status.IsAborted()) {
+      // Wait queue is shutting down.
+      InvokeCallback(wait_status);
+      return;
+    }
+    if (wait_status.ok()) {
+      auto status = context_->CheckRestartAfterWait();
+      if (!status.ok()) {
+        InvokeCallback(status);
+        return;
+      }
+    } else {
+      // Deadlock or wait timeout, resolve remaining conflicts using priorities.
+      wait_failed_ = true;
+    }
+
+    RelockAndResolve();
+  }
+
+  // Reacquires locks released while waiting and reads conflicts again. Locks could be held by other
+  // writes to the same keys, in this case the attempt is retried after a delay instead of blocking
+  // the thread.
+  void RelockAndResolve() {
+    if (!lock_batch_->TryRelock()) {
+      if (CoarseMonoClock::now() >= deadline_) {
+        InvokeCallback(STATUS_FORMAT(
+            TryAgain, "Failed to obtain locks until deadline: $0", deadline_));
+        return;
+      }
+      relock_delay_ = relock_delay_ ? std::min<MonoDelta>(relock_delay_ * 2, kMaxRelockDelay)
+                                    : MonoDelta(kMinRelockDelay);
+      auto self = shared_from_this();
+      wait_queue_->RetryAfter(relock_delay_, [self](const Status& status) {
+        if (!status.ok()) {
+          self->InvokeCallback(status);
+          return;
+        }
+        self->RelockAndResolve();
+      });
+      return;
+    }
+
+    // Other transactions could write new intents while locks were released, so conflicts should be
+    // read again. Conflicting transactions could have been committed after the original resolution
+    // time, so their status is requested at a new one.
+    conflicts_.clear();
+    transactions_.clear();
+    remaining_transactions_ = 0;
+    relock_delay_ = MonoDelta();
+    intent_iter_.Reset();
+    context_->ResetConflicts(clock_->Now());
+    Resolve();
+  }
+
   std::string LogPrefix() const {
     return context_->LogPrefix();
   }
@@ -505,6 +628,15 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   size_t remaining_transactions_;
 
   std::atomic<int> pending_requests_{0};
+
+  WaitQueue* wait_queue_ = nullptr;
+  LockBatch* lock_batch_ = nullptr;
+  ClockBase* clock_ = nullptr;
+  CoarseTimePoint deadline_;
+  // Delay before the next attempt to reacquire locks after waiting.
+  MonoDelta relock_delay_;
+  // Set when waiting failed, so remaining conflicts should be resolved without waiting.
+  bool wait_failed_ = false;
 };
 
 struct IntentData {
@@ -694,6 +826,15 @@ class ConflictResolverContextBase : public ConflictResolverContext {
     resolution_ht_.MakeAtLeast(resolution_ht);
   }
 
+  CHECKED_STATUS CheckRestartAfterWait() override {
+    return Status::OK();
+  }
+
+  void ResetConflicts(HybridTime resolution_ht) override {
+    MakeResolutionAtLeast(resolution_ht);
+    fetched_metadata_for_transactions_ = false;
+  }
+
   Counter* GetConflictsMetric() {
     return conflicts_metric_;
   }
@@ -885,6 +1026,18 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     return true;
   }
 
+  CHECKED_STATUS CheckRestartAfterWait() override {
+    // Conflicting transactions that committed while we were waiting have commit time after our
+    // read time, so reading conflicts again would just fail with conflict. Restart the operation,
+    // so it is executed with a new read time.
+    if (read_time_ != HybridTime::kMax) {
+      return STATUS_EC_FORMAT(
+          TryAgain, TransactionError(TransactionErrorCode::kReadRestartRequired),
+          "Read time $0 is stale after waiting for conflicting transactions", read_time_);
+    }
+    return Status::OK();
+  }
+
   bool IgnoreConflictsWith(const TransactionId& other) override {
     return other == *transaction_id_;
   }
@@ -998,6 +1151,10 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 WaitQueue* wait_queue,
+                                 LockBatch* lock_batch,
+                                 ClockBase* clock,
+                                 CoarseTimePoint deadline,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   TRACE("ResolveTransactionConflicts");
@@ -1005,6 +1162,9 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
       doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+  if (wait_queue && lock_batch && clock) {
+    resolver->EnableWaiting(wait_queue, lock_batch, clock, deadline);
+  }
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
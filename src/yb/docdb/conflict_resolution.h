@@ -40,7 +40,10 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // Resolves conflicts for write batch of transaction.
 // Read all intents that could conflict with intents generated by provided write_batch.
 // Forms set of conflicting transactions.
-// Tries to abort transactions with lower priority.
+// When wait queues are enabled, waits in wait_queue until conflicting transactions are finished.
+// Otherwise, or if waiting failed, tries to abort transactions with lower priority.
+// If the transaction has read time and waiting succeeded, fails with kReadRestartRequired, since
+// conflicts with transactions committed while waiting could not be resolved at that read time.
 // If it conflicts with transaction with higher priority or committed one then error is returned.
 //
 // write_batch - values that would be written as part of transaction.
@@ -48,6 +51,10 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// wait_queue - wait queue of the tablet, could be null.
+// lock_batch - locks acquired for write_batch, released while waiting in wait_queue.
+// clock - used to pick new resolution time after waiting.
+// deadline - deadline of the write operation.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
                                  HybridTime resolution_ht,
@@ -56,6 +63,10 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 WaitQueue* wait_queue,
+                                 LockBatch* lock_batch,
+                                 ClockBase* clock,
+                                 CoarseTimePoint deadline,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
@@ -18,6 +18,7 @@
 
 #include "yb/common/doc_hybrid_time.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/pgsql_error.h"
 #include "yb/common/transaction.h"
 
 #include "yb/docdb/docdb_fwd.h"
@@ -27,6 +28,7 @@
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/subdoc_reader.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -35,6 +37,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
+#include "yb/util/status_format.h"
 
 using std::vector;
 
@@ -70,6 +73,8 @@ Result<boost::optional<SubDocument>> TEST_GetSubDocument(
   iter->SeekToLastDocKey();
   DocDBTableReader doc_reader(iter.get(), deadline);
   RETURN_NOT_OK(doc_reader.UpdateTableTombstoneTime(sub_doc_key));
+  // Tests could write packed rows without creating a table with the packed_row property.
+  doc_reader.EnablePackedRows(boost::none);
 
   SubDocument result;
   if (VERIFY_RESULT(doc_reader.Get(sub_doc_key, projection, &result))) {
@@ -89,6 +94,11 @@ void DocDBTableReader::SetTableTtl(const Schema& table_schema) {
       iter_->read_time(), table_obsolescence_tracker_.GetHighWriteTime(), table_ttl);
 }
 
+void DocDBTableReader::EnablePackedRows(const boost::optional<uint32_t>& schema_version) {
+  packed_rows_enabled_ = true;
+  schema_version_ = schema_version;
+}
+
 Status DocDBTableReader::UpdateTableTombstoneTime(const Slice& root_doc_key) {
   if (root_doc_key[0] == ValueTypeAsChar::kPgTableOid) {
     // Update table_tombstone_time based on what is written to RocksDB if its not already set.
@@ -136,17 +146,55 @@ Result<bool> DocDBTableReader::Get(
   // Preallocate some extra space to avoid allocation for small subkeys.
   key_bytes.Reserve(root_doc_key.size() + kMaxBytesPerEncodedHybridTime + 32);
   key_bytes.AppendRawBytes(root_doc_key);
+  // Full document reads and the fallback below decode the packed row in SubDocumentReader, but it
+  // is always read here first to validate its schema version.
+  PackedRowDecoder packed_row;
+  DocHybridTime packed_row_time = DocHybridTime::kMin;
+  bool has_packed_row = false;
+  bool has_column_records = true;
+  if (packed_rows_enabled_) {
+    has_packed_row = VERIFY_RESULT(ReadPackedRow(root_doc_key, &packed_row_time, &packed_row));
+    if (has_packed_row) {
+      has_column_records = VERIFY_RESULT(HasColumnRecords(root_doc_key));
+    }
+  }
   if (projection != nullptr) {
-    bool doc_found = false;
+    bool doc_found = has_packed_row;
     const size_t subdocument_key_size = key_bytes.size();
     for (const PrimitiveValue& subkey : *projection) {
+      if (!has_column_records) {
+        // None of the columns was written separately, so the packed row has all of them and there
+        // is no need to seek to the column keys.
+        SubDocument descendant;
+        if (VERIFY_RESULT(GetPackedColumn(packed_row, subkey, packed_row_time, &descendant))) {
+          result->SetChild(subkey, std::move(descendant));
+        }
+        continue;
+      }
       // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
       // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
       // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
       subkey.AppendToKey(&key_bytes);
       key_bytes.Reserve(key_bytes.size() + kMaxBytesPerEncodedHybridTime + 1);
-      // This seek is to initialize the iterator for BuildSubDocument call.
-      iter_->SeekForward(&key_bytes);
+      if (has_packed_row) {
+        // The packed row contains the latest value of the column, unless the column was updated
+        // separately after the row was packed.
+        DocHybridTime column_write_time = packed_row_time;
+        RETURN_NOT_OK(iter_->FindLatestRecord(key_bytes, &column_write_time));
+        if (column_write_time == packed_row_time) {
+          SubDocument descendant;
+          if (VERIFY_RESULT(GetPackedColumn(packed_row, subkey, packed_row_time, &descendant))) {
+            result->SetChild(subkey, std::move(descendant));
+          }
+          key_bytes.Truncate(subdocument_key_size);
+          continue;
+        }
+        // FindLatestRecord could have moved the iterator past the column records.
+        iter_->Seek(key_bytes);
+      } else {
+        // This seek is to initialize the iterator for BuildSubDocument call.
+        iter_->SeekForward(&key_bytes);
+      }
       SubDocument descendant;
       auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
       RETURN_NOT_OK(reader->Get(&descendant));
@@ -180,5 +228,55 @@ Result<bool> DocDBTableReader::Get(
       && result->value_type() != ValueType::kTombstone;
 }
 
+Result<bool> DocDBTableReader::ReadPackedRow(
+    const Slice& root_doc_key, DocHybridTime* write_time, PackedRowDecoder* decoder) {
+  Slice value;
+  RETURN_NOT_OK(iter_->FindLatestRecord(root_doc_key, write_time, &value));
+  if (value.empty()) {
+    return false;
+  }
+  // Values written by transactions could be prefixed with control fields.
+  Value control_fields;
+  RETURN_NOT_OK(control_fields.DecodeControlFields(&value));
+  if (!IsPackedRow(value) || table_obsolescence_tracker_.IsObsolete(*write_time)) {
+    return false;
+  }
+  packed_row_value_.assign(value.cdata(), value.size());
+  RETURN_NOT_OK(decoder->Init(packed_row_value_));
+  if (schema_version_ && decoder->schema_version() > *schema_version_) {
+    return STATUS_EC_FORMAT(
+        InvalidArgument,
+        PgsqlRequestStatus(PgsqlResponsePB::PGSQL_STATUS_SCHEMA_VERSION_MISMATCH),
+        "Packed row schema version $0 is newer than the read schema version $1",
+        decoder->schema_version(), *schema_version_);
+  }
+  return true;
+}
+
+Result<bool> DocDBTableReader::HasColumnRecords(const Slice& root_doc_key) {
+  // Column keys follow all records of the root key, so a single step forward is enough.
+  iter_->SeekPastSubKey(root_doc_key);
+  if (!iter_->valid()) {
+    return false;
+  }
+  auto key_data = VERIFY_RESULT(iter_->FetchKey());
+  return key_data.key.starts_with(root_doc_key);
+}
+
+Result<bool> DocDBTableReader::GetPackedColumn(
+    const PackedRowDecoder& decoder, const PrimitiveValue& subkey,
+    const DocHybridTime& write_time, SubDocument* result) {
+  PrimitiveValue value;
+  if (subkey == PrimitiveValue::kLivenessColumn) {
+    // Existence of the packed row implies existence of the liveness column.
+  } else if (subkey.value_type() != ValueType::kColumnId ||
+             !VERIFY_RESULT(decoder.DecodeValue(subkey.GetColumnId(), &value))) {
+    return false;
+  }
+  value.SetWriteTime(write_time.hybrid_time().GetPhysicalValueMicros());
+  *result = SubDocument(std::move(value));
+  return true;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -27,6 +27,7 @@
 #include "yb/docdb/deadline_info.h"
 #include "yb/docdb/docdb_types.h"
 #include "yb/docdb/expiration.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/subdoc_reader.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -83,6 +84,11 @@ class DocDBTableReader {
   // subsequently read SubDocuments.
   void SetTableTtl(const Schema& table_schema);
 
+  // Enables reading rows stored in the packed format, i.e. for tables with the packed_row property.
+  // If schema_version is specified, packed rows written with a newer schema version are rejected,
+  // since the schema known to the reader could be missing their columns.
+  void EnablePackedRows(const boost::optional<uint32_t>& schema_version);
+
   // For each value in projection, read into the provided SubDocument* a child Subdocument
   // corresponding to the data at the key formed by appending the projection value to the end of the
   // provided root_doc_key. If found, the result will be a SubDocument rooted at root_doc_key with
@@ -102,6 +108,21 @@ class DocDBTableReader {
   // seek_fwd_suffices_ flag.
   void SeekTo(const Slice& subdoc_key);
 
+  // Checks whether the latest record at root_doc_key is a live packed row. If so, stores its write
+  // time and prepares decoder to access its columns.
+  Result<bool> ReadPackedRow(
+      const Slice& root_doc_key, DocHybridTime* write_time, PackedRowDecoder* decoder);
+
+  // Checks whether there are records for the columns of the row at root_doc_key, e.g. written by
+  // updates after the row was packed. Should be called right after ReadPackedRow.
+  Result<bool> HasColumnRecords(const Slice& root_doc_key);
+
+  // Fills result with the value of the projected subkey stored in the packed row. Returns false if
+  // the packed row does not contain this column, i.e. it is NULL.
+  Result<bool> GetPackedColumn(
+      const PackedRowDecoder& decoder, const PrimitiveValue& subkey,
+      const DocHybridTime& write_time, SubDocument* result);
+
   // Owned by caller.
   IntentAwareIterator* iter_;
   DeadlineInfo deadline_info_;
@@ -109,6 +130,11 @@ class DocDBTableReader {
   Expiration table_expiration_;
   ObsolescenceTracker table_obsolescence_tracker_;
   SubDocumentReaderBuilder subdoc_reader_builder_;
+  // Copy of the packed row of the current document, the iterator's value could be invalidated by
+  // subsequent seeks.
+  std::string packed_row_value_;
+  bool packed_rows_enabled_ = false;
+  boost::optional<uint32_t> schema_version_;
 };
 
 }  // namespace docdb
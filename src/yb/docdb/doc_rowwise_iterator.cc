@@ -32,6 +32,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_path.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/column_batch.h"
 #include "yb/docdb/doc_reader.h"
 #include "yb/docdb/doc_scanspec_util.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
@@ -723,6 +724,9 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       if (!ignore_ttl_) {
         doc_reader_->SetTableTtl(schema_);
       }
+      if (schema_.table_properties().packed_row()) {
+        doc_reader_->EnablePackedRows(schema_version_);
+      }
     }
 
     row_ = SubDocument();
@@ -842,6 +846,64 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::NextBatch(size_t max_rows, ColumnarRowBatch* batch) {
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+    RETURN_NOT_OK(AppendRowToBatch(batch));
+    ++num_rows;
+  }
+  return num_rows;
+}
+
+Status DocRowwiseIterator::AppendRowToBatch(ColumnarRowBatch* batch) {
+  if (!row_ready_) {
+    return STATUS(InternalError, "next row has not be prepared for reading");
+  }
+
+  bool key_decoded = false;
+  for (size_t i = 0; i != batch->num_columns(); ++i) {
+    auto* column = batch->mutable_column(i);
+    const auto column_id = column->column_id();
+    const int schema_idx = schema_.find_column_by_id(column_id);
+    if (schema_idx == Schema::kColumnNotFound) {
+      return STATUS_FORMAT(InvalidArgument, "Column $0 not found in $1", column_id, schema_);
+    }
+    if (schema_.is_key_column(schema_idx)) {
+      if (!key_decoded) {
+        RETURN_NOT_OK(DecodeKeyColumnValues());
+        key_decoded = true;
+      }
+      RETURN_NOT_OK(column->Append(&key_values_[schema_idx]));
+    } else {
+      RETURN_NOT_OK(column->Append(row_.GetChild(PrimitiveValue(column_id))));
+    }
+  }
+  batch->RowAppended();
+
+  row_ready_ = false;
+  return Status::OK();
+}
+
+Status DocRowwiseIterator::DecodeKeyColumnValues() {
+  key_values_.resize(schema_.num_key_columns());
+  DocKeyDecoder decoder(row_key_);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  size_t idx = 0;
+  if (VERIFY_RESULT(decoder.DecodeHashCode())) {
+    for (; idx != schema_.num_hash_key_columns(); ++idx) {
+      RETURN_NOT_OK(decoder.DecodePrimitiveValue(&key_values_[idx]));
+    }
+    RETURN_NOT_OK(decoder.ConsumeGroupEnd());
+  }
+  if (!decoder.GroupEnded()) {
+    for (; idx != schema_.num_key_columns(); ++idx) {
+      RETURN_NOT_OK(decoder.DecodePrimitiveValue(&key_values_[idx]));
+    }
+  }
+  return Status::OK();
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(PrimitiveValue::kLivenessColumn);
   return subdoc != nullptr && subdoc->value_type() != ValueType::kInvalid;
@@ -113,10 +113,19 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Retrieves the next key to read after the iterator finishes for the given page.
   CHECKED_STATUS GetNextReadSubDocKey(SubDocKey* sub_doc_key) const override;
 
+  // Reads rows directly from the assembled SubDocuments into the column vectors, bypassing
+  // QLTableRow construction.
+  Result<size_t> NextBatch(size_t max_rows, ColumnarRowBatch* batch) override;
+
   void set_debug_dump(bool value) {
     debug_dump_ = value;
   }
 
+  // Schema version the read was issued with, used to validate packed rows.
+  void set_schema_version(uint32_t schema_version) {
+    schema_version_ = schema_version;
+  }
+
  private:
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
@@ -164,6 +173,13 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Appends values of the current row to the columns of the batch.
+  CHECKED_STATUS AppendRowToBatch(ColumnarRowBatch* batch);
+
+  // Decodes values of the primary key columns of the current row into key_values_, in the schema
+  // order.
+  CHECKED_STATUS DecodeKeyColumnValues();
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -219,6 +235,9 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
 
   mutable std::vector<PrimitiveValue> projection_subkeys_;
 
+  // Primary key column values of the current row, used by NextBatch.
+  std::vector<PrimitiveValue> key_values_;
+
   // Used for keeping track of errors in HasNext.
   mutable Status has_next_status_;
 
@@ -230,6 +249,8 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   mutable bool ignore_ttl_ = false;
 
   bool debug_dump_ = false;
+
+  boost::optional<uint32_t> schema_version_;
 };
 
 }  // namespace docdb
@@ -16,6 +16,7 @@
 
 #include "yb/common/doc_hybrid_time.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/pgsql_error.h"
 #include "yb/common/ql_type.h"
 #include "yb/common/ql_value.h"
 
@@ -31,6 +32,8 @@
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
+#include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
 
 #include "yb/gutil/casts.h"
@@ -481,6 +484,15 @@ class DocDBTestQl : public DocDBTest {
       const ReadHybridTime& read_time = ReadHybridTime::Max()) override {
     GetSubDocQl(doc_db(), subdoc_key, result, found_result, txn_op_context, read_time);
   }
+
+  // Writes the row packed by packer at the root of doc_key, the same way as a YSQL insert does.
+  void InsertPackedRow(const DocKey& doc_key, RowPacker* packer, HybridTime hybrid_time) {
+    auto dwb = MakeDocWriteBatch();
+    auto& entry = dwb.AddRaw();
+    entry.first = doc_key.Encode().ToStringBuffer();
+    entry.second = packer->Complete();
+    ASSERT_OK(WriteToRocksDB(dwb, hybrid_time));
+  }
 };
 
 class DocDBTestRedis : public DocDBTest {
@@ -661,6 +673,151 @@ TEST_F(DocDBTestQl, LastProjectionIsNull) {
   )#", doc_from_rocksdb.ToString());
 }
 
+namespace {
+
+std::string ChildToString(const SubDocument& doc, const PrimitiveValue& subkey) {
+  auto child = doc.GetChild(subkey);
+  if (!child || child->value_type() == ValueType::kInvalid ||
+      child->value_type() == ValueType::kTombstone) {
+    return "NULL";
+  }
+  return child->ToString();
+}
+
+} // namespace
+
+// Reads a packed row whose columns were partially updated after it was packed, both with a
+// projection and as a whole document.
+TEST_F(DocDBTestQl, PackedRow) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key = doc_key.Encode();
+  const PrimitiveValue column_a(ColumnId(kFirstColumnId + 0));
+  const PrimitiveValue column_b(ColumnId(kFirstColumnId + 1));
+  const PrimitiveValue column_c(ColumnId(kFirstColumnId + 2));
+  const PrimitiveValue column_d(ColumnId(kFirstColumnId + 3));
+
+  // A column written before the row was packed is overwritten by the packed row.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, column_a), PrimitiveValue("old"), 500_usec_ht));
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(column_a.GetColumnId(), PrimitiveValue("a"));
+  packer.AddValue(column_b.GetColumnId(), PrimitiveValue(1));
+  packer.AddValue(column_c.GetColumnId(), PrimitiveValue(2));
+  ASSERT_NO_FATALS(InsertPackedRow(doc_key, &packer, 1000_usec_ht));
+  // Columns updated after the row was packed, including setting a column to NULL.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, column_b), PrimitiveValue(10), 2000_usec_ht));
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, column_c), PrimitiveValue(ValueType::kTombstone), 2000_usec_ht));
+
+  const vector<PrimitiveValue> projection = {
+      PrimitiveValue::kLivenessColumn, column_a, column_b, column_c, column_d };
+  const vector<PrimitiveValue>* projections[] = { &projection, nullptr };
+  for (const auto* current_projection : projections) {
+    auto doc = ASSERT_RESULT(TEST_GetSubDocument(
+        encoded_doc_key, doc_db(), rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(3000_usec_ht),
+        current_projection));
+    ASSERT_TRUE(doc);
+    ASSERT_NE("NULL", ChildToString(*doc, PrimitiveValue::kLivenessColumn));
+    ASSERT_EQ("\"a\"", ChildToString(*doc, column_a));
+    ASSERT_EQ("10", ChildToString(*doc, column_b));
+    ASSERT_EQ("NULL", ChildToString(*doc, column_c));
+    ASSERT_EQ("NULL", ChildToString(*doc, column_d));
+
+    doc = ASSERT_RESULT(TEST_GetSubDocument(
+        encoded_doc_key, doc_db(), rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(1500_usec_ht),
+        current_projection));
+    ASSERT_TRUE(doc);
+    ASSERT_EQ("\"a\"", ChildToString(*doc, column_a));
+    ASSERT_EQ("1", ChildToString(*doc, column_b));
+    ASSERT_EQ("2", ChildToString(*doc, column_c));
+  }
+}
+
+// A packed row hidden by a colocated table tombstone is read by the whole document fallback.
+TEST_F(DocDBTestQl, PackedRowTableTombstone) {
+  constexpr PgTableOid pgtable_id(0x4001);
+  DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  doc_key.set_pgtable_id(pgtable_id);
+  const PrimitiveValue column_a(ColumnId(kFirstColumnId + 0));
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(column_a.GetColumnId(), PrimitiveValue("a"));
+  ASSERT_NO_FATALS(InsertPackedRow(doc_key, &packer, 1000_usec_ht));
+
+  DocKey doc_key_table;
+  doc_key_table.set_pgtable_id(pgtable_id);
+  ASSERT_OK(DeleteSubDoc(doc_key_table.Encode(), 2000_usec_ht));
+
+  const vector<PrimitiveValue> projection = { column_a };
+  auto doc = ASSERT_RESULT(TEST_GetSubDocument(
+      doc_key.Encode(), doc_db(), rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(4000_usec_ht),
+      &projection));
+  ASSERT_FALSE(doc);
+
+  doc = ASSERT_RESULT(TEST_GetSubDocument(
+      doc_key.Encode(), doc_db(), rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(1500_usec_ht),
+      &projection));
+  ASSERT_TRUE(doc);
+  ASSERT_EQ("\"a\"", ChildToString(*doc, column_a));
+}
+
+// A packed row written with a schema version newer than the one of the reader is rejected.
+TEST_F(DocDBTestQl, PackedRowSchemaVersion) {
+  constexpr uint32_t kSchemaVersion = 2;
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key = doc_key.Encode();
+  RowPacker packer(kSchemaVersion);
+  packer.AddValue(ColumnId(kFirstColumnId), PrimitiveValue("a"));
+  ASSERT_NO_FATALS(InsertPackedRow(doc_key, &packer, 1000_usec_ht));
+
+  for (auto schema_version : {kSchemaVersion - 1, kSchemaVersion, kSchemaVersion + 1}) {
+    auto iter = CreateIntentAwareIterator(
+        doc_db(), BloomFilterMode::USE_BLOOM_FILTER, encoded_doc_key.AsSlice(),
+        rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(2000_usec_ht));
+    iter->SeekToLastDocKey();
+    DocDBTableReader doc_reader(iter.get(), CoarseTimePoint::max() /* deadline */);
+    doc_reader.EnablePackedRows(schema_version);
+    SubDocument result;
+    auto doc_found = doc_reader.Get(encoded_doc_key, nullptr /* projection */, &result);
+    if (schema_version < kSchemaVersion) {
+      ASSERT_NOK(doc_found);
+      ASSERT_EQ(PgsqlRequestStatus(doc_found.status()),
+                PgsqlResponsePB::PGSQL_STATUS_SCHEMA_VERSION_MISMATCH) << doc_found.status();
+    } else {
+      ASSERT_TRUE(ASSERT_RESULT(std::move(doc_found)));
+    }
+  }
+}
+
+// Compaction removes values of dropped columns from packed rows.
+TEST_F(DocDBTestQl, PackedRowDroppedColumn) {
+  const DocKey doc_key(PrimitiveValues("mydockey", 123456));
+  const KeyBytes encoded_doc_key = doc_key.Encode();
+  const PrimitiveValue column_a(ColumnId(kFirstColumnId + 0));
+  const PrimitiveValue column_b(ColumnId(kFirstColumnId + 1));
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(column_a.GetColumnId(), PrimitiveValue("a"));
+  packer.AddValue(column_b.GetColumnId(), PrimitiveValue(1));
+  ASSERT_NO_FATALS(InsertPackedRow(doc_key, &packer, 1000_usec_ht));
+
+  retention_policy_->AddDeletedColumn(column_b.GetColumnId());
+  FullyCompactHistoryBefore(2000_usec_ht);
+
+  const vector<PrimitiveValue> projection = {
+      PrimitiveValue::kLivenessColumn, column_a, column_b };
+  auto doc = ASSERT_RESULT(TEST_GetSubDocument(
+      encoded_doc_key, doc_db(), rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(3000_usec_ht),
+      &projection));
+  ASSERT_TRUE(doc);
+  ASSERT_NE("NULL", ChildToString(*doc, PrimitiveValue::kLivenessColumn));
+  ASSERT_EQ("\"a\"", ChildToString(*doc, column_a));
+  ASSERT_EQ("NULL", ChildToString(*doc, column_b));
+}
+
 TEST_F(DocDBTestQl, ColocatedTableTombstoneTest) {
   constexpr PgTableOid pgtable_id(0x4001);
   DocKey doc_key_1(PrimitiveValues("mydockey", 123456));
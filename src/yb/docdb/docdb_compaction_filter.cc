@@ -21,6 +21,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/key_bounds.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/value_type.h"
 
@@ -224,6 +225,23 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
       value_slice.FirstByteOr(ValueTypeAsChar::kInvalid));
   const Expiration curr_exp(ht.hybrid_time(), value.ttl());
 
+  // Packed rows store values of all columns at the root of the row, so values of deleted columns
+  // should be removed from them as well.
+  std::string packed_row_buffer;
+  bool packed_row_changed = false;
+  if (value_type == ValueType::kPackedRow && sub_key_ends_.size() == 1 &&
+      !retention_.deleted_cols->empty()) {
+    const auto& deleted_cols = *retention_.deleted_cols;
+    packed_row_changed = VERIFY_RESULT(RepackWithoutColumns(
+        value_slice, [&deleted_cols](ColumnId column_id) {
+          return deleted_cols.count(column_id) != 0;
+        },
+        &packed_row_buffer));
+    if (packed_row_changed) {
+      value_slice = packed_row_buffer;
+    }
+  }
+
   // If within the merge block.
   //     If the row is a TTL row, delete it.
   //     Otherwise, replace it with the cached TTL (i.e., apply merge).
@@ -292,6 +310,13 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     // We are reusing the existing encoded value without decoding/encoding it.
     value.EncodeAndAppend(new_value, &value_slice);
     within_merge_block_ = false;
+  } else if (packed_row_changed) {
+    if (value.intent_doc_ht().is_valid() && ht.hybrid_time() < history_cutoff) {
+      value.ClearIntentDocHt();
+    }
+    *value_changed = true;
+    new_value->clear();
+    value.EncodeAndAppend(new_value, &value_slice);
   } else if (value.intent_doc_ht().is_valid() && ht.hybrid_time() < history_cutoff) {
     // Cleanup intent doc hybrid time when we don't need it anymore.
     // See https://github.com/yugabyte/yugabyte-db/issues/4535 for details.
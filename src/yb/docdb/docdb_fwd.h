@@ -23,6 +23,7 @@
 namespace yb {
 namespace docdb {
 
+class ColumnarRowBatch;
 class ConsensusFrontier;
 class DeadlineInfo;
 class DocDBCompactionFilterFactory;
@@ -34,6 +35,7 @@ class DocWriteBatch;
 class HistoryRetentionPolicy;
 class IntentAwareIterator;
 class KeyBytes;
+class LockBatch;
 class ManualHistoryRetentionPolicy;
 class PgsqlWriteOperation;
 class PrimitiveValue;
@@ -41,6 +43,8 @@ class QLWriteOperation;
 class RedisWriteOperation;
 class SharedLockManager;
 class SubDocKey;
+class WaitForGraph;
+class WaitQueue;
 class YQLRowwiseIteratorIf;
 class YQLStorageIf;
 
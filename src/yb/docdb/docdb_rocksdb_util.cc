@@ -121,6 +121,19 @@ DEFINE_string(
     "Key-value encoding to use for regular data blocks in RocksDB. Possible options: "
     "shared_prefix, three_shared_parts");
 
+DEFINE_string(
+    regular_tablets_index_block_key_value_encoding, "shared_prefix",
+    "Key-value encoding to use for multi-level data index blocks in RocksDB. Only matters when "
+    "index_block_restart_interval is greater than 1. Possible options: "
+    "shared_prefix, three_shared_parts");
+TAG_FLAG(regular_tablets_index_block_key_value_encoding, advanced);
+
+DEFINE_string(
+    regular_tablets_memtable_rep, "skiplist",
+    "Memtable representation to use for regular RocksDB of tablets. Possible options: skiplist, "
+    "art (adaptive radix tree, efficient for DocDB keys with long common prefixes).");
+TAG_FLAG(regular_tablets_memtable_rep, advanced);
+
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
 DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved small compaction "
@@ -138,9 +151,31 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_string(bottommost_compression_type, "",
+              "On-disk compression type to use for files produced by compactions that include the "
+              "oldest data of the tablet. Such files contain cold data, so it could be compressed "
+              "with a stronger compression, for instance ZSTD, while recently flushed files stay "
+              "on a fast one. Empty value means that compression_type is used.");
+TAG_FLAG(bottommost_compression_type, advanced);
+
+DEFINE_int32(compression_max_dict_bytes, 0,
+             "Maximum size of dictionary that is built per SST file to compress its data "
+             "blocks. Only used by ZSTD compression. 0 disables dictionary compression.");
+TAG_FLAG(compression_max_dict_bytes, advanced);
+
+DEFINE_int32(compression_dict_train_bytes, 0,
+             "Amount of data blocks used to train the compression dictionary. If 0, the first "
+             "compression_max_dict_bytes of data are used as the dictionary without training.");
+TAG_FLAG(compression_dict_train_bytes, advanced);
+
 DEFINE_int32(block_restart_interval, kDefaultBlockStartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
+DEFINE_int32(index_block_restart_interval, kMinBlockStartInterval,
+             "Controls the number of keys to look at for computing the diff encoding of index "
+             "blocks. 1 to store every index key fully.");
+TAG_FLAG(index_block_restart_interval, advanced);
+
 namespace yb {
 
 namespace {
@@ -153,7 +188,8 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
     rocksdb::kNoCompression,
     rocksdb::kSnappyCompression,
     rocksdb::kZlibCompression,
-    rocksdb::kLZ4Compression
+    rocksdb::kLZ4Compression,
+    rocksdb::kZSTD
   };
   for (const auto& compression_type : kValidRocksDBCompressionTypes) {
     if (flag_value == rocksdb::CompressionTypeToString(compression_type)) {
@@ -182,6 +218,18 @@ Result<rocksdb::KeyValueEncodingFormat> GetConfiguredKeyValueEncodingFormat(
   return STATUS_FORMAT(InvalidArgument, "Key-value encoding format $0 is not valid.", flag_value);
 }
 
+Result<std::shared_ptr<rocksdb::MemTableRepFactory>> GetConfiguredMemTableRepFactory(
+    const std::string& flag_value) {
+  if (flag_value == "skiplist") {
+    return std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  }
+  if (flag_value == "art") {
+    return std::make_shared<rocksdb::AdaptiveRadixTreeFactory>();
+  }
+  return STATUS_FORMAT(InvalidArgument, "Memtable representation $0 is not valid.", flag_value);
+}
+
 } // namespace docdb
 
 } // namespace yb
@@ -208,12 +256,33 @@ bool KeyValueEncodingFormatValidator(const char* flag_name, const std::string& f
   return ok;
 }
 
+bool MemTableRepValidator(const char* flag_name, const std::string& flag_value) {
+  auto res = yb::docdb::GetConfiguredMemTableRepFactory(flag_value);
+  bool ok = res.ok();
+  if (!ok) {
+    LOG(ERROR) << flag_name << ": " << res.status();
+  }
+  return ok;
+}
+
+bool BottommostCompressionTypeValidator(
+    const char* flagname, const std::string& flag_compression_type) {
+  return flag_compression_type.empty() ||
+         CompressionTypeValidator(flagname, flag_compression_type);
+}
+
 } // namespace
 
 __attribute__((unused))
 DEFINE_validator(compression_type, &CompressionTypeValidator);
 __attribute__((unused))
+DEFINE_validator(bottommost_compression_type, &BottommostCompressionTypeValidator);
+__attribute__((unused))
 DEFINE_validator(regular_tablets_data_block_key_value_encoding, &KeyValueEncodingFormatValidator);
+__attribute__((unused))
+DEFINE_validator(regular_tablets_index_block_key_value_encoding, &KeyValueEncodingFormatValidator);
+__attribute__((unused))
+DEFINE_validator(regular_tablets_memtable_rep, &MemTableRepValidator);
 
 using std::shared_ptr;
 using std::string;
@@ -454,6 +523,10 @@ void AutoInitFromBlockBasedTableOptions(rocksdb::BlockBasedTableOptions* table_o
     } else {
       table_options->block_restart_interval = FLAGS_block_restart_interval;
     }
+
+  table_options->index_block_restart_interval = std::min(
+      std::max(FLAGS_index_block_restart_interval, kMinBlockStartInterval),
+      kMaxBlockStartInterval);
 }
 
 class HybridTimeFilteringIterator : public rocksdb::FilteringIterator {
@@ -589,6 +662,12 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  if (!FLAGS_bottommost_compression_type.empty()) {
+    options->bottommost_compression = CHECK_RESULT(
+        GetConfiguredCompressionType(FLAGS_bottommost_compression_type));
+  }
+  options->compression_opts.max_dict_bytes = FLAGS_compression_max_dict_bytes;
+  options->compression_opts.zstd_max_train_bytes = FLAGS_compression_dict_train_bytes;
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
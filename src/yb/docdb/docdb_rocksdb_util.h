@@ -108,6 +108,11 @@ rocksdb::BlockBasedTableOptions TEST_AutoInitFromRocksDbTableFlags();
 Result<rocksdb::KeyValueEncodingFormat> GetConfiguredKeyValueEncodingFormat(
     const std::string& flag_value);
 
+// Returns memtable factory for memtable representation name, as specified in
+// regular_tablets_memtable_rep flag.
+Result<std::shared_ptr<rocksdb::MemTableRepFactory>> GetConfiguredMemTableRepFactory(
+    const std::string& flag_value);
+
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
@@ -50,6 +50,27 @@ void LockBatch::Reset() {
   }
 }
 
+void LockBatch::Unlock() {
+  DCHECK(data_.unlocked_key_to_type.empty());
+  if (!empty()) {
+    VLOG(1) << "Temporarily unlocking a LockBatch with " << size() << " keys";
+    DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    data_.unlocked_key_to_type = std::move(data_.key_to_type);
+    data_.key_to_type.clear();
+  }
+}
+
+bool LockBatch::TryRelock() {
+  DCHECK(empty());
+  if (!data_.unlocked_key_to_type.empty() &&
+      !DCHECK_NOTNULL(data_.shared_lock_manager)->TryLock(&data_.unlocked_key_to_type)) {
+    return false;
+  }
+  data_.key_to_type = std::move(data_.unlocked_key_to_type);
+  data_.unlocked_key_to_type.clear();
+  return true;
+}
+
 void LockBatch::MoveFrom(LockBatch* other) {
   Reset();
   data_ = std::move(other->data_);
@@ -74,6 +74,15 @@ class LockBatch {
   // Unlocks this batch if it is non-empty.
   void Reset();
 
+  // Releases the locks, but remembers the locked keys, so the same keys could be locked again using
+  // TryRelock. The batch is empty after this call.
+  void Unlock();
+
+  // Locks keys that were released by Unlock, without waiting for other batches. Returns false if
+  // some of the keys are locked by other batches, in this case the batch remains empty and
+  // TryRelock could be called again later.
+  MUST_USE_RESULT bool TryRelock();
+
  private:
   void MoveFrom(LockBatch* other);
 
@@ -90,6 +99,9 @@ class LockBatch {
 
     LockBatchEntries key_to_type;
 
+    // Keys released by Unlock.
+    LockBatchEntries unlocked_key_to_type;
+
     SharedLockManager* shared_lock_manager = nullptr;
 
     Status status;
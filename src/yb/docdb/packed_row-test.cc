@@ -0,0 +1,108 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/random.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PackedRowTest : public YBTest {
+};
+
+TEST_F(PackedRowTest, TestEncodeDecode) {
+  constexpr int kNumColumns = 50;
+  Random r(0);
+  RowPacker packer(/* schema_version= */ 3);
+  std::vector<PrimitiveValue> expected(kNumColumns);
+  // Add columns in reverse order to make sure that packer sorts them. Skip every third column to
+  // emulate NULL values.
+  for (int i = kNumColumns; i-- > 0;) {
+    if (i % 3 == 0) {
+      continue;
+    }
+    if (i % 2 == 0) {
+      expected[i] = PrimitiveValue(static_cast<int64_t>(r.Next64()));
+    } else {
+      expected[i] = PrimitiveValue(RandomHumanReadableString(i, &r));
+    }
+    packer.AddValue(ColumnId(kFirstColumnId + i), expected[i]);
+  }
+  auto packed = packer.Complete();
+  ASSERT_EQ(ValueType::kPackedRow, DecodeValueType(packed));
+
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed));
+  ASSERT_EQ(3U, decoder.schema_version());
+  ASSERT_EQ(kNumColumns - (kNumColumns + 2) / 3U, decoder.num_columns());
+  for (int i = 0; i != kNumColumns; ++i) {
+    PrimitiveValue value;
+    auto found = ASSERT_RESULT(decoder.DecodeValue(ColumnId(kFirstColumnId + i), &value));
+    ASSERT_EQ(i % 3 != 0, found) << "Column: " << i;
+    if (found) {
+      ASSERT_EQ(expected[i], value);
+    }
+  }
+  // Column that was never added, e.g. added by ALTER TABLE after the row was written.
+  ASSERT_FALSE(decoder.GetValue(ColumnId(kFirstColumnId + kNumColumns)));
+}
+
+TEST_F(PackedRowTest, TestEmptyAndCorrupted) {
+  auto packed = RowPacker(/* schema_version= */ 0).Complete();
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed));
+  ASSERT_EQ(0U, decoder.num_columns());
+  ASSERT_FALSE(decoder.GetValue(ColumnId(kFirstColumnId)));
+
+  RowPacker packer(/* schema_version= */ 1);
+  packer.AddValue(ColumnId(kFirstColumnId), PrimitiveValue("value"));
+  packed = packer.Complete();
+  ASSERT_NOK(decoder.Init(Slice(packed.data(), packed.size() - 1)));
+  ASSERT_NOK(decoder.Init(Slice(packed.data(), 4)));
+}
+
+TEST_F(PackedRowTest, TestRepackWithoutColumns) {
+  RowPacker packer(/* schema_version= */ 2);
+  for (int i = 0; i != 4; ++i) {
+    packer.AddValue(ColumnId(kFirstColumnId + i), PrimitiveValue(i));
+  }
+  const auto packed = packer.Complete();
+  const auto is_odd = [](ColumnId column_id) { return (column_id - kFirstColumnId) % 2 != 0; };
+
+  std::string repacked;
+  ASSERT_TRUE(ASSERT_RESULT(RepackWithoutColumns(packed, is_odd, &repacked)));
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(repacked));
+  ASSERT_EQ(2U, decoder.schema_version());
+  ASSERT_EQ(2U, decoder.num_columns());
+  for (int i = 0; i != 4; ++i) {
+    PrimitiveValue value;
+    auto found = ASSERT_RESULT(decoder.DecodeValue(ColumnId(kFirstColumnId + i), &value));
+    ASSERT_EQ(i % 2 == 0, found) << "Column: " << i;
+    if (found) {
+      ASSERT_EQ(PrimitiveValue(i), value);
+    }
+  }
+
+  // Nothing to remove, so the packed row is kept as is.
+  std::string unchanged;
+  ASSERT_FALSE(ASSERT_RESULT(RepackWithoutColumns(repacked, is_odd, &unchanged)));
+  ASSERT_TRUE(unchanged.empty());
+}
+
+}  // namespace docdb
+}  // namespace yb
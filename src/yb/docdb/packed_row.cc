@@ -0,0 +1,180 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/coding.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Type byte, schema version and number of columns.
+constexpr size_t kPackedRowHeaderSize = 1 + 2 * sizeof(uint32_t);
+
+// Column id and end offset.
+constexpr size_t kPackedRowBytesPerColumn = 2 * sizeof(uint32_t);
+
+void AppendFixed32(uint32_t value, std::string* out) {
+  uint8_t buf[sizeof(uint32_t)];
+  EncodeFixed32(buf, value);
+  out->append(reinterpret_cast<const char*>(buf), sizeof(buf));
+}
+
+} // namespace
+
+RowPacker::RowPacker(uint32_t schema_version) : schema_version_(schema_version) {
+}
+
+void RowPacker::AddValue(ColumnId column_id, const PrimitiveValue& value) {
+  DCHECK(IsPrimitiveValueType(value.value_type())) << value.ToString();
+  values_.emplace_back(column_id, value.ToValue());
+}
+
+void RowPacker::AddEncodedValue(ColumnId column_id, const Slice& encoded_value) {
+  values_.emplace_back(column_id, encoded_value.ToBuffer());
+}
+
+std::string RowPacker::Complete() {
+  std::sort(values_.begin(), values_.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  size_t values_size = 0;
+  for (const auto& p : values_) {
+    values_size += p.second.size();
+  }
+
+  std::string result;
+  result.reserve(kPackedRowHeaderSize + values_.size() * kPackedRowBytesPerColumn + values_size);
+  result.push_back(ValueTypeAsChar::kPackedRow);
+  AppendFixed32(schema_version_, &result);
+  AppendFixed32(static_cast<uint32_t>(values_.size()), &result);
+  for (const auto& p : values_) {
+    AppendFixed32(static_cast<uint32_t>(p.first.rep()), &result);
+  }
+  uint32_t end_offset = 0;
+  for (const auto& p : values_) {
+    end_offset += static_cast<uint32_t>(p.second.size());
+    AppendFixed32(end_offset, &result);
+  }
+  for (const auto& p : values_) {
+    result.append(p.second);
+  }
+  values_.clear();
+  return result;
+}
+
+Status PackedRowDecoder::Init(const Slice& packed_value) {
+  if (packed_value.size() < kPackedRowHeaderSize || !IsPackedRow(packed_value)) {
+    return STATUS_FORMAT(
+        Corruption, "Invalid packed row header: $0", packed_value.ToDebugHexString());
+  }
+  const uint8_t* p = packed_value.data() + 1;
+  schema_version_ = DecodeFixed32(p);
+  num_columns_ = DecodeFixed32(p + sizeof(uint32_t));
+  if (num_columns_ * kPackedRowBytesPerColumn > packed_value.size() - kPackedRowHeaderSize) {
+    return STATUS_FORMAT(
+        Corruption, "Packed row with $0 columns does not fit into $1 bytes",
+        num_columns_, packed_value.size());
+  }
+  header_ = p + 2 * sizeof(uint32_t);
+  values_ = header_ + num_columns_ * kPackedRowBytesPerColumn;
+  values_size_ = packed_value.end() - values_;
+  if (num_columns_ && EndOffsetAt(num_columns_ - 1) != values_size_) {
+    return STATUS_FORMAT(
+        Corruption, "Packed row values size mismatch: $0 vs $1",
+        EndOffsetAt(num_columns_ - 1), values_size_);
+  }
+  return Status::OK();
+}
+
+uint32_t PackedRowDecoder::ColumnIdAt(size_t idx) const {
+  return DecodeFixed32(header_ + idx * sizeof(uint32_t));
+}
+
+uint32_t PackedRowDecoder::EndOffsetAt(size_t idx) const {
+  return DecodeFixed32(header_ + (num_columns_ + idx) * sizeof(uint32_t));
+}
+
+boost::optional<Slice> PackedRowDecoder::GetValue(ColumnId column_id) const {
+  // Column ids are sorted, so binary search them in place without materializing the header.
+  size_t lo = 0;
+  size_t hi = num_columns_;
+  const auto target = static_cast<uint32_t>(column_id.rep());
+  while (lo < hi) {
+    const size_t mid = (lo + hi) / 2;
+    if (ColumnIdAt(mid) < target) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == num_columns_ || ColumnIdAt(lo) != target) {
+    return boost::none;
+  }
+  return value(lo);
+}
+
+ColumnId PackedRowDecoder::column_id(size_t idx) const {
+  return ColumnId(static_cast<ColumnIdRep>(ColumnIdAt(idx)));
+}
+
+Slice PackedRowDecoder::value(size_t idx) const {
+  const uint32_t begin = idx == 0 ? 0 : EndOffsetAt(idx - 1);
+  return Slice(values_ + begin, values_ + EndOffsetAt(idx));
+}
+
+Result<bool> PackedRowDecoder::DecodeValue(ColumnId column_id, PrimitiveValue* out) const {
+  auto value = GetValue(column_id);
+  if (!value) {
+    return false;
+  }
+  RETURN_NOT_OK(out->DecodeFromValue(*value));
+  return true;
+}
+
+Result<bool> RepackWithoutColumns(
+    const Slice& packed_value, const std::function<bool(ColumnId)>& should_remove,
+    std::string* out) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_value));
+  size_t idx = 0;
+  while (idx != decoder.num_columns() && !should_remove(decoder.column_id(idx))) {
+    ++idx;
+  }
+  if (idx == decoder.num_columns()) {
+    return false;
+  }
+  RowPacker packer(decoder.schema_version());
+  for (idx = 0; idx != decoder.num_columns(); ++idx) {
+    const auto column_id = decoder.column_id(idx);
+    if (!should_remove(column_id)) {
+      packer.AddEncodedValue(column_id, decoder.value(idx));
+    }
+  }
+  *out = packer.Complete();
+  return true;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H
+#define YB_DOCDB_PACKED_ROW_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "yb/common/column_id.h"
+
+#include "yb/docdb/docdb_fwd.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// A packed row stores all non-key columns of a single row version as one RocksDB value, written at
+// the root DocKey of the row instead of one key/value pair per column.
+//
+// Encoding (all integers are little endian fixed 32 bit):
+//   ValueType::kPackedRow
+//   schema version
+//   number of stored columns N
+//   N column ids, sorted in ascending order
+//   N end offsets of the column values, relative to the start of the value area
+//   value area: concatenation of the column values encoded with PrimitiveValue::ToValue()
+//
+// Columns that are NULL are not stored at all. The header is self describing, so a row packed with
+// an older schema version could be decoded without access to that schema: dropped columns are
+// simply never projected and added columns are missing, i.e. NULL.
+class RowPacker {
+ public:
+  explicit RowPacker(uint32_t schema_version);
+
+  // Adds a column value. Columns could be added in any order, but each column at most once.
+  void AddValue(ColumnId column_id, const PrimitiveValue& value);
+
+  // Adds a column value that is already encoded with PrimitiveValue::ToValue().
+  void AddEncodedValue(ColumnId column_id, const Slice& encoded_value);
+
+  // Returns the encoded packed row. The packer should not be used after this call.
+  std::string Complete();
+
+ private:
+  uint32_t schema_version_;
+  std::vector<std::pair<ColumnId, std::string>> values_;
+};
+
+// Provides random access to the column values of an encoded packed row. The decoder does not own
+// the underlying data, so the packed value should outlive it.
+class PackedRowDecoder {
+ public:
+  PackedRowDecoder() = default;
+
+  // Validates the header of the provided packed value and prepares it for column lookups.
+  CHECKED_STATUS Init(const Slice& packed_value);
+
+  uint32_t schema_version() const { return schema_version_; }
+
+  size_t num_columns() const { return num_columns_; }
+
+  // Returns the id of the column stored at the specified position, idx < num_columns().
+  ColumnId column_id(size_t idx) const;
+
+  // Returns the encoded value of the column stored at the specified position, idx < num_columns().
+  Slice value(size_t idx) const;
+
+  // Returns the encoded value of the specified column, or boost::none if the column was not stored
+  // in this row, i.e. it is NULL.
+  boost::optional<Slice> GetValue(ColumnId column_id) const;
+
+  // Decodes the value of the specified column. Returns false if the column is not present.
+  Result<bool> DecodeValue(ColumnId column_id, PrimitiveValue* out) const;
+
+ private:
+  uint32_t ColumnIdAt(size_t idx) const;
+  uint32_t EndOffsetAt(size_t idx) const;
+
+  const uint8_t* header_ = nullptr;
+  const uint8_t* values_ = nullptr;
+  size_t values_size_ = 0;
+  uint32_t schema_version_ = 0;
+  size_t num_columns_ = 0;
+};
+
+// Encodes packed_value without the columns matching should_remove into out. Returns false, leaving
+// out untouched, if none of the stored columns match, so the packed row could be kept as is.
+Result<bool> RepackWithoutColumns(
+    const Slice& packed_value, const std::function<bool(ColumnId)>& should_remove,
+    std::string* out);
+
+inline bool IsPackedRow(const Slice& value) {
+  return !value.empty() && value[0] == ValueTypeAsChar::kPackedRow;
+}
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H
@@ -24,6 +24,8 @@
 #include "yb/common/pg_system_attr.h"
 #include "yb/common/ql_value.h"
 
+#include "yb/docdb/column_aggregate.h"
+#include "yb/docdb/column_batch.h"
 #include "yb/docdb/doc_path.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
@@ -33,6 +35,7 @@
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/ql_storage_interface.h"
 
@@ -56,6 +59,17 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ysql_enable_batch_aggregate, true,
+            "Whether simple aggregates pushed down to DocDB (COUNT, SUM, MIN and MAX of fixed-width "
+            "columns without a WHERE condition) should be evaluated over columnar row batches "
+            "instead of row by row.");
+TAG_FLAG(ysql_enable_batch_aggregate, advanced);
+TAG_FLAG(ysql_enable_batch_aggregate, runtime);
+
+DEFINE_int32(ysql_batch_aggregate_rows, 1024,
+             "Number of rows read into a single columnar batch by the batch aggregate evaluation.");
+TAG_FLAG(ysql_batch_aggregate_rows, advanced);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -409,10 +423,17 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     }
   }
 
-  RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
-      DocPath(encoded_doc_key_.as_slice(), PrimitiveValue::kLivenessColumn),
-      Value(PrimitiveValue()),
-      data.read_time, data.deadline, request_.stmt_id()));
+  // Upserts could overwrite only some columns of an existing row, so only plain inserts are
+  // packed. The packed row implies the liveness column.
+  boost::optional<RowPacker> packer;
+  if (!is_upsert && schema_.table_properties().packed_row()) {
+    packer.emplace(request_.schema_version());
+  } else {
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+        DocPath(encoded_doc_key_.as_slice(), PrimitiveValue::kLivenessColumn),
+        Value(PrimitiveValue()),
+        data.read_time, data.deadline, request_.stmt_id()));
+  }
 
   for (const auto& column_value : request_.column_values()) {
     // Get the column.
@@ -432,12 +453,29 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     const SubDocument sub_doc =
         SubDocument::FromQLValuePB(expr_result.Value(), column.sorting_type());
 
+    if (packer) {
+      // NULL columns are not stored in the packed row.
+      if (sub_doc.value_type() != ValueType::kTombstone) {
+        RSTATUS_DCHECK(IsPrimitiveValueType(sub_doc.value_type()), IllegalState,
+                       Format("Cannot pack non primitive value of column $0", column_id));
+        packer->AddValue(column_id, sub_doc);
+      }
+      continue;
+    }
+
     // Inserting into specified column.
     DocPath sub_path(encoded_doc_key_.as_slice(), PrimitiveValue(column_id));
     RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
         sub_path, sub_doc, data.read_time, data.deadline, request_.stmt_id()));
   }
 
+  if (packer) {
+    // The key in the key/value batch does not have an encoded HybridTime.
+    auto& entry = data.doc_write_batch->AddRaw();
+    entry.first = encoded_doc_key_.as_slice().ToBuffer();
+    entry.second = packer->Complete();
+  }
+
   RETURN_NOT_OK(PopulateResultSet(table_row));
 
   response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
@@ -932,8 +970,25 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
-  while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
+
+  ColumnarRowBatch batch;
+  std::vector<int> batch_targets;
+  if (VERIFY_RESULT(PrepareBatchAggregate(schema, &batch, &batch_targets))) {
+    const size_t batch_rows = std::max(FLAGS_ysql_batch_aggregate_rows, 1);
+    while (!scan_time_exceeded) {
+      batch.Clear();
+      const auto num_rows = VERIFY_RESULT(iter->NextBatch(batch_rows, &batch));
+      if (num_rows == 0) {
+        break;
+      }
+      RETURN_NOT_OK(EvalBatchAggregate(batch, batch_targets));
+      match_count += static_cast<int>(num_rows);
+      scan_time_exceeded = CoarseMonoClock::now() >= deadline;
+    }
+  }
+
+  while (batch_targets.empty() && fetched_rows < row_count_limit &&
+         VERIFY_RESULT(iter->HasNext()) && !scan_time_exceeded) {
     row.Clear();
 
     // If there is an index request, fetch ybbasectid from the index and use it as ybctid
@@ -1108,6 +1163,94 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
   return Status::OK();
 }
 
+Result<bool> PgsqlReadOperation::PrepareBatchAggregate(
+    const Schema& schema, ColumnarRowBatch* batch, std::vector<int>* batch_targets) {
+  if (!FLAGS_ysql_enable_batch_aggregate || !request_.is_aggregate() ||
+      request_.has_where_expr() || request_.has_index_request() || request_.targets().empty()) {
+    return false;
+  }
+
+  std::vector<int> targets;
+  targets.reserve(request_.targets().size());
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    if (!expr.has_tscall() || expr.tscall().operands().size() != 1) {
+      return false;
+    }
+    const auto opcode = static_cast<bfpg::TSOpcode>(expr.tscall().opcode());
+    const auto& operand = expr.tscall().operands(0);
+    switch (opcode) {
+      case bfpg::TSOpcode::kCount:
+        if (operand.has_value() && !QLValue::IsNull(operand.value())) {
+          // COUNT(*) or COUNT of a non NULL constant.
+          targets.push_back(-1);
+          continue;
+        }
+        break;
+      case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt64: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumFloat: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumDouble: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kMin: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kMax:
+        break;
+      default:
+        return false;
+    }
+    if (!operand.has_column_id()) {
+      return false;
+    }
+    const ColumnId column_id(operand.column_id());
+    int idx = batch->ColumnIndex(column_id);
+    if (idx < 0) {
+      // Operands that are not regular columns of the table, e.g. system columns, are aggregated
+      // row by row.
+      const int column_idx = schema.find_column_by_id(column_id);
+      if (column_idx == Schema::kColumnNotFound ||
+          !ColumnVector::IsSupportedType(schema.column(column_idx).type()->main())) {
+        return false;
+      }
+      RETURN_NOT_OK(batch->AddColumn(schema, column_id));
+      idx = static_cast<int>(batch->num_columns()) - 1;
+    }
+    targets.push_back(idx);
+  }
+
+  if (aggr_result_.empty()) {
+    aggr_result_.resize(request_.targets().size());
+  }
+  *batch_targets = std::move(targets);
+  return true;
+}
+
+Status PgsqlReadOperation::EvalBatchAggregate(
+    const ColumnarRowBatch& batch, const std::vector<int>& batch_targets) {
+  for (size_t i = 0; i != batch_targets.size(); ++i) {
+    auto& result = aggr_result_[i].ForceNewValue();
+    if (batch_targets[i] < 0) {
+      AggregateCountRows(batch.num_rows(), &result);
+      continue;
+    }
+    const auto& column = batch.column(batch_targets[i]);
+    switch (static_cast<bfpg::TSOpcode>(request_.targets(i).tscall().opcode())) {
+      case bfpg::TSOpcode::kCount:
+        AggregateCount(column, &result);
+        break;
+      case bfpg::TSOpcode::kMin:
+        RETURN_NOT_OK(AggregateMin(column, &result));
+        break;
+      case bfpg::TSOpcode::kMax:
+        RETURN_NOT_OK(AggregateMax(column, &result));
+        break;
+      default:
+        RETURN_NOT_OK(AggregateSum(column, &result));
+        break;
+    }
+  }
+  return Status::OK();
+}
+
 Status PgsqlReadOperation::PopulateAggregate(const QLTableRow& table_row,
                                              faststring *result_buffer) {
   int column_count = request_.targets().size();
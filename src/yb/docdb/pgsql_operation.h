@@ -191,6 +191,17 @@ class PgsqlReadOperation : public DocExprExecutor {
 
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
 
+  // Checks whether all targets of the request are aggregates that could be evaluated over columnar
+  // batches, i.e. COUNT, SUM, MIN and MAX of fixed-width columns without a WHERE condition. If so,
+  // adds the referenced columns to batch and fills batch_targets with the batch column index of
+  // each target (-1 for COUNT(*)).
+  Result<bool> PrepareBatchAggregate(
+      const Schema& schema, ColumnarRowBatch* batch, std::vector<int>* batch_targets);
+
+  // Merges all rows of the batch into the aggregate results.
+  CHECKED_STATUS EvalBatchAggregate(
+      const ColumnarRowBatch& batch, const std::vector<int>& batch_targets);
+
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
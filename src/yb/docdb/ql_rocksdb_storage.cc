@@ -121,6 +121,7 @@ Status QLRocksDBStorage::InitIterator(YQLRowwiseIteratorIf* iter,
   DocKey range_doc_key(schema);
   RETURN_NOT_OK(range_doc_key.DecodeFrom(ybctid.binary_value()));
   DocRowwiseIterator *doc_iter = static_cast<DocRowwiseIterator*>(iter);
+  doc_iter->set_schema_version(request.schema_version());
   RETURN_NOT_OK(doc_iter->Init(DocPgsqlScanSpec(schema, request.stmt_id(), range_doc_key)));
   return Status::OK();
 }
@@ -159,6 +160,7 @@ Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
 
   auto doc_iter = std::make_unique<DocRowwiseIterator>(
       projection, schema, txn_op_context, doc_db_, deadline, read_time);
+  doc_iter->set_schema_version(request.schema_version());
 
   if (range_components.size() == schema.num_range_key_columns()) {
     // Construct the scan spec basing on the RANGE condition as all range columns are specified.
@@ -13,6 +13,10 @@
 
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/common/ql_expr.h"
+
+#include "yb/docdb/column_batch.h"
+
 #include "yb/util/result.h"
 
 namespace yb {
@@ -30,6 +34,27 @@ Result<bool> YQLRowwiseIteratorIf::SeekTuple(const Slice& tuple_id) {
   return STATUS(NotSupported, "This iterator cannot seek by tuple id");
 }
 
+Result<size_t> YQLRowwiseIteratorIf::NextBatch(size_t max_rows, ColumnarRowBatch* batch) {
+  QLTableRow row;
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+    row.Clear();
+    RETURN_NOT_OK(NextRow(&row));
+    for (size_t i = 0; i != batch->num_columns(); ++i) {
+      auto* column = batch->mutable_column(i);
+      auto value = row.GetValue(column->column_id());
+      if (value) {
+        RETURN_NOT_OK(column->Append(*value));
+      } else {
+        RETURN_NOT_OK(column->Append(nullptr));
+      }
+    }
+    batch->RowAppended();
+    ++num_rows;
+  }
+  return num_rows;
+}
+
 Status YQLRowwiseIteratorIf::NextRow(const Schema& projection, QLTableRow* table_row) {
   return DoNextRow(projection, table_row);
 }
@@ -70,6 +70,11 @@ class YQLRowwiseIteratorIf {
   // Seeks to the given tuple by its id. See DocRowwiseIterator for details.
   virtual Result<bool> SeekTuple(const Slice& tuple_id);
 
+  // Reads up to max_rows next rows into the columns of the provided batch. Returns the number of
+  // rows read, zero means that there are no more rows.
+  // The default implementation reads rows one by one through NextRow.
+  virtual Result<size_t> NextBatch(size_t max_rows, ColumnarRowBatch* batch);
+
   //------------------------------------------------------------------------------------------------
   // Common API methods.
   //------------------------------------------------------------------------------------------------
@@ -122,6 +122,28 @@ TEST_F(SharedLockManagerTest, LockBatchReset) {
   EXPECT_TRUE(lb.empty());
 }
 
+TEST_F(SharedLockManagerTest, LockBatchUnlockRelock) {
+  LockBatch lb = TestLockBatch();
+  lb.Unlock();
+  EXPECT_TRUE(lb.empty());
+
+  // Keys are available for other batches while lb is unlocked.
+  LockBatch lb2 = TestLockBatch(CoarseMonoClock::now() + 10ms);
+  ASSERT_OK(lb2.status());
+  lb2.Unlock();
+
+  ASSERT_TRUE(lb.TryRelock());
+  EXPECT_EQ(2, lb.size());
+
+  // Keys are locked by lb, so lb2 fails without waiting and could retry later.
+  ASSERT_FALSE(lb2.TryRelock());
+  ASSERT_TRUE(lb2.empty());
+
+  lb.Reset();
+  ASSERT_TRUE(lb2.TryRelock());
+  EXPECT_EQ(2, lb2.size());
+}
+
 // Launch pairs of threads. Each pair tries to lock/unlock on the same key sequence.
 // This catches bug in SharedLockManager when condition is waited incorrectly.
 TEST_F(SharedLockManagerTest, QuickLockUnlock) {
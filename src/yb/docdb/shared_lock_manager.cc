@@ -25,12 +25,23 @@
 #include "yb/docdb/lock_batch.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/metrics.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+METRIC_DEFINE_coarse_histogram(
+    tablet, shared_lock_wait_time, "Shared lock wait time", yb::MetricUnit::kMicroseconds,
+    "Time spent waiting for conflicting in-memory key locks to be released, per key wait");
+METRIC_DEFINE_simple_counter(
+    tablet, shared_lock_waits, "Number of times a key lock had to wait for conflicting locks",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_counter(
+    tablet, shared_lock_timeouts, "Number of key locks that were not acquired until deadline",
+    yb::MetricUnit::kRequests);
+
 namespace yb {
 namespace docdb {
 
@@ -92,8 +103,17 @@ std::array<LockState, kIntentTypeSetMapSize> GenerateByMask(LockState single_int
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetAdd = GenerateByMask(1);
 
+// Number of independent parts of the key to lock entry map, should be power of 2.
+constexpr size_t kNumStripes = 16;
+
 } // namespace
 
+struct SharedLockManagerMetrics {
+  scoped_refptr<Histogram> wait_time;
+  scoped_refptr<Counter> waits;
+  scoped_refptr<Counter> timeouts;
+};
+
 bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
   for (auto intent1 : lhs) {
     for (auto intent2 : rhs) {
@@ -111,16 +131,20 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the stripe that owns
+  // this entry is locked.
   size_t ref_count = 0;
 
+  // Index of the lock manager stripe that owns this entry.
+  size_t stripe = 0;
+
   // Number of holders for each type
   std::atomic<LockState> num_holding{0};
 
   std::atomic<size_t> num_waiters{0};
 
-  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
+  MUST_USE_RESULT bool Lock(
+      IntentTypeSet lock, CoarseTimePoint deadline, const SharedLockManagerMetrics& metrics);
 
   void Unlock(IntentTypeSet lock);
 
@@ -137,29 +161,45 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+    metrics_.wait_time = METRIC_shared_lock_wait_time.Instantiate(metric_entity);
+    metrics_.waits = METRIC_shared_lock_waits.Instantiate(metric_entity);
+    metrics_.timeouts = METRIC_shared_lock_timeouts.Instantiate(metric_entity);
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      LOG_IF(DFATAL, !stripe.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(stripe.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Keys are distributed between stripes by hash, so batches that lock different keys don't
+  // contend on the same mutex while reserving and releasing entries.
+  struct Stripe {
+    // Taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  // Make sure the entries exist in the locks map of appropriate stripe and fill pointers to them
+  // in the batch, so we can access them without holding the stripe lock.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  std::array<Stripe, kNumStripes> stripes_;
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  SharedLockManagerMetrics metrics_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -184,19 +224,38 @@ std::string SharedLockManager::ToString(const LockState& state) {
   return result;
 }
 
-bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
+bool LockedBatchEntry::Lock(
+    IntentTypeSet lock_type, CoarseTimePoint deadline, const SharedLockManagerMetrics& metrics) {
   size_t type_idx = lock_type.ToUIntPtr();
   auto& num_holding = this->num_holding;
   auto old_value = num_holding.load(std::memory_order_acquire);
   auto add = kIntentTypeSetAdd[type_idx];
+  CoarseTimePoint wait_start;
+  auto record_wait = [&metrics, &wait_start] {
+    if (wait_start != CoarseTimePoint() && metrics.wait_time) {
+      metrics.wait_time->Increment(
+          MonoDelta(CoarseMonoClock::now() - wait_start).ToMicroseconds());
+    }
+  };
   for (;;) {
     if ((old_value & kIntentTypeSetConflicts[type_idx]) == 0) {
       auto new_value = old_value + add;
       if (num_holding.compare_exchange_weak(old_value, new_value, std::memory_order_acq_rel)) {
+        record_wait();
         return true;
       }
       continue;
     }
+    if (deadline == CoarseTimePoint::min()) {
+      // Try lock, should not wait for conflicting holders.
+      return false;
+    }
+    if (wait_start == CoarseTimePoint()) {
+      wait_start = CoarseMonoClock::now();
+      if (metrics.waits) {
+        metrics.waits->Increment();
+      }
+    }
     num_waiters.fetch_add(1, std::memory_order_release);
     auto se = ScopeExit([this] {
       num_waiters.fetch_sub(1, std::memory_order_release);
@@ -206,6 +265,10 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
     if ((old_value & kIntentTypeSetConflicts[type_idx]) != 0) {
       if (deadline != CoarseTimePoint::max()) {
         if (cond_var.wait_until(lock, deadline) == std::cv_status::timeout) {
+          record_wait();
+          if (metrics.timeouts) {
+            metrics.timeouts->Increment();
+          }
           return false;
         }
       } else {
@@ -263,7 +326,7 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
     const auto intent_types = key_and_intent_type.intent_types;
     VLOG(4) << "Locking " << yb::ToString(intent_types) << ": "
             << key_and_intent_type.key.as_slice().ToDebugHexString();
-    if (!key_and_intent_type.locked->Lock(intent_types, deadline)) {
+    if (!key_and_intent_type.locked->Lock(intent_types, deadline, metrics_)) {
       while (it != key_to_intent_type->begin()) {
         --it;
         it->locked->Unlock(it->intent_types);
@@ -278,16 +341,19 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto stripe_idx = RefCntPrefixHash()(key_and_intent_type.key) & (kNumStripes - 1);
+    auto& stripe = stripes_[stripe_idx];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto& value = stripe.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!stripe.free_lock_entries.empty()) {
+        value = stripe.free_lock_entries.back();
+        stripe.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        stripe.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = stripe.lock_entries.back().get();
+        value->stripe = stripe_idx;
       }
     }
     value->ref_count++;
@@ -306,11 +372,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& stripe = stripes_[item.locked->stripe];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      stripe.locks.erase(item.key);
+      stripe.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -324,9 +391,17 @@ bool SharedLockManager::Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoi
   return impl_->Lock(key_to_intent_type, deadline);
 }
 
+bool SharedLockManager::TryLock(LockBatchEntries* key_to_intent_type) {
+  return impl_->Lock(key_to_intent_type, CoarseTimePoint::min());
+}
+
 void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+void SharedLockManager::SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+  impl_->SetMetricEntity(metric_entity);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -21,6 +21,7 @@
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/intent.h"
 
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/monotime.h"
 
 namespace yb {
@@ -44,9 +45,17 @@ class SharedLockManager {
   // Returns false if was not able to acquire lock until deadline.
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
 
+  // Attempt to lock a batch of keys without waiting for other locks to be released.
+  //
+  // Returns false, with none of the keys locked, if some key is locked with a conflicting intent.
+  MUST_USE_RESULT bool TryLock(LockBatchEntries* key_to_intent_type);
+
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Enables lock wait metrics. Should be called before the first Lock.
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/subdoc_reader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -31,6 +32,7 @@
 #include "yb/docdb/expiration.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -227,7 +229,8 @@ Result<SubDocument*> LazySubDocumentHolder::Get() {
 // This class provides a wrapper to access data corresponding to a RocksDB row.
 class DocDbRowData {
  public:
-  DocDbRowData(const Slice& key, const DocHybridTime& write_time, Value&& value);
+  DocDbRowData(
+      const Slice& key, const DocHybridTime& write_time, Value&& value, std::string packed_row);
 
   static Result<std::unique_ptr<DocDbRowData>> CurrentRow(IntentAwareIterator* iter);
 
@@ -241,7 +244,15 @@ class DocDbRowData {
 
   bool IsCollection() const { return IsCollectionType(value_.value_type()); }
 
-  bool IsPrimitiveValue() const { return IsPrimitiveValueType(value_.value_type()); }
+  bool IsPrimitiveValue() const {
+    return !IsPackedRow() && IsPrimitiveValueType(value_.value_type());
+  }
+
+  bool IsPackedRow() const { return !packed_row_.empty(); }
+
+  // Encoded packed row, only valid if IsPackedRow() is true. Control fields are decoded into
+  // value().
+  const std::string& packed_row() const { return packed_row_; }
 
   PrimitiveValue* mutable_primitive_value() { return value_.mutable_primitive_value(); }
 
@@ -249,13 +260,15 @@ class DocDbRowData {
   const KeyBytes target_key_;
   const DocHybridTime write_time_;
   Value value_;
+  const std::string packed_row_;
 
   DISALLOW_COPY_AND_ASSIGN(DocDbRowData);
 };
 
 DocDbRowData::DocDbRowData(
-    const Slice& key, const DocHybridTime& write_time, Value&& value):
-    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)) {}
+    const Slice& key, const DocHybridTime& write_time, Value&& value, std::string packed_row):
+    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)),
+    packed_row_(std::move(packed_row)) {}
 
 Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterator* iter) {
   auto key_data = VERIFY_RESULT(iter->FetchKey());
@@ -268,13 +281,25 @@ Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterat
   // TODO -- we could optimize be decoding directly into a SubDocument instance on the heap which
   // could be later bound to our result SubDocument. This could work if e.g. Value could be
   // initialized with a PrimitiveValue*.
-  RETURN_NOT_OK(value.Decode(iter->value()));
+  Slice value_slice = iter->value();
+  RETURN_NOT_OK(value.DecodeControlFields(&value_slice));
+  std::string packed_row;
+  if (IsPackedRow(value_slice)) {
+    // The iterator's value could be invalidated by subsequent seeks, so keep a copy of the packed
+    // row to decode its columns after the records written after it are processed.
+    packed_row.assign(value_slice.cdata(), value_slice.size());
+  } else {
+    RETURN_NOT_OK_PREPEND(
+        value.mutable_primitive_value()->DecodeFromValue(value_slice),
+        Format("Failed to decode value in $0", iter->value().ToDebugHexString()));
+  }
 
   if (key_data.write_time == DocHybridTime::kMin) {
     return STATUS(Corruption, "No hybrid timestamp found on entry");
   }
 
-  return std::make_unique<DocDbRowData>(key_data.key, key_data.write_time, std::move(value));
+  return std::make_unique<DocDbRowData>(
+      key_data.key, key_data.write_time, std::move(value), std::move(packed_row));
 }
 
 // This class provides a convenience handle for modifying a SubDocument specified by a provided
@@ -295,6 +320,12 @@ class DocDbRowAssembler {
 
   CHECKED_STATUS SetPrimitiveValue(DocDbRowData* row);
 
+  // Adds the columns stored in the packed row as children of the constructed SubDocument, except
+  // for updated_columns, which were overwritten after the row was packed.
+  CHECKED_STATUS SetPackedColumns(
+      const PackedRowDecoder& decoder, const DocHybridTime& write_time,
+      const std::vector<ColumnId>& updated_columns);
+
   Result<bool> HasStoredValue();
 
  private:
@@ -342,6 +373,34 @@ Status DocDbRowAssembler::SetPrimitiveValue(DocDbRowData* row) {
   return Status::OK();
 }
 
+Status DocDbRowAssembler::SetPackedColumns(
+    const PackedRowDecoder& decoder, const DocHybridTime& write_time,
+    const std::vector<ColumnId>& updated_columns) {
+  auto* subdoc = VERIFY_RESULT(root_.Get());
+  const auto write_time_micros = write_time.hybrid_time().GetPhysicalValueMicros();
+
+  // Existence of the packed row implies existence of the liveness column.
+  auto liveness_column = subdoc->GetOrAddChild(PrimitiveValue::kLivenessColumn);
+  if (liveness_column.second) {
+    PrimitiveValue liveness_value;
+    liveness_value.SetWriteTime(write_time_micros);
+    *liveness_column.first = SubDocument(liveness_value);
+  }
+
+  for (size_t i = 0; i != decoder.num_columns(); ++i) {
+    const auto column_id = decoder.column_id(i);
+    if (std::find(updated_columns.begin(), updated_columns.end(), column_id) !=
+            updated_columns.end()) {
+      continue;
+    }
+    PrimitiveValue value;
+    RETURN_NOT_OK(value.DecodeFromValue(decoder.value(i)));
+    value.SetWriteTime(write_time_micros);
+    subdoc->SetChild(PrimitiveValue(column_id), SubDocument(value));
+  }
+  return Status::OK();
+}
+
 Result<bool> DocDbRowAssembler::HasStoredValue() {
   if (!root_.IsConstructed()) {
     return false;
@@ -401,6 +460,8 @@ class ScopedDocDbRowContext {
 
   const ObsolescenceTracker* obsolescence_tracker() const { return &obsolescence_tracker_; }
 
+  Slice key() const { return key_; }
+
   ScopedDocDbCollectionContext* collection();
 
   CHECKED_STATUS CheckDeadline();
@@ -594,6 +655,34 @@ Status MaybeReviveCollection(ScopedDocDbRowContextWithData* scope) {
   return Status::OK();
 }
 
+Status ProcessPackedRow(ScopedDocDbRowContextWithData* scope) {
+  auto data = scope->data();
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(data->packed_row()));
+
+  // The packed row is the latest version of the whole row, so records written before it are
+  // obsolete. Columns updated after the row was packed are stored as separate records and take
+  // precedence over the packed values, including tombstones written to set a column to NULL.
+  RETURN_NOT_OK(scope->mutable_assembler()->SetEmptyCollection());
+  std::vector<ColumnId> updated_columns;
+  auto collection = scope->collection();
+  while (ScopedDocDbRowContextWithData* child = VERIFY_RESULT(collection->GetNextChild())) {
+    RETURN_NOT_OK(ProcessSubDocument(child));
+    if (scope->obsolescence_tracker()->IsObsolete(child->data()->write_time())) {
+      continue;
+    }
+    Slice child_key = child->data()->key().AsSlice();
+    child_key.remove_prefix(scope->key().size());
+    PrimitiveValue subkey;
+    RETURN_NOT_OK(subkey.DecodeFromKey(&child_key));
+    if (subkey.value_type() == ValueType::kColumnId) {
+      updated_columns.push_back(subkey.GetColumnId());
+    }
+  }
+  return scope->mutable_assembler()->SetPackedColumns(
+      decoder, data->write_time(), updated_columns);
+}
+
 Status ProcessSubDocument(ScopedDocDbRowContextWithData* scope) {
   RETURN_NOT_OK(scope->CheckDeadline());
 
@@ -616,6 +705,10 @@ Status ProcessSubDocument(ScopedDocDbRowContextWithData* scope) {
     return ProcessCollection(scope);
   }
 
+  if (data->IsPackedRow()) {
+    return ProcessPackedRow(scope);
+  }
+
   if (data->IsPrimitiveValue()) {
     auto ttl_opt = obsolescence_tracker->GetTtlRemainingSeconds(data->write_time().hybrid_time());
     if (ttl_opt) {
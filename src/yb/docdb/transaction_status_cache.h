@@ -22,6 +22,8 @@ namespace docdb {
 
 // Caches transaction statuses fetched by single IntentAwareIterator.
 // Thread safety is not required, because IntentAwareIterator is used in a single thread only.
+// Final statuses of transactions are also cached tablet wide by the transaction participant, so
+// they are shared between iterators and conflict resolution.
 class TransactionStatusCache {
  public:
   TransactionStatusCache(const TransactionOperationContext& txn_context_opt,
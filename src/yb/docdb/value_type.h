@@ -101,6 +101,8 @@ namespace docdb {
     ((kString, 'S'))  /* ASCII code 83 */ \
     ((kTrue, 'T'))  /* ASCII code 84 */ \
     ((kUInt64, 'U')) /* ASCII code 85 */ \
+    /* All non-key columns of a row version stored as a single value, see packed_row.h. */ \
+    ((kPackedRow, 'V'))  /* ASCII code 86 */ \
     ((kTombstone, 'X'))  /* ASCII code 88 */ \
     ((kExternalIntents, 'Z')) /* ASCII code 90 */ \
     ((kArrayIndex, '['))  /* ASCII code 91 */ \
@@ -190,7 +192,7 @@ constexpr inline bool IsCollectionType(const ValueType value_type) {
 constexpr inline bool IsPrimitiveValueType(const ValueType value_type) {
   return (kMinPrimitiveValueType <= value_type && value_type <= kMaxPrimitiveValueType &&
           !IsCollectionType(value_type) &&
-          value_type != ValueType::kTombstone) ||
+          value_type != ValueType::kTombstone && value_type != ValueType::kPackedRow) ||
          value_type == ValueType::kTransactionApplyState ||
          value_type == ValueType::kExternalTransactionId;
 }
@@ -0,0 +1,194 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <map>
+
+#include "yb/docdb/wait_queue.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_uint64(wait_queue_max_wait_ms);
+
+namespace yb {
+namespace docdb {
+
+class WaitQueueTest : public YBTest {
+ protected:
+  std::unique_ptr<WaitQueue> CreateQueue(WaitForGraph* graph = nullptr) {
+    return std::make_unique<WaitQueue>(
+        graph, [](const WaitDoneCallback& callback, const Status& status, MonoDelta delay) {
+          callback(status);
+        }, nullptr /* metric_entity */, "T test: ");
+  }
+
+  // Waits on queue and returns the index of the wait, that could be used to check its status.
+  size_t WaitOn(WaitQueue* queue, const TransactionId& waiter,
+                std::vector<TransactionId> blockers,
+                CoarseTimePoint deadline = CoarseTimePoint::max()) {
+    auto idx = next_wait_idx_++;
+    queue->WaitOn(waiter, std::move(blockers), deadline, [this, idx](const Status& status) {
+      ASSERT_EQ(statuses_.count(idx), 0) << "Wait " << idx << " resumed twice";
+      statuses_.emplace(idx, status);
+    });
+    return idx;
+  }
+
+  // Schedules retry on queue and returns its index, like WaitOn.
+  size_t RetryAfter(WaitQueue* queue, MonoDelta delay) {
+    auto idx = next_wait_idx_++;
+    queue->RetryAfter(delay, [this, idx](const Status& status) {
+      ASSERT_EQ(statuses_.count(idx), 0) << "Retry " << idx << " resumed twice";
+      statuses_.emplace(idx, status);
+    });
+    return idx;
+  }
+
+  bool Resumed(size_t idx) const {
+    return statuses_.count(idx) != 0;
+  }
+
+  const Status& ResumeStatus(size_t idx) const {
+    return statuses_.at(idx);
+  }
+
+  size_t next_wait_idx_ = 0;
+  std::map<size_t, Status> statuses_;
+};
+
+TEST_F(WaitQueueTest, ResumeWhenBlockersFinished) {
+  auto queue = CreateQueue();
+  auto waiter = TransactionId::GenerateRandom();
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+
+  auto idx = WaitOn(queue.get(), waiter, {blocker1, blocker2});
+  ASSERT_FALSE(Resumed(idx));
+  ASSERT_EQ(queue->TEST_NumWaiters(), 1);
+
+  queue->SignalFinished(blocker1);
+  ASSERT_FALSE(Resumed(idx));
+
+  queue->SignalFinished(blocker2);
+  ASSERT_TRUE(Resumed(idx));
+  ASSERT_OK(ResumeStatus(idx));
+  ASSERT_EQ(queue->TEST_NumWaiters(), 0);
+}
+
+TEST_F(WaitQueueTest, RecentlyFinishedBlocker) {
+  auto queue = CreateQueue();
+  auto blocker = TransactionId::GenerateRandom();
+
+  // Blocker finished between the moment conflicts were read and the moment of wait.
+  queue->SignalFinished(blocker);
+  auto idx = WaitOn(queue.get(), TransactionId::GenerateRandom(), {blocker});
+  ASSERT_TRUE(Resumed(idx));
+  ASSERT_OK(ResumeStatus(idx));
+  ASSERT_EQ(queue->TEST_NumWaiters(), 0);
+}
+
+TEST_F(WaitQueueTest, Timeout) {
+  auto queue = CreateQueue();
+  auto blocker = TransactionId::GenerateRandom();
+  auto deadline = CoarseMonoClock::now() + 1s;
+
+  auto idx = WaitOn(queue.get(), TransactionId::GenerateRandom(), {blocker}, deadline);
+  queue->Poll(deadline - 1ms);
+  ASSERT_FALSE(Resumed(idx));
+
+  queue->Poll(deadline);
+  ASSERT_TRUE(Resumed(idx));
+  ASSERT_TRUE(ResumeStatus(idx).IsTimedOut()) << ResumeStatus(idx);
+
+  // Finish of blocker should not resume the waiter again.
+  queue->SignalFinished(blocker);
+}
+
+TEST_F(WaitQueueTest, MaxWait) {
+  FLAGS_wait_queue_max_wait_ms = 100;
+  auto queue = CreateQueue();
+
+  auto idx = WaitOn(queue.get(), TransactionId::GenerateRandom(),
+                    {TransactionId::GenerateRandom()});
+  queue->Poll(CoarseMonoClock::now() + 200ms);
+  ASSERT_TRUE(Resumed(idx));
+  ASSERT_TRUE(ResumeStatus(idx).IsTimedOut()) << ResumeStatus(idx);
+}
+
+TEST_F(WaitQueueTest, DeadlockAcrossQueues) {
+  WaitForGraph graph;
+  auto queue1 = CreateQueue(&graph);
+  auto queue2 = CreateQueue(&graph);
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  auto txn3 = TransactionId::GenerateRandom();
+
+  // txn1 -> txn2 on the first tablet, txn2 -> txn3 on the second tablet.
+  auto idx1 = WaitOn(queue1.get(), txn1, {txn2});
+  auto idx2 = WaitOn(queue2.get(), txn2, {txn3});
+  ASSERT_FALSE(Resumed(idx1));
+  ASSERT_FALSE(Resumed(idx2));
+
+  // txn3 -> txn1 closes the cycle.
+  auto idx3 = WaitOn(queue1.get(), txn3, {txn1});
+  ASSERT_TRUE(Resumed(idx3));
+  ASSERT_TRUE(ResumeStatus(idx3).IsIllegalState()) << ResumeStatus(idx3);
+  ASSERT_EQ(queue1->TEST_NumWaiters(), 1);
+
+  // After txn3 finishes, txn2 is resumed and txn2 -> txn1 does not create a cycle anymore.
+  queue2->SignalFinished(txn3);
+  ASSERT_TRUE(Resumed(idx2));
+  ASSERT_OK(ResumeStatus(idx2));
+
+  auto idx4 = WaitOn(queue2.get(), txn3, {txn1});
+  ASSERT_FALSE(Resumed(idx4));
+
+  queue1->SignalFinished(txn2);
+  queue2->SignalFinished(txn1);
+  ASSERT_OK(ResumeStatus(idx1));
+  ASSERT_OK(ResumeStatus(idx4));
+}
+
+TEST_F(WaitQueueTest, Shutdown) {
+  auto queue = CreateQueue();
+
+  auto idx1 = WaitOn(queue.get(), TransactionId::GenerateRandom(),
+                     {TransactionId::GenerateRandom()});
+  queue->StartShutdown();
+  ASSERT_TRUE(Resumed(idx1));
+  ASSERT_TRUE(ResumeStatus(idx1).IsAborted()) << ResumeStatus(idx1);
+
+  auto idx2 = WaitOn(queue.get(), TransactionId::GenerateRandom(),
+                     {TransactionId::GenerateRandom()});
+  ASSERT_TRUE(Resumed(idx2));
+  ASSERT_TRUE(ResumeStatus(idx2).IsAborted()) << ResumeStatus(idx2);
+
+  // Retry of a resumed waiter is not scheduled after shutdown.
+  auto idx3 = RetryAfter(queue.get(), 1ms);
+  ASSERT_TRUE(Resumed(idx3));
+  ASSERT_TRUE(ResumeStatus(idx3).IsAborted()) << ResumeStatus(idx3);
+}
+
+TEST_F(WaitQueueTest, RetryAfter) {
+  auto queue = CreateQueue();
+
+  auto idx = RetryAfter(queue.get(), 1ms);
+  ASSERT_TRUE(Resumed(idx));
+  ASSERT_OK(ResumeStatus(idx));
+  ASSERT_EQ(queue->TEST_NumWaiters(), 0);
+}
+
+} // namespace docdb
+} // namespace yb
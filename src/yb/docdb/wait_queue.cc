@@ -0,0 +1,389 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/wait_queue.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_wait_queues, false,
+            "Whether transactional writes that conflict with running transactions should wait "
+            "for them to finish, instead of aborting the lower priority transaction.");
+TAG_FLAG(enable_wait_queues, advanced);
+TAG_FLAG(enable_wait_queues, runtime);
+
+DEFINE_uint64(wait_queue_max_wait_ms, 2000,
+              "Max time that a transactional write could wait in the wait queue for conflicting "
+              "transactions. After that conflicts are resolved using transaction priorities. "
+              "Also bounds the time that a deadlock spanning several servers could last.");
+TAG_FLAG(wait_queue_max_wait_ms, advanced);
+TAG_FLAG(wait_queue_max_wait_ms, runtime);
+
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_waits, "Total number of writes that waited for conflicting transactions",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_timeouts,
+    "Total number of writes that stopped waiting for conflicting transactions because of timeout",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_deadlocks, "Total number of deadlocks detected by wait queue",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, wait_queue_waiters, "Number of writes waiting for conflicting transactions",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_coarse_histogram(
+    tablet, wait_queue_wait_time, "Wait queue wait time", yb::MetricUnit::kMicroseconds,
+    "Time spent by writes waiting for conflicting transactions");
+
+namespace yb {
+namespace docdb {
+
+WaitForGraph::WaitForGraph() = default;
+
+WaitForGraph::~WaitForGraph() = default;
+
+bool WaitForGraph::AddEdges(const TransactionId& waiter,
+                            const std::vector<TransactionId>& blockers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& blocker : blockers) {
+    if (blocker == waiter || ReachableUnlocked(blocker, waiter)) {
+      return false;
+    }
+  }
+  auto& edges = edges_[waiter];
+  for (const auto& blocker : blockers) {
+    ++edges[blocker];
+  }
+  return true;
+}
+
+void WaitForGraph::RemoveEdges(const TransactionId& waiter,
+                               const std::vector<TransactionId>& blockers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = edges_.find(waiter);
+  if (it == edges_.end()) {
+    LOG(DFATAL) << "Removing edges of unknown waiter: " << waiter;
+    return;
+  }
+  for (const auto& blocker : blockers) {
+    auto edge_it = it->second.find(blocker);
+    if (edge_it != it->second.end() && --edge_it->second == 0) {
+      it->second.erase(edge_it);
+    }
+  }
+  if (it->second.empty()) {
+    edges_.erase(it);
+  }
+}
+
+bool WaitForGraph::ReachableUnlocked(const TransactionId& from, const TransactionId& to) {
+  std::vector<TransactionId> queue = {from};
+  TransactionIdSet visited = {from};
+  while (!queue.empty()) {
+    auto current = queue.back();
+    queue.pop_back();
+    auto it = edges_.find(current);
+    if (it == edges_.end()) {
+      continue;
+    }
+    for (const auto& p : it->second) {
+      if (p.first == to) {
+        return true;
+      }
+      if (visited.insert(p.first).second) {
+        queue.push_back(p.first);
+      }
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// Time to remember finished transactions, so waiter does not wait for transaction that finished
+// between the moment conflicts were read and the moment the waiter was added to the queue.
+constexpr auto kRecentlyFinishedTtl = 15s;
+
+struct Waiter {
+  TransactionId id;
+  std::vector<TransactionId> blockers;
+  // Number of blockers that are not finished yet.
+  size_t num_running_blockers;
+  CoarseTimePoint start;
+  CoarseTimePoint deadline;
+  WaitDoneCallback callback;
+};
+
+using WaiterPtr = std::shared_ptr<Waiter>;
+
+} // namespace
+
+class WaitQueue::Impl {
+ public:
+  Impl(WaitForGraph* shared_graph, WaitQueueExecutor executor,
+       const scoped_refptr<MetricEntity>& metric_entity, const std::string& log_prefix)
+      : own_graph_(shared_graph ? nullptr : std::make_unique<WaitForGraph>()),
+        graph_(shared_graph ? *shared_graph : *own_graph_),
+        executor_(std::move(executor)),
+        log_prefix_(log_prefix) {
+    if (metric_entity) {
+      waits_ = METRIC_wait_queue_waits.Instantiate(metric_entity);
+      timeouts_ = METRIC_wait_queue_timeouts.Instantiate(metric_entity);
+      deadlocks_ = METRIC_wait_queue_deadlocks.Instantiate(metric_entity);
+      waiters_gauge_ = METRIC_wait_queue_waiters.Instantiate(metric_entity, 0);
+      wait_time_ = METRIC_wait_queue_wait_time.Instantiate(metric_entity);
+    }
+  }
+
+  ~Impl() {
+    LOG_IF_WITH_PREFIX(DFATAL, !waiters_.empty())
+        << "Destroying wait queue with " << waiters_.size() << " waiters";
+  }
+
+  void WaitOn(const TransactionId& waiter_id, std::vector<TransactionId> blockers,
+              CoarseTimePoint deadline, WaitDoneCallback callback) {
+    auto now = CoarseMonoClock::now();
+    deadline = std::min<CoarseTimePoint>(
+        deadline, now + std::chrono::milliseconds(FLAGS_wait_queue_max_wait_ms));
+    Status status;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CleanupRecentlyFinishedUnlocked(now);
+      blockers.erase(std::remove_if(blockers.begin(), blockers.end(), [this](const auto& id) {
+        return recently_finished_.count(id) != 0;
+      }), blockers.end());
+      if (closing_) {
+        status = STATUS(Aborted, "Wait queue is shutting down");
+      } else if (blockers.empty()) {
+        VLOG_WITH_PREFIX(4) << waiter_id << " all blockers already finished";
+      } else if (!graph_.AddEdges(waiter_id, blockers)) {
+        IncrementCounter(deadlocks_);
+        status = STATUS_FORMAT(
+            IllegalState, "Waiting for $0 would cause a deadlock", AsString(blockers));
+      } else {
+        auto waiter = std::make_shared<Waiter>();
+        waiter->id = waiter_id;
+        waiter->blockers = std::move(blockers);
+        waiter->num_running_blockers = waiter->blockers.size();
+        waiter->start = now;
+        waiter->deadline = deadline;
+        waiter->callback = std::move(callback);
+        for (const auto& blocker : waiter->blockers) {
+          blocker_to_waiters_[blocker].push_back(waiter);
+        }
+        VLOG_WITH_PREFIX(4) << waiter_id << " waits for " << AsString(waiter->blockers);
+        waiters_.insert(std::move(waiter));
+        IncrementCounter(waits_);
+        UpdateWaitersGaugeUnlocked();
+        return;
+      }
+    }
+    executor_(callback, status, MonoDelta::kZero);
+  }
+
+  void RetryAfter(MonoDelta delay, WaitDoneCallback callback) {
+    bool closing;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closing = closing_;
+    }
+    if (closing) {
+      executor_(callback, STATUS(Aborted, "Wait queue is shutting down"), MonoDelta::kZero);
+      return;
+    }
+    executor_(callback, Status::OK(), delay);
+  }
+
+  void SignalFinished(const TransactionId& id) {
+    std::vector<WaiterPtr> resumed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto now = CoarseMonoClock::now();
+      CleanupRecentlyFinishedUnlocked(now);
+      if (recently_finished_.insert(id).second) {
+        recently_finished_cleanup_queue_.emplace_back(id, now + kRecentlyFinishedTtl);
+      }
+      auto it = blocker_to_waiters_.find(id);
+      if (it == blocker_to_waiters_.end()) {
+        return;
+      }
+      for (auto& waiter : it->second) {
+        if (--waiter->num_running_blockers == 0 && waiters_.erase(waiter)) {
+          resumed.push_back(std::move(waiter));
+        }
+      }
+      blocker_to_waiters_.erase(it);
+      UpdateWaitersGaugeUnlocked();
+    }
+    for (const auto& waiter : resumed) {
+      VLOG_WITH_PREFIX(4) << waiter->id << " resumed, " << id << " finished";
+      Resume(*waiter, Status::OK());
+    }
+  }
+
+  void Poll(CoarseTimePoint now) {
+    std::vector<WaiterPtr> expired;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CleanupRecentlyFinishedUnlocked(now);
+      for (auto it = waiters_.begin(); it != waiters_.end();) {
+        if ((**it).deadline <= now) {
+          expired.push_back(*it);
+          it = waiters_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      for (const auto& waiter : expired) {
+        RemoveFromBlockersUnlocked(waiter);
+      }
+      UpdateWaitersGaugeUnlocked();
+    }
+    for (const auto& waiter : expired) {
+      IncrementCounter(timeouts_);
+      Resume(*waiter, STATUS_FORMAT(
+          TimedOut, "Timed out waiting for $0", AsString(waiter->blockers)));
+    }
+  }
+
+  void StartShutdown() {
+    decltype(waiters_) waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closing_ = true;
+      waiters.swap(waiters_);
+      blocker_to_waiters_.clear();
+      UpdateWaitersGaugeUnlocked();
+    }
+    for (const auto& waiter : waiters) {
+      Resume(*waiter, STATUS(Aborted, "Wait queue is shutting down"));
+    }
+  }
+
+  size_t NumWaiters() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiters_.size();
+  }
+
+ private:
+  const std::string& LogPrefix() const {
+    return log_prefix_;
+  }
+
+  void Resume(const Waiter& waiter, const Status& status) {
+    graph_.RemoveEdges(waiter.id, waiter.blockers);
+    if (wait_time_) {
+      wait_time_->Increment(MonoDelta(CoarseMonoClock::now() - waiter.start).ToMicroseconds());
+    }
+    executor_(waiter.callback, status, MonoDelta::kZero);
+  }
+
+  void RemoveFromBlockersUnlocked(const WaiterPtr& waiter) REQUIRES(mutex_) {
+    for (const auto& blocker : waiter->blockers) {
+      auto it = blocker_to_waiters_.find(blocker);
+      if (it == blocker_to_waiters_.end()) {
+        continue;
+      }
+      auto& list = it->second;
+      list.erase(std::remove(list.begin(), list.end(), waiter), list.end());
+      if (list.empty()) {
+        blocker_to_waiters_.erase(it);
+      }
+    }
+  }
+
+  void CleanupRecentlyFinishedUnlocked(CoarseTimePoint now) REQUIRES(mutex_) {
+    while (!recently_finished_cleanup_queue_.empty() &&
+           recently_finished_cleanup_queue_.front().second <= now) {
+      recently_finished_.erase(recently_finished_cleanup_queue_.front().first);
+      recently_finished_cleanup_queue_.pop_front();
+    }
+  }
+
+  void UpdateWaitersGaugeUnlocked() REQUIRES(mutex_) {
+    if (waiters_gauge_) {
+      waiters_gauge_->set_value(waiters_.size());
+    }
+  }
+
+  static void IncrementCounter(const scoped_refptr<Counter>& counter) {
+    if (counter) {
+      counter->Increment();
+    }
+  }
+
+  std::unique_ptr<WaitForGraph> own_graph_;
+  WaitForGraph& graph_;
+  const WaitQueueExecutor executor_;
+  const std::string log_prefix_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  std::unordered_set<WaiterPtr> waiters_ GUARDED_BY(mutex_);
+  std::unordered_map<TransactionId, std::vector<WaiterPtr>, TransactionIdHash>
+      blocker_to_waiters_ GUARDED_BY(mutex_);
+  TransactionIdSet recently_finished_ GUARDED_BY(mutex_);
+  std::deque<std::pair<TransactionId, CoarseTimePoint>> recently_finished_cleanup_queue_
+      GUARDED_BY(mutex_);
+
+  scoped_refptr<Counter> waits_;
+  scoped_refptr<Counter> timeouts_;
+  scoped_refptr<Counter> deadlocks_;
+  scoped_refptr<AtomicGauge<uint64_t>> waiters_gauge_;
+  scoped_refptr<Histogram> wait_time_;
+};
+
+WaitQueue::WaitQueue(WaitForGraph* shared_graph, WaitQueueExecutor executor,
+                     const scoped_refptr<MetricEntity>& metric_entity,
+                     const std::string& log_prefix)
+    : impl_(new Impl(shared_graph, std::move(executor), metric_entity, log_prefix)) {
+}
+
+WaitQueue::~WaitQueue() = default;
+
+void WaitQueue::WaitOn(const TransactionId& waiter, std::vector<TransactionId> blockers,
+                       CoarseTimePoint deadline, WaitDoneCallback callback) {
+  impl_->WaitOn(waiter, std::move(blockers), deadline, std::move(callback));
+}
+
+void WaitQueue::RetryAfter(MonoDelta delay, WaitDoneCallback callback) {
+  impl_->RetryAfter(delay, std::move(callback));
+}
+
+void WaitQueue::SignalFinished(const TransactionId& id) {
+  impl_->SignalFinished(id);
+}
+
+void WaitQueue::Poll(CoarseTimePoint now) {
+  impl_->Poll(now);
+}
+
+void WaitQueue::StartShutdown() {
+  impl_->StartShutdown();
+}
+
+size_t WaitQueue::TEST_NumWaiters() const {
+  return impl_->NumWaiters();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_WAIT_QUEUE_H
+#define YB_DOCDB_WAIT_QUEUE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Graph of transactions waiting for other transactions, used to detect deadlocks between waiters.
+// The same graph could be shared by wait queues of all tablets of the server, so deadlocks that
+// span several tablets of the same server are also detected. Deadlocks that span several servers
+// are not visible here, they are resolved by the wait timeout.
+class WaitForGraph {
+ public:
+  WaitForGraph();
+  ~WaitForGraph();
+
+  // Adds edges from waiter to each of blockers. Returns false without adding anything if it would
+  // create a cycle, i.e. one of the blockers is already waiting, directly or transitively, for the
+  // waiter.
+  bool AddEdges(const TransactionId& waiter, const std::vector<TransactionId>& blockers);
+
+  // Removes edges previously added by AddEdges.
+  void RemoveEdges(const TransactionId& waiter, const std::vector<TransactionId>& blockers);
+
+ private:
+  bool ReachableUnlocked(const TransactionId& from, const TransactionId& to) REQUIRES(mutex_);
+
+  std::mutex mutex_;
+
+  // Transaction could wait on several tablets at once, so edges are reference counted.
+  using Edges = std::unordered_map<TransactionId, size_t, TransactionIdHash>;
+  std::unordered_map<TransactionId, Edges, TransactionIdHash> edges_ GUARDED_BY(mutex_);
+};
+
+using WaitDoneCallback = std::function<void(const Status&)>;
+
+// Invokes callback with the provided status, after the provided delay. Should not call it in the
+// context of the function itself, since WaitQueue could be called while its caller holds locks,
+// that are also acquired by the waiter when it continues.
+using WaitQueueExecutor = std::function<void(const WaitDoneCallback&, const Status&, MonoDelta)>;
+
+// Per tablet queue of transactional writes that were blocked by conflicting transactions.
+//
+// Instead of aborting the conflicting transaction (or itself, depending on priorities), conflict
+// resolution parks the write here, until all transactions it conflicts with are committed or
+// aborted. The transaction participant notifies the queue when it removes a transaction, so the
+// waiter resumes without polling the transaction coordinator.
+//
+// The waiter is resumed with a non OK status when it would create a deadlock, or when it waited
+// for too long. In this case conflict resolution falls back to the priority based resolution.
+class WaitQueue {
+ public:
+  WaitQueue(WaitForGraph* shared_graph, WaitQueueExecutor executor,
+            const scoped_refptr<MetricEntity>& metric_entity, const std::string& log_prefix);
+  ~WaitQueue();
+
+  // Parks waiter transaction until all blockers are finished, deadline is reached or the queue is
+  // shut down. Callback is always invoked via executor.
+  void WaitOn(const TransactionId& waiter, std::vector<TransactionId> blockers,
+              CoarseTimePoint deadline, WaitDoneCallback callback);
+
+  // Invokes callback via executor after delay, or immediately with Aborted status if the queue is
+  // shutting down. Used by a resumed waiter to retry acquiring its key locks without blocking
+  // the thread.
+  void RetryAfter(MonoDelta delay, WaitDoneCallback callback);
+
+  // Notifies the queue that transaction was committed and applied, or aborted, on this tablet.
+  void SignalFinished(const TransactionId& id);
+
+  // Resumes waiters whose deadline has passed.
+  void Poll(CoarseTimePoint now);
+
+  // Resumes all waiters with Aborted status, and rejects new waiters.
+  void StartShutdown();
+
+  size_t TEST_NumWaiters() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_WAIT_QUEUE_H
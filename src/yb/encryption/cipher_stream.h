@@ -16,12 +16,13 @@
 
 #include <openssl/ossl_typ.h>
 
+#include <memory>
 #include <string>
 
 #include "yb/encryption/cipher_stream_fwd.h"
 
+#include "yb/util/slice.h"
 #include "yb/util/status_fwd.h"
-#include "yb/util/locks.h"
 
 namespace yb {
 namespace encryption {
@@ -31,6 +32,10 @@ struct EncryptionParams;
 typedef std::unique_ptr<EncryptionParams> EncryptionParamsPtr;
 
 // BlockAccessCipherStream is the base class for any cipher stream.
+//
+// Stream does not own OpenSSL cipher context, instead each thread keeps a few contexts initialized
+// with keys of recently used streams. So concurrent encryption of the same file does not require
+// locking, and key schedule is not recalculated for each call.
 class BlockAccessCipherStream {
  public:
   static Result<std::unique_ptr<BlockAccessCipherStream>> FromEncryptionParams(
@@ -39,6 +44,7 @@ class BlockAccessCipherStream {
   CHECKED_STATUS Init();
 
   // Encrypt data at an offset.
+  // Output could point to the same buffer as input, in this case data is encrypted in place.
   CHECKED_STATUS Encrypt(
       uint64_t file_offset,
       const Slice& input,
@@ -50,6 +56,7 @@ class BlockAccessCipherStream {
   // counter_overflow_workaround indicates whether we should add one to byte 11 of the initilization
   // vector. Used to as a workaround in case of block checksum mismatches when reading data that is
   // affected by https://github.com/yugabyte/yugabyte-db/issues/3707.
+  // Output could point to the same buffer as input, in this case data is decrypted in place.
   CHECKED_STATUS Decrypt(
       uint64_t file_offset,
       const Slice& input,
@@ -70,9 +77,13 @@ class BlockAccessCipherStream {
   void IncrementCounter(const uint64_t start_idx, uint8_t* iv,
                         EncryptionOverflowWorkaround counter_overflow_workaround);
 
+  // Returns cipher context of the current thread, initialized with the key of this stream.
+  Result<EVP_CIPHER_CTX*> ThreadContext();
+
   EncryptionParamsPtr encryption_params_;
-  std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> encryption_context_;
-  mutable simple_spinlock mutex_;
+  const EVP_CIPHER* cipher_ = nullptr;
+  // Unique id of this stream, used to find thread cipher context initialized with its key.
+  const uint64_t id_;
 };
 
 } // namespace encryption
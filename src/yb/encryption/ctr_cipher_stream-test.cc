@@ -126,6 +126,53 @@ TEST_F(TestCipherStream, ConcurrentEncryption) {
   }
 }
 
+TEST_F(TestCipherStream, InPlace) {
+  InitOpenSSL();
+
+  constexpr int kBufSize = 10000;
+  auto plaintext_bytes = RandomBytes(kBufSize);
+  uint8_t encrypted_bytes[kBufSize];
+  auto cipher_stream = ASSERT_RESULT(BlockAccessCipherStream::FromEncryptionParams(
+      EncryptionParams::NewEncryptionParams()));
+  ASSERT_OK(cipher_stream->Encrypt(0, Slice(plaintext_bytes.data(), kBufSize), encrypted_bytes));
+
+  for (int i = 0; i < kNumRuns; i++) {
+    int start = RandomUniformInt(0, kBufSize);
+    int size = RandomUniformInt(0, kBufSize - start);
+    uint8_t buf[kBufSize];
+    memcpy(buf, encrypted_bytes + start, size);
+    ASSERT_OK(cipher_stream->Decrypt(start, Slice(buf, size), buf));
+    ASSERT_EQ(Slice(plaintext_bytes.data() + start, size), Slice(buf, size));
+  }
+}
+
+// Use more streams than the number of cipher contexts cached per thread, so contexts are
+// reinitialized with keys of other streams.
+TEST_F(TestCipherStream, ManyStreams) {
+  InitOpenSSL();
+
+  constexpr int kNumStreams = 20;
+  auto plaintext_bytes = RandomBytes(kDataSize);
+  std::vector<std::unique_ptr<BlockAccessCipherStream>> streams;
+  std::vector<std::vector<uint8_t>> encrypted(kNumStreams, std::vector<uint8_t>(kDataSize));
+  for (int i = 0; i < kNumStreams; i++) {
+    streams.push_back(ASSERT_RESULT(BlockAccessCipherStream::FromEncryptionParams(
+        EncryptionParams::NewEncryptionParams())));
+    ASSERT_OK(streams.back()->Encrypt(
+        0, Slice(plaintext_bytes.data(), kDataSize), encrypted[i].data()));
+  }
+
+  for (int i = 0; i < kNumRuns; i++) {
+    int stream_idx = RandomUniformInt(0, kNumStreams - 1);
+    int start = RandomUniformInt(0, kDataSize);
+    int size = RandomUniformInt(0, kDataSize - start);
+    uint8_t decrypted_bytes[kDataSize];
+    ASSERT_OK(streams[stream_idx]->Decrypt(
+        start, Slice(encrypted[stream_idx].data() + start, size), decrypted_bytes));
+    ASSERT_EQ(Slice(plaintext_bytes.data() + start, size), Slice(decrypted_bytes, size));
+  }
+}
+
 TEST_F(TestCipherStream, Overflow) {
   // Create a cipher stream on a iv about to overflow.
   ASSERT_OK(TestOverFlowWithKeyType(true /* use_openssl_compatible_counter_overflow */ ));
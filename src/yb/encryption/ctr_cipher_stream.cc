@@ -13,6 +13,9 @@
 
 #include <openssl/evp.h>
 
+#include <array>
+#include <atomic>
+
 #include "yb/encryption/cipher_stream.h"
 #include "yb/encryption/encryption_util.h"
 
@@ -23,6 +26,56 @@
 namespace yb {
 namespace encryption {
 
+namespace {
+
+std::atomic<uint64_t> next_stream_id{1};
+
+struct CipherContextDeleter {
+  void operator()(EVP_CIPHER_CTX* ctx) const {
+    EVP_CIPHER_CTX_free(ctx);
+  }
+};
+
+// Cipher contexts of the current thread, each initialized with the key of some stream.
+// Compaction and block reads alternate between a few files, so a few contexts are kept, replacing
+// them in round robin order.
+class ThreadCipherContexts {
+ public:
+  struct Entry {
+    // Id of the stream, whose key was used to initialize context, 0 if not initialized.
+    uint64_t stream_id = 0;
+    std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter> context;
+  };
+
+  // Returns entry for the stream with specified id. If there is no such entry, then the next
+  // entry is reused, and its context should be initialized by the caller.
+  Entry* Find(uint64_t stream_id) {
+    for (auto& entry : entries_) {
+      if (entry.stream_id == stream_id) {
+        return &entry;
+      }
+    }
+    auto& entry = entries_[next_victim_];
+    next_victim_ = (next_victim_ + 1) % entries_.size();
+    entry.stream_id = 0;
+    if (!entry.context) {
+      entry.context.reset(EVP_CIPHER_CTX_new());
+    }
+    return &entry;
+  }
+
+  static ThreadCipherContexts& Instance() {
+    static thread_local ThreadCipherContexts contexts;
+    return contexts;
+  }
+
+ private:
+  std::array<Entry, 8> entries_;
+  size_t next_victim_ = 0;
+};
+
+} // namespace
+
 Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEncryptionParams(
     EncryptionParamsPtr encryption_params) {
   auto stream = std::make_unique<BlockAccessCipherStream>(std::move(encryption_params));
@@ -33,46 +86,56 @@ Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEn
 BlockAccessCipherStream::BlockAccessCipherStream(
     EncryptionParamsPtr encryption_params) :
     encryption_params_(std::move(encryption_params)),
-    encryption_context_(EVP_CIPHER_CTX_new(), [](EVP_CIPHER_CTX* ctx){
-      EVP_CIPHER_CTX_cleanup(ctx);
-      EVP_CIPHER_CTX_free(ctx);
-    }) {}
+    id_(next_stream_id.fetch_add(1, std::memory_order_relaxed)) {}
 
 Status BlockAccessCipherStream::Init() {
-  EVP_CIPHER_CTX_init(encryption_context_.get());
-  const EVP_CIPHER* cipher;
   switch (encryption_params_->key_size) {
     case 16:
-      cipher = EVP_aes_128_ctr();
+      cipher_ = EVP_aes_128_ctr();
       break;
     case 24:
-      cipher = EVP_aes_192_ctr();
+      cipher_ = EVP_aes_192_ctr();
       break;
     case 32:
-      cipher = EVP_aes_256_ctr();
+      cipher_ = EVP_aes_256_ctr();
       break;
     default:
       return STATUS_SUBSTITUTE(IllegalState, "Expected key size to be one of 16, 24, 32, found $0.",
           encryption_params_->key_size);
   }
 
+  // Check that the context could be initialized with the key of this stream.
+  RETURN_NOT_OK(ThreadContext());
+  return Status::OK();
+}
+
+Result<EVP_CIPHER_CTX*> BlockAccessCipherStream::ThreadContext() {
+  auto* entry = ThreadCipherContexts::Instance().Find(id_);
+  auto* context = entry->context.get();
+  if (!context) {
+    return STATUS(InternalError, "EVP_CIPHER_CTX_new failed");
+  }
+  if (entry->stream_id == id_) {
+    return context;
+  }
+
   const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
-      /* iv */ nullptr);
+      context, cipher_, /* impl */ nullptr, encryption_params_->key, /* iv */ nullptr);
   if (encrypt_init_ex_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0",
                          encrypt_init_ex_result);
   }
 
-  const auto set_padding_result = EVP_CIPHER_CTX_set_padding(encryption_context_.get(), 0);
+  const auto set_padding_result = EVP_CIPHER_CTX_set_padding(context, 0);
   if (set_padding_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_CIPHER_CTX_set_padding returned $0",
                          set_padding_result);
   }
 
-  return Status::OK();
+  entry->stream_id = id_;
+  return context;
 }
 
 Status BlockAccessCipherStream::Encrypt(
@@ -148,12 +211,11 @@ Status BlockAccessCipherStream::EncryptByBlock(
   const uint64_t start_index = encryption_params_->counter + block_index;
   IncrementCounter(start_index, iv, counter_overflow_workaround);
 
-  // Lock the encryption op since we modify encryption context.
-  std::lock_guard<simple_spinlock> l(mutex_);
-
+  // Context is owned by the current thread, so no locking is required. Key is already set, so
+  // only the iv is updated and the key schedule is reused.
+  auto* context = VERIFY_RESULT(ThreadContext());
   const int init_result =
-      EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+      EVP_EncryptInit_ex(context, /* cipher */ nullptr, /* impl */ nullptr, /* key */ nullptr, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
@@ -163,9 +225,10 @@ Status BlockAccessCipherStream::EncryptByBlock(
 
   // Perform the encryption.
   int bytes_updated = 0;
+  // For the whole range OpenSSL generates keystream for several blocks at once (AES-NI CTR
+  // implementation pipelines them), so the range is processed with a single call.
   const int update_result = EVP_EncryptUpdate(
-      encryption_context_.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
-      data_size);
+      context, static_cast<uint8_t*>(output), &bytes_updated, input.data(), data_size);
   if (update_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptUpdate returned $0 when encrypting/decrypting $1 bytes "
@@ -23,7 +23,9 @@
 
 #include "yb/gutil/casts.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
@@ -61,5 +63,46 @@ TEST_F(TestEncryptedEnv, FileOps) {
   }
 }
 
+// Compares throughput of random access reads from encrypted and plain files.
+TEST_F(TestEncryptedEnv, BenchmarkRandomAccessReads) {
+  const size_t kFileSize = AllowSlowTests() ? 256_MB : 16_MB;
+  const size_t kBlockSize = 32_KB;
+  const size_t kNumReads = AllowSlowTests() ? 100000 : 10000;
+
+  auto header_manager = GetMockHeaderManager();
+  HeaderManager* hm_ptr = header_manager.get();
+  auto env = NewEncryptedEnv(std::move(header_manager));
+  auto bytes = RandomBytes(kFileSize);
+  std::vector<uint8_t> scratch(kBlockSize);
+
+  for (bool encrypted : {false, true}) {
+    down_cast<HeaderManagerMockImpl*>(hm_ptr)->SetFileEncryption(encrypted);
+
+    string fname;
+    std::unique_ptr<WritableFile> writable_file;
+    ASSERT_OK(env->NewTempWritableFile(
+        WritableFileOptions(), "bench-fileXXXXXX", &fname, &writable_file));
+    ASSERT_OK(writable_file->Append(Slice(bytes.data(), bytes.size())));
+    ASSERT_OK(writable_file->Close());
+
+    std::unique_ptr<yb::RandomAccessFile> ra_file;
+    ASSERT_OK(env->NewRandomAccessFile(fname, &ra_file));
+
+    auto start = MonoTime::Now();
+    for (size_t i = 0; i != kNumReads; ++i) {
+      auto offset = RandomUniformInt<size_t>(0, kFileSize - kBlockSize);
+      Slice result;
+      ASSERT_OK(ra_file->Read(offset, kBlockSize, &result, scratch.data()));
+      ASSERT_EQ(kBlockSize, result.size());
+    }
+    auto elapsed = MonoTime::Now() - start;
+    LOG(INFO) << (encrypted ? "Encrypted" : "Plain") << " reads: " << kNumReads << " x "
+              << kBlockSize << " bytes in " << elapsed << ", "
+              << kNumReads * kBlockSize / elapsed.ToSeconds() / 1_MB << " MB/s";
+
+    ASSERT_OK(env->DeleteFile(fname));
+  }
+}
+
 } // namespace encryption
 } // namespace yb
@@ -47,8 +47,9 @@ Status EncryptedRandomAccessFile::ReadInternal(
   if (!scratch) {
     return STATUS(InvalidArgument, "scratch argument is null.");
   }
-  uint8_t* buf = static_cast<uint8_t*>(EncryptionBuffer::Get()->GetBuffer(n));
-  RETURN_NOT_OK(RandomAccessFileWrapper::Read(offset + header_size_, n, result, buf));
+  // Read directly to scratch and decrypt in place, to avoid copying data through a separate buffer.
+  RETURN_NOT_OK(RandomAccessFileWrapper::Read(
+      offset + header_size_, n, result, to_uchar_ptr(scratch)));
   RETURN_NOT_OK(stream_->Decrypt(offset, *result, scratch, counter_overflow_workaround));
   *result = Slice(scratch, result->size());
   return Status::OK();
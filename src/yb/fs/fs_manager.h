@@ -206,6 +206,10 @@ class FsManager {
 
   Env *env() { return env_; }
 
+  const scoped_refptr<MetricEntity>& metric_entity() const {
+    return metric_entity_;
+  }
+
   bool read_only() const {
     return read_only_;
   }
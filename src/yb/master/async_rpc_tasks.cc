@@ -1330,9 +1330,12 @@ bool IsDefinitelyPermanentError(const Status& s) {
 // ============================================================================
 AsyncGetTabletSplitKey::AsyncGetTabletSplitKey(
     Master* master, ThreadPool* callback_pool, const scoped_refptr<TabletInfo>& tablet,
-    DataCallbackType result_cb)
+    SplitByLoad split_by_load, DataCallbackType result_cb)
     : AsyncTabletLeaderTask(master, callback_pool, tablet), result_cb_(result_cb) {
   req_.set_tablet_id(tablet_id());
+  if (split_by_load) {
+    req_.set_split_by_load(true);
+  }
 }
 
 void AsyncGetTabletSplitKey::HandleResponse(int attempt) {
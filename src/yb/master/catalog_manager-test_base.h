@@ -14,6 +14,8 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_TEST_BASE_H
 #define YB_MASTER_CATALOG_MANAGER_TEST_BASE_H
 
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "yb/gutil/strings/substitute.h"
@@ -238,6 +240,9 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "0");
     PrepareTestState(ts_descs_multi_az);
     TestLeaderBlacklist();
+
+    PrepareTestState(ts_descs_multi_az);
+    TestThroughputAwareBalancing();
   }
 
  protected:
@@ -909,6 +914,60 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
   }
 
+  void TestThroughputAwareBalancing() NO_THREAD_SAFETY_ANALYSIS {
+    LOG(INFO) << "Testing balancing of load cost reported by tablet servers";
+    PlacementInfoPB *cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kDefaultNumReplicas);
+
+    // Add the fourth TS and move one replica of tablets 0, 1 and 2 to it, so that every TS has 3
+    // tablets. Tablet leaders are: tablet 0: ts0, tablet 1: ts1, tablet 2: ts2, tablet 3: ts0.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+    RemoveReplica(tablets_[0].get(), ts_descs_[2]);
+    AddRunningReplica(tablets_[0].get(), ts_descs_[3]);
+    RemoveReplica(tablets_[1].get(), ts_descs_[0]);
+    AddRunningReplica(tablets_[1].get(), ts_descs_[3]);
+    RemoveReplica(tablets_[2].get(), ts_descs_[1]);
+    AddRunningReplica(tablets_[2].get(), ts_descs_[3]);
+
+    // Tablets 2 and 3 are hot, their replicas cost 5 and their leaders cost 4 more. That gives
+    // costs 15, 7, 15, 7 to the TSs.
+    for (int i : {2, 3}) {
+      SetTabletLoad(tablets_[i].get(), 4000 /* write_ops_per_sec */);
+    }
+    cb_->state_->options_->kThroughputAware = true;
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+    const auto initial_spread = GetCostSpread();
+    ASSERT_NEAR(8, initial_spread, 1e-6);
+
+    // Tablet and leader counts are balanced, but without cost based moves nothing would move.
+    string placeholder;
+    cb_->state_->options_->kThroughputAware = false;
+    cb_->can_perform_global_operations_ = true;
+    ASSERT_FALSE(ASSERT_RESULT(HandleAddReplicas(&placeholder, &placeholder, &placeholder)));
+    cb_->state_->options_->kThroughputAware = true;
+
+    // The only move that reduces the cost variance is swapping tablet 3 on ts2 with tablet 0 on
+    // ts3, leaders are not moved.
+    string tablet_id, from_ts, to_ts;
+    ASSERT_TRUE(ASSERT_RESULT(HandleAddReplicas(&tablet_id, &from_ts, &to_ts)));
+    ASSERT_EQ(tablets_[3]->tablet_id(), tablet_id);
+    ASSERT_EQ(ts_descs_[2]->permanent_uuid(), from_ts);
+    ASSERT_EQ(ts_descs_[3]->permanent_uuid(), to_ts);
+    ASSERT_EQ(2, cb_->get_total_starting_tablets());
+    // Only one cost based move is made until the load balancer is idle.
+    ASSERT_FALSE(ASSERT_RESULT(HandleAddReplicas(&placeholder, &placeholder, &placeholder)));
+
+    // Apply the moves to the tablet map, until costs of all TSs are equal.
+    const int kMaxRounds = 20;
+    auto rounds = ASSERT_RESULT(SimulateBalancing(kMaxRounds));
+    ASSERT_LT(rounds, kMaxRounds);
+    ASSERT_NEAR(0, GetCostSpread(), 1e-6);
+
+    cb_->state_->options_->kThroughputAware = false;
+  }
+
   void TestMissingPlacementSingleAz() {
     LOG(INFO) << "Testing single az deployment where min_num_replicas different from num_replicas";
     // Setup cluster level placement to single AZ.
@@ -1077,6 +1136,82 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  // Sets the load reported by all replicas of the tablet.
+  void SetTabletLoad(TabletInfo* tablet, double write_ops_per_sec, double read_ops_per_sec = 0) {
+    std::shared_ptr<TabletReplicaMap> replicas =
+      std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
+    for (auto& replica : *replicas) {
+      replica.second.drive_info.write_ops_per_sec = write_ops_per_sec;
+      replica.second.drive_info.read_ops_per_sec = read_ops_per_sec;
+    }
+    tablet->SetReplicaLocations(replicas);
+  }
+
+  // Difference between the highest and the lowest load cost of tablet servers in the current
+  // load balancer state.
+  double GetCostSpread() {
+    double min_cost = std::numeric_limits<double>::max();
+    double max_cost = std::numeric_limits<double>::lowest();
+    for (const auto& ts_desc : ts_descs_) {
+      auto cost = cb_->global_state_->GetGlobalCost(ts_desc->permanent_uuid());
+      min_cost = std::min(min_cost, cost);
+      max_cost = std::max(max_cost, cost);
+    }
+    return max_cost - min_cost;
+  }
+
+  // Simulates load balancer runs over the mocked cluster. Every round analyzes the tablet map,
+  // makes the highest priority move and applies the changes sent by the load balancer to the
+  // tablet map, as if they were completed by tablet servers. New replicas report the same load as
+  // other replicas of the tablet.
+  //
+  // Returns the number of rounds that made any change, the load balancer state is left analyzed
+  // after the last round.
+  Result<int> SimulateBalancing(int max_rounds) NO_THREAD_SAFETY_ANALYSIS {
+    for (int round = 0; round != max_rounds; ++round) {
+      ResetState();
+      RETURN_NOT_OK(AnalyzeTablets());
+      cb_->can_perform_global_operations_ = true;
+      cb_->replica_changes_.clear();
+
+      TabletId tablet_id;
+      TabletServerId from_ts, to_ts;
+      if (!VERIFY_RESULT(cb_->HandleRemoveReplicas(&tablet_id, &from_ts)) &&
+          !VERIFY_RESULT(HandleAddReplicas(&tablet_id, &from_ts, &to_ts))) {
+        RETURN_NOT_OK(HandleLeaderMoves(&tablet_id, &from_ts, &to_ts));
+      }
+      if (cb_->replica_changes_.empty()) {
+        return round;
+      }
+
+      for (const auto& change : cb_->replica_changes_) {
+        auto tablet = tablet_map_.at(change.tablet_id);
+        if (!change.new_leader_uuid.empty()) {
+          MoveTabletLeader(tablet.get(), VERIFY_RESULT(FindTS(change.new_leader_uuid)));
+        } else if (change.is_add) {
+          auto drive_info = tablet->GetReplicaLocations()->begin()->second.drive_info;
+          AddRunningReplica(tablet.get(), VERIFY_RESULT(FindTS(change.ts_uuid)));
+          std::shared_ptr<TabletReplicaMap> replicas =
+            std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
+          replicas->at(change.ts_uuid).drive_info = drive_info;
+          tablet->SetReplicaLocations(replicas);
+        } else {
+          RemoveReplica(tablet.get(), VERIFY_RESULT(FindTS(change.ts_uuid)));
+        }
+      }
+    }
+    return max_rounds;
+  }
+
+  Result<std::shared_ptr<TSDescriptor>> FindTS(const TabletServerId& ts_uuid) {
+    for (const auto& ts_desc : ts_descs_) {
+      if (ts_desc->permanent_uuid() == ts_uuid) {
+        return ts_desc;
+      }
+    }
+    return STATUS_FORMAT(NotFound, "Unknown tablet server: $0", ts_uuid);
+  }
+
   // Clear the tablets_added_ field from the state, used for testing.
   void ClearTabletsAddedForTest() {
     cb_->state_->tablets_added_.clear();
@@ -400,6 +400,12 @@ DEFINE_int32(ysql_tablespace_info_refresh_secs, 30,
              "from pg catalog tables. A value of -1 disables the refresh task.");
 TAG_FLAG(ysql_tablespace_info_refresh_secs, runtime);
 
+DEFINE_bool(ysql_enable_packed_row, false,
+            "Whether YSQL tables created while this flag is set should store inserted rows in the "
+            "packed row format, i.e. all non-key columns of the row as a single DocDB value.");
+TAG_FLAG(ysql_enable_packed_row, advanced);
+TAG_FLAG(ysql_enable_packed_row, runtime);
+
 DEFINE_int64(tablet_split_size_threshold_bytes, 0,
              "DEPRECATED -- Threshold on tablet size after which tablet should be split. Automated "
              "splitting is disabled if this value is set to 0.");
@@ -424,6 +430,13 @@ DEFINE_int64(tablet_force_split_threshold_bytes, 100_GB,
              "tablets from forming in your cluster even if both automatic splitting phases have "
              "been finished.");
 
+DEFINE_double(tablet_split_load_threshold_ops_per_sec, 0,
+              "The number of read and write operations per second served by the tablet leader at "
+              "which to split the tablet regardless of its size. Such tablet is split at the point "
+              "that divides its load into halves. Load based splitting is disabled if this value "
+              "is set to 0.");
+TAG_FLAG(tablet_split_load_threshold_ops_per_sec, runtime);
+
 DEFINE_test_flag(bool, crash_server_on_sys_catalog_leader_affinity_move, false,
                  "When set, crash the master process if it performs a sys catalog leader affinity "
                  "move.");
@@ -2480,6 +2493,15 @@ bool CatalogManager::ShouldSplitValidCandidate(
   return size > FLAGS_tablet_force_split_threshold_bytes;
 }
 
+bool CatalogManager::ShouldSplitByLoad(
+    const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const {
+  auto threshold = GetAtomicFlag(&FLAGS_tablet_split_load_threshold_ops_per_sec);
+  if (threshold <= 0 || drive_info.may_have_orphaned_post_split_data) {
+    return false;
+  }
+  return drive_info.read_ops_per_sec + drive_info.write_ops_per_sec >= threshold;
+}
+
 Status CatalogManager::DoSplitTablet(
     const scoped_refptr<TabletInfo>& source_tablet_info, std::string split_encoded_key,
     std::string split_partition_key) {
@@ -2493,7 +2515,8 @@ Status CatalogManager::DoSplitTablet(
   RETURN_NOT_OK(ValidateSplitCandidate(*source_tablet_info));
 
   auto drive_info = VERIFY_RESULT(source_tablet_info->GetLeaderReplicaDriveInfo());
-  if (!ShouldSplitValidCandidate(*source_tablet_info, drive_info)) {
+  if (!ShouldSplitValidCandidate(*source_tablet_info, drive_info) &&
+      !ShouldSplitByLoad(*source_tablet_info, drive_info)) {
     // It is possible that we queued up a split candidate in TabletSplitManager which was, at the
     // time, a valid split candidate, but by the time the candidate was actually processed here, the
     // cluster may have changed, putting us in a new split threshold phase, and it may no longer be
@@ -2592,14 +2615,18 @@ void CatalogManager::SplitTabletWithKey(
 }
 
 Status CatalogManager::SplitTablet(const TabletId& tablet_id) {
-  LOG(INFO) << "Got tablet to split: " << tablet_id;
+  return SplitTablet(tablet_id, SplitByLoad::kFalse);
+}
+
+Status CatalogManager::SplitTablet(const TabletId& tablet_id, SplitByLoad split_by_load) {
+  LOG(INFO) << "Got tablet to split: " << tablet_id << ", by load: " << split_by_load;
 
   const auto tablet = VERIFY_RESULT(GetTabletInfo(tablet_id));
 
   VLOG(2) << "Scheduling GetSplitKey request to leader tserver for source tablet ID: "
           << tablet->tablet_id();
   auto call = std::make_shared<AsyncGetTabletSplitKey>(
-      master_, AsyncTaskPool(), tablet,
+      master_, AsyncTaskPool(), tablet, split_by_load,
       [this, tablet](const Result<AsyncGetTabletSplitKey::Data>& result) {
         if (result.ok()) {
           SplitTabletWithKey(tablet, result->split_encoded_key, result->split_partition_key);
@@ -3081,6 +3108,11 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
     schema.InitColumnIdsByDefault();
   }
 
+  // The storage format is fixed at creation, so tablets of other tables never look for packed rows.
+  if (is_pg_table && !is_pg_catalog_table && FLAGS_ysql_enable_packed_row) {
+    schema.SetPackedRow(true);
+  }
+
   if (schema.table_properties().HasCopartitionTableId()) {
     return CreateCopartitionedTable(req, resp, rpc, schema, ns);
   }
@@ -10260,7 +10292,9 @@ void CatalogManager::ProcessTabletStorageMetadata(
         storage_metadata.sst_file_size(),
         storage_metadata.wal_file_size(),
         storage_metadata.uncompressed_sst_file_size(),
-        storage_metadata.may_have_orphaned_post_split_data()};
+        storage_metadata.may_have_orphaned_post_split_data(),
+        storage_metadata.read_ops_per_sec(),
+        storage_metadata.write_ops_per_sec()};
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
   WARN_NOT_OK(
         tablet_split_manager_.ProcessLiveTablet(*tablet, ts_uuid, drive_info),
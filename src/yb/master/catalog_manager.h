@@ -762,6 +762,8 @@ class CatalogManager :
 
   CHECKED_STATUS SplitTablet(const TabletId& tablet_id) override;
 
+  CHECKED_STATUS SplitTablet(const TabletId& tablet_id, SplitByLoad split_by_load) override;
+
   // Splits tablet specified in the request using middle of the partition as a split point.
   CHECKED_STATUS SplitTablet(
       const SplitTabletRequestPB* req, SplitTabletResponsePB* resp, rpc::RpcContext* rpc);
@@ -823,6 +825,9 @@ class CatalogManager :
   bool ShouldSplitValidCandidate(
       const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const override;
 
+  bool ShouldSplitByLoad(
+      const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const override;
+
   BlacklistSet BlacklistSetFromPB() const override;
 
  protected:
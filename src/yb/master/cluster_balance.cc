@@ -33,6 +33,7 @@
 #include "yb/master/master_error.h"
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -135,6 +136,22 @@ DEFINE_bool(load_balancer_ignore_cloud_info_similarity, false,
             "If true, ignore the similarity between cloud infos when deciding which tablet "
             "to move.");
 
+DEFINE_bool(load_balancer_throughput_aware, false,
+            "When tablet and leader counts are balanced, also move tablets and leaders between "
+            "tablet servers to equalize the cost of the load they serve. The cost is estimated "
+            "from the operations per second and SST file sizes reported by tablet servers.");
+TAG_FLAG(load_balancer_throughput_aware, advanced);
+
+DEFINE_double(load_balancer_cost_unit_ops_per_sec, 1000,
+              "Number of tablet operations per second that cost as much as serving one more "
+              "tablet replica, used by throughput aware load balancing.");
+TAG_FLAG(load_balancer_cost_unit_ops_per_sec, advanced);
+
+DEFINE_int64(load_balancer_cost_unit_sst_bytes, 10_GB,
+             "Size of tablet SST files that costs as much as serving one more tablet replica, "
+             "used by throughput aware load balancing.");
+TAG_FLAG(load_balancer_cost_unit_sst_bytes, advanced);
+
 // TODO(tsplit): make false by default or even remove flag after
 // https://github.com/yugabyte/yugabyte-db/issues/10301 is fixed.
 DEFINE_test_flag(
@@ -202,6 +219,52 @@ std::vector<std::pair<TabletId, std::string>> GetLeadersOnTSToMove(
   return intersection;
 }
 
+struct CostMoveCandidate {
+  TabletId tablet_id;
+  double cost;
+  // Path of the replica on the destination TS, used by leader moves.
+  std::string to_path;
+
+  bool operator<(const CostMoveCandidate& rhs) const {
+    return cost < rhs.cost;
+  }
+};
+
+// Picks a move from the higher cost TS, or a swap of moves between the higher and the lower cost
+// TS, that brings costs of these TSs closest to each other. Does not pick anything, if no move
+// reduces the cost variance.
+void PickCostMove(double cost_variance, bool allow_single_move,
+                  const std::vector<CostMoveCandidate>& from_high,
+                  std::vector<CostMoveCandidate>* from_low,
+                  const CostMoveCandidate** high_move, const CostMoveCandidate** low_move) {
+  *high_move = nullptr;
+  *low_move = nullptr;
+  std::sort(from_low->begin(), from_low->end());
+  // Moving cost delta from the higher cost TS to the lower cost TS changes the variance to
+  // cost_variance - 2 * delta.
+  double best_variance = cost_variance;
+  for (const auto& high : from_high) {
+    if (allow_single_move && std::abs(cost_variance - 2 * high.cost) < best_variance) {
+      best_variance = std::abs(cost_variance - 2 * high.cost);
+      *high_move = &high;
+      *low_move = nullptr;
+    }
+    CostMoveCandidate target { TabletId(), high.cost - cost_variance / 2, std::string() };
+    auto it = std::lower_bound(from_low->begin(), from_low->end(), target);
+    for (auto candidate : {it, it == from_low->begin() ? from_low->end() : std::prev(it)}) {
+      if (candidate == from_low->end()) {
+        continue;
+      }
+      double variance = std::abs(cost_variance - 2 * (high.cost - candidate->cost));
+      if (variance < best_variance) {
+        best_variance = variance;
+        *high_move = &high;
+        *low_move = &*candidate;
+      }
+    }
+  }
+}
+
 } // namespace
 
 Result<ReplicationInfoPB> ClusterLoadBalancer::GetTableReplicationInfo(
@@ -835,6 +898,11 @@ Result<bool> ClusterLoadBalancer::HandleAddReplicas(
 
   // Finally, handle normal load balancing.
   if (!VERIFY_RESULT(GetLoadToMove(out_tablet_id, out_from_ts, out_to_ts))) {
+    // Tablet counts are balanced, try to balance the cost of the load served by tablet servers.
+    if (state_->options_->kThroughputAware &&
+        VERIFY_RESULT(GetCostLoadToMove(out_tablet_id, out_from_ts, out_to_ts))) {
+      return true;
+    }
     VLOG(1) << "Cannot find any more tablets to move, under current constraints.";
     if (VLOG_IS_ON(1)) {
       DumpSortedLoad();
@@ -1180,6 +1248,202 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(TabletId* moving_tablet_id,
   FATAL_ERROR("Load balancing algorithm reached invalid state!");
 }
 
+Result<bool> ClusterLoadBalancer::GetCostLoadToMove(
+    TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts) {
+  if (state_->sorted_load_.size() < 2 || !CanBalanceGlobalLoad()) {
+    return false;
+  }
+
+  // Tablet counts are already balanced here, so we go through TSs sorted by global load cost and
+  // try to move a cheap enough tablet from the higher cost TS to the lower cost TS. The move could
+  // break the balance of tablet counts, so when the higher cost TS does not have more tablets than
+  // the lower cost TS, the move is paired with a move of a cheaper tablet in the opposite
+  // direction. The move is made only if it reduces the cost variance of these two TSs.
+  std::vector<TabletServerId> sorted_cost = state_->sorted_load_;
+  std::sort(sorted_cost.begin(), sorted_cost.end(),
+            [this](const TabletServerId& lhs, const TabletServerId& rhs) {
+    return global_state_->GetGlobalCost(lhs) < global_state_->GetGlobalCost(rhs);
+  });
+
+  int last_pos = sorted_cost.size() - 1;
+  for (int left = 0; left < last_pos; ++left) {
+    const TabletServerId& low_cost_uuid = sorted_cost[left];
+    for (int right = last_pos; right > left; --right) {
+      const TabletServerId& high_cost_uuid = sorted_cost[right];
+      double cost_variance = global_state_->GetGlobalCost(high_cost_uuid) -
+                             global_state_->GetGlobalCost(low_cost_uuid);
+      if (cost_variance < state_->options_->kMinCostVarianceToBalance) {
+        // TSs between left and right have even lower cost variance.
+        break;
+      }
+      bool allow_single_move =
+          state_->GetLoad(high_cost_uuid) > state_->GetLoad(low_cost_uuid) &&
+          global_state_->GetGlobalLoad(high_cost_uuid) >
+              global_state_->GetGlobalLoad(low_cost_uuid);
+
+      std::vector<CostMoveCandidate> from_high;
+      for (const auto& tablet_id : state_->per_ts_meta_[high_cost_uuid].running_tablets) {
+        if (VERIFY_RESULT(CanMoveReplicaByCost(tablet_id, high_cost_uuid, low_cost_uuid))) {
+          from_high.push_back({tablet_id, state_->GetReplicaCost(tablet_id), std::string()});
+        }
+      }
+      if (from_high.empty()) {
+        continue;
+      }
+      std::vector<CostMoveCandidate> from_low;
+      for (const auto& tablet_id : state_->per_ts_meta_[low_cost_uuid].running_tablets) {
+        if (VERIFY_RESULT(CanMoveReplicaByCost(tablet_id, low_cost_uuid, high_cost_uuid))) {
+          from_low.push_back({tablet_id, state_->GetReplicaCost(tablet_id), std::string()});
+        }
+      }
+
+      const CostMoveCandidate* high_move;
+      const CostMoveCandidate* low_move;
+      PickCostMove(cost_variance, allow_single_move, from_high, &from_low, &high_move, &low_move);
+      if (!high_move) {
+        continue;
+      }
+
+      *moving_tablet_id = high_move->tablet_id;
+      *from_ts = high_cost_uuid;
+      *to_ts = low_cost_uuid;
+      LOG(INFO) << "Balancing load cost " << cost_variance << " between TS " << high_cost_uuid
+                << " and TS " << low_cost_uuid << ", moving tablet " << high_move->tablet_id
+                << (low_move ? " in exchange for tablet " + low_move->tablet_id : std::string());
+      RETURN_NOT_OK(MoveReplica(high_move->tablet_id, high_cost_uuid, low_cost_uuid));
+      cost_moved_from_[high_move->tablet_id] = high_cost_uuid;
+      if (low_move) {
+        RETURN_NOT_OK(MoveReplica(low_move->tablet_id, low_cost_uuid, high_cost_uuid));
+        cost_moved_from_[low_move->tablet_id] = low_cost_uuid;
+      }
+      // Reported load does not reflect this move yet, so wait until the load balancer is idle
+      // before making another cost based move.
+      can_perform_global_operations_ = false;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Result<bool> ClusterLoadBalancer::CanMoveReplicaByCost(
+    const TabletId& tablet_id, const TabletServerId& from_ts, const TabletServerId& to_ts) {
+  if (state_->tablets_over_replicated_.count(tablet_id) ||
+      ContainsKey(state_->per_ts_meta_[from_ts].disabled_by_ts_tablets, tablet_id)) {
+    return false;
+  }
+  // Leaders are balanced by cost separately, moving a leader replica would also move the cost of
+  // its leadership.
+  if (state_->per_tablet_meta_[tablet_id].leader_uuid == from_ts) {
+    return false;
+  }
+  const auto& placement_info = GetPlacementByTablet(tablet_id);
+  if (!VERIFY_RESULT(state_->CanAddTabletToTabletServer(tablet_id, to_ts, &placement_info))) {
+    return false;
+  }
+  if (placement_info.placement_blocks().empty()) {
+    return true;
+  }
+  // Same as in GetTabletToMove, keep the distribution of the tablet over placement blocks.
+  auto from_ts_block = state_->GetValidPlacement(from_ts, &placement_info);
+  auto to_ts_block = state_->GetValidPlacement(to_ts, &placement_info);
+  return from_ts_block.has_value() && to_ts_block.has_value() &&
+         TSDescriptor::generate_placement_id(*from_ts_block) ==
+             TSDescriptor::generate_placement_id(*to_ts_block);
+}
+
+Result<bool> ClusterLoadBalancer::GetCostLeaderToMove(
+    TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts) {
+  if (!CanBalanceGlobalLoad()) {
+    return false;
+  }
+
+  // Same as GetCostLoadToMove, but moves leaders between TSs that host replicas of both tablets.
+  std::vector<TabletServerId> sorted_cost;
+  for (const auto& ts_uuid : state_->sorted_leader_load_) {
+    if (!state_->leader_blacklisted_servers_.count(ts_uuid)) {
+      sorted_cost.push_back(ts_uuid);
+    }
+  }
+  std::sort(sorted_cost.begin(), sorted_cost.end(),
+            [this](const TabletServerId& lhs, const TabletServerId& rhs) {
+    return global_state_->GetGlobalCost(lhs) < global_state_->GetGlobalCost(rhs);
+  });
+
+  auto leaders_to_move = [this](const TabletServerId& from_uuid, const TabletServerId& to_uuid) {
+    std::vector<CostMoveCandidate> result;
+    for (const auto& tablet : GetLeadersOnTSToMove(global_state_->drive_aware_,
+                                                   state_->per_ts_meta_[from_uuid].leaders,
+                                                   state_->per_ts_meta_[to_uuid])) {
+      if (CanMoveLeaderTo(tablet.first, to_uuid)) {
+        result.push_back({tablet.first, state_->GetLeaderCost(tablet.first), tablet.second});
+      }
+    }
+    return result;
+  };
+
+  int last_pos = sorted_cost.size() - 1;
+  for (int left = 0; left < last_pos; ++left) {
+    const TabletServerId& low_cost_uuid = sorted_cost[left];
+    for (int right = last_pos; right > left; --right) {
+      const TabletServerId& high_cost_uuid = sorted_cost[right];
+      double cost_variance = global_state_->GetGlobalCost(high_cost_uuid) -
+                             global_state_->GetGlobalCost(low_cost_uuid);
+      if (cost_variance < state_->options_->kMinCostVarianceToBalance) {
+        break;
+      }
+      bool allow_single_move =
+          state_->GetLeaderLoad(high_cost_uuid) > state_->GetLeaderLoad(low_cost_uuid) &&
+          global_state_->GetGlobalLeaderLoad(high_cost_uuid) >
+              global_state_->GetGlobalLeaderLoad(low_cost_uuid);
+
+      auto from_high = leaders_to_move(high_cost_uuid, low_cost_uuid);
+      if (from_high.empty()) {
+        continue;
+      }
+      auto from_low = leaders_to_move(low_cost_uuid, high_cost_uuid);
+
+      const CostMoveCandidate* high_move;
+      const CostMoveCandidate* low_move;
+      PickCostMove(cost_variance, allow_single_move, from_high, &from_low, &high_move, &low_move);
+      if (!high_move) {
+        continue;
+      }
+
+      *moving_tablet_id = high_move->tablet_id;
+      *from_ts = high_cost_uuid;
+      *to_ts = low_cost_uuid;
+      LOG(INFO) << "Balancing leader cost " << cost_variance << " between TS " << high_cost_uuid
+                << " and TS " << low_cost_uuid << ", moving leader of " << high_move->tablet_id
+                << (low_move ? " in exchange for leader of " + low_move->tablet_id
+                             : std::string());
+      RETURN_NOT_OK(MoveLeader(
+          high_move->tablet_id, high_cost_uuid, low_cost_uuid, high_move->to_path));
+      if (low_move) {
+        RETURN_NOT_OK(MoveLeader(
+            low_move->tablet_id, low_cost_uuid, high_cost_uuid, low_move->to_path));
+      }
+      can_perform_global_operations_ = false;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ClusterLoadBalancer::CanMoveLeaderTo(
+    const TabletId& tablet_id, const TabletServerId& to_ts) const {
+  auto tablet_meta_iter = state_->per_tablet_meta_.find(tablet_id);
+  if (tablet_meta_iter == state_->per_tablet_meta_.end()) {
+    return false;
+  }
+  const auto& stepdown_failures = tablet_meta_iter->second.leader_stepdown_failures;
+  auto stepdown_failure_iter = stepdown_failures.find(to_ts);
+  return stepdown_failure_iter == stepdown_failures.end() ||
+         (MonoTime::Now() - stepdown_failure_iter->second).ToMilliseconds() >=
+             FLAGS_min_leader_stepdown_retry_interval_ms;
+}
+
 Result<bool> ClusterLoadBalancer::HandleRemoveReplicas(
     TabletId* out_tablet_id, TabletServerId* out_from_ts) {
   // Give high priority to removing tablets that are not respecting the placement policy.
@@ -1210,6 +1474,16 @@ Result<bool> ClusterLoadBalancer::HandleRemoveReplicas(
     }
     // Sort in reverse to first try to remove a replica from the highest loaded TS.
     sort(sorted_ts.rbegin(), sorted_ts.rend(), comparator);
+    // Tablet counts do not tell which replica should be removed after a cost based move, it
+    // should be the one the tablet was moved from.
+    auto cost_moved_from_it = cost_moved_from_.find(tablet_id);
+    if (cost_moved_from_it != cost_moved_from_.end()) {
+      auto it = std::find(sorted_ts.begin(), sorted_ts.end(), cost_moved_from_it->second);
+      if (it != sorted_ts.end()) {
+        std::iter_swap(sorted_ts.begin(), it);
+      }
+      cost_moved_from_.erase(cost_moved_from_it);
+    }
     string remove_candidate = sorted_ts[0];
     *out_tablet_id = tablet_id;
     *out_from_ts = remove_candidate;
@@ -1314,6 +1588,11 @@ Result<bool> ClusterLoadBalancer::HandleLeaderMoves(
     RETURN_NOT_OK(MoveLeader(*out_tablet_id, *out_from_ts, *out_to_ts, out_ts_ts_path));
     return true;
   }
+  // Leader counts are balanced, try to balance the cost of the load served by leaders.
+  if (state_->options_->kThroughputAware &&
+      VERIFY_RESULT(GetCostLeaderToMove(out_tablet_id, out_from_ts, out_to_ts))) {
+    return true;
+  }
   return false;
 }
 
@@ -285,6 +285,33 @@ class ClusterLoadBalancer {
                                TabletServerId* to_ts,
                                std::string* to_ts_path);
 
+  // Used when tablet counts are balanced. Go through TSs sorted by global load cost and move a
+  // tablet from a TS with higher cost to a TS with lower cost, or swap two tablets between them,
+  // without breaking the balance of tablet counts.
+  //
+  // Returns true if a move was actually made and sets the three output parameters to the tablet
+  // moved from the higher cost TS.
+  Result<bool> GetCostLoadToMove(
+      TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts)
+      REQUIRES_SHARED(catalog_manager_->mutex_);
+
+  // Used when leader counts are balanced. Same as GetCostLoadToMove, but for leaders.
+  //
+  // Returns true if a move was actually made and sets the three output parameters to the leader
+  // moved from the higher cost TS.
+  Result<bool> GetCostLeaderToMove(
+      TabletId* moving_tablet_id, TabletServerId* from_ts, TabletServerId* to_ts)
+      REQUIRES_SHARED(catalog_manager_->mutex_);
+
+  // Whether a replica of the tablet could be moved from from_ts to to_ts to balance load cost.
+  Result<bool> CanMoveReplicaByCost(
+      const TabletId& tablet_id, const TabletServerId& from_ts, const TabletServerId& to_ts)
+      REQUIRES_SHARED(catalog_manager_->mutex_);
+
+  // Whether a leader of the tablet could be moved to to_ts, i.e. there was no recent failure to
+  // step down to it.
+  bool CanMoveLeaderTo(const TabletId& tablet_id, const TabletServerId& to_ts) const;
+
   // Issue the change config and modify the in-memory state for moving a replica from one tablet
   // server to another.
   CHECKED_STATUS MoveReplica(
@@ -401,6 +428,10 @@ class ClusterLoadBalancer {
   // once we perform a non-global move.
   bool can_perform_global_operations_ = false;
 
+  // Tablet servers that replicas were moved from to balance load cost, by tablet. Used to remove
+  // the replica from the right tablet server once the tablet becomes over-replicated.
+  std::unordered_map<TabletId, TabletServerId> cost_moved_from_;
+
   // Record load balancer activity for tables and tservers.
   void RecordActivity(uint32_t master_errors) REQUIRES_SHARED(catalog_manager_->mutex_);
 
@@ -58,10 +58,18 @@ class ClusterLoadBalancerMocked : public ClusterLoadBalancer {
   const BlacklistPB& GetServerBlacklist() const override { return blacklist_; }
   const BlacklistPB& GetLeaderBlacklist() const override { return leader_blacklist_; }
 
+  // Change sent by the load balancer, recorded so that tests could apply it to the tablet map.
+  struct ReplicaChange {
+    TabletId tablet_id;
+    TabletServerId ts_uuid;
+    bool is_add;
+    TabletServerId new_leader_uuid;
+  };
+
   Status SendReplicaChanges(scoped_refptr<TabletInfo> tablet, const TabletServerId& ts_uuid,
                           const bool is_add, const bool should_remove,
                           const TabletServerId& new_leader_uuid) override {
-    // Do nothing.
+    replica_changes_.push_back({tablet->tablet_id(), ts_uuid, is_add, new_leader_uuid});
     return Status::OK();
   }
 
@@ -111,6 +119,7 @@ class ClusterLoadBalancerMocked : public ClusterLoadBalancer {
   vector<TabletId> pending_add_replica_tasks_;
   vector<TabletId> pending_remove_replica_tasks_;
   vector<TabletId> pending_stepdown_leader_tasks_;
+  vector<ReplicaChange> replica_changes_;
 
   friend class TestLoadBalancerEnterprise;
 };
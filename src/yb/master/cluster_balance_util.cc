@@ -49,7 +49,8 @@ std::string CBTabletMetadata::ToString() const {
       running, starting, is_under_replicated, under_replicated_placements,
       is_over_replicated, over_replicated_tablet_servers,
       wrong_placement_tablet_servers, blacklisted_tablet_servers,
-      leader_uuid, leader_stepdown_failures, leader_blacklisted_tablet_servers);
+      leader_uuid, leader_stepdown_failures, leader_blacklisted_tablet_servers,
+      read_ops_per_sec, write_ops_per_sec, sst_files_size);
 }
 
 int GlobalLoadState::GetGlobalLoad(const TabletServerId& ts_uuid) const {
@@ -62,6 +63,10 @@ int GlobalLoadState::GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const {
   return ts_meta.leaders_count;
 }
 
+double GlobalLoadState::GetGlobalCost(const TabletServerId& ts_uuid) const {
+  return per_ts_global_meta_.at(ts_uuid).cost;
+}
+
 PerTableLoadState::PerTableLoadState(GlobalLoadState* global_state)
     : leader_balance_threshold_(FLAGS_leader_balance_threshold),
       current_time_(MonoTime::Now()),
@@ -117,6 +122,31 @@ int PerTableLoadState::GetLeaderLoad(const TabletServerId& ts_uuid) const {
   return per_ts_meta_.at(ts_uuid).leaders.size();
 }
 
+double PerTableLoadState::GetReplicaCost(const TabletId& tablet_id) const {
+  double result = 1;
+  auto it = per_tablet_meta_.find(tablet_id);
+  if (it == per_tablet_meta_.end()) {
+    return result;
+  }
+  const auto& tablet_meta = it->second;
+  if (options_->kCostUnitOpsPerSec > 0) {
+    result += tablet_meta.write_ops_per_sec / options_->kCostUnitOpsPerSec;
+  }
+  if (options_->kCostUnitSstBytes > 0) {
+    result += static_cast<double>(tablet_meta.sst_files_size) / options_->kCostUnitSstBytes;
+  }
+  return result;
+}
+
+double PerTableLoadState::GetLeaderCost(const TabletId& tablet_id) const {
+  auto it = per_tablet_meta_.find(tablet_id);
+  if (it == per_tablet_meta_.end() || options_->kCostUnitOpsPerSec <= 0) {
+    return 0;
+  }
+  return (it->second.read_ops_per_sec + it->second.write_ops_per_sec) /
+         options_->kCostUnitOpsPerSec;
+}
+
 Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
   const auto& tablet_id = tablet->id();
   // Set the per-tablet entry to empty default and get the reference for filling up information.
@@ -127,6 +157,18 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
 
   // Get replicas for this tablet.
   auto replica_map = GetReplicaLocations(tablet);
+
+  // Take the number of operations from the leader and the size from the largest replica, so the
+  // cost of a replica does not depend on the tablet server that hosts it.
+  for (const auto& replica_it : *replica_map) {
+    const auto& drive_info = replica_it.second.drive_info;
+    tablet_meta.sst_files_size = std::max(tablet_meta.sst_files_size, drive_info.sst_files_size);
+    if (replica_it.second.role == PeerRole::LEADER) {
+      tablet_meta.read_ops_per_sec = drive_info.read_ops_per_sec;
+      tablet_meta.write_ops_per_sec = drive_info.write_ops_per_sec;
+    }
+  }
+
   // Set state information for both the tablet and the tablet server replicas.
   for (const auto& replica_it : *replica_map) {
     const auto& ts_uuid = replica_it.first;
@@ -723,7 +765,9 @@ Status PerTableLoadState::AddRunningTablet(const TabletId& tablet_id,
   auto& meta_ts = per_ts_meta_.at(ts_uuid);
   auto ret = meta_ts.running_tablets.insert(tablet_id);
   if (ret.second) {
-    ++global_state_->per_ts_global_meta_[ts_uuid].running_tablets_count;
+    auto& global_meta_ts = global_state_->per_ts_global_meta_[ts_uuid];
+    ++global_meta_ts.running_tablets_count;
+    global_meta_ts.cost += GetReplicaCost(tablet_id);
     ++total_running_;
     ++per_tablet_meta_[tablet_id].running;
   }
@@ -743,7 +787,9 @@ Status PerTableLoadState::RemoveRunningTablet(
       "Could not find running tablet to remove: ts_uuid: $0, tablet_id: $1",
       ts_uuid, tablet_id);
   }
-  global_state_->per_ts_global_meta_[ts_uuid].running_tablets_count -= num_erased;
+  auto& global_meta_ts = global_state_->per_ts_global_meta_[ts_uuid];
+  global_meta_ts.running_tablets_count -= num_erased;
+  global_meta_ts.cost -= GetReplicaCost(tablet_id);
   total_running_ -= num_erased;
   per_tablet_meta_[tablet_id].running -= num_erased;
   bool found = false;
@@ -763,7 +809,9 @@ Status PerTableLoadState::AddStartingTablet(
           Format(uninitialized_ts_meta_format_msg, ts_uuid, table_id_));
   auto ret = per_ts_meta_.at(ts_uuid).starting_tablets.insert(tablet_id);
   if (ret.second) {
-    ++global_state_->per_ts_global_meta_[ts_uuid].starting_tablets_count;
+    auto& global_meta_ts = global_state_->per_ts_global_meta_[ts_uuid];
+    ++global_meta_ts.starting_tablets_count;
+    global_meta_ts.cost += GetReplicaCost(tablet_id);
     ++total_starting_;
     ++global_state_->total_starting_tablets_;
     ++per_tablet_meta_[tablet_id].starting;
@@ -782,7 +830,9 @@ Status PerTableLoadState::AddLeaderTablet(
   auto& meta_ts = per_ts_meta_.at(ts_uuid);
   auto ret = meta_ts.leaders.insert(tablet_id);
   if (ret.second) {
-    ++global_state_->per_ts_global_meta_[ts_uuid].leaders_count;
+    auto& global_meta_ts = global_state_->per_ts_global_meta_[ts_uuid];
+    ++global_meta_ts.leaders_count;
+    global_meta_ts.cost += GetLeaderCost(tablet_id);
   }
   meta_ts.path_to_leaders[ts_path].insert(tablet_id);
   return Status::OK();
@@ -793,7 +843,11 @@ Status PerTableLoadState::RemoveLeaderTablet(
   SCHECK(per_ts_meta_.find(ts_uuid) != per_ts_meta_.end(), IllegalState,
           Format(uninitialized_ts_meta_format_msg, ts_uuid, table_id_));
   int num_erased = per_ts_meta_.at(ts_uuid).leaders.erase(tablet_id);
-  global_state_->per_ts_global_meta_[ts_uuid].leaders_count -= num_erased;
+  if (num_erased) {
+    auto& global_meta_ts = global_state_->per_ts_global_meta_[ts_uuid];
+    global_meta_ts.leaders_count -= num_erased;
+    global_meta_ts.cost -= GetLeaderCost(tablet_id);
+  }
   return Status::OK();
 }
 
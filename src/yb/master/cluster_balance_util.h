@@ -40,6 +40,12 @@ DECLARE_int32(load_balancer_max_concurrent_moves);
 
 DECLARE_int32(load_balancer_max_concurrent_moves_per_table);
 
+DECLARE_bool(load_balancer_throughput_aware);
+
+DECLARE_double(load_balancer_cost_unit_ops_per_sec);
+
+DECLARE_int64(load_balancer_cost_unit_sst_bytes);
+
 namespace yb {
 namespace master {
 
@@ -120,6 +126,13 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Number of operations per second served by this tablet, as reported by its leader.
+  double read_ops_per_sec = 0;
+  double write_ops_per_sec = 0;
+
+  // Size of the SST files of the largest replica of this tablet.
+  uint64_t sst_files_size = 0;
+
   std::string ToString() const;
 };
 
@@ -167,6 +180,8 @@ struct CBTabletServerLoadCounts {
   int running_tablets_count = 0;
   int starting_tablets_count = 0;
   int leaders_count = 0;
+  // Cost of the load served by the tablet server, see PerTableLoadState::GetReplicaCost.
+  double cost = 0;
 };
 
 struct Options {
@@ -184,6 +199,19 @@ struct Options {
   // If variance between global leader load on TS goes past this number, we should try to balance.
   double kMinGlobalLeaderLoadVarianceToBalance = 2.0;
 
+  // Whether to move tablets and leaders between TS to equalize the cost of their load, once tablet
+  // and leader counts are balanced.
+  bool kThroughputAware = FLAGS_load_balancer_throughput_aware;
+
+  // If variance between global load cost on TS goes past this number, we should try to balance.
+  double kMinCostVarianceToBalance = 2.0;
+
+  // Number of operations per second that cost as much as serving one more tablet replica.
+  double kCostUnitOpsPerSec = FLAGS_load_balancer_cost_unit_ops_per_sec;
+
+  // Size of SST files that costs as much as serving one more tablet replica.
+  int64_t kCostUnitSstBytes = FLAGS_load_balancer_cost_unit_sst_bytes;
+
   // Whether to limit the number of tablets being spun up on the cluster at any given time.
   bool kAllowLimitStartingTablets = true;
 
@@ -236,6 +264,9 @@ class GlobalLoadState {
   // Get global leader load for a certain TS.
   int GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Get the global cost of the load served by a certain TS.
+  double GetGlobalCost(const TabletServerId& ts_uuid) const;
+
   // Used to determine how many tablets are being remote bootstrapped across the cluster.
   int total_starting_tablets_ = 0;
 
@@ -291,6 +322,14 @@ class PerTableLoadState {
   // Get the load for a certain TS.
   int GetLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Get the cost of serving a replica of the tablet. An idle replica costs 1, every replica also
+  // pays for applying writes of the tablet and for the size of its SST files.
+  double GetReplicaCost(const TabletId& tablet_id) const;
+
+  // Get the additional cost of serving the tablet as a leader, i.e. of processing its reads and
+  // writes.
+  double GetLeaderCost(const TabletId& tablet_id) const;
+
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
   void SetLeaderBlacklist(const BlacklistPB& leader_blacklist) {
     leader_blacklist_ = leader_blacklist;
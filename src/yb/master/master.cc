@@ -259,6 +259,7 @@ Status Master::RegisterServices() {
       std::make_unique<tserver::PgClientServiceImpl>(
           client_future(), std::bind(&Master::TransactionPool, this),
           metric_entity(),
+          nullptr /* shared_data */,
           &messenger()->scheduler())));
 
   return Status::OK();
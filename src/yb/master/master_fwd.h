@@ -107,6 +107,8 @@ YB_STRONGLY_TYPED_BOOL(RegisteredThroughHeartbeat);
 
 YB_STRONGLY_TYPED_BOOL(IncludeInactive);
 
+YB_STRONGLY_TYPED_BOOL(SplitByLoad);
+
 YB_DEFINE_ENUM(
     CollectFlag, (kAddIndexes)(kIncludeParentColocatedTable)(kSucceedIfCreateInProgress));
 using CollectFlags = EnumBitSet<CollectFlag>;
@@ -33,6 +33,9 @@ class TabletSplitCandidateFilterIf {
   // Returns true if we should split a tablet based on the provided drive_info.
   virtual bool ShouldSplitValidCandidate(
       const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const = 0;
+  // Returns true if we should split a tablet because of the load reported in drive_info.
+  virtual bool ShouldSplitByLoad(
+      const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const = 0;
 };
 
 }  // namespace master
@@ -19,6 +19,8 @@
 
 #include "yb/common/entity_ids_types.h"
 
+#include "yb/master/master_fwd.h"
+
 #include "yb/util/status_fwd.h"
 
 namespace yb {
@@ -27,7 +29,9 @@ namespace master {
 class TabletSplitDriverIf {
  public:
   virtual ~TabletSplitDriverIf() {}
-  virtual CHECKED_STATUS SplitTablet(const TabletId& tablet_id) = 0;
+  // When split_by_load is true, the tablet is split at the point that halves its load instead of
+  // its data.
+  virtual CHECKED_STATUS SplitTablet(const TabletId& tablet_id, SplitByLoad split_by_load) = 0;
 };
 
 }  // namespace master
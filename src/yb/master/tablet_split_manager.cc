@@ -21,6 +21,7 @@
 #include "yb/master/cdc_consumer_split_driver.h"
 #include "yb/master/ts_descriptor.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/status_log.h"
 #include "yb/util/unique_lock.h"
@@ -44,6 +45,11 @@ DEFINE_int32(outstanding_tablet_split_limit, 5,
              "Limit of the number of outstanding tablet splits. Limitation is disabled if this "
              "value is set to 0.");
 
+DEFINE_int32(tablet_split_load_cooldown_sec, 300,
+             "Minimal time between two splits by load of tablets of the same table, so the load "
+             "of the new tablets is reported to master before the next split is considered.");
+TAG_FLAG(tablet_split_load_cooldown_sec, runtime);
+
 constexpr int32 kHardLimitCandidateQueueSize = 100;
 
 namespace yb {
@@ -167,25 +173,52 @@ Status TabletSplitManager::ProcessLiveTablet(
   }
 
   auto tablet_id = tablet_info.tablet_id();
-  if (std::find(candidates_.begin(), candidates_.end(), tablet_id) != candidates_.end()) {
+  auto it = std::find_if(
+      candidates_.begin(), candidates_.end(),
+      [&tablet_id](const SplitCandidate& candidate) { return candidate.tablet_id == tablet_id; });
+  if (it != candidates_.end()) {
     return Status::OK();
   }
   auto is_tablet_leader_drive_info = (
       VERIFY_RESULT(tablet_info.GetLeader())->permanent_uuid() == drive_info_ts_uuid);
-  if (is_tablet_leader_drive_info
-      && filter_->ValidateSplitCandidate(tablet_info).ok()
-      && filter_->ShouldSplitValidCandidate(tablet_info, drive_info)) {
-    auto all_replicas_finished_compacting = all_replicas_finished_compacting_opt.has_value()
-      ? *all_replicas_finished_compacting_opt : AllReplicasHaveFinshedCompaction(tablet_info);
-    if (!all_replicas_finished_compacting) {
+  if (!is_tablet_leader_drive_info || !filter_->ValidateSplitCandidate(tablet_info).ok()) {
+    return Status::OK();
+  }
+  SplitByLoad split_by_load = SplitByLoad::kFalse;
+  if (!filter_->ShouldSplitValidCandidate(tablet_info, drive_info)) {
+    if (!filter_->ShouldSplitByLoad(tablet_info, drive_info) ||
+        IsLoadSplitCoolingDown(tablet_info.table()->id())) {
       return Status::OK();
     }
-    LOG(INFO) << "Adding tablet into split queue: " << tablet_id;
-    candidates_.push_back(tablet_id);
+    split_by_load = SplitByLoad::kTrue;
   }
+  auto all_replicas_finished_compacting = all_replicas_finished_compacting_opt.has_value()
+    ? *all_replicas_finished_compacting_opt : AllReplicasHaveFinshedCompaction(tablet_info);
+  if (!all_replicas_finished_compacting) {
+    return Status::OK();
+  }
+  LOG(INFO) << "Adding tablet into split queue: " << tablet_id << ", by load: " << split_by_load;
+  candidates_.push_back(SplitCandidate {
+    .tablet_id = tablet_id,
+    .table_id = tablet_info.table()->id(),
+    .split_by_load = split_by_load,
+  });
   return Status::OK();
 }
 
+bool TabletSplitManager::IsLoadSplitCoolingDown(const TableId& table_id) {
+  auto it = last_load_split_time_.find(table_id);
+  if (it == last_load_split_time_.end()) {
+    return false;
+  }
+  if (CoarseMonoClock::Now() - it->second <
+          std::chrono::seconds(GetAtomicFlag(&FLAGS_tablet_split_load_cooldown_sec))) {
+    return true;
+  }
+  last_load_split_time_.erase(it);
+  return false;
+}
+
 void TabletSplitManager::ProcessQueuedSplitItems() {
   if (PREDICT_FALSE(FLAGS_TEST_disable_split_tablet_candidate_processing)) {
     return;
@@ -197,13 +230,17 @@ void TabletSplitManager::ProcessQueuedSplitItems() {
         processing_tablets_to_split_children_.size() >= FLAGS_outstanding_tablet_split_limit) {
       return;
     }
-    auto tablet_id = candidates_.front();
-    auto s = driver_->SplitTablet(tablet_id);
-    WARN_NOT_OK(s, Format("Failed to trigger split for tablet_id: $0.", tablet_id));
+    auto candidate = std::move(candidates_.front());
     candidates_.pop_front();
+    const auto& tablet_id = candidate.tablet_id;
+    auto s = driver_->SplitTablet(tablet_id, candidate.split_by_load);
+    WARN_NOT_OK(s, Format("Failed to trigger split for tablet_id: $0.", tablet_id));
 
     if (s.ok()) {
       processing_tablets_to_split_children_.insert({tablet_id, ""});
+      if (candidate.split_by_load) {
+        last_load_split_time_[candidate.table_id] = CoarseMonoClock::Now();
+      }
     }
   }
 }
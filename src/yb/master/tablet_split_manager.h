@@ -23,6 +23,7 @@
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 #include <boost/version.hpp>
@@ -67,8 +68,18 @@ class TabletSplitManager : public TabletSplitCompleteHandlerIf {
                                 const SplitTabletIds& split_tablet_ids);
 
  private:
+  struct SplitCandidate {
+    TabletId tablet_id;
+    TableId table_id;
+    SplitByLoad split_by_load;
+  };
+
   void ProcessQueuedSplitItems();
 
+  // Returns true if a tablet of the specified table was recently split by load, so the load
+  // reported by tablets of this table could be not yet rebalanced.
+  bool IsLoadSplitCoolingDown(const TableId& table_id) REQUIRES(mutex_);
+
   TabletSplitCandidateFilterIf* filter_;
   TabletSplitDriverIf* driver_;
   CDCConsumerSplitDriverIf* cdc_consumer_split_driver_;
@@ -78,7 +89,9 @@ class TabletSplitManager : public TabletSplitCompleteHandlerIf {
   // tablet once both of its children have been created and compacted, so the value is used to keep
   // track of which children are done so far (value starts empty).
   std::unordered_map<TabletId, TabletId> processing_tablets_to_split_children_ GUARDED_BY(mutex_);
-  std::deque<TabletId> candidates_ GUARDED_BY(mutex_);
+  std::deque<SplitCandidate> candidates_ GUARDED_BY(mutex_);
+  // Time of the last split by load for each table.
+  std::unordered_map<TableId, CoarseTimePoint> last_load_split_time_ GUARDED_BY(mutex_);
   std::unique_ptr<BackgroundTask> process_tablet_candidates_task_;
 };
 
@@ -55,6 +55,17 @@ enum SubCacheType {
   MULTI_TOUCH
 };
 
+// Policy used to decide whether a new entry should be admitted to the cache, when it would evict
+// existing entries.
+enum class CacheAdmissionPolicy {
+  // Always admit new entries.
+  kAlways,
+  // TinyLFU: admit new entry only if its estimated access frequency is greater than the access
+  // frequency of the entry that would be evicted. Keeps frequently accessed blocks in the cache
+  // during large scans, when every block is accessed only once.
+  kTinyLFU,
+};
+
 class Cache;
 
 // Create a new cache with a fixed size capacity. The cache is sharded
@@ -67,6 +78,9 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
+extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                                     bool strict_capacity_limit,
+                                     CacheAdmissionPolicy admission_policy);
 
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
@@ -0,0 +1,220 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <set>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include <gtest/gtest.h>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/memtable_allocator.h"
+#include "yb/rocksdb/db/writebuffer.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/util/concurrent_arena.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/testharness.h"
+
+#include "yb/util/format.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/tsan_util.h"
+
+namespace rocksdb {
+
+namespace {
+
+// User key and sequence number of entry.
+typedef std::pair<std::string, SequenceNumber> Key;
+
+// Orders keys in the same way as internal key comparator.
+struct KeyComparator {
+  bool operator()(const Key& lhs, const Key& rhs) const {
+    int cmp = lhs.first.compare(rhs.first);
+    return cmp ? cmp < 0 : lhs.second > rhs.second;
+  }
+};
+
+typedef std::set<Key, KeyComparator> KeySet;
+
+std::string MakeInternalKey(const Key& key) {
+  std::string result = key.first;
+  PutFixed64(&result, PackSequenceAndType(key.second, kTypeValue));
+  return result;
+}
+
+Key DecodeKey(const char* memtable_key) {
+  ParsedInternalKey parsed;
+  EXPECT_TRUE(ParseInternalKey(GetLengthPrefixedSlice(memtable_key), &parsed));
+  return Key(parsed.user_key.ToBuffer(), parsed.sequence);
+}
+
+} // namespace
+
+class ArtRepTest : public testing::Test {
+ protected:
+  ArtRepTest()
+      : internal_comparator_(BytewiseComparator()), key_comparator_(internal_comparator_),
+        write_buffer_(0), allocator_(&arena_, &write_buffer_) {
+    rep_.reset(AdaptiveRadixTreeFactory().CreateMemTableRep(
+        key_comparator_, &allocator_, nullptr /* transform */, nullptr /* logger */));
+  }
+
+  void Insert(const Key& key, bool concurrently = false) {
+    auto internal_key = MakeInternalKey(key);
+    char* buf;
+    auto handle = rep_->Allocate(VarintLength(internal_key.size()) + internal_key.size(), &buf);
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(internal_key.size()));
+    memcpy(p, internal_key.data(), internal_key.size());
+    if (concurrently) {
+      rep_->InsertConcurrently(handle);
+    } else {
+      rep_->Insert(handle);
+    }
+  }
+
+  void CheckContent(const KeySet& keys) {
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    iter->SeekToFirst();
+    for (const auto& key : keys) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(key, DecodeKey(iter->key()));
+      iter->Next();
+    }
+    ASSERT_FALSE(iter->Valid());
+
+    iter->SeekToLast();
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(*it, DecodeKey(iter->key()));
+      iter->Prev();
+    }
+    ASSERT_FALSE(iter->Valid());
+  }
+
+  void CheckSeek(const KeySet& keys, const Key& target) {
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    iter->Seek(MakeInternalKey(target), nullptr /* memtable_key */);
+    auto it = keys.lower_bound(target);
+    if (it == keys.end()) {
+      ASSERT_FALSE(iter->Valid());
+      return;
+    }
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(*it, DecodeKey(iter->key()));
+    if (it != keys.begin()) {
+      iter->Prev();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(*std::prev(it), DecodeKey(iter->key()));
+    }
+  }
+
+  InternalKeyComparator internal_comparator_;
+  MemTable::KeyComparator key_comparator_;
+  ConcurrentArena arena_;
+  WriteBuffer write_buffer_;
+  MemTableAllocator allocator_;
+  std::unique_ptr<MemTableRep> rep_;
+};
+
+TEST_F(ArtRepTest, Empty) {
+  std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+  iter->SeekToLast();
+  ASSERT_FALSE(iter->Valid());
+  iter->Seek(MakeInternalKey(Key("key", 1)), nullptr /* memtable_key */);
+  ASSERT_FALSE(iter->Valid());
+}
+
+TEST_F(ArtRepTest, Random) {
+  // Short keys, so there are a lot of keys that are prefixes of other keys, and a lot of versions
+  // of the same user key.
+  constexpr int kNumKeys = 10000;
+  const std::string kPrefix = "doc_key_prefix";
+  KeySet keys;
+  for (int i = 0; i != kNumKeys; ++i) {
+    Key key(yb::RandomHumanReadableString(yb::RandomUniformInt<size_t>(0, 4)),
+            yb::RandomUniformInt<SequenceNumber>(1, 5));
+    if (yb::RandomUniformBool()) {
+      key.first = kPrefix + key.first;
+    }
+    if (keys.insert(key).second) {
+      Insert(key);
+    }
+  }
+
+  ASSERT_NO_FATALS(CheckContent(keys));
+
+  for (int i = 0; i != kNumKeys; ++i) {
+    Key key(kPrefix.substr(0, yb::RandomUniformInt<size_t>(0, kPrefix.size())) +
+                yb::RandomHumanReadableString(yb::RandomUniformInt<size_t>(0, 5)),
+            yb::RandomUniformInt<SequenceNumber>(0, 6));
+    ASSERT_NO_FATALS(CheckSeek(keys, key));
+
+    std::string memtable_key;
+    PutLengthPrefixedSlice(&memtable_key, MakeInternalKey(key));
+    ASSERT_EQ(keys.count(key) != 0, rep_->Contains(memtable_key.c_str()));
+  }
+}
+
+TEST_F(ArtRepTest, ConcurrentReadWrite) {
+  constexpr int kNumWriters = 4;
+  constexpr int kNumReaders = 4;
+  const int kKeysPerWriter = yb::NonTsanVsTsan(20000, 2000);
+
+  yb::TestThreadHolder thread_holder;
+  std::atomic<int> writers_left(kNumWriters);
+  for (int i = 0; i != kNumWriters; ++i) {
+    thread_holder.AddThread([this, i, &writers_left] {
+      for (int j = 0; j != kKeysPerWriter; ++j) {
+        Insert(Key(yb::Format("row_$0_column_$1", j * 7919 % kKeysPerWriter, i), j),
+               true /* concurrently */);
+      }
+      --writers_left;
+    });
+  }
+  for (int i = 0; i != kNumReaders; ++i) {
+    thread_holder.AddThread([this, &writers_left] {
+      while (writers_left.load() != 0) {
+        std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+        boost::optional<Key> prev;
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+          auto key = DecodeKey(iter->key());
+          if (prev) {
+            ASSERT_TRUE(KeyComparator()(*prev, key));
+          }
+          prev = key;
+        }
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++count;
+  }
+  ASSERT_EQ(kNumWriters * kKeysPerWriter, count);
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
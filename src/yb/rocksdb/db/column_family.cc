@@ -138,6 +138,13 @@ Status CheckCompressionSupported(const ColumnFamilyOptions& cf_options) {
           " is not linked with the binary.");
     }
   }
+  if (cf_options.bottommost_compression != kDisableCompressionOption &&
+      !CompressionTypeSupported(cf_options.bottommost_compression)) {
+    return STATUS(InvalidArgument,
+        "Bottommost compression type " +
+        CompressionTypeToString(cf_options.bottommost_compression) +
+        " is not linked with the binary.");
+  }
   return Status::OK();
 }
 
@@ -103,6 +103,14 @@ void Compaction::SetInputVersion(Version* input_version) {
   cfd_ = input_version->cfd();
   cfd_->Ref();
 
+  // Compaction that includes the oldest data produces cold files, that could use stronger
+  // compression than recently written ones.
+  const auto bottommost_compression = cfd_->ioptions()->bottommost_compression;
+  if (bottommost_level_ && output_compression_ != kNoCompression &&
+      bottommost_compression != kDisableCompressionOption) {
+    output_compression_ = bottommost_compression;
+  }
+
   if (IsCompactionStyleUniversal()) {
     // We don't need to lock the whole input version for universal compaction, only need input
     // files.
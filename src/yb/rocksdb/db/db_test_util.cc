@@ -418,6 +418,11 @@ Options DBTestBase::CurrentOptions(
       options.enable_write_thread_adaptive_yield = true;
       break;
     }
+    case kAdaptiveRadixTree: {
+      options.memtable_factory.reset(new AdaptiveRadixTreeFactory());
+      options.allow_concurrent_memtable_write = true;
+      break;
+    }
     case kBlockBasedTableWithThreeSharedPartsKeyDeltaEncoding: {
       table_options.use_delta_encoding = true;
       table_options.data_block_key_value_encoding_format =
@@ -597,11 +597,12 @@ class DBTestBase : public testing::Test {
     kRowCache = 27,
     kRecycleLogFiles = 28,
     kConcurrentSkipList = 29,
-    kEnd = 30,
-    kLevelSubcompactions = 30,
-    kUniversalSubcompactions = 31,
-    kBlockBasedTableWithIndexRestartInterval = 32,
-    kBlockBasedTableWithThreeSharedPartsKeyDeltaEncoding = 33,
+    kAdaptiveRadixTree = 30,
+    kEnd = 31,
+    kLevelSubcompactions = 31,
+    kUniversalSubcompactions = 32,
+    kBlockBasedTableWithIndexRestartInterval = 33,
+    kBlockBasedTableWithThreeSharedPartsKeyDeltaEncoding = 34,
   };
   int option_config_;
 
@@ -34,6 +34,7 @@ int main() {
 #else
 
 #include <atomic>
+#include <cinttypes>
 #include <iostream>
 #include <memory>
 #include <thread>
@@ -79,7 +80,12 @@ DEFINE_string(memtablerep, "skiplist",
               "\tskiplist            -- backed by a skiplist\n"
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
-              "\thashlinklist        -- backed by a hash linked list\n");
+              "\thashlinklist        -- backed by a hash linked list\n"
+              "\tart                 -- backed by an adaptive radix tree\n");
+
+DEFINE_bool(docdb_keys, false,
+            "Use keys shaped like DocDB keys of a table row, i.e. with long common prefix, "
+            "instead of 8 byte integers");
 
 DEFINE_int64(bucket_count, 1000000,
              "bucket_count parameter to pass into NewHashSkiplistRepFactory or "
@@ -240,6 +246,35 @@ class BenchmarkThread {
   RandomGenerator generator_;
 };
 
+// Appends user key for specified key number.
+void AppendUserKey(uint64_t key, std::string* out) {
+  if (!FLAGS_docdb_keys) {
+    PutFixed64(out, key);
+    return;
+  }
+  // Mimics DocDB key of a table row: hash, string hash component and column id, followed by the
+  // encoded hybrid time of the write. Each row has 16 columns.
+  const uint64_t row = key / 16;
+  const auto hash = static_cast<uint16_t>(row * 0x9e37);
+  char buffer[32];
+  out->push_back('G');
+  out->push_back(static_cast<char>(hash >> 8));
+  out->push_back(static_cast<char>(hash));
+  out->push_back('S');
+  out->append(buffer, snprintf(buffer, sizeof(buffer), "customer_%010" PRIu64, row));
+  out->append("\0\0!!K", 5);
+  out->push_back(static_cast<char>(key % 16 + 10));
+  out->push_back('#');
+  PutFixed64(out, ~(key * 4096));
+  PutFixed32(out, 0);
+}
+
+size_t InternalKeySize() {
+  std::string key;
+  AppendUserKey(0, &key);
+  return key.size() + 8;
+}
+
 class FillBenchmarkThread : public BenchmarkThread {
  public:
   FillBenchmarkThread(MemTableRep* table, KeyGenerator* key_gen,
@@ -250,15 +285,16 @@ class FillBenchmarkThread : public BenchmarkThread {
 
   void FillOne() {
     char* buf = nullptr;
-    auto internal_key_size = 16;
+    std::string user_key;
+    AppendUserKey(key_gen_->Next(), &user_key);
+    auto internal_key_size = user_key.size() + 8;
     auto encoded_len =
         FLAGS_item_size + VarintLength(internal_key_size) + internal_key_size;
     KeyHandle handle = table_->Allocate(encoded_len, &buf);
     assert(buf != nullptr);
-    char* p = EncodeVarint32(buf, internal_key_size);
-    auto key = key_gen_->Next();
-    EncodeFixed64(p, key);
-    p += 8;
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(internal_key_size));
+    memcpy(p, user_key.data(), user_key.size());
+    p += user_key.size();
     EncodeFixed64(p, ++(*sequence_));
     p += 8;
     Slice bytes = generator_.Generate(FLAGS_item_size);
@@ -324,8 +360,7 @@ class ReadBenchmarkThread : public BenchmarkThread {
 
   void ReadOne() {
     std::string user_key;
-    auto key = key_gen_->Next();
-    PutFixed64(&user_key, key);
+    AppendUserKey(key_gen_->Next(), &user_key);
     LookupKey lookup_key(user_key, *sequence_);
     InternalKeyComparator internal_key_comp(BytewiseComparator());
     CallbackVerifyArgs verify_args;
@@ -335,7 +370,7 @@ class ReadBenchmarkThread : public BenchmarkThread {
     verify_args.comparator = &internal_key_comp;
     table_->Get(lookup_key, &verify_args, callback);
     if (verify_args.found) {
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(user_key.size() + 8) + user_key.size() + 8 + FLAGS_item_size;
       ++*read_hits_;
     }
   }
@@ -357,9 +392,10 @@ class SeqReadBenchmarkThread : public BenchmarkThread {
 
   void ReadOneSeq() {
     std::unique_ptr<MemTableRep::Iterator> iter(table_->GetIterator());
+    const auto internal_key_size = InternalKeySize();
     for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
       // pretend to read the value
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(internal_key_size) + internal_key_size + FLAGS_item_size;
     }
     ++*read_hits_;
   }
@@ -608,6 +644,8 @@ int main(int argc, char** argv) {
         FLAGS_if_log_bucket_dist_when_flash, FLAGS_threshold_use_skiplist));
     options.prefix_extractor.reset(
         rocksdb::NewFixedPrefixTransform(FLAGS_prefix_length));
+  } else if (FLAGS_memtablerep == "art") {
+    factory.reset(new rocksdb::AdaptiveRadixTreeFactory);
   } else {
     fprintf(stdout, "Unknown memtablerep: %s\n", FLAGS_memtablerep.c_str());
     exit(1);
@@ -0,0 +1,854 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// MemTableRep based on adaptive radix tree, see "The Adaptive Radix Tree: ARTful Indexing for
+// Main-Memory Databases" by V. Leis, A. Kemper and T. Neumann.
+//
+// DocDB keys written to the same tablet share long prefixes (cotable id, hash, hash and range
+// components), so skip list compares the same leading bytes over and over on each level.
+// The radix tree looks at every key byte at most once during the descent and keeps common parts
+// of the keys in inner nodes (path compression).
+//
+// The tree orders keys by user key bytes, so it is used only with bytewise user comparator.
+// All internal keys with the same user key are kept in one leaf, in the list sorted in the
+// internal key order, i.e. by descending sequence number and type.
+//
+// Readers are lock free. Writers are serialized, and a writer never modifies the tree in a way
+// that could be observed inconsistent by a concurrent reader: new children are appended to a node
+// and published with release semantics, while a node that should grow or should be split by
+// prefix is copied, and the copy replaces the node in its parent. Replaced nodes stay in the
+// memtable arena, so readers that have already reached them do not need reclamation protocol.
+
+#include <mutex>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/rocksdb/comparator.h"
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/enums.h"
+
+namespace rocksdb {
+namespace {
+
+// Entry header, the memtable key is placed right after it.
+struct Entry {
+  std::atomic<Entry*> next{nullptr};
+
+  char* key() {
+    return reinterpret_cast<char*>(this + 1);
+  }
+
+  const char* key() const {
+    return reinterpret_cast<const char*>(this + 1);
+  }
+
+  Slice internal_key() const {
+    return GetLengthPrefixedSlice(key());
+  }
+
+  uint64_t trailer() const {
+    return DecodeFixed64(internal_key().cend() - kLastInternalComponentSize);
+  }
+};
+
+inline uint64_t Trailer(const Slice& internal_key) {
+  return DecodeFixed64(internal_key.cend() - kLastInternalComponentSize);
+}
+
+// All entries with the same user key.
+struct Leaf {
+  Leaf(const uint8_t* key_, size_t key_size_, Entry* entry)
+      : key(key_), key_size(key_size_), head(entry) {}
+
+  Slice user_key() const {
+    return Slice(key, key_size);
+  }
+
+  // Insert entry keeping list sorted by descending trailer.
+  void Add(Entry* entry, uint64_t trailer) {
+    std::atomic<Entry*>* link = &head;
+    Entry* current;
+    while ((current = link->load(std::memory_order_relaxed)) != nullptr &&
+           current->trailer() > trailer) {
+      link = &current->next;
+    }
+    entry->next.store(current, std::memory_order_relaxed);
+    link->store(entry, std::memory_order_release);
+  }
+
+  const uint8_t* const key;
+  const size_t key_size;
+  std::atomic<Entry*> head;
+};
+
+enum class NodeType : uint8_t {
+  kNode4,
+  kNode16,
+  kNode48,
+  kNode256,
+};
+
+// Child pointer, leafs are tagged with the lowest bit.
+typedef uintptr_t NodePtr;
+constexpr NodePtr kLeafTag = 1;
+
+// Positions inside a node used during iteration. Non negative positions are key bytes.
+constexpr int kBeforeFirst = -2;
+constexpr int kTerminal = -1;
+constexpr int kAfterLast = 0x100;
+
+inline bool IsLeaf(NodePtr ptr) {
+  return (ptr & kLeafTag) != 0;
+}
+
+inline Leaf* AsLeaf(NodePtr ptr) {
+  return reinterpret_cast<Leaf*>(ptr & ~kLeafTag);
+}
+
+inline NodePtr LeafPtr(Leaf* leaf) {
+  return reinterpret_cast<NodePtr>(leaf) | kLeafTag;
+}
+
+struct Node {
+  Node(NodeType type_, const uint8_t* prefix_, size_t prefix_size_)
+      : type(type_), prefix(prefix_), prefix_size(prefix_size_), terminal(0) {}
+
+  const NodeType type;
+  // Bytes shared by all keys in this subtree, points to the key of some entry.
+  const uint8_t* const prefix;
+  const size_t prefix_size;
+  // Leaf whose user key ends at this node.
+  std::atomic<NodePtr> terminal;
+};
+
+inline Node* AsNode(NodePtr ptr) {
+  return reinterpret_cast<Node*>(ptr);
+}
+
+inline NodePtr NodePtrOf(Node* node) {
+  return reinterpret_cast<NodePtr>(node);
+}
+
+// Node4 and Node16, keys are stored in insertion order.
+template <NodeType kType, size_t kCapacity>
+struct SmallNode : public Node {
+  static constexpr NodeType kNodeType = kType;
+
+  SmallNode(const uint8_t* prefix_, size_t prefix_size_)
+      : Node(kType, prefix_, prefix_size_), count(0) {
+    for (auto& child : children) {
+      child.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<size_t> count;
+  uint8_t keys[kCapacity];
+  std::atomic<NodePtr> children[kCapacity];
+};
+
+typedef SmallNode<NodeType::kNode4, 4> Node4;
+typedef SmallNode<NodeType::kNode16, 16> Node16;
+
+struct Node48 : public Node {
+  static constexpr NodeType kNodeType = NodeType::kNode48;
+  static constexpr size_t kCapacity = 48;
+
+  Node48(const uint8_t* prefix_, size_t prefix_size_)
+      : Node(kNodeType, prefix_, prefix_size_) {
+    for (auto& idx : index) {
+      idx.store(0, std::memory_order_relaxed);
+    }
+    for (auto& child : children) {
+      child.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Index of child plus one, zero when there is no such child.
+  std::atomic<uint8_t> index[0x100];
+  std::atomic<NodePtr> children[kCapacity];
+  // Accessed by writer only.
+  size_t count = 0;
+};
+
+struct Node256 : public Node {
+  static constexpr NodeType kNodeType = NodeType::kNode256;
+
+  Node256(const uint8_t* prefix_, size_t prefix_size_)
+      : Node(kNodeType, prefix_, prefix_size_) {
+    for (auto& child : children) {
+      child.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<NodePtr> children[0x100];
+};
+
+template <class SmallNodeType>
+std::atomic<NodePtr>* FindSmallNodeChild(Node* node, uint8_t byte) {
+  auto* small = static_cast<SmallNodeType*>(node);
+  size_t count = small->count.load(std::memory_order_acquire);
+  for (size_t i = 0; i != count; ++i) {
+    if (small->keys[i] == byte) {
+      return &small->children[i];
+    }
+  }
+  return nullptr;
+}
+
+// Returns slot of child with specified byte, or nullptr if there is no such child.
+std::atomic<NodePtr>* FindChild(Node* node, uint8_t byte) {
+  switch (node->type) {
+    case NodeType::kNode4:
+      return FindSmallNodeChild<Node4>(node, byte);
+    case NodeType::kNode16:
+      return FindSmallNodeChild<Node16>(node, byte);
+    case NodeType::kNode48: {
+      auto* node48 = static_cast<Node48*>(node);
+      auto idx = node48->index[byte].load(std::memory_order_acquire);
+      return idx ? &node48->children[idx - 1] : nullptr;
+    }
+    case NodeType::kNode256: {
+      auto* slot = &static_cast<Node256*>(node)->children[byte];
+      return slot->load(std::memory_order_acquire) ? slot : nullptr;
+    }
+  }
+  FATAL_INVALID_ENUM_VALUE(NodeType, node->type);
+}
+
+template <class SmallNodeType>
+bool IsSmallNodeFull(const Node* node) {
+  return static_cast<const SmallNodeType*>(node)->count.load(std::memory_order_relaxed) ==
+         sizeof(SmallNodeType::keys);
+}
+
+bool IsFull(const Node* node) {
+  switch (node->type) {
+    case NodeType::kNode4:
+      return IsSmallNodeFull<Node4>(node);
+    case NodeType::kNode16:
+      return IsSmallNodeFull<Node16>(node);
+    case NodeType::kNode48:
+      return static_cast<const Node48*>(node)->count == Node48::kCapacity;
+    case NodeType::kNode256:
+      return false;
+  }
+  FATAL_INVALID_ENUM_VALUE(NodeType, node->type);
+}
+
+NodeType GrownType(NodeType type) {
+  switch (type) {
+    case NodeType::kNode4:
+      return NodeType::kNode16;
+    case NodeType::kNode16:
+      return NodeType::kNode48;
+    case NodeType::kNode48: FALLTHROUGH_INTENDED;
+    case NodeType::kNode256:
+      return NodeType::kNode256;
+  }
+  FATAL_INVALID_ENUM_VALUE(NodeType, type);
+}
+
+template <class SmallNodeType>
+void AddSmallNodeChild(Node* node, uint8_t byte, NodePtr child) {
+  auto* small = static_cast<SmallNodeType*>(node);
+  size_t count = small->count.load(std::memory_order_relaxed);
+  small->keys[count] = byte;
+  small->children[count].store(child, std::memory_order_relaxed);
+  small->count.store(count + 1, std::memory_order_release);
+}
+
+// Adds child to the node, that should not be full and should not contain child with this byte.
+void AddChild(Node* node, uint8_t byte, NodePtr child) {
+  switch (node->type) {
+    case NodeType::kNode4:
+      AddSmallNodeChild<Node4>(node, byte, child);
+      return;
+    case NodeType::kNode16:
+      AddSmallNodeChild<Node16>(node, byte, child);
+      return;
+    case NodeType::kNode48: {
+      auto* node48 = static_cast<Node48*>(node);
+      node48->children[node48->count].store(child, std::memory_order_relaxed);
+      ++node48->count;
+      node48->index[byte].store(static_cast<uint8_t>(node48->count), std::memory_order_release);
+      return;
+    }
+    case NodeType::kNode256:
+      static_cast<Node256*>(node)->children[byte].store(child, std::memory_order_release);
+      return;
+  }
+  FATAL_INVALID_ENUM_VALUE(NodeType, node->type);
+}
+
+// Returns the child at specified position, returned by NextPosition or PrevPosition.
+NodePtr ChildAt(Node* node, int pos) {
+  if (pos == kTerminal) {
+    return node->terminal.load(std::memory_order_acquire);
+  }
+  return FindChild(node, static_cast<uint8_t>(pos))->load(std::memory_order_acquire);
+}
+
+// Returns the first position after pos, or kAfterLast if there is no such position.
+int NextPosition(Node* node, int pos) {
+  int from = pos + 1;
+  if (from < 0) {
+    if (node->terminal.load(std::memory_order_acquire)) {
+      return kTerminal;
+    }
+    from = 0;
+  }
+  switch (node->type) {
+    case NodeType::kNode4: FALLTHROUGH_INTENDED;
+    case NodeType::kNode16: {
+      const uint8_t* keys;
+      size_t count;
+      if (node->type == NodeType::kNode4) {
+        auto* small = static_cast<Node4*>(node);
+        count = small->count.load(std::memory_order_acquire);
+        keys = small->keys;
+      } else {
+        auto* small = static_cast<Node16*>(node);
+        count = small->count.load(std::memory_order_acquire);
+        keys = small->keys;
+      }
+      int result = kAfterLast;
+      for (size_t i = 0; i != count; ++i) {
+        int key = keys[i];
+        if (key >= from && key < result) {
+          result = key;
+        }
+      }
+      return result;
+    }
+    case NodeType::kNode48: {
+      auto* node48 = static_cast<Node48*>(node);
+      for (int i = from; i < kAfterLast; ++i) {
+        if (node48->index[i].load(std::memory_order_acquire)) {
+          return i;
+        }
+      }
+      return kAfterLast;
+    }
+    case NodeType::kNode256: {
+      auto* node256 = static_cast<Node256*>(node);
+      for (int i = from; i < kAfterLast; ++i) {
+        if (node256->children[i].load(std::memory_order_acquire)) {
+          return i;
+        }
+      }
+      return kAfterLast;
+    }
+  }
+  FATAL_INVALID_ENUM_VALUE(NodeType, node->type);
+}
+
+// Returns the last position before pos, or kBeforeFirst if there is no such position.
+int PrevPosition(Node* node, int pos) {
+  int result = kBeforeFirst;
+  switch (node->type) {
+    case NodeType::kNode4: FALLTHROUGH_INTENDED;
+    case NodeType::kNode16: {
+      const uint8_t* keys;
+      size_t count;
+      if (node->type == NodeType::kNode4) {
+        auto* small = static_cast<Node4*>(node);
+        count = small->count.load(std::memory_order_acquire);
+        keys = small->keys;
+      } else {
+        auto* small = static_cast<Node16*>(node);
+        count = small->count.load(std::memory_order_acquire);
+        keys = small->keys;
+      }
+      for (size_t i = 0; i != count; ++i) {
+        int key = keys[i];
+        if (key < pos && key > result) {
+          result = key;
+        }
+      }
+      break;
+    }
+    case NodeType::kNode48: {
+      auto* node48 = static_cast<Node48*>(node);
+      for (int i = std::min(pos, kAfterLast) - 1; i >= 0; --i) {
+        if (node48->index[i].load(std::memory_order_acquire)) {
+          return i;
+        }
+      }
+      break;
+    }
+    case NodeType::kNode256: {
+      auto* node256 = static_cast<Node256*>(node);
+      for (int i = std::min(pos, kAfterLast) - 1; i >= 0; --i) {
+        if (node256->children[i].load(std::memory_order_acquire)) {
+          return i;
+        }
+      }
+      break;
+    }
+  }
+  if (result == kBeforeFirst && pos > kTerminal &&
+      node->terminal.load(std::memory_order_acquire)) {
+    return kTerminal;
+  }
+  return result;
+}
+
+// Returns number of equal bytes at the start of lhs and rhs.
+size_t CommonPrefixSize(const uint8_t* lhs, const uint8_t* rhs, size_t size) {
+  size_t result = 0;
+  while (result != size && lhs[result] == rhs[result]) {
+    ++result;
+  }
+  return result;
+}
+
+class AdaptiveRadixTreeRep : public MemTableRep {
+ public:
+  explicit AdaptiveRadixTreeRep(MemTableAllocator* allocator)
+      : MemTableRep(allocator), root_(0) {}
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    auto* entry = new (allocator_->AllocateAligned(sizeof(Entry) + len)) Entry();
+    *buf = entry->key();
+    return entry;
+  }
+
+  void Insert(KeyHandle handle) override {
+    DoInsert(static_cast<Entry*>(handle));
+  }
+
+  void InsertConcurrently(KeyHandle handle) override {
+    // Inserts are short and mostly touch the same nodes, so they are just serialized,
+    // readers do not take this lock.
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+    DoInsert(static_cast<Entry*>(handle));
+  }
+
+  bool Contains(const char* key) const override {
+    Slice internal_key = GetLengthPrefixedSlice(key);
+    auto* leaf = FindLeaf(ExtractUserKey(internal_key));
+    if (!leaf) {
+      return false;
+    }
+    auto trailer = Trailer(internal_key);
+    for (auto* entry = leaf->head.load(std::memory_order_acquire); entry;
+         entry = entry->next.load(std::memory_order_acquire)) {
+      if (entry->trailer() == trailer) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    Iterator iter(this);
+    Slice dummy_slice;
+    for (iter.Seek(dummy_slice, k.memtable_key().cdata());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void *mem =
+      arena ? arena->AllocateAligned(sizeof(AdaptiveRadixTreeRep::Iterator))
+            : operator new(sizeof(AdaptiveRadixTreeRep::Iterator));
+    return new (mem) AdaptiveRadixTreeRep::Iterator(this);
+  }
+
+ private:
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const AdaptiveRadixTreeRep* rep) : rep_(rep) {}
+
+    bool Valid() const override {
+      return entry_ != nullptr;
+    }
+
+    const char* key() const override {
+      return entry_->key();
+    }
+
+    void Next() override {
+      entry_ = entry_->next.load(std::memory_order_acquire);
+      if (!entry_) {
+        NextLeaf();
+      }
+    }
+
+    void Prev() override {
+      auto* entry = leaf_->head.load(std::memory_order_acquire);
+      if (entry == entry_) {
+        PrevLeaf();
+        return;
+      }
+      for (;;) {
+        auto* next = entry->next.load(std::memory_order_acquire);
+        if (next == entry_) {
+          entry_ = entry;
+          return;
+        }
+        entry = next;
+      }
+    }
+
+    void Seek(const Slice& key, const char* memtable_key) override {
+      Slice internal_key = memtable_key ? GetLengthPrefixedSlice(memtable_key) : key;
+      DoSeek(ExtractUserKey(internal_key), Trailer(internal_key));
+    }
+
+    void SeekToFirst() override {
+      Reset();
+      auto root = rep_->root_.load(std::memory_order_acquire);
+      if (root) {
+        DescendLeftmost(root);
+      }
+    }
+
+    void SeekToLast() override {
+      Reset();
+      auto root = rep_->root_.load(std::memory_order_acquire);
+      if (root) {
+        DescendRightmost(root);
+      }
+    }
+
+   private:
+    struct Frame {
+      Node* node;
+      int pos;
+    };
+
+    void Reset() {
+      stack_.clear();
+      leaf_ = nullptr;
+      entry_ = nullptr;
+    }
+
+    // Positions iterator to the first entry that is not less than (user_key, trailer).
+    void DoSeek(const Slice& user_key, uint64_t trailer) {
+      Reset();
+      NodePtr ptr = rep_->root_.load(std::memory_order_acquire);
+      size_t depth = 0;
+      while (ptr) {
+        if (IsLeaf(ptr)) {
+          SeekInLeaf(AsLeaf(ptr), user_key, trailer);
+          return;
+        }
+        Node* node = AsNode(ptr);
+        size_t left = user_key.size() - depth;
+        int cmp = memcmp(node->prefix, user_key.data() + depth, std::min(left, node->prefix_size));
+        if (cmp > 0 || (cmp == 0 && left < node->prefix_size)) {
+          // All keys in this subtree are greater than the target.
+          DescendLeftmost(ptr);
+          return;
+        }
+        if (cmp < 0) {
+          // All keys in this subtree are less than the target.
+          NextLeaf();
+          return;
+        }
+        depth += node->prefix_size;
+        if (depth == user_key.size()) {
+          auto terminal = node->terminal.load(std::memory_order_acquire);
+          if (terminal) {
+            stack_.push_back({node, kTerminal});
+            SeekInLeaf(AsLeaf(terminal), user_key, trailer);
+          } else {
+            stack_.push_back({node, kBeforeFirst});
+            NextLeaf();
+          }
+          return;
+        }
+        uint8_t byte = user_key[depth];
+        stack_.push_back({node, byte});
+        auto* child = FindChild(node, byte);
+        if (!child) {
+          NextLeaf();
+          return;
+        }
+        ptr = child->load(std::memory_order_acquire);
+        ++depth;
+      }
+    }
+
+    void SeekInLeaf(Leaf* leaf, const Slice& user_key, uint64_t trailer) {
+      int cmp = leaf->user_key().compare(user_key);
+      if (cmp > 0) {
+        SetLeaf(leaf, leaf->head.load(std::memory_order_acquire));
+        return;
+      }
+      if (cmp == 0) {
+        for (auto* entry = leaf->head.load(std::memory_order_acquire); entry;
+             entry = entry->next.load(std::memory_order_acquire)) {
+          if (entry->trailer() <= trailer) {
+            SetLeaf(leaf, entry);
+            return;
+          }
+        }
+      }
+      NextLeaf();
+    }
+
+    void SetLeaf(Leaf* leaf, Entry* entry) {
+      leaf_ = leaf;
+      entry_ = entry;
+    }
+
+    void DescendLeftmost(NodePtr ptr) {
+      while (!IsLeaf(ptr)) {
+        Node* node = AsNode(ptr);
+        int pos = NextPosition(node, kBeforeFirst);
+        DCHECK_NE(pos, kAfterLast);
+        stack_.push_back({node, pos});
+        ptr = ChildAt(node, pos);
+      }
+      auto* leaf = AsLeaf(ptr);
+      SetLeaf(leaf, leaf->head.load(std::memory_order_acquire));
+    }
+
+    void DescendRightmost(NodePtr ptr) {
+      while (!IsLeaf(ptr)) {
+        Node* node = AsNode(ptr);
+        int pos = PrevPosition(node, kAfterLast);
+        DCHECK_NE(pos, kBeforeFirst);
+        stack_.push_back({node, pos});
+        ptr = ChildAt(node, pos);
+      }
+      auto* leaf = AsLeaf(ptr);
+      auto* entry = leaf->head.load(std::memory_order_acquire);
+      for (;;) {
+        auto* next = entry->next.load(std::memory_order_acquire);
+        if (!next) {
+          break;
+        }
+        entry = next;
+      }
+      SetLeaf(leaf, entry);
+    }
+
+    // Moves to the first entry of the leaf that follows the current position of the stack.
+    void NextLeaf() {
+      while (!stack_.empty()) {
+        auto& frame = stack_.back();
+        int pos = NextPosition(frame.node, frame.pos);
+        if (pos != kAfterLast) {
+          frame.pos = pos;
+          DescendLeftmost(ChildAt(frame.node, pos));
+          return;
+        }
+        stack_.pop_back();
+      }
+      SetLeaf(nullptr, nullptr);
+    }
+
+    // Moves to the last entry of the leaf that precedes the current position of the stack.
+    void PrevLeaf() {
+      while (!stack_.empty()) {
+        auto& frame = stack_.back();
+        int pos = PrevPosition(frame.node, frame.pos);
+        if (pos != kBeforeFirst) {
+          frame.pos = pos;
+          DescendRightmost(ChildAt(frame.node, pos));
+          return;
+        }
+        stack_.pop_back();
+      }
+      SetLeaf(nullptr, nullptr);
+    }
+
+    const AdaptiveRadixTreeRep* const rep_;
+    boost::container::small_vector<Frame, 16> stack_;
+    Leaf* leaf_ = nullptr;
+    Entry* entry_ = nullptr;
+  };
+
+  template <class T, class... Args>
+  T* New(Args&&... args) {
+    return new (allocator_->AllocateAligned(sizeof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // Creates node of specified type with the same children as the source node and new prefix.
+  Node* Clone(Node* source, NodeType type, const uint8_t* prefix, size_t prefix_size) {
+    Node* result = nullptr;
+    switch (type) {
+      case NodeType::kNode4:
+        result = New<Node4>(prefix, prefix_size);
+        break;
+      case NodeType::kNode16:
+        result = New<Node16>(prefix, prefix_size);
+        break;
+      case NodeType::kNode48:
+        result = New<Node48>(prefix, prefix_size);
+        break;
+      case NodeType::kNode256:
+        result = New<Node256>(prefix, prefix_size);
+        break;
+    }
+    int pos = kBeforeFirst;
+    while ((pos = NextPosition(source, pos)) != kAfterLast) {
+      auto child = ChildAt(source, pos);
+      if (pos == kTerminal) {
+        result->terminal.store(child, std::memory_order_relaxed);
+      } else {
+        AddChild(result, static_cast<uint8_t>(pos), child);
+      }
+    }
+    return result;
+  }
+
+  // Adds child to the node, that consumed size bytes of the key.
+  static void AddByKey(Node* node, const Slice& key, size_t size, NodePtr child) {
+    if (key.size() == size) {
+      node->terminal.store(child, std::memory_order_release);
+    } else {
+      AddChild(node, key[size], child);
+    }
+  }
+
+  void DoInsert(Entry* entry) {
+    Slice internal_key = entry->internal_key();
+    Slice user_key = ExtractUserKey(internal_key);
+    auto trailer = Trailer(internal_key);
+
+    std::atomic<NodePtr>* ref = &root_;
+    size_t depth = 0;
+    for (;;) {
+      // Tree is modified only under lock, so relaxed load is enough here.
+      NodePtr ptr = ref->load(std::memory_order_relaxed);
+      if (!ptr) {
+        ref->store(NewLeaf(user_key, entry), std::memory_order_release);
+        return;
+      }
+      if (IsLeaf(ptr)) {
+        auto* leaf = AsLeaf(ptr);
+        auto leaf_key = leaf->user_key();
+        if (leaf_key == user_key) {
+          leaf->Add(entry, trailer);
+          return;
+        }
+        // Replace leaf with node that contains both leafs.
+        auto common = CommonPrefixSize(
+            leaf_key.data() + depth, user_key.data() + depth,
+            std::min(leaf_key.size(), user_key.size()) - depth);
+        Node* node = New<Node4>(user_key.data() + depth, common);
+        AddByKey(node, leaf_key, depth + common, ptr);
+        AddByKey(node, user_key, depth + common, NewLeaf(user_key, entry));
+        ref->store(NodePtrOf(node), std::memory_order_release);
+        return;
+      }
+
+      Node* node = AsNode(ptr);
+      auto common = CommonPrefixSize(
+          node->prefix, user_key.data() + depth,
+          std::min(node->prefix_size, user_key.size() - depth));
+      if (common < node->prefix_size) {
+        // Split node prefix, the copy of node with shortened prefix becomes child of new node.
+        Node* parent = New<Node4>(node->prefix, common);
+        AddChild(parent, node->prefix[common], NodePtrOf(Clone(
+            node, node->type, node->prefix + common + 1, node->prefix_size - common - 1)));
+        AddByKey(parent, user_key, depth + common, NewLeaf(user_key, entry));
+        ref->store(NodePtrOf(parent), std::memory_order_release);
+        return;
+      }
+      depth += node->prefix_size;
+
+      if (depth == user_key.size()) {
+        if (node->terminal.load(std::memory_order_relaxed)) {
+          ref = &node->terminal;
+          continue;
+        }
+        node->terminal.store(NewLeaf(user_key, entry), std::memory_order_release);
+        return;
+      }
+
+      uint8_t byte = user_key[depth];
+      auto* child = FindChild(node, byte);
+      if (child) {
+        ref = child;
+        ++depth;
+        continue;
+      }
+      if (IsFull(node)) {
+        Node* grown = Clone(node, GrownType(node->type), node->prefix, node->prefix_size);
+        AddChild(grown, byte, NewLeaf(user_key, entry));
+        ref->store(NodePtrOf(grown), std::memory_order_release);
+      } else {
+        AddChild(node, byte, NewLeaf(user_key, entry));
+      }
+      return;
+    }
+  }
+
+  NodePtr NewLeaf(const Slice& user_key, Entry* entry) {
+    return LeafPtr(New<Leaf>(user_key.data(), user_key.size(), entry));
+  }
+
+  Leaf* FindLeaf(const Slice& user_key) const {
+    NodePtr ptr = root_.load(std::memory_order_acquire);
+    size_t depth = 0;
+    while (ptr) {
+      if (IsLeaf(ptr)) {
+        auto* leaf = AsLeaf(ptr);
+        return leaf->user_key() == user_key ? leaf : nullptr;
+      }
+      Node* node = AsNode(ptr);
+      if (user_key.size() - depth < node->prefix_size ||
+          memcmp(node->prefix, user_key.data() + depth, node->prefix_size) != 0) {
+        return nullptr;
+      }
+      depth += node->prefix_size;
+      if (depth == user_key.size()) {
+        ptr = node->terminal.load(std::memory_order_acquire);
+        continue;
+      }
+      auto* child = FindChild(node, user_key[depth]);
+      if (!child) {
+        return nullptr;
+      }
+      ptr = child->load(std::memory_order_acquire);
+      ++depth;
+    }
+    return nullptr;
+  }
+
+  std::atomic<NodePtr> root_;
+  std::mutex insert_mutex_;
+};
+
+} // namespace
+
+MemTableRep* AdaptiveRadixTreeFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  auto* memtable_comparator = dynamic_cast<const MemTable::KeyComparator*>(&compare);
+  if (!memtable_comparator ||
+      strcmp(memtable_comparator->comparator.user_comparator()->Name(),
+             BytewiseComparator()->Name()) != 0) {
+    // Radix tree orders keys by their bytes, so it could not be used with other comparators.
+    return SkipListFactory().CreateMemTableRep(compare, allocator, transform, logger);
+  }
+  return new AdaptiveRadixTreeRep(allocator);
+}
+
+} // namespace rocksdb
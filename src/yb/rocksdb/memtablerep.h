@@ -266,6 +266,22 @@ class SkipListFactory : public MemTableRepFactory {
   const ConcurrentWrites concurrent_writes_;
 };
 
+// This uses an adaptive radix tree to store keys. Keys with common prefixes share inner nodes of
+// the tree, so it is efficient for keys with long common prefixes, like DocDB keys.
+// Tree orders keys by their bytes, so skip list is used when user comparator is not bytewise.
+// Inserts are serialized, while reads are lock free.
+class AdaptiveRadixTreeFactory : public MemTableRepFactory {
+ public:
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
+                                 MemTableAllocator*,
+                                 const SliceTransform*,
+                                 Logger* logger) override;
+
+  const char* Name() const override { return "AdaptiveRadixTreeFactory"; }
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+};
+
 class CDSSkipListFactory : public MemTableRepFactory {
  public:
   MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
@@ -93,8 +93,13 @@ enum CompressionType : char {
   kBZip2Compression = 0x3,
   kLZ4Compression = 0x4,
   kLZ4HCCompression = 0x5,
-  // zstd format is not finalized yet so it's subject to changes.
+  kZSTD = 0x7,
+  // Blocks written by old versions when zstd format was not finalized yet. Uses the same block
+  // format as kZSTD.
   kZSTDNotFinalCompression = 0x40,
+
+  // Not a compression type. Used by options to indicate that the option is not set.
+  kDisableCompressionOption = 0x7f,
 };
 
 enum CompactionStyle : char {
@@ -168,9 +173,22 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of dictionary used to prime the compression library. Dictionary is built per SST
+  // file from the samples of its data blocks, and stored in the file meta block, so blocks could be
+  // decompressed independently. Only supported by ZSTD.
+  // Default: 0, i.e. dictionary compression is disabled.
+  uint32_t max_dict_bytes;
+  // Amount of data blocks buffered by the table builder to train the dictionary. When 0, the
+  // dictionary is not trained, but the first max_dict_bytes of data are used as the dictionary
+  // as is. Training usually requires about 100x max_dict_bytes of samples.
+  // Default: 0.
+  uint32_t zstd_max_train_bytes;
+  CompressionOptions()
+      : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0), zstd_max_train_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0,
+                     uint32_t _zstd_max_train_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        zstd_max_train_bytes(_zstd_max_train_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -378,6 +396,16 @@ struct ColumnFamilyOptions {
   // change when data grows.
   std::vector<CompressionType> compression_per_level;
 
+  // Compression algorithm used for files produced by compactions that include the oldest data of
+  // the column family, i.e. compactions to the bottommost level. For universal compaction those
+  // are compactions that include the oldest sorted run. Usually this data is cold, so it is worth
+  // to use stronger but slower compression for it, while recent data stays on a fast one.
+  // Compaction outputs that are not compressed according to compression_size_percent stay
+  // uncompressed.
+  //
+  // Default: kDisableCompressionOption, i.e. use compression or compression_per_level.
+  CompressionType bottommost_compression;
+
   // different options for compression algorithms
   CompressionOptions compression_opts;
 
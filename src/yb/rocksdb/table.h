@@ -165,6 +165,16 @@ struct BlockBasedTableOptions {
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
 
+  // Specifies format for encoding entries in index blocks of kMultiLevelBinarySearch index, other
+  // index types always use kKeyDeltaEncodingSharedPrefix.
+  // Index keys are only delta encoded between restart points, so the format only matters when
+  // index_block_restart_interval is greater than 1. With kKeyDeltaEncodingThreeSharedParts
+  // separators of DocDB keys share their hashed and range components as well as the key suffix
+  // with the previous separator, that significantly reduces the size of index blocks of large
+  // files.
+  KeyValueEncodingFormat index_block_key_value_encoding_format =
+      KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -225,6 +235,8 @@ struct BlockBasedTablePropertyNames {
   static const char kPrefixFiltering[];
   // value is a uint8_t.
   static const char kDataBlockKeyValueEncodingFormat[];
+  // value is a uint8_t.
+  static const char kIndexBlockKeyValueEncodingFormat[];
 };
 
 // Create default block based table factory.
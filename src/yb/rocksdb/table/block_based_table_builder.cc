@@ -32,6 +32,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -110,6 +111,7 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
+                    const Slice& compression_dict,
                     std::string* compressed_output) {
   if (*type == kNoCompression) {
     return raw;
@@ -161,9 +163,10 @@ Slice CompressBlock(const Slice& raw,
         return *compressed_output;
       }
       break;     // fall back to no compression.
+    case kZSTD:
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -202,12 +205,14 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
  public:
   explicit BlockBasedTablePropertiesCollector(
       BlockBasedTableBuilder::Rep* rep, IndexType index_type, bool whole_key_filtering,
-      bool prefix_filtering, const KeyValueEncodingFormat key_value_encoding_format)
+      bool prefix_filtering, const KeyValueEncodingFormat key_value_encoding_format,
+      const KeyValueEncodingFormat index_key_value_encoding_format)
       : rep_(rep),
         index_type_(index_type),
         whole_key_filtering_(whole_key_filtering),
         prefix_filtering_(prefix_filtering),
-        key_value_encoding_format_(key_value_encoding_format) {}
+        key_value_encoding_format_(key_value_encoding_format),
+        index_key_value_encoding_format_(index_key_value_encoding_format) {}
 
   virtual Status InternalAdd(const Slice& key, const Slice& value,
                              uint64_t file_size) override {
@@ -234,6 +239,7 @@ class BlockBasedTableBuilder::BlockBasedTablePropertiesCollector
   bool whole_key_filtering_;
   bool prefix_filtering_;
   KeyValueEncodingFormat key_value_encoding_format_;
+  KeyValueEncodingFormat index_key_value_encoding_format_;
 };
 
 // Originally following data was stored in BlockBasedTableBuilder::Rep and related to a single SST
@@ -301,6 +307,22 @@ struct BlockBasedTableBuilder::Rep {
   std::string compressed_output;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
 
+  // Dictionary used to compress data blocks, see CompressionOptions::max_dict_bytes.
+  std::string compression_dict;
+
+  // Until the compression dictionary is built, data blocks are kept in memory, so they could be
+  // used as samples for the dictionary, and then compressed with it.
+  struct BufferedDataBlock {
+    std::string contents;
+    std::string last_key;
+    std::string next_block_first_key;
+  };
+  bool buffer_data_blocks = false;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  size_t buffered_data_size = 0;
+  // Memory used by buffered data blocks, charged to mem_tracker.
+  yb::ScopedTrackedConsumption buffered_data_consumption;
+
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
   yb::MemTrackerPtr mem_tracker;
@@ -339,6 +361,9 @@ Status BlockBasedTableBuilder::BlockBasedTablePropertiesCollector::Finish(
     val.clear();
     PutFixed8(&val, static_cast<uint8_t>(key_value_encoding_format_));
     properties->emplace(BlockBasedTablePropertyNames::kDataBlockKeyValueEncodingFormat, val);
+    val.clear();
+    PutFixed8(&val, static_cast<uint8_t>(index_key_value_encoding_format_));
+    properties->emplace(BlockBasedTablePropertyNames::kIndexBlockKeyValueEncodingFormat, val);
   }
   return Status::OK();
 }
@@ -386,6 +411,16 @@ BlockBasedTableBuilder::Rep::Rep(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
   }
 
+  // Block based filter and hash index track data blocks while keys are added, so they don't support
+  // delayed writing of data blocks.
+  buffer_data_blocks =
+      (compression_type == kZSTD || compression_type == kZSTDNotFinalCompression) &&
+      compression_opts.max_dict_bytes > 0 && filter_type != FilterType::kBlockBasedFilter &&
+      table_options.index_type != IndexType::kHashSearch;
+  if (buffer_data_blocks && mem_tracker) {
+    buffered_data_consumption = yb::ScopedTrackedConsumption(mem_tracker, 0);
+  }
+
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
   metadata_writer->writer = metadata_file;
   if (data_file != nullptr) {
@@ -400,7 +435,10 @@ BlockBasedTableBuilder::Rep::Rep(
   }
   table_properties_collectors.emplace_back(new BlockBasedTablePropertiesCollector(
       this, table_options.index_type, table_options.whole_key_filtering,
-      _ioptions.prefix_extractor != nullptr, table_options.data_block_key_value_encoding_format));
+      _ioptions.prefix_extractor != nullptr, table_options.data_block_key_value_encoding_format,
+      table_options.index_type == IndexType::kMultiLevelBinarySearch
+          ? table_options.index_block_key_value_encoding_format
+          : kIndexBlockKeyValueEncodingFormat));
 }
 
 BlockBasedTableBuilder::BlockBasedTableBuilder(
@@ -498,12 +536,24 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
+
+  if (r->buffer_data_blocks && !r->data_block_builder.empty()) {
+    BufferDataBlock(next_block_first_key);
+    return;
+  }
+
   size_t data_block_size = 0;
 
   if (!r->data_block_builder.empty()) {
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+        r->data_writer.get(), r->compression_dict);
   }
+  FinishDataBlock(data_block_size, &r->last_key, next_block_first_key);
+}
+
+void BlockBasedTableBuilder::FinishDataBlock(
+    size_t data_block_size, std::string* last_key, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
   if (!ok()) return;
 
   if (!r->table_options.skip_table_builder_flush) {
@@ -526,7 +576,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
   while (r->data_index_builder->ShouldFlush()) {
@@ -545,6 +595,63 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   }
 }
 
+void BlockBasedTableBuilder::BufferDataBlock(const Slice& next_block_first_key) {
+  Rep* const r = rep_;
+  const Slice contents = r->data_block_builder.Finish();
+  r->buffered_data_size += contents.size();
+  r->buffered_data_blocks.push_back(Rep::BufferedDataBlock {
+      contents.ToBuffer(), r->last_key, next_block_first_key.ToBuffer() });
+  if (r->buffered_data_consumption) {
+    const auto& block = r->buffered_data_blocks.back();
+    r->buffered_data_consumption.Add(
+        block.contents.capacity() + block.last_key.capacity() +
+        block.next_block_first_key.capacity());
+  }
+  r->data_block_builder.Reset();
+
+  const auto& opts = r->compression_opts;
+  if (r->buffered_data_size >= std::max(opts.max_dict_bytes, opts.zstd_max_train_bytes)) {
+    FlushBufferedDataBlocks();
+  }
+}
+
+void BlockBasedTableBuilder::FlushBufferedDataBlocks() {
+  Rep* const r = rep_;
+  r->buffer_data_blocks = false;
+  auto blocks = std::move(r->buffered_data_blocks);
+  r->buffered_data_blocks.clear();
+  r->buffered_data_size = 0;
+  // Released when the buffered blocks and samples are destroyed at the end of this function.
+  auto consumption = std::move(r->buffered_data_consumption);
+  if (blocks.empty()) {
+    return;
+  }
+
+  std::string samples;
+  std::vector<size_t> sample_lens;
+  sample_lens.reserve(blocks.size());
+  for (const auto& block : blocks) {
+    samples += block.contents;
+    sample_lens.push_back(block.contents.size());
+  }
+  if (consumption) {
+    consumption.Add(samples.capacity());
+  }
+  const auto& opts = r->compression_opts;
+  if (opts.zstd_max_train_bytes > 0) {
+    r->compression_dict = ZSTD_TrainDictionary(samples, sample_lens, opts.max_dict_bytes);
+  } else {
+    r->compression_dict = samples.substr(0, opts.max_dict_bytes);
+  }
+
+  for (auto& block : blocks) {
+    if (!ok()) return;
+    const size_t data_block_size = WriteBlock(
+        block.contents, &r->data_pending_handle, r->data_writer.get(), r->compression_dict);
+    FinishDataBlock(data_block_size, &block.last_key, block.next_block_first_key);
+  }
+}
+
 void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_first_filter_key) {
   Rep* const r = rep_;
   assert(!r->closed);
@@ -575,15 +682,17 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_firs
 
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const Slice& compression_dict) {
+  size_t block_size = WriteBlock(block->Finish(), handle, writer_info, compression_dict);
   block->Reset();
   return block_size;
 }
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const Slice& compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -596,7 +705,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, compression_dict, &r->compressed_output);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -717,6 +826,10 @@ Status BlockBasedTableBuilder::Finish() {
   if (!r->data_block_builder.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
+  if (r->buffer_data_blocks) {
+    // The whole file fits into the buffer, so dictionary is built from all its data.
+    FlushBufferedDataBlocks();
+  }
   if (r->filter_block_builder != nullptr) {
     FlushFilterBlock(nullptr);  // no more filter block
   }
@@ -743,6 +856,14 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && !r->compression_dict.empty()) {
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(
+        r->compression_dict, kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -858,6 +979,8 @@ void BlockBasedTableBuilder::Abandon() {
   Rep* r = rep_;
   assert(!r->closed);
   r->closed = true;
+  r->buffered_data_blocks.clear();
+  r->buffered_data_consumption = yb::ScopedTrackedConsumption();
 }
 
 uint64_t BlockBasedTableBuilder::NumEntries() const {
@@ -865,8 +988,9 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are not written yet, so their uncompressed size is used as an estimate.
+  return (rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
+      rep_->metadata_writer->offset) + rep_->buffered_data_size;
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
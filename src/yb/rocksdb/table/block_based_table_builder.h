@@ -111,11 +111,14 @@ class BlockBasedTableBuilder : public TableBuilder {
   bool ok() const { return status().ok(); }
   // Call block's Finish() method and then write the finalize block contents to
   // file. Returns number of bytes written to file.
+  // compression_dict is the dictionary used to compress the block, if not empty.
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-                    FileWriterWithOffsetAndCachePrefix* writer_info);
+                    FileWriterWithOffsetAndCachePrefix* writer_info,
+                    const Slice& compression_dict = Slice());
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const Slice& compression_dict = Slice());
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -133,6 +136,18 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called.
   void FlushDataBlock(const Slice& next_block_first_key);
 
+  // Updates table properties and adds index entry for the data block that was just written.
+  void FinishDataBlock(size_t data_block_size, std::string* last_key,
+                       const Slice& next_block_first_key);
+
+  // Keeps the current data block in memory, until there is enough data to build the compression
+  // dictionary.
+  void BufferDataBlock(const Slice& next_block_first_key);
+
+  // Builds the compression dictionary from the buffered data blocks, and writes them compressed
+  // with this dictionary.
+  void FlushBufferedDataBlocks();
+
   // Flush the current filter block into disk. next_block_first_filter_key should be nullptr if this
   // is the last block written to disk.
   // REQUIRES: Finish(), Abandon() have not been called.
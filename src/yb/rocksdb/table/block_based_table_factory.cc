@@ -178,6 +178,10 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  index_block_key_value_encoding_format: %s\n",
+           KeyValueEncodingFormatToString(
+               table_options_.index_block_key_value_encoding_format).c_str());
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr ?
              "nullptr" : table_options_.filter_policy->Name());
@@ -217,6 +221,8 @@ const char BlockBasedTablePropertyNames::kPrefixFiltering[] =
     "rocksdb.block.based.table.prefix.filtering";
 const char BlockBasedTablePropertyNames::kDataBlockKeyValueEncodingFormat[] =
     "rocksdb.block.based.table.data.block.key.value.encoding.format";
+const char BlockBasedTablePropertyNames::kIndexBlockKeyValueEncodingFormat[] =
+    "rocksdb.block.based.table.index.block.key.value.encoding.format";
 const char kHashIndexPrefixesBlock[] = "rocksdb.hashindex.prefixes";
 const char kHashIndexPrefixesMetadataBlock[] =
     "rocksdb.hashindex.metadata";
@@ -234,6 +234,10 @@ struct BlockBasedTable::Rep {
   bool prefix_filtering = false;
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+  // Format of data index blocks. Files written before the format became configurable don't have
+  // the corresponding property and use kIndexBlockKeyValueEncodingFormat.
+  KeyValueEncodingFormat data_index_block_key_value_encoding_format =
+      kIndexBlockKeyValueEncodingFormat;
   // TODO(kailiu) It is very ugly to use internal key in table, since table
   // module should not be relying on db module. However to make things easier
   // and compatible with existing code, we introduce a wrapper that allows
@@ -242,6 +246,9 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Dictionary that was used to compress data blocks, empty if dictionary was not used.
+  std::string compression_dict;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
@@ -319,7 +326,7 @@ KeyValueEncodingFormat BlockBasedTable::GetKeyValueEncodingFormat(const BlockTyp
     case BlockType::kData:
       return rep_->data_block_key_value_encoding_format;
     case BlockType::kIndex:
-      return kIndexBlockKeyValueEncodingFormat;
+      return rep_->data_index_block_key_value_encoding_format;
   }
   FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
 }
@@ -425,6 +432,16 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->ReadPropertiesBlock(meta_iter.get()));
 
+  BlockHandle compression_dict_handle;
+  if (FindMetaBlock(meta_iter.get(), kCompressionDictBlock, &compression_dict_handle).ok()) {
+    BlockContents compression_dict_block;
+    RETURN_NOT_OK(ReadBlockContents(
+        rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
+        compression_dict_handle, &compression_dict_block, rep->ioptions.env, rep->mem_tracker,
+        false /* do_uncompress */));
+    rep->compression_dict = compression_dict_block.data.ToBuffer();
+  }
+
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
@@ -567,6 +584,11 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
       rep_->data_block_key_value_encoding_format =
           static_cast<KeyValueEncodingFormat>(DecodeFixed8(it->second.c_str()));
     }
+    it = props.find(BlockBasedTablePropertyNames::kIndexBlockKeyValueEncodingFormat);
+    if (it != props.end()) {
+      rep_->data_index_block_key_value_encoding_format =
+          static_cast<KeyValueEncodingFormat>(DecodeFixed8(it->second.c_str()));
+    }
   }
 
   return Status::OK();
@@ -758,7 +780,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -802,7 +824,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -830,7 +852,7 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -839,7 +861,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -1191,6 +1213,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  // Only data blocks are compressed using dictionary.
+  const Slice compression_dict =
+      block_type == BlockType::kData ? Slice(rep_->compression_dict) : Slice();
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1211,7 +1236,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, compression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1219,13 +1244,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, compression_dict);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                compression_dict);
       }
     }
   }
@@ -1244,7 +1270,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, compression_dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1554,7 +1580,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->compression_dict);
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
@@ -1639,7 +1666,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       }
       int num_levels = DecodeFixed32(pos->second.c_str());
       auto result = MultiLevelIndexReader::Create(
-          file, footer, num_levels, footer.index_handle(), env, comparator, rep_->mem_tracker);
+          file, footer, num_levels, footer.index_handle(), env, comparator,
+          rep_->data_index_block_key_value_encoding_format, rep_->mem_tracker);
       RETURN_NOT_OK(result);
       *index_reader = std::move(*result);
       return Status::OK();
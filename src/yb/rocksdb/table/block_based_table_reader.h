@@ -251,7 +251,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const Slice& compression_dict = Slice());
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -266,7 +267,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const Slice& compression_dict = Slice());
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -445,7 +445,8 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         const Slice& compression_dict) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -476,7 +477,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, compression_dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -503,7 +505,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const Slice& compression_dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -570,9 +573,10 @@ Status UncompressBlockContents(const char* data, size_t n,
       *contents =
           BlockContents(std::move(ubuf), decompress_size, true, kNoCompression, mem_tracker);
       break;
+    case kZSTD:
     case kZSTDNotFinalCompression:
-      ubuf =
-          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
+      ubuf = std::unique_ptr<char[]>(
+          ZSTD_Uncompress(data, n, &decompress_size, compression_dict));
       if (!ubuf) {
         static char zstd_corrupt_msg[] =
             "ZSTD not supported or corrupted ZSTD compressed block contents";
@@ -147,7 +147,9 @@ void MultiLevelIndexBuilder::EnsureCurrentLevelIndexBuilderCreated() {
   if (!current_level_index_block_builder_) {
     DCHECK(!flush_policy_);
     current_level_index_block_builder_.reset(
-        new ShortenedIndexBuilder(comparator_, table_opt_.index_block_restart_interval));
+        new ShortenedIndexBuilder(
+            comparator_, table_opt_.index_block_restart_interval,
+            table_opt_.index_block_key_value_encoding_format));
     flush_policy_ = FlushBlockBySizePolicyFactory::NewFlushBlockPolicy(
         table_opt_.index_block_size, table_opt_.block_size_deviation,
         table_opt_.min_keys_per_index_block,
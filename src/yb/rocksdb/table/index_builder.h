@@ -118,10 +118,11 @@ YB_STRONGLY_TYPED_BOOL(ShortenKeys);
 //     substitute key that serves the same function.
 class ShortenedIndexBuilder : public IndexBuilder {
  public:
-  explicit ShortenedIndexBuilder(const Comparator* comparator,
-                                 int index_block_restart_interval)
+  ShortenedIndexBuilder(
+      const Comparator* comparator, int index_block_restart_interval,
+      KeyValueEncodingFormat key_value_encoding_format = kIndexBlockKeyValueEncodingFormat)
       : IndexBuilder(comparator),
-        index_block_builder_(index_block_restart_interval, kIndexBlockKeyValueEncodingFormat) {}
+        index_block_builder_(index_block_restart_interval, key_value_encoding_format) {}
 
   void AddIndexEntry(
       std::string* last_key_in_current_block,
@@ -289,25 +289,27 @@ class MultiLevelIterator : public InternalIterator {
 Result<std::unique_ptr<MultiLevelIndexReader>> MultiLevelIndexReader::Create(
     RandomAccessFileReader* file, const Footer& footer, const int num_levels,
     const BlockHandle& top_level_index_handle, Env* env, const ComparatorPtr& comparator,
+    const KeyValueEncodingFormat key_value_encoding_format,
     const std::shared_ptr<yb::MemTracker>& mem_tracker) {
   std::unique_ptr<Block> index_block;
   RETURN_NOT_OK(block_based_table::ReadBlockFromFile(
       file, footer, ReadOptions::kDefault, top_level_index_handle, &index_block, env,
       mem_tracker));
 
-  return std::make_unique<MultiLevelIndexReader>(comparator, num_levels, std::move(index_block));
+  return std::make_unique<MultiLevelIndexReader>(
+      comparator, num_levels, key_value_encoding_format, std::move(index_block));
 }
 
 InternalIterator* MultiLevelIndexReader::NewIterator(
     BlockIter* iter, TwoLevelIteratorState* index_iterator_state, bool) {
-  InternalIterator* top_level_iter = top_level_index_block_->NewIndexIterator(
-      comparator_.get(), iter, true /* total_order_seek */);
+  InternalIterator* top_level_iter = top_level_index_block_->NewIterator(
+      comparator_.get(), key_value_encoding_format_, iter, true /* total_order_seek */);
   return new MultiLevelIterator(
       index_iterator_state, top_level_iter, num_levels_, top_level_iter != iter);
 }
 
 Result<Slice> MultiLevelIndexReader::GetMiddleKey() {
-  return top_level_index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
+  return top_level_index_block_->GetMiddleKey(key_value_encoding_format_);
 }
 
 } // namespace rocksdb
@@ -183,13 +183,16 @@ class MultiLevelIndexReader : public IndexReader {
   static Result<std::unique_ptr<MultiLevelIndexReader>> Create(
       RandomAccessFileReader* file, const Footer& footer, int num_levels,
       const BlockHandle& top_level_index_handle, Env* env, const ComparatorPtr& comparator,
+      KeyValueEncodingFormat key_value_encoding_format,
       const std::shared_ptr<yb::MemTracker>& mem_tracker);
 
   MultiLevelIndexReader(
       const ComparatorPtr& comparator, int num_levels,
+      KeyValueEncodingFormat key_value_encoding_format,
       std::unique_ptr<Block> top_level_index_block)
       : IndexReader(comparator),
         num_levels_(num_levels),
+        key_value_encoding_format_(key_value_encoding_format),
         top_level_index_block_(std::move(top_level_index_block)) {
     DCHECK_ONLY_NOTNULL(top_level_index_block_.get());
   }
@@ -213,6 +216,8 @@ class MultiLevelIndexReader : public IndexReader {
   }
 
   const int num_levels_;
+  // Format of entries in index blocks of all levels.
+  const KeyValueEncodingFormat key_value_encoding_format_;
   const std::unique_ptr<Block> top_level_index_block_;
 };
 
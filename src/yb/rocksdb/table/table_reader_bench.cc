@@ -26,6 +26,8 @@ int main() {
 }
 #else
 
+#include <inttypes.h>
+
 #include <gflags/gflags.h>
 
 #include "yb/rocksdb/db.h"
@@ -159,6 +161,12 @@ void TableReaderBenchmark(const Options& opts, const EnvOptions& env_options,
     }
   }
 
+  if (!through_db) {
+    auto props = table_reader->GetTableProperties();
+    fprintf(stderr, "Data size: %" PRIu64 ", index size: %" PRIu64 ", reader memory: %zu\n",
+            props->data_size, props->index_size, table_reader->ApproximateMemoryUsage());
+  }
+
   Random rnd(301);
   std::string result;
   HistogramImpl hist;
@@ -277,6 +285,11 @@ DEFINE_bool(through_db, false, "If enable, a DB instance will be created and "
 DEFINE_bool(mmap_read, true, "Whether use mmap read");
 DEFINE_string(table_factory, "block_based",
               "Table factory to use: `block_based` (default) or `plain_table`.");
+DEFINE_int32(index_block_restart_interval, 1,
+             "Number of keys between restart points of index blocks of block based table.");
+DEFINE_string(index_block_key_value_encoding, "shared_prefix",
+              "Key-value encoding of index blocks of block based table: `shared_prefix` "
+              "(default) or `three_shared_parts`.");
 DEFINE_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
@@ -310,7 +323,14 @@ int main(int argc, char** argv) {
     options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(
         FLAGS_prefix_len));
   } else if (FLAGS_table_factory == "block_based") {
-    tf.reset(new rocksdb::BlockBasedTableFactory());
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.index_block_restart_interval = FLAGS_index_block_restart_interval;
+    for (auto format : rocksdb::kKeyValueEncodingFormatList) {
+      if (FLAGS_index_block_key_value_encoding == KeyValueEncodingFormatToString(format)) {
+        table_options.index_block_key_value_encoding_format = format;
+      }
+    }
+    tf.reset(new rocksdb::BlockBasedTableFactory(table_options));
   } else {
     fprintf(stderr, "Invalid table type %s\n", FLAGS_table_factory.c_str());
   }
@@ -66,6 +66,7 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/format.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 
@@ -307,7 +308,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -583,8 +584,8 @@ static std::vector<TestArgs> GenerateArgList() {
     compression_types.emplace_back(kLZ4HCCompression, true);
   }
   if (ZSTD_Supported()) {
-    compression_types.emplace_back(kZSTDNotFinalCompression, false);
-    compression_types.emplace_back(kZSTDNotFinalCompression, true);
+    compression_types.emplace_back(kZSTD, false);
+    compression_types.emplace_back(kZSTD, true);
   }
 
   for (auto test_type : test_types) {
@@ -1899,6 +1900,70 @@ TEST_F(BlockBasedTableTest, InvalidOptions) {
   ValidateBlockRestartInterval(1000, 1000);
 }
 
+namespace {
+
+// Builds table compressed with ZSTD, checks that all data could be read back and returns size of
+// data blocks.
+uint64_t CheckZSTDTable(uint32_t max_dict_bytes, uint32_t zstd_max_train_bytes) {
+  TableConstructor c(BytewiseComparator(), true /* convert_to_internal_key */);
+  // Values share long common part, that could be compressed only using dictionary, when values
+  // are in different blocks.
+  Random rnd(301);
+  const std::string common = RandomString(&rnd, 200);
+  for (int i = 0; i != 1000; ++i) {
+    c.Add("k" + std::to_string(1000000 + i), common + RandomString(&rnd, 50));
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  options.compression = kZSTD;
+  options.compression_opts.max_dict_bytes = max_dict_bytes;
+  options.compression_opts.zstd_max_train_bytes = zstd_max_train_bytes;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, GetPlainInternalComparator(options.comparator),
+           &keys, &kvmap);
+
+  auto props = c.GetTableProperties();
+  EXPECT_GT(props.num_data_blocks, 1U);
+
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    EXPECT_TRUE(iter->Valid());
+    if (!iter->Valid()) {
+      break;
+    }
+    EXPECT_EQ(kv.first, iter->key().ToBuffer());
+    EXPECT_EQ(kv.second, iter->value().ToBuffer());
+    iter->Next();
+  }
+  EXPECT_FALSE(iter->Valid());
+  EXPECT_OK(iter->status());
+
+  return props.data_size;
+}
+
+} // namespace
+
+TEST_F(BlockBasedTableTest, ZSTDDictionaryCompression) {
+  if (!ZSTD_Supported()) {
+    fprintf(stderr, "skipping zstd dictionary compression test\n");
+    return;
+  }
+
+  const auto no_dict_size = CheckZSTDTable(0, 0);
+  const auto raw_dict_size = CheckZSTDTable(4096, 0);
+  const auto trained_dict_size = CheckZSTDTable(4096, 64 * 1024);
+  LOG(INFO) << "No dictionary: " << no_dict_size << ", raw dictionary: " << raw_dict_size
+            << ", trained dictionary: " << trained_dict_size;
+  ASSERT_LT(raw_dict_size, no_dict_size);
+  ASSERT_LT(trained_dict_size, no_dict_size);
+}
+
 TEST_F(BlockBasedTableTest, BlockReadCountTest) {
   // bloom_filter_type = 0 -- block-based filter
   // bloom_filter_type = 1 -- full filter
@@ -2454,6 +2519,8 @@ TEST_P(IndexBlockRestartIntervalTest, IndexBlockRestartInterval) {
     // were no other formats before we added this property.
     table_options.data_block_key_value_encoding_format =
         format.get_value_or(KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix);
+    table_options.index_block_key_value_encoding_format =
+        table_options.data_block_key_value_encoding_format;
     options.table_factory.reset(new BlockBasedTableFactory(table_options));
 
     TableConstructor c(BytewiseComparator());
@@ -2498,6 +2565,58 @@ TEST_P(IndexBlockRestartIntervalTest, IndexBlockRestartInterval) {
   }
 }
 
+TEST_F(BlockBasedTableTest, IndexBlockKeyValueEncoding) {
+  constexpr int kKeysInTable = 20000;
+
+  // Keys that look like DocDB keys: hash, hashed and range components, and hybrid time, so
+  // neighbour separators share their prefix and parts after the range component.
+  std::vector<std::string> keys;
+  for (int i = 0; i < kKeysInTable; i++) {
+    auto user_key = yb::Format("H$0S$1_$2R$3#HT$4", i / 1000, 100000 + i / 10, "column_value",
+                               i % 10, 1000000);
+    keys.push_back(InternalKey(user_key, 0, kTypeValue).Encode().ToString());
+  }
+
+  uint64_t default_index_size = 0;
+  for (auto format : kKeyValueEncodingFormatList) {
+    Options options;
+    options.compression = kNoCompression;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 64;  // small block size to get big index
+    table_options.index_block_restart_interval = 16;
+    table_options.index_block_key_value_encoding_format = format;
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+
+    TableConstructor c(BytewiseComparator());
+    for (const auto& key : keys) {
+      c.Add(key, "val");
+    }
+    std::vector<std::string> ks;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             std::make_shared<InternalKeyComparator>(BytewiseComparator()), &ks, &kvmap);
+    auto reader = c.GetTableReader();
+
+    auto index_size = reader->GetTableProperties()->data_index_size;
+    LOG(INFO) << KeyValueEncodingFormatToString(format) << " index size: " << index_size;
+    if (format == KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix) {
+      default_index_size = index_size;
+    } else {
+      ASSERT_LT(index_size, default_index_size);
+    }
+
+    std::unique_ptr<InternalIterator> iter(reader->NewIterator(ReadOptions()));
+    for (const auto& key : keys) {
+      iter->Seek(key);
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), key);
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_RESULT(reader->GetMiddleKey());
+  }
+}
+
 class PrefixTest : public testing::Test {
  public:
   PrefixTest() : testing::Test() {}
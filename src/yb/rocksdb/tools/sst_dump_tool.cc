@@ -233,14 +233,13 @@ int SstFileReader::ShowAllCompressionSizes(size_t block_size) {
       std::make_pair(CompressionType::kLZ4Compression, "kLZ4Compression"));
   compress_type.insert(
       std::make_pair(CompressionType::kLZ4HCCompression, "kLZ4HCCompression"));
-  compress_type.insert(std::make_pair(CompressionType::kZSTDNotFinalCompression,
-                                      "kZSTDNotFinalCompression"));
+  compress_type.insert(std::make_pair(CompressionType::kZSTD, "kZSTD"));
 
   fprintf(stdout, "Block Size: %" ROCKSDB_PRIszt "\n", block_size);
 
   for (CompressionType i = CompressionType::kNoCompression;
-       i <= CompressionType::kZSTDNotFinalCompression;
-       i = (i == kLZ4HCCompression) ? kZSTDNotFinalCompression
+       i <= CompressionType::kZSTD;
+       i = (i == kLZ4HCCompression) ? kZSTD
                                     : CompressionType(i + 1)) {
     CompressionOptions compress_opt;
     TableBuilderOptions tb_opts(imoptions,
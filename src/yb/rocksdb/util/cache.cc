@@ -24,6 +24,8 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <vector>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -209,6 +211,10 @@ class HandleTable {
     return result;
   }
 
+  uint32_t size() const {
+    return elems_;
+  }
+
  private:
   // The table consists of an array of buckets where each bucket is
   // a linked list of cache entries that hash into the bucket.
@@ -260,6 +266,77 @@ class HandleTable {
   }
 };
 
+// Approximate access frequency of keys, used by TinyLFU admission policy.
+// Count-min sketch with kDepth rows of small saturating counters. After the number of recorded
+// accesses reaches the sample size, all counters are halved, so the estimate reflects recent
+// history and keys that were hot long ago do not stay in the cache forever.
+class FrequencySketch {
+ public:
+  FrequencySketch() {
+    Resize(kMinWidth);
+  }
+
+  // Resizes the sketch to track about expected_keys distinct keys. Resets all counters.
+  void Resize(size_t expected_keys) {
+    size_t width = kMinWidth;
+    while (width < expected_keys) {
+      width *= 2;
+    }
+    width_mask_ = width - 1;
+    counters_.assign(width * kDepth, 0);
+    additions_ = 0;
+    sample_size_ = width * 10;
+  }
+
+  size_t width() const {
+    return width_mask_ + 1;
+  }
+
+  void Increment(uint32_t hash) {
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& counter = counters_[Index(hash, row)];
+      if (counter < kMaxCount) {
+        ++counter;
+      }
+    }
+    if (++additions_ >= sample_size_) {
+      for (auto& counter : counters_) {
+        counter >>= 1;
+      }
+      additions_ /= 2;
+    }
+  }
+
+  uint8_t Estimate(uint32_t hash) const {
+    uint8_t result = kMaxCount;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result, counters_[Index(hash, row)]);
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 1024;
+  static constexpr uint8_t kMaxCount = 15;
+
+  static constexpr uint64_t kSeeds[kDepth] = {
+      0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+      0xcbf29ce484222325ULL };
+
+  size_t Index(uint32_t hash, size_t row) const {
+    uint64_t h = (hash + kSeeds[row]) * kSeeds[row];
+    return row * width() + ((h >> 32) & width_mask_);
+  }
+
+  std::vector<uint8_t> counters_;
+  size_t width_mask_ = 0;
+  size_t additions_ = 0;
+  size_t sample_size_ = 0;
+};
+
+constexpr uint64_t FrequencySketch::kSeeds[FrequencySketch::kDepth];
+
 // Sub-cache of the LRUCache that is used to track different LRU pointers, capacity and usage.
 class LRUSubCache {
  public:
@@ -392,6 +469,11 @@ class LRUCache {
   // Set the flag to reject insertion if cache if full.
   void SetStrictCapacityLimit(bool strict_capacity_limit);
 
+  void SetAdmissionPolicy(CacheAdmissionPolicy admission_policy) {
+    MutexLock l(&mutex_);
+    admission_policy_ = admission_policy;
+  }
+
   // Like Cache methods, but with an extra "hash" parameter.
   Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
                 void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
@@ -460,9 +542,18 @@ class LRUCache {
     return single_touch_sub_cache_.Usage() + multi_touch_sub_cache_.Usage();
   }
 
+  // Checks whether new entry should be added to the subcache, according to the admission policy.
+  // Entries are always admitted while there is free space in the subcache.
+  bool Admit(LRUHandle* e, SubCacheType subcache_type);
+
   // Whether to reject insertion if cache reaches its full capacity.
   bool strict_capacity_limit_ = false;
 
+  CacheAdmissionPolicy admission_policy_ = CacheAdmissionPolicy::kAlways;
+
+  // Access frequencies of keys, maintained only for kTinyLFU admission policy.
+  FrequencySketch sketch_;
+
   // mutex_ protects the following state.
   // We don't count mutex_ as the cache's internal state so semantically we
   // don't mind mutex_ invoking the non-const actions.
@@ -577,6 +668,9 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  if (admission_policy_ == CacheAdmissionPolicy::kTinyLFU) {
+    sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -688,6 +782,22 @@ void LRUCache::Release(Cache::Handle* handle) {
   }
 }
 
+bool LRUCache::Admit(LRUHandle* e, SubCacheType subcache_type) {
+  if (admission_policy_ != CacheAdmissionPolicy::kTinyLFU) {
+    return true;
+  }
+  LRUSubCache* sub_cache = GetSubCache(subcache_type);
+  if (sub_cache->Usage() + e->charge <= GetSubCacheCapacity(subcache_type) ||
+      sub_cache->IsLRUEmpty()) {
+    return true;
+  }
+  if (table_.size() > sketch_.width()) {
+    sketch_.Resize(table_.size());
+  }
+  const LRUHandle* victim = sub_cache->LRU_Head().next;
+  return sketch_.Estimate(e->hash) > sketch_.Estimate(victim->hash);
+}
+
 size_t LRUCache::Evict(size_t required) {
   LRUHandleDeleter evicted(metrics_.get());
   {
@@ -744,50 +854,74 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
-    EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
-    // If the cache no longer has any more space in the given pool.
-    if (strict_capacity_limit_ &&
-        sub_cache->Usage() - sub_cache->LRU_Usage() + charge > GetSubCacheCapacity(subcache_type)) {
+    // Entries that were already accessed by other queries are always admitted, since scans should
+    // not prevent blocks that are being reused from entering the cache.
+    const bool reused = query_id == kInMultiTouchId ||
+                        (FLAGS_cache_single_touch_ratio != 0 && e->query_id == kInMultiTouchId);
+    const bool admitted = reused || Admit(e, subcache_type);
+    if (!admitted) {
+      // The entry does not replace any of existing entries. If the caller requested a handle, the
+      // entry is returned to it, and freed when the handle is released.
+      e->in_cache = false;
       if (handle == nullptr) {
+        e->refs = 0;
         last_reference_list.Add(e);
       } else {
-        delete[] reinterpret_cast<char*>(e);
-        *handle = nullptr;
+        e->refs = 1;
+        sub_cache->IncrementUsage(e->charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
       }
-      s = STATUS(Incomplete, "Insert failed due to LRU cache being full.");
+      if (metrics_ != nullptr) {
+        metrics_->admission_rejects->Increment();
+      }
+      s = Status::OK();
     } else {
-      // insert into the cache
-      // note that the cache might get larger than its capacity if not enough
-      // space was freed
-      LRUHandle* old = table_.Insert(e);
-      sub_cache->IncrementUsage(e->charge);
-      if (old != nullptr) {
-        old->in_cache = false;
-        if (Unref(old)) {
-          DecrementUsage(old->GetSubCacheType(), old->charge);
-          // old is on LRU because it's in cache and its reference count
-          // was just 1 (Unref returned 0)
-          LRU_Remove(old);
-          last_reference_list.Add(old);
+      EvictFromLRU(charge, &last_reference_list, subcache_type);
+      // If the cache no longer has any more space in the given pool.
+      if (strict_capacity_limit_ &&
+          sub_cache->Usage() - sub_cache->LRU_Usage() + charge >
+              GetSubCacheCapacity(subcache_type)) {
+        if (handle == nullptr) {
+          last_reference_list.Add(e);
+        } else {
+          delete[] reinterpret_cast<char*>(e);
+          *handle = nullptr;
         }
-      }
-      // No external reference, so put it in LRU to be potentially evicted.
-      if (handle == nullptr) {
-        LRU_Append(e);
+        s = STATUS(Incomplete, "Insert failed due to LRU cache being full.");
       } else {
-        *handle = reinterpret_cast<Cache::Handle*>(e);
-      }
-      if (subcache_type == MULTI_TOUCH && FLAGS_cache_single_touch_ratio != 0) {
-        // Evict entries from single touch cache if the total size increases. This can happen if
-        // single touch entries has overflown and we insert entries directly into the multi touch
-        // cache without it going through the single touch cache.
-        EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
+        // insert into the cache
+        // note that the cache might get larger than its capacity if not enough
+        // space was freed
+        LRUHandle* old = table_.Insert(e);
+        sub_cache->IncrementUsage(e->charge);
+        if (old != nullptr) {
+          old->in_cache = false;
+          if (Unref(old)) {
+            DecrementUsage(old->GetSubCacheType(), old->charge);
+            // old is on LRU because it's in cache and its reference count
+            // was just 1 (Unref returned 0)
+            LRU_Remove(old);
+            last_reference_list.Add(old);
+          }
+        }
+        // No external reference, so put it in LRU to be potentially evicted.
+        if (handle == nullptr) {
+          LRU_Append(e);
+        } else {
+          *handle = reinterpret_cast<Cache::Handle*>(e);
+        }
+        if (subcache_type == MULTI_TOUCH && FLAGS_cache_single_touch_ratio != 0) {
+          // Evict entries from single touch cache if the total size increases. This can happen if
+          // single touch entries has overflown and we insert entries directly into the multi touch
+          // cache without it going through the single touch cache.
+          EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
+        }
+        s = Status::OK();
       }
-      s = Status::OK();
     }
     if (statistics != nullptr) {
-      if (s.ok()) {
+      if (s.ok() && admitted) {
         RecordTick(statistics, BLOCK_CACHE_ADD);
         RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
         if (subcache_type == SubCacheType::SINGLE_TOUCH) {
@@ -866,7 +1000,7 @@ class ShardedLRUCache : public Cache {
 
  public:
   ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+                  bool strict_capacity_limit, CacheAdmissionPolicy admission_policy)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
@@ -877,6 +1011,7 @@ class ShardedLRUCache : public Cache {
     const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+      shards_[s].SetAdmissionPolicy(admission_policy);
       shards_[s].SetCapacity(per_shard);
     }
   }
@@ -1026,11 +1161,18 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits) {
 
 shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                               bool strict_capacity_limit) {
+  return NewLRUCache(capacity, num_shard_bits, strict_capacity_limit,
+                     CacheAdmissionPolicy::kAlways);
+}
+
+shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                              bool strict_capacity_limit,
+                              CacheAdmissionPolicy admission_policy) {
   if (num_shard_bits >= 20) {
     return nullptr;  // the cache cannot be sharded into too many fine pieces
   }
   return std::make_shared<ShardedLRUCache>(capacity, num_shard_bits,
-                                           strict_capacity_limit);
+                                           strict_capacity_limit, admission_policy);
 }
 
 }  // namespace rocksdb
@@ -32,6 +32,9 @@ int main() {
 #include <inttypes.h>
 #include <sys/types.h>
 #include <stdio.h>
+
+#include <atomic>
+
 #include <gflags/gflags.h>
 
 #include "yb/rocksdb/db.h"
@@ -61,6 +64,15 @@ DEFINE_int32(lookup_percent, 50,
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
 
+DEFINE_string(admission_policy, "lru", "Cache admission policy: lru or tiny_lfu.");
+DEFINE_bool(scan_workload, false,
+            "Run mixed workload of point reads of hot keys and sequential scans, instead of "
+            "random insert/lookup/erase operations. Reports hit rate of point reads.");
+DEFINE_int64(hot_keys, 64 * KB, "Number of keys accessed by point reads in scan workload.");
+DEFINE_int32(scan_percent, 50,
+             "Ratio of scan steps to total scan workload (expressed as a percentage)");
+DEFINE_int32(value_size, 1, "Charge of every value inserted into the cache.");
+
 namespace rocksdb {
 
 class CacheBench;
@@ -142,10 +154,21 @@ struct ThreadState {
 };
 }  // namespace
 
+CacheAdmissionPolicy AdmissionPolicy() {
+  if (FLAGS_admission_policy == "tiny_lfu") {
+    return CacheAdmissionPolicy::kTinyLFU;
+  }
+  if (FLAGS_admission_policy != "lru") {
+    fprintf(stderr, "Unknown admission policy %s, using lru\n", FLAGS_admission_policy.c_str());
+  }
+  return CacheAdmissionPolicy::kAlways;
+}
+
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits,
+                         false /* strict_capacity_limit */, AdmissionPolicy())),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,7 +180,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], FLAGS_value_size, &deleter);
     }
   }
 
@@ -194,6 +217,11 @@ class CacheBench {
       uint32_t qps = static_cast<uint32_t>(
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      if (FLAGS_scan_workload) {
+        auto point_reads = point_reads_.load();
+        fprintf(stdout, "Point reads: %" PRIu64 ", hit rate: %.2f%%\n", point_reads,
+                point_reads ? point_read_hits_.load() * 100.0 / point_reads : 0.0);
+      }
     }
     return true;
   }
@@ -202,6 +230,42 @@ class CacheBench {
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
 
+  // Scans use keys starting from this value, so they do not intersect with hot keys.
+  static constexpr uint64_t kScanKeysStart = 1ULL << 62;
+  std::atomic<uint64_t> next_scan_key_{kScanKeysStart};
+  std::atomic<uint64_t> point_reads_{0};
+  std::atomic<uint64_t> point_read_hits_{0};
+
+  // Looks up the key and inserts it on miss, like a block based table reader. Returns true on hit.
+  bool ReadThrough(uint64_t key_value, QueryId query_id) {
+    Slice key(reinterpret_cast<char*>(&key_value), sizeof(key_value));
+    auto handle = cache_->Lookup(key, query_id);
+    if (handle) {
+      cache_->Release(handle);
+      return true;
+    }
+    cache_->Insert(key, query_id, new char[10], FLAGS_value_size, &deleter);
+    return false;
+  }
+
+  void OperateScanWorkload(ThreadState* thread) {
+    // Every point read is a separate query, while scan steps of the thread belong to one query.
+    const QueryId scan_query_id = thread->tid + 1;
+    uint64_t next_point_query_id = (static_cast<uint64_t>(thread->tid) + 1) << 40;
+    for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
+      if (static_cast<int32_t>(thread->rnd.Uniform(100)) < FLAGS_scan_percent) {
+        ReadThrough(next_scan_key_.fetch_add(1, std::memory_order_relaxed), scan_query_id);
+      } else {
+        // Skewed distribution of hot keys, so some of them are accessed much more often.
+        uint64_t key = thread->rnd.Skewed(20) % FLAGS_hot_keys;
+        if (ReadThrough(key, next_point_query_id++)) {
+          point_read_hits_.fetch_add(1, std::memory_order_relaxed);
+        }
+        point_reads_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
   static void ThreadBody(void* v) {
     ThreadState* thread = reinterpret_cast<ThreadState*>(v);
     SharedState* shared = thread->shared;
@@ -228,6 +292,10 @@ class CacheBench {
   }
 
   void OperateCache(ThreadState* thread) {
+    if (FLAGS_scan_workload) {
+      OperateScanWorkload(thread);
+      return;
+    }
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
       uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
@@ -235,11 +303,11 @@ class CacheBench {
       int32_t prob_op = thread->rnd.Uniform(100);
       if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
+        cache_->Insert(key, kDefaultQueryId, new char[10], FLAGS_value_size, &deleter);
       } else if (prob_op -= FLAGS_insert_percent &&
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        auto handle = cache_->Lookup(key, kDefaultQueryId);
         if (handle) {
           cache_->Release(handle);
         }
@@ -261,6 +329,11 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    printf("Admission policy    : %s\n", FLAGS_admission_policy.c_str());
+    if (FLAGS_scan_workload) {
+      printf("Scan workload       : hot keys %" PRIu64 ", scan percentage %d%%\n",
+             FLAGS_hot_keys, FLAGS_scan_percent);
+    }
     printf("----------------------------\n");
   }
 };
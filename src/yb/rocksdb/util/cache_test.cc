@@ -742,6 +742,78 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+// Large scan should not evict frequently accessed entries from the cache with TinyLFU admission.
+TEST_F(CacheTest, TinyLFUScanResistance) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  constexpr int kHotKeys = 50;
+  constexpr int kScanKeys = 1000;
+  constexpr int kScanStart = 1000;
+  constexpr QueryId kScanQueryId = 2;
+
+  for (auto policy : {CacheAdmissionPolicy::kAlways, CacheAdmissionPolicy::kTinyLFU}) {
+    auto cache = NewLRUCache(kCacheSize2, 0, false /* strict_capacity_limit */, policy);
+
+    // Point reads of the hot keys.
+    for (int round = 0; round != 4; ++round) {
+      for (int key = 0; key != kHotKeys; ++key) {
+        if (Lookup(cache, key) == -1) {
+          ASSERT_OK(Insert(cache, key, key));
+        }
+      }
+    }
+
+    // Scan touches every key exactly once.
+    for (int key = kScanStart; key != kScanStart + kScanKeys; ++key) {
+      if (Lookup(cache, key, kScanQueryId) == -1) {
+        ASSERT_OK(Insert(cache, key, key, 1 /* charge */, kScanQueryId));
+      }
+    }
+
+    int hot_keys_in_cache = 0;
+    for (int key = 0; key != kHotKeys; ++key) {
+      if (Lookup(cache, key) == key) {
+        ++hot_keys_in_cache;
+      }
+    }
+    if (policy == CacheAdmissionPolicy::kTinyLFU) {
+      ASSERT_EQ(hot_keys_in_cache, kHotKeys);
+    } else {
+      ASSERT_EQ(hot_keys_in_cache, 0);
+    }
+    ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCacheSize2));
+  }
+}
+
+// Entry rejected by admission policy should still be returned to the caller that requested handle.
+TEST_F(CacheTest, TinyLFURejectedEntryHandle) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  const int kCapacity = kCacheSize2;
+  auto cache = NewLRUCache(
+      kCapacity, 0, false /* strict_capacity_limit */, CacheAdmissionPolicy::kTinyLFU);
+  for (int round = 0; round != 2; ++round) {
+    for (int key = 0; key != kCapacity; ++key) {
+      if (Lookup(cache, key) == -1) {
+        ASSERT_OK(Insert(cache, key, key));
+      }
+    }
+  }
+
+  Cache::Handle* handle = nullptr;
+  ASSERT_OK(cache->Insert(EncodeKey(kCapacity), kTestQueryId, EncodeValue(kCapacity), 1,
+                          &CacheTest::Deleter, &handle));
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(DecodeValue(cache->Value(handle)), kCapacity);
+  ASSERT_EQ(Lookup(cache, kCapacity), -1);
+  ASSERT_EQ(cache->GetUsage(), kCapacity + 1U);
+  ASSERT_EQ(cache->GetPinnedUsage(), 1U);
+
+  deleted_keys_.clear();
+  cache->Release(handle);
+  ASSERT_EQ(deleted_keys_, std::vector<int>{kCapacity});
+  ASSERT_EQ(cache->GetUsage(), static_cast<size_t>(kCapacity));
+  ASSERT_EQ(Lookup(cache, 0), 0);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
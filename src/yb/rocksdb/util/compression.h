@@ -25,7 +25,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -49,6 +51,7 @@
 
 #if defined(ZSTD)
 #include <zstd.h>
+#include <zdict.h>
 #endif
 
 namespace rocksdb {
@@ -102,6 +105,7 @@ inline bool CompressionTypeSupported(CompressionType compression_type) {
       return LZ4_Supported();
     case kLZ4HCCompression:
       return LZ4_Supported();
+    case kZSTD:
     case kZSTDNotFinalCompression:
       return ZSTD_Supported();
     default:
@@ -124,8 +128,10 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
       return "LZ4";
     case kLZ4HCCompression:
       return "LZ4HC";
-    case kZSTDNotFinalCompression:
+    case kZSTD:
       return "ZSTD";
+    case kZSTDNotFinalCompression:
+      return "ZSTDNotFinal";
     default:
       assert(false);
       return "";
@@ -620,8 +626,36 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+#ifdef ZSTD
+// ZSTD contexts keep internal buffers, that are relatively expensive to allocate, so each thread
+// reuses its own contexts for all blocks it compresses or decompresses.
+inline ZSTD_CCtx* ZSTD_ThreadLocalCompressionContext() {
+  struct Holder {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    ~Holder() { ZSTD_freeCCtx(context); }
+  };
+  static thread_local Holder holder;
+  return holder.context;
+}
+
+inline ZSTD_DCtx* ZSTD_ThreadLocalDecompressionContext() {
+  struct Holder {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    ~Holder() { ZSTD_freeDCtx(context); }
+  };
+  static thread_local Holder holder;
+  return holder.context;
+}
+#endif
+
+// Default compression level of ZSTD, used when it is not specified in options.
+constexpr int kZSTDDefaultLevel = 3;
+
+// compression_dict is used to prime the compressor, when not empty. The same dictionary should be
+// passed to ZSTD_Uncompress.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +667,11 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  const int level = opts.level > 0 ? opts.level : kZSTDDefaultLevel;
+  size_t outlen = ZSTD_compress_usingDict(
+      ZSTD_ThreadLocalCompressionContext(), &(*output)[output_header_len], compressBound,
+      input, length, compression_dict.data(), compression_dict.size(), level);
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +681,7 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size, const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -653,14 +689,40 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
-  char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
-  assert(actual_output_length == output_len);
+  std::unique_ptr<char[]> output(new char[output_len]);
+  size_t actual_output_length = ZSTD_decompress_usingDict(
+      ZSTD_ThreadLocalDecompressionContext(), output.get(), output_len, input_data, input_length,
+      compression_dict.data(), compression_dict.size());
+  if (ZSTD_isError(actual_output_length) || actual_output_length != output_len) {
+    return nullptr;
+  }
   *decompress_size = static_cast<int>(actual_output_length);
-  return output;
+  return output.release();
 #endif
   return nullptr;
 }
 
+// Builds dictionary of at most max_dict_bytes for ZSTD compression from the samples. Samples are
+// concatenated in the samples string, sample_lens contains the length of each of them.
+// When training is not possible, for instance when there are too few samples, the tail of
+// samples is used as raw content dictionary, since its content is the most similar to the data
+// that follows.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_lens,
+                                        size_t max_dict_bytes) {
+#ifdef ZSTD
+  if (!sample_lens.empty()) {
+    std::string dict(max_dict_bytes, '\0');
+    size_t dict_len = ZDICT_trainFromBuffer(
+        &dict[0], max_dict_bytes, samples.data(), sample_lens.data(),
+        static_cast<unsigned>(sample_lens.size()));
+    if (!ZDICT_isError(dict_len)) {
+      dict.resize(dict_len);
+      return dict;
+    }
+  }
+#endif
+  return samples.substr(samples.size() - std::min(samples.size(), max_dict_bytes));
+}
+
 }  // namespace rocksdb
@@ -81,6 +81,7 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       use_fsync(options.use_fsync),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      bottommost_compression(options.bottommost_compression),
       compression_opts(options.compression_opts),
       level_compaction_dynamic_level_bytes(
           options.level_compaction_dynamic_level_bytes),
@@ -107,6 +108,7 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       min_write_buffer_number_to_merge(1),
       max_write_buffer_number_to_maintain(0),
       compression(Snappy_Supported() ? kSnappyCompression : kNoCompression),
+      bottommost_compression(kDisableCompressionOption),
       prefix_extractor(nullptr),
       num_levels(7),
       level0_file_num_compaction_trigger(4),
@@ -165,6 +167,7 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
           options.max_write_buffer_number_to_maintain),
       compression(options.compression),
       compression_per_level(options.compression_per_level),
+      bottommost_compression(options.bottommost_compression),
       compression_opts(options.compression_opts),
       prefix_extractor(options.prefix_extractor),
       num_levels(options.num_levels),
@@ -446,6 +449,9 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       RHEADER(log, "         Options.compression: %s",
           CompressionTypeToString(compression).c_str());
     }
+  RHEADER(log, "      Options.bottommost_compression: %s",
+      bottommost_compression == kDisableCompressionOption ? "Disabled" :
+          CompressionTypeToString(bottommost_compression).c_str());
   RHEADER(log, "      Options.prefix_extractor: %s",
       prefix_extractor == nullptr ? "nullptr" : prefix_extractor->Name());
   RHEADER(log, "            Options.num_levels: %d", num_levels);
@@ -459,6 +465,10 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compression_opts.level);
   RHEADER(log, "              Options.compression_opts.strategy: %d",
       compression_opts.strategy);
+  RHEADER(log, "        Options.compression_opts.max_dict_bytes: %" PRIu32,
+      compression_opts.max_dict_bytes);
+  RHEADER(log, "  Options.compression_opts.zstd_max_train_bytes: %" PRIu32,
+      compression_opts.zstd_max_train_bytes);
   RHEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
       level0_file_num_compaction_trigger);
   RHEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
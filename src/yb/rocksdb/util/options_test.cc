@@ -129,7 +129,8 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
        "kLZ4Compression:"
        "kLZ4HCCompression:"
        "kZSTDNotFinalCompression"},
-      {"compression_opts", "4:5:6"},
+      {"bottommost_compression", "kZSTD"},
+      {"compression_opts", "4:5:6:7:8"},
       {"num_levels", "7"},
       {"level0_file_num_compaction_trigger", "8"},
       {"level0_slowdown_writes_trigger", "9"},
@@ -225,6 +226,9 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.compression_opts.window_bits, 4);
   ASSERT_EQ(new_cf_opt.compression_opts.level, 5);
   ASSERT_EQ(new_cf_opt.compression_opts.strategy, 6);
+  ASSERT_EQ(new_cf_opt.compression_opts.max_dict_bytes, 7U);
+  ASSERT_EQ(new_cf_opt.compression_opts.zstd_max_train_bytes, 8U);
+  ASSERT_EQ(new_cf_opt.bottommost_compression, kZSTD);
   ASSERT_EQ(new_cf_opt.num_levels, 7);
   ASSERT_EQ(new_cf_opt.level0_file_num_compaction_trigger, 8);
   ASSERT_EQ(new_cf_opt.level0_slowdown_writes_trigger, 9);
@@ -1722,6 +1726,7 @@ Status GetFromString(ColumnFamilyOptions* source, ColumnFamilyOptions* destinati
       "compression_per_level=kBZip2Compression:kBZip2Compression:"
       "kBZip2Compression:kNoCompression:kZlibCompression:kBZip2Compression:"
       "kSnappyCompression;"
+      "bottommost_compression=kZSTD;"
       "max_bytes_for_level_base=986;"
       "bloom_locality=8016;"
       "target_file_size_base=4294976376;"
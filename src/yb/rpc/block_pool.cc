@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/block_pool.h"
+
+namespace yb {
+namespace rpc {
+
+std::shared_ptr<BlockPool> BlockPool::Create(size_t block_size, const MemTrackerPtr& tracker) {
+  auto result = std::make_shared<BlockPool>(block_size, tracker);
+  tracker->parent()->AddGarbageCollector(result);
+  return result;
+}
+
+BlockPool::BlockPool(size_t block_size, const MemTrackerPtr& tracker)
+    : block_size_(block_size), tracker_(tracker), pool_(0) {
+}
+
+BlockPool::~BlockPool() {
+  CollectGarbage(std::numeric_limits<size_t>::max());
+}
+
+uint8_t* BlockPool::Take() {
+  uint8_t* result = nullptr;
+  if (!pool_.pop(result)) {
+    return nullptr;
+  }
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  tracker_->Release(block_size_);
+  return result;
+}
+
+void BlockPool::Put(uint8_t* block, size_t max_blocks) {
+  // The limit is soft, concurrent puts could slightly exceed it.
+  if (size_.load(std::memory_order_relaxed) < max_blocks &&
+      tracker_->TryConsume(block_size_)) {
+    if (pool_.push(block)) {
+      size_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    tracker_->Release(block_size_);
+  }
+  free(block);
+}
+
+void BlockPool::CollectGarbage(size_t required) {
+  uint8_t* block = nullptr;
+  size_t total = 0;
+  while (total < required && pool_.pop(block)) {
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    free(block);
+    total += block_size_;
+  }
+  tracker_->Release(total);
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_BLOCK_POOL_H
+#define YB_RPC_BLOCK_POOL_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include <boost/lockfree/stack.hpp>
+
+#include "yb/util/mem_tracker.h"
+
+namespace yb {
+namespace rpc {
+
+// Pool of idle memory blocks of the same size, kept for reuse.
+// Blocks contained in the pool are consumed from the tracker. The pool is registered as garbage
+// collector of the tracker's parent, so idle blocks are freed when memory is required elsewhere.
+class BlockPool : public GarbageCollector {
+ public:
+  static std::shared_ptr<BlockPool> Create(size_t block_size, const MemTrackerPtr& tracker);
+
+  BlockPool(size_t block_size, const MemTrackerPtr& tracker);
+  virtual ~BlockPool();
+
+  size_t block_size() const {
+    return block_size_;
+  }
+
+  // Tracker of blocks contained in the pool.
+  const MemTrackerPtr& tracker() const {
+    return tracker_;
+  }
+
+  // Returns block from the pool, or nullptr when the pool is empty.
+  uint8_t* Take();
+
+  // Returns block to the pool. The block is freed when the pool already contains max_blocks blocks,
+  // or when the tracker does not allow to keep it.
+  void Put(uint8_t* block, size_t max_blocks = std::numeric_limits<size_t>::max());
+
+ private:
+  void CollectGarbage(size_t required) override;
+
+  const size_t block_size_;
+  const MemTrackerPtr tracker_;
+  boost::lockfree::stack<uint8_t*> pool_;
+  std::atomic<size_t> size_{0};
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_BLOCK_POOL_H
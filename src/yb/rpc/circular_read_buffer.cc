@@ -13,16 +13,89 @@
 
 #include "yb/rpc/circular_read_buffer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/rpc/block_pool.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
 #include "yb/util/tostring.h"
 
+DEFINE_int32(rpc_read_buffer_pool_max_buffers, 64,
+             "Max number of idle read buffers of each size, that are kept for reuse by new "
+             "connections. 0 to disable pooling.");
+TAG_FLAG(rpc_read_buffer_pool_max_buffers, advanced);
+TAG_FLAG(rpc_read_buffer_pool_max_buffers, runtime);
+
 namespace yb {
 namespace rpc {
 
+namespace {
+
+std::atomic<int64_t> read_buffers_allocated{0};
+std::atomic<int64_t> read_buffers_reused{0};
+
+} // namespace
+
+ReadBufferPool::ReadBufferPool(size_t capacity)
+    : pool_(BlockPool::Create(capacity, MemTracker::FindOrCreateTracker("Read Buffer Pool"))) {
+}
+
+ReadBufferPool& ReadBufferPool::Get(size_t capacity) {
+  static std::mutex mutex;
+  // Pools are never destroyed, since buffers could be returned during process shutdown.
+  static auto* pools = new std::unordered_map<size_t, ReadBufferPool*>();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& result = (*pools)[capacity];
+  if (!result) {
+    result = new ReadBufferPool(capacity);
+  }
+  return *result;
+}
+
+int64_t ReadBufferPool::Allocated() {
+  return read_buffers_allocated.load(std::memory_order_relaxed);
+}
+
+int64_t ReadBufferPool::Reused() {
+  return read_buffers_reused.load(std::memory_order_relaxed);
+}
+
+size_t ReadBufferPool::capacity() const {
+  return pool_->block_size();
+}
+
+char* ReadBufferPool::Allocate() {
+  auto* result = pool_->Take();
+  if (result) {
+    read_buffers_reused.fetch_add(1, std::memory_order_relaxed);
+    return pointer_cast<char*>(result);
+  }
+  read_buffers_allocated.fetch_add(1, std::memory_order_relaxed);
+  return static_cast<char*>(malloc(pool_->block_size()));
+}
+
+void ReadBufferPool::Free(char* buffer) {
+  if (!buffer) {
+    return;
+  }
+  pool_->Put(pointer_cast<uint8_t*>(buffer),
+             static_cast<size_t>(std::max(FLAGS_rpc_read_buffer_pool_max_buffers, 0)));
+}
+
 CircularReadBuffer::CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker)
+    : CircularReadBuffer(&ReadBufferPool::Get(capacity), parent_tracker) {
+}
+
+CircularReadBuffer::CircularReadBuffer(ReadBufferPool* pool, const MemTrackerPtr& parent_tracker)
     : consumption_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse),
-                   capacity),
-      buffer_(static_cast<char*>(malloc(capacity))), capacity_(capacity) {
+                   pool->capacity()),
+      buffer_(pool->Allocate(), ReadBufferDeleter(pool)), capacity_(pool->capacity()) {
 }
 
 bool CircularReadBuffer::Empty() {
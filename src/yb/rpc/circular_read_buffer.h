@@ -14,6 +14,8 @@
 #ifndef YB_RPC_CIRCULAR_READ_BUFFER_H
 #define YB_RPC_CIRCULAR_READ_BUFFER_H
 
+#include <memory>
+
 #include "yb/rpc/stream.h"
 
 #include "yb/util/mem_tracker.h"
@@ -21,16 +23,51 @@
 namespace yb {
 namespace rpc {
 
-struct FreeMemory {
-  void operator()(void* data) const {
-    free(data);
+class BlockPool;
+
+// Pool of receive buffers of the same capacity, shared by all connections of the process.
+// Connections could be short lived, and their read buffers are too large to be served by the
+// thread caches of the allocator. So buffers of closed connections are kept for reuse by new
+// connections, up to rpc_read_buffer_pool_max_buffers buffers per capacity. Idle buffers are
+// tracked by a "Read Buffer Pool" mem tracker and released under memory pressure.
+class ReadBufferPool {
+ public:
+  // Returns pool for buffers of the specified capacity.
+  static ReadBufferPool& Get(size_t capacity);
+
+  // Total number of buffers allocated from malloc and taken from the pool, by all pools.
+  static int64_t Allocated();
+  static int64_t Reused();
+
+  size_t capacity() const;
+
+  char* Allocate();
+  void Free(char* buffer);
+
+ private:
+  explicit ReadBufferPool(size_t capacity);
+
+  std::shared_ptr<BlockPool> pool_;
+};
+
+// Used in conjuction with std::unique_ptr to return buffer to pool.
+class ReadBufferDeleter {
+ public:
+  explicit ReadBufferDeleter(ReadBufferPool* pool) : pool_(pool) {}
+
+  void operator()(char* buffer) const {
+    pool_->Free(buffer);
   }
+
+ private:
+  ReadBufferPool* pool_;
 };
 
 // StreamReadBuffer implementation that is based on circular buffer of fixed capacity.
 class CircularReadBuffer : public StreamReadBuffer {
  public:
-  explicit CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker);
+  CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker);
+  CircularReadBuffer(ReadBufferPool* pool, const MemTrackerPtr& parent_tracker);
 
   bool ReadyToRead() override;
   bool Empty() override;
@@ -45,7 +82,7 @@ class CircularReadBuffer : public StreamReadBuffer {
 
  private:
   ScopedTrackedConsumption consumption_;
-  std::unique_ptr<char, FreeMemory> buffer_;
+  std::unique_ptr<char, ReadBufferDeleter> buffer_;
   const size_t capacity_;
   size_t pos_ = 0;
   size_t size_ = 0;
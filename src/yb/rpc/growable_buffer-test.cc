@@ -13,8 +13,12 @@
 //
 //
 
+#include <set>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "yb/rpc/circular_read_buffer.h"
 #include "yb/rpc/growable_buffer.h"
 
 #include "yb/util/result.h"
@@ -110,5 +114,38 @@ TEST_F(GrowableBufferTest, TestConsume) {
   }
 }
 
+TEST_F(GrowableBufferTest, TestReadBufferPool) {
+  constexpr size_t kCapacity = kBlockSize * 3;
+  constexpr int kBuffers = 4;
+
+  auto& pool = ReadBufferPool::Get(kCapacity);
+  ASSERT_EQ(&pool, &ReadBufferPool::Get(kCapacity));
+  ASSERT_EQ(pool.capacity(), kCapacity);
+
+  auto allocated = ReadBufferPool::Allocated();
+  auto reused = ReadBufferPool::Reused();
+  std::set<char*> used;
+  {
+    std::vector<std::unique_ptr<CircularReadBuffer>> buffers;
+    for (int i = 0; i != kBuffers; ++i) {
+      buffers.push_back(std::make_unique<CircularReadBuffer>(&pool, MemTrackerPtr()));
+      auto iov = ASSERT_RESULT(buffers.back()->PrepareAppend());
+      ASSERT_EQ(iov.size(), 1U);
+      ASSERT_EQ(iov[0].iov_len, kCapacity);
+      used.insert(static_cast<char*>(iov[0].iov_base));
+    }
+  }
+  ASSERT_EQ(ReadBufferPool::Allocated() - allocated, kBuffers);
+
+  // Buffers of destroyed read buffers are reused by new ones.
+  for (int i = 0; i != kBuffers; ++i) {
+    CircularReadBuffer buffer(&pool, MemTrackerPtr());
+    auto iov = ASSERT_RESULT(buffer.PrepareAppend());
+    ASSERT_EQ(used.count(static_cast<char*>(iov[0].iov_base)), 1);
+  }
+  ASSERT_EQ(ReadBufferPool::Allocated() - allocated, kBuffers);
+  ASSERT_EQ(ReadBufferPool::Reused() - reused, kBuffers);
+}
+
 } // namespace rpc
 } // namespace yb
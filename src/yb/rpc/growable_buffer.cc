@@ -20,9 +20,10 @@
 #include <functional>
 #include <thread>
 
-#include <boost/lockfree/stack.hpp>
 #include <glog/logging.h>
 
+#include "yb/rpc/block_pool.h"
+
 #include "yb/util/mem_tracker.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
@@ -32,8 +33,7 @@ using namespace std::placeholders;
 namespace yb {
 namespace rpc {
 
-class GrowableBufferAllocator::Impl : public GarbageCollector,
-                                      public std::enable_shared_from_this<Impl> {
+class GrowableBufferAllocator::Impl {
  public:
   Impl(size_t block_size,
        const MemTrackerPtr& mem_tracker)
@@ -41,39 +41,29 @@ class GrowableBufferAllocator::Impl : public GarbageCollector,
         mandatory_tracker_(MemTracker::FindOrCreateTracker(
             "Mandatory", mem_tracker, AddToParent::kFalse)),
         used_tracker_(MemTracker::FindOrCreateTracker("Used", mem_tracker)),
-        allocated_tracker_(MemTracker::FindOrCreateTracker("Allocated", mem_tracker)),
-        pool_(0) {
-  }
-
-  void CompleteInit() {
-    allocated_tracker_->parent()->AddGarbageCollector(shared_from_this());
-  }
-
-  virtual ~Impl() {
-    CollectGarbage(std::numeric_limits<size_t>::max());
+        pool_(BlockPool::Create(
+            block_size, MemTracker::FindOrCreateTracker("Allocated", mem_tracker))) {
   }
 
   uint8_t* Allocate(bool forced) {
-    uint8_t* result = nullptr;
+    uint8_t* result = pool_->Take();
 
     if (forced) {
-      if (pool_.pop(result)) {
-        allocated_tracker_->Release(block_size_);
-      } else {
+      if (!result) {
         result = static_cast<uint8_t*>(malloc(block_size_));
       }
       mandatory_tracker_->Consume(block_size_);
       return result;
     }
 
-    if (!pool_.pop(result)) {
-      if (!allocated_tracker_->TryConsume(block_size_)) {
+    if (!result) {
+      if (!pool_->tracker()->TryConsume(block_size_)) {
         return nullptr;
       }
+      pool_->tracker()->Release(block_size_);
       result = static_cast<uint8_t*>(malloc(block_size_));
     }
     used_tracker_->Consume(block_size_);
-    allocated_tracker_->Release(block_size_);
     return result;
   }
 
@@ -84,14 +74,7 @@ class GrowableBufferAllocator::Impl : public GarbageCollector,
 
     auto* tracker = was_forced ? mandatory_tracker_.get() : used_tracker_.get();
     tracker->Release(block_size_);
-    if (allocated_tracker_->TryConsume(block_size_)) {
-      if (!pool_.push(buffer)) {
-        allocated_tracker_->Release(block_size_);
-        free(buffer);
-      }
-    } else {
-      free(buffer);
-    }
+    pool_->Put(buffer);
   }
 
   size_t block_size() const {
@@ -99,30 +82,18 @@ class GrowableBufferAllocator::Impl : public GarbageCollector,
   }
 
  private:
-  void CollectGarbage(size_t required) override {
-    uint8_t* buffer = nullptr;
-    size_t total = 0;
-    while (total < required && pool_.pop(buffer)) {
-      free(buffer);
-      total += block_size_;
-    }
-    allocated_tracker_->Release(total);
-  }
-
   const size_t block_size_;
   // Buffers that allocated with force flag, does not could in parent.
   MemTrackerPtr mandatory_tracker_;
   // Buffers that are in use by client of this class.
   MemTrackerPtr used_tracker_;
-  // Buffers that is contained in pool.
-  MemTrackerPtr allocated_tracker_;
-  boost::lockfree::stack<uint8_t*> pool_;
+  // Buffers that are not used, kept for reuse.
+  std::shared_ptr<BlockPool> pool_;
 };
 
 GrowableBufferAllocator::GrowableBufferAllocator(
     size_t block_size, const MemTrackerPtr& mem_tracker)
     : impl_(std::make_shared<Impl>(block_size, mem_tracker)) {
-  impl_->CompleteInit();
 }
 
 GrowableBufferAllocator::~GrowableBufferAllocator() {
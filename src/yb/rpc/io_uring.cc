@@ -0,0 +1,454 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/io_uring.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// Fast poll (Linux 5.7) is required, otherwise socket requests would block io-wq workers.
+#if defined(IORING_FEAT_FAST_POLL)
+#define YB_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#if YB_HAS_IO_URING
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#endif
+
+#include "yb/util/errno.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
+
+#if YB_HAS_IO_URING
+
+// System call numbers are the same for all architectures, but could be missing in old headers.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+#endif
+
+METRIC_DEFINE_counter(server, rpc_io_uring_submit_calls,
+                      "io_uring Submit Calls", yb::MetricUnit::kRequests,
+                      "Number of io_uring_enter calls used to submit RPC socket requests.");
+
+METRIC_DEFINE_counter(server, rpc_io_uring_submitted_requests,
+                      "io_uring Submitted Requests", yb::MetricUnit::kRequests,
+                      "Number of RPC socket requests submitted via io_uring.");
+
+namespace yb {
+namespace rpc {
+
+#if YB_HAS_IO_URING
+
+namespace {
+
+template <class T>
+T* RingPtr(void* base, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+class IoUring::Impl {
+ public:
+  Impl(ev::loop_ref loop, const scoped_refptr<MetricEntity>& metric_entity) : loop_(loop) {
+    if (metric_entity) {
+      submit_calls_ = METRIC_rpc_io_uring_submit_calls.Instantiate(metric_entity);
+      submitted_requests_ = METRIC_rpc_io_uring_submitted_requests.Instantiate(metric_entity);
+    }
+  }
+
+  ~Impl() {
+    io_.stop();
+    prepare_.stop();
+    LOG_IF(DFATAL, !deferred_.empty()) << "Destroying io_uring with undispatched completions";
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != MAP_FAILED) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  CHECKED_STATUS Init(size_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd_ < 0) {
+      return STATUS(NotSupported, "io_uring_setup failed", Errno(errno));
+    }
+    const uint32_t kRequiredFeatures = IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+    if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+      return STATUS_FORMAT(
+          NotSupported, "io_uring features $0 are not supported by the kernel",
+          kRequiredFeatures & ~params.features);
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = VERIFY_RESULT(Map(sq_ring_size_, IORING_OFF_SQ_RING));
+    cq_ring_ = single_mmap ? sq_ring_ : VERIFY_RESULT(Map(cq_ring_size_, IORING_OFF_CQ_RING));
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(VERIFY_RESULT(Map(sqes_size_, IORING_OFF_SQES)));
+
+    sq_head_ = RingPtr<uint32_t>(sq_ring_, params.sq_off.head);
+    sq_tail_ = RingPtr<uint32_t>(sq_ring_, params.sq_off.tail);
+    sq_mask_ = *RingPtr<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+    sq_flags_ = RingPtr<uint32_t>(sq_ring_, params.sq_off.flags);
+    sq_array_ = RingPtr<uint32_t>(sq_ring_, params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+
+    cq_head_ = RingPtr<uint32_t>(cq_ring_, params.cq_off.head);
+    cq_tail_ = RingPtr<uint32_t>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *RingPtr<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = RingPtr<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+    io_.set(loop_);
+    io_.set<Impl, &Impl::Handler>(this);
+    io_.start(fd_, ev::READ);
+
+    prepare_.set(loop_);
+    prepare_.set<Impl, &Impl::PrepareHandler>(this);
+    prepare_.start();
+
+    return Status::OK();
+  }
+
+  CHECKED_STATUS RecvMsg(int fd, msghdr* msg, IoUringOp* op) {
+    auto* sqe = VERIFY_RESULT(NextSqe(op));
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uintptr_t>(msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS SendMsg(int fd, const msghdr* msg, IoUringOp* op) {
+    auto* sqe = VERIFY_RESULT(NextSqe(op));
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uintptr_t>(msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS PollAdd(int fd, uint32_t events, IoUringOp* op) {
+    auto* sqe = VERIFY_RESULT(NextSqe(op));
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll_events = static_cast<uint16_t>(events);
+    return Status::OK();
+  }
+
+  void CancelAndWait(IoUringOp* op) {
+    if (!op->in_flight_) {
+      return;
+    }
+
+    // Completion could be already received while we were waiting for another operation.
+    for (auto it = deferred_.begin(); it != deferred_.end(); ++it) {
+      if (it->op == op) {
+        auto result = it->result;
+        deferred_.erase(it);
+        Dispatch(op, result);
+        return;
+      }
+    }
+
+    auto sqe = NextSqe(nullptr);
+    if (sqe.ok()) {
+      (**sqe).opcode = IORING_OP_ASYNC_CANCEL;
+      (**sqe).fd = -1;
+      (**sqe).addr = reinterpret_cast<uintptr_t>(op);
+    } else {
+      // The request will be completed anyway, since the caller shuts down the socket.
+      LOG(WARNING) << "Failed to cancel io_uring request: " << sqe.status();
+    }
+    WARN_NOT_OK(Submit(), "Failed to submit io_uring requests");
+
+    while (op->in_flight_) {
+      IoUringOp* completed;
+      int32_t result;
+      if (!PopCompletion(&completed, &result)) {
+        if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+          LOG(DFATAL) << "Failed to wait for io_uring completion: " << ErrnoToString(errno);
+          return;
+        }
+        continue;
+      }
+      if (completed == op) {
+        Dispatch(op, result);
+      } else if (completed) {
+        deferred_.push_back(Completion{completed, result});
+      }
+    }
+  }
+
+  CHECKED_STATUS Submit() {
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+    auto to_submit = sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    while (to_submit != 0) {
+      auto submitted = Enter(to_submit, 0, 0);
+      if (submitted < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EBUSY || errno == EAGAIN) {
+          // Completion queue overflowed, requests will be submitted after completions are reaped.
+          return Status::OK();
+        }
+        return STATUS(IOError, "io_uring_enter failed", Errno(errno));
+      }
+      IncrementCounter(submit_calls_);
+      IncrementCounterBy(submitted_requests_, submitted);
+      to_submit -= std::min<uint32_t>(to_submit, submitted);
+    }
+    return Status::OK();
+  }
+
+ private:
+  struct Completion {
+    IoUringOp* op;
+    int32_t result;
+  };
+
+  Result<void*> Map(size_t size, off_t offset) {
+    auto result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                       offset);
+    if (result == MAP_FAILED) {
+      return STATUS(IOError, "Failed to map io_uring", Errno(errno));
+    }
+    return result;
+  }
+
+  int Enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return static_cast<int>(syscall(
+        __NR_io_uring_enter, fd_, to_submit, min_complete, flags, nullptr, 0));
+  }
+
+  Result<io_uring_sqe*> NextSqe(IoUringOp* op) {
+    if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      RETURN_NOT_OK(Submit());
+      if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+        return STATUS(ServiceUnavailable, "io_uring submission queue is full");
+      }
+    }
+    auto index = sq_local_tail_ & sq_mask_;
+    auto* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = reinterpret_cast<uintptr_t>(op);
+    sq_array_[index] = index;
+    ++sq_local_tail_;
+    if (op) {
+      DCHECK(!op->in_flight_);
+      op->in_flight_ = true;
+    }
+    return sqe;
+  }
+
+  bool PopCompletion(IoUringOp** op, int32_t* result) {
+    auto head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+    const auto& cqe = cqes_[head & cq_mask_];
+    *op = reinterpret_cast<IoUringOp*>(cqe.user_data);
+    *result = cqe.res;
+    // Release the entry before dispatching, since completion handler could reap completions too.
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  void Dispatch(IoUringOp* op, int32_t result) {
+    op->in_flight_ = false;
+    op->Completed(result);
+  }
+
+  void DispatchDeferred() {
+    while (!deferred_.empty()) {
+      auto completion = deferred_.front();
+      deferred_.pop_front();
+      Dispatch(completion.op, completion.result);
+    }
+  }
+
+  void Handler(ev::io& watcher, int revents) { // NOLINT
+    DispatchDeferred();
+    for (;;) {
+      IoUringOp* op;
+      int32_t result;
+      while (PopCompletion(&op, &result)) {
+        // Completions of cancel requests are not associated with operations.
+        if (op) {
+          Dispatch(op, result);
+        }
+      }
+#ifdef IORING_SQ_CQ_OVERFLOW
+      // Completions that did not fit into the queue are flushed to it by io_uring_enter.
+      if (__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) & IORING_SQ_CQ_OVERFLOW) {
+        Enter(0, 0, IORING_ENTER_GETEVENTS);
+        continue;
+      }
+#endif
+      break;
+    }
+  }
+
+  void PrepareHandler(ev::prepare& watcher, int revents) { // NOLINT
+    DispatchDeferred();
+    WARN_NOT_OK(Submit(), "Failed to submit io_uring requests");
+  }
+
+  ev::loop_ref loop_;
+  ev::io io_;
+  ev::prepare prepare_;
+
+  int fd_ = -1;
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_flags_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  // Tail of prepared requests, it is published to the kernel by Submit.
+  uint32_t sq_local_tail_ = 0;
+
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  std::deque<Completion> deferred_;
+
+  scoped_refptr<Counter> submit_calls_;
+  scoped_refptr<Counter> submitted_requests_;
+};
+
+Result<std::unique_ptr<IoUring>> IoUring::Create(
+    ev::loop_ref loop, size_t entries, const scoped_refptr<MetricEntity>& metric_entity) {
+  auto impl = std::make_unique<Impl>(loop, metric_entity);
+  RETURN_NOT_OK(impl->Init(entries));
+  return std::unique_ptr<IoUring>(new IoUring(std::move(impl)));
+}
+
+bool IoUring::IsSupported() {
+  static const bool result = [] {
+    ev::dynamic_loop loop;
+    auto io_uring = Create(loop, /* entries= */ 1, /* metric_entity= */ nullptr);
+    if (!io_uring.ok()) {
+      LOG(INFO) << "io_uring is not supported: " << io_uring.status();
+      return false;
+    }
+    return true;
+  }();
+  return result;
+}
+
+Status IoUring::RecvMsg(int fd, msghdr* msg, IoUringOp* op) {
+  return impl_->RecvMsg(fd, msg, op);
+}
+
+Status IoUring::SendMsg(int fd, const msghdr* msg, IoUringOp* op) {
+  return impl_->SendMsg(fd, msg, op);
+}
+
+Status IoUring::PollAdd(int fd, uint32_t events, IoUringOp* op) {
+  return impl_->PollAdd(fd, events, op);
+}
+
+void IoUring::CancelAndWait(IoUringOp* op) {
+  impl_->CancelAndWait(op);
+}
+
+Status IoUring::Submit() {
+  return impl_->Submit();
+}
+
+#else // YB_HAS_IO_URING
+
+class IoUring::Impl {
+};
+
+Result<std::unique_ptr<IoUring>> IoUring::Create(
+    ev::loop_ref loop, size_t entries, const scoped_refptr<MetricEntity>& metric_entity) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+bool IoUring::IsSupported() {
+  return false;
+}
+
+Status IoUring::RecvMsg(int fd, msghdr* msg, IoUringOp* op) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+Status IoUring::SendMsg(int fd, const msghdr* msg, IoUringOp* op) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+Status IoUring::PollAdd(int fd, uint32_t events, IoUringOp* op) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+void IoUring::CancelAndWait(IoUringOp* op) {
+}
+
+Status IoUring::Submit() {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+#endif // YB_HAS_IO_URING
+
+IoUring::IoUring(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {
+}
+
+IoUring::~IoUring() = default;
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,100 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_IO_URING_H
+#define YB_RPC_IO_URING_H
+
+#include <stdint.h>
+
+#include <memory>
+
+#include <ev++.h>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/result.h"
+
+struct msghdr;
+
+namespace yb {
+
+class MetricEntity;
+
+namespace rpc {
+
+// Operation submitted to IoUring. At most one request could be in flight for the same operation.
+class IoUringOp {
+ public:
+  bool InFlight() const {
+    return in_flight_;
+  }
+
+ protected:
+  ~IoUringOp() = default;
+
+ private:
+  friend class IoUring;
+
+  // Invoked on the reactor thread with the result of the request, i.e. the number of transferred
+  // bytes or negated errno.
+  virtual void Completed(int32_t result) = 0;
+
+  bool in_flight_ = false;
+};
+
+// Submission and completion queues of io_uring, driven by the libev loop of a reactor.
+//
+// Requests prepared while the loop processes events are submitted with a single io_uring_enter
+// call right before the loop blocks, and completions are dispatched when the ring file
+// descriptor becomes readable. So a reactor issues one system call per loop iteration instead of
+// one per socket event.
+//
+// Should be used from the reactor thread only.
+class IoUring {
+ public:
+  // Returns NotSupported when io_uring is not supported by the kernel or by the build.
+  static Result<std::unique_ptr<IoUring>> Create(
+      ev::loop_ref loop, size_t entries, const scoped_refptr<MetricEntity>& metric_entity);
+
+  // Returns whether io_uring could be created, i.e. it is supported by both the kernel and the
+  // build.
+  static bool IsSupported();
+
+  ~IoUring();
+
+  // Prepares request for the next submission. Buffers referenced by msg should stay valid until
+  // the operation is completed.
+  CHECKED_STATUS RecvMsg(int fd, msghdr* msg, IoUringOp* op);
+  CHECKED_STATUS SendMsg(int fd, const msghdr* msg, IoUringOp* op);
+  CHECKED_STATUS PollAdd(int fd, uint32_t events, IoUringOp* op);
+
+  // Cancels request of op and waits until it is completed, so the caller could release buffers
+  // used by the request. Completions of other operations received meanwhile are dispatched later
+  // from the loop.
+  void CancelAndWait(IoUringOp* op);
+
+  // Submits all prepared requests.
+  CHECKED_STATUS Submit();
+
+ private:
+  class Impl;
+
+  explicit IoUring(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_IO_URING_H
@@ -0,0 +1,174 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/circular_read_buffer.h"
+#include "yb/rpc/io_uring.h"
+#include "yb/rpc/io_uring_stream.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/socket.h"
+#include "yb/util/result.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+constexpr size_t kReadBufferSize = 64;
+
+// Context that consumes everything it receives, unless it is paused. A paused context emulates
+// a connection whose call queue is full, that asks the stream to parse received data later.
+class TestStreamContext : public StreamContext {
+ public:
+  TestStreamContext() : read_buffer_(kReadBufferSize, MemTrackerPtr()) {}
+
+  void UpdateLastActivity() override {}
+  void UpdateLastRead() override {}
+  void UpdateLastWrite() override {}
+  void Transferred(const OutboundDataPtr& data, const Status& status) override {}
+  void Connected() override {}
+
+  void Destroy(const Status& status) override {
+    LOG(INFO) << "Destroy: " << status;
+    destroy_status_ = status;
+  }
+
+  Result<size_t> ProcessReceived(ReadBufferFull read_buffer_full) override {
+    if (paused_) {
+      return 0;
+    }
+    size_t consumed = 0;
+    for (const auto& vec : read_buffer_.AppendedVecs()) {
+      received_.append(static_cast<const char*>(vec.iov_base), vec.iov_len);
+      consumed += vec.iov_len;
+    }
+    read_buffer_.Consume(consumed, Slice());
+    return 0;
+  }
+
+  StreamReadBuffer& ReadBuffer() override {
+    return read_buffer_;
+  }
+
+  void set_paused(bool value) {
+    paused_ = value;
+  }
+
+  const std::string& received() const {
+    return received_;
+  }
+
+  const Status& destroy_status() const {
+    return destroy_status_;
+  }
+
+ private:
+  CircularReadBuffer read_buffer_;
+  bool paused_ = false;
+  std::string received_;
+  Status destroy_status_;
+};
+
+} // namespace
+
+class IoUringStreamTest : public YBTest {
+ protected:
+  // Runs the loop until predicate is satisfied or the timeout expires.
+  template <class Predicate>
+  bool RunLoopUntil(const Predicate& predicate) {
+    auto deadline = CoarseMonoClock::now() + 10s;
+    while (!predicate()) {
+      if (CoarseMonoClock::now() > deadline) {
+        return false;
+      }
+      loop_.run(ev::NOWAIT);
+      std::this_thread::sleep_for(1ms);
+    }
+    return true;
+  }
+
+  void Write(const std::string& data) {
+    size_t written = 0;
+    ASSERT_OK(client_.BlockingWrite(
+        pointer_cast<const uint8_t*>(data.data()), data.size(), &written,
+        MonoTime::Now() + 10s));
+    ASSERT_EQ(data.size(), written);
+  }
+
+  ev::dynamic_loop loop_;
+  Socket client_;
+};
+
+// ParseReceived is invoked while a receive request is in flight. The request was prepared before
+// the context consumed the received data, so it should not append data using the old iovecs.
+TEST_F(IoUringStreamTest, ParseWhileReceiving) {
+  if (!IoUring::IsSupported()) {
+    LOG(INFO) << "io_uring is not supported, skipping test";
+    return;
+  }
+
+  auto io_uring = ASSERT_RESULT(IoUring::Create(loop_, 16, /* metric_entity= */ nullptr));
+
+  Socket listen_socket;
+  ASSERT_OK(listen_socket.Init(0));
+  ASSERT_OK(listen_socket.BindAndListen(Endpoint(IpAddress::from_string("127.0.0.1"), 0), 1));
+  Endpoint listen_endpoint;
+  ASSERT_OK(listen_socket.GetSocketAddress(&listen_endpoint));
+  ASSERT_OK(client_.Init(0));
+  ASSERT_OK(client_.Connect(listen_endpoint));
+  Socket server_socket;
+  Endpoint remote;
+  ASSERT_OK(listen_socket.Accept(&server_socket, &remote, Socket::FLAG_NONBLOCKING));
+
+  TestStreamContext context;
+  const std::string remote_hostname;
+  std::unique_ptr<Stream> stream = std::make_unique<IoUringStream>(StreamCreateData {
+    .remote = remote,
+    .remote_hostname = remote_hostname,
+    .socket = &server_socket,
+    .receive_buffer_size = 0,
+    .mem_tracker = nullptr,
+    .metric_entity = nullptr,
+    .io_uring = io_uring.get(),
+  });
+  ASSERT_OK(stream->Start(/* connect= */ false, &loop_, &context));
+
+  // Received data stays in the read buffer, while the next receive request is in flight.
+  context.set_paused(true);
+  ASSERT_NO_FATALS(Write("aaaa"));
+  ASSERT_TRUE(RunLoopUntil([&context] { return context.ReadBuffer().DataAvailable() == 4; }));
+
+  context.set_paused(false);
+  stream->ParseReceived();
+  ASSERT_EQ(context.received(), "aaaa");
+
+  ASSERT_NO_FATALS(Write("bbbb"));
+  ASSERT_TRUE(RunLoopUntil([&context] { return context.received().size() >= 8; }));
+  ASSERT_EQ(context.received(), "aaaabbbb");
+  ASSERT_OK(context.destroy_status());
+
+  stream->Shutdown(STATUS(Aborted, "Test finished"));
+}
+
+} // namespace rpc
+} // namespace yb
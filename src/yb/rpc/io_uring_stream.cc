@@ -0,0 +1,471 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/io_uring_stream.h"
+
+#include <poll.h>
+#include <string.h>
+
+#include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_introspection.pb.h"
+#include "yb/rpc/rpc_util.h"
+
+#include "yb/util/errno.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/result.h"
+#include "yb/util/status_log.h"
+#include "yb/util/string_util.h"
+
+using namespace std::literals;
+
+DECLARE_uint64(rpc_connection_timeout_ms);
+
+METRIC_DECLARE_counter(tcp_bytes_sent);
+METRIC_DECLARE_counter(tcp_bytes_received);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+Status RequestFailed(const char* message, int32_t result) {
+  return STATUS(NetworkError, message, Errno(-result));
+}
+
+bool IsTemporaryError(int32_t result) {
+  return result == -EAGAIN || result == -EINTR;
+}
+
+} // namespace
+
+IoUringStream::IoUringStream(const StreamCreateData& data)
+    : socket_(std::move(*data.socket)),
+      remote_(data.remote),
+      io_uring_(data.io_uring) {
+  memset(&receive_msg_, 0, sizeof(receive_msg_));
+  memset(&send_msg_, 0, sizeof(send_msg_));
+  if (data.mem_tracker) {
+    mem_tracker_ = MemTracker::FindOrCreateTracker("Sending", data.mem_tracker);
+  }
+  if (data.metric_entity) {
+    bytes_received_counter_ = METRIC_tcp_bytes_received.Instantiate(data.metric_entity);
+    bytes_sent_counter_ = METRIC_tcp_bytes_sent.Instantiate(data.metric_entity);
+  }
+}
+
+IoUringStream::~IoUringStream() {
+  // Must clear the outbound_transfers_ list before deleting.
+  CHECK(sending_.empty()) << ToString();
+
+  // Requests in flight reference buffers of this stream, so they should be completed by Shutdown.
+  CHECK(!connect_op_.InFlight() && !receive_op_.InFlight() && !send_op_.InFlight()) << ToString();
+}
+
+Status IoUringStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  connected_ = !connect;
+
+  RETURN_NOT_OK(socket_.SetNoDelay(true));
+  // These timeouts don't affect non-blocking sockets:
+  RETURN_NOT_OK(socket_.SetSendTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+  RETURN_NOT_OK(socket_.SetRecvTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+
+  if (connect) {
+    auto status = socket_.Connect(remote_);
+    if (!status.ok() && !status.IsTryAgain()) {
+      LOG_WITH_PREFIX(WARNING) << "Connect failed: " << status;
+      return status;
+    }
+  }
+
+  RETURN_NOT_OK(socket_.GetSocketAddress(&local_));
+  log_prefix_.clear();
+
+  started_ = true;
+
+  DVLOG_WITH_PREFIX(3) << "Starting, connected: " << connected_ << ", fd: " << socket_.GetFd();
+
+  if (!connected_) {
+    // Socket becomes writable when connection is established.
+    return io_uring_->PollAdd(socket_.GetFd(), POLLOUT, &connect_op_);
+  }
+
+  context_->Connected();
+  return StartReceive();
+}
+
+void IoUringStream::Close() {
+  if (socket_.GetFd() >= 0) {
+    auto status = socket_.Shutdown(true, true);
+    LOG_IF(INFO, !status.ok()) << "Failed to shutdown socket: " << status;
+  }
+}
+
+void IoUringStream::Shutdown(const Status& status) {
+  shutdown_ = true;
+
+  // Shut down the socket first, so requests in flight complete promptly.
+  Close();
+  io_uring_->CancelAndWait(&connect_op_);
+  io_uring_->CancelAndWait(&receive_op_);
+  io_uring_->CancelAndWait(&send_op_);
+  sending_in_flight_ = 0;
+
+  ClearSending(status);
+
+  if (!ReadBuffer().Empty()) {
+    LOG_WITH_PREFIX(WARNING) << "Shutting down with pending inbound data ("
+                             << ReadBuffer().ToString() << ", status = " << status << ")";
+  }
+
+  ReadBuffer().Reset();
+
+  WARN_NOT_OK(socket_.Close(), "Error closing socket");
+}
+
+void IoUringStream::ConnectCompleted(int32_t result) {
+  if (shutdown_) {
+    return;
+  }
+  if (result < 0) {
+    context_->Destroy(RequestFailed("connect failed", result));
+    return;
+  }
+  if (result & (POLLERR | POLLHUP)) {
+    auto status = socket_.GetSockError();
+    context_->Destroy(status.ok() ? STATUS(NetworkError, "Connect failed") : status);
+    return;
+  }
+
+  connected_ = true;
+  context_->Connected();
+  auto status = StartReceive();
+  if (status.ok()) {
+    status = DoWrite();
+  }
+  if (!status.ok()) {
+    context_->Destroy(status);
+  }
+}
+
+Status IoUringStream::StartReceive() {
+  if (!started_ || shutdown_ || receive_op_.InFlight()) {
+    return Status::OK();
+  }
+
+  if (inbound_bytes_to_skip_ > 0) {
+    auto global_skip_buffer = GetGlobalSkipBuffer();
+    receive_iov_.resize(1);
+    receive_iov_[0].iov_base = global_skip_buffer.mutable_data();
+    receive_iov_[0].iov_len = std::min(global_skip_buffer.size(), inbound_bytes_to_skip_);
+    receiving_skipped_ = true;
+  } else {
+    auto iov = ReadBuffer().PrepareAppend();
+    if (!iov.ok()) {
+      VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
+      if (iov.status().IsBusy()) {
+        // Receive will be restarted by ParseReceived, when the context consumes received data.
+        return Status::OK();
+      }
+      return iov.status();
+    }
+    receive_iov_ = std::move(*iov);
+    receiving_skipped_ = false;
+  }
+
+  receive_msg_.msg_iov = receive_iov_.data();
+  receive_msg_.msg_iovlen = receive_iov_.size();
+  return io_uring_->RecvMsg(socket_.GetFd(), &receive_msg_, &receive_op_);
+}
+
+void IoUringStream::ReceiveCompleted(int32_t result) {
+  if (shutdown_) {
+    return;
+  }
+
+  if (receive_paused_ && (result == -ECANCELED || IsTemporaryError(result))) {
+    // ParseReceived cancelled the request, it will start the next one.
+    return;
+  }
+
+  Status status;
+  if (IsTemporaryError(result)) {
+    status = StartReceive();
+  } else if (result < 0) {
+    status = RequestFailed("recvmsg error", result);
+    YB_LOG_WITH_PREFIX_EVERY_N(INFO, 50) << " Recv failed: " << status;
+  } else if (result == 0) {
+    VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
+    status = STATUS(NetworkError, "recvmsg got EOF from remote", Slice(), Errno(ESHUTDOWN));
+  } else {
+    DVLOG_WITH_PREFIX(4) << "Received bytes: " << result;
+    context_->UpdateLastRead();
+    IncrementCounterBy(bytes_received_counter_, result);
+    if (receiving_skipped_) {
+      inbound_bytes_to_skip_ -= result;
+    } else {
+      ReadBuffer().DataAppended(result);
+      if (!receive_paused_) {
+        auto processed = TryProcessReceived();
+        if (!processed.ok()) {
+          status = processed.status();
+        }
+      }
+    }
+    if (status.ok() && !receive_paused_) {
+      status = StartReceive();
+    }
+  }
+
+  if (!status.ok()) {
+    context_->Destroy(status);
+  }
+}
+
+void IoUringStream::ParseReceived() {
+  if (receive_op_.InFlight() && !receiving_skipped_) {
+    // The receive request in flight writes to iovecs prepared before the context consumes data,
+    // so it should complete before the read buffer is changed. Data received by the cancelled
+    // request is appended to the read buffer, and is parsed below.
+    receive_paused_ = true;
+    io_uring_->CancelAndWait(&receive_op_);
+    receive_paused_ = false;
+    if (shutdown_) {
+      return;
+    }
+  }
+
+  auto result = TryProcessReceived();
+  if (!result.ok()) {
+    context_->Destroy(result.status());
+    return;
+  }
+  auto status = StartReceive();
+  if (!status.ok()) {
+    context_->Destroy(status);
+  }
+}
+
+Result<bool> IoUringStream::TryProcessReceived() {
+  auto& read_buffer = ReadBuffer();
+  if (!read_buffer.ReadyToRead()) {
+    return false;
+  }
+
+  auto result = VERIFY_RESULT(context_->ProcessReceived(ReadBufferFull(read_buffer.Full())));
+  DVLOG_WITH_PREFIX(5) << "context_->ProcessReceived result: " << AsString(result);
+
+  LOG_IF(DFATAL, inbound_bytes_to_skip_ != 0)
+      << "Expected inbound_bytes_to_skip_ to be 0 instead of " << inbound_bytes_to_skip_;
+  inbound_bytes_to_skip_ = result;
+  return true;
+}
+
+Status IoUringStream::TryWrite() {
+  return DoWrite();
+}
+
+Status IoUringStream::DoWrite() {
+  if (!connected_ || !started_ || shutdown_ || send_op_.InFlight()) {
+    return Status::OK();
+  }
+
+  while (!sending_.empty()) {
+    size_t len = 0;
+    size_t offset = send_position_;
+    bool only_heartbeats = true;
+    sending_in_flight_ = 0;
+    for (auto& data : sending_) {
+      if (len == kMaxIov) {
+        break;
+      }
+      ++sending_in_flight_;
+      const auto& wrapped_data = data.data;
+      if (wrapped_data && !wrapped_data->IsHeartbeat()) {
+        only_heartbeats = false;
+      }
+      if (data.skipped || (offset == 0 && wrapped_data && wrapped_data->IsFinished())) {
+        queued_bytes_to_send_ -= data.bytes_size();
+        data.ClearBytes();
+        data.skipped = true;
+        continue;
+      }
+      for (const auto& bytes : data.bytes) {
+        if (offset >= bytes.size()) {
+          offset -= bytes.size();
+          continue;
+        }
+        send_iov_[len].iov_base = bytes.data() + offset;
+        send_iov_[len].iov_len = bytes.size() - offset;
+        offset = 0;
+        if (++len == kMaxIov) {
+          break;
+        }
+      }
+    }
+
+    if (!only_heartbeats) {
+      context_->UpdateLastActivity();
+    }
+
+    if (len == 0) {
+      // Everything left was skipped.
+      sending_in_flight_ = 0;
+      DataSent(0);
+      continue;
+    }
+
+    send_msg_.msg_iov = send_iov_;
+    send_msg_.msg_iovlen = len;
+    return io_uring_->SendMsg(socket_.GetFd(), &send_msg_, &send_op_);
+  }
+
+  return Status::OK();
+}
+
+void IoUringStream::SendCompleted(int32_t result) {
+  if (shutdown_) {
+    return;
+  }
+  sending_in_flight_ = 0;
+
+  Status status;
+  if (IsTemporaryError(result)) {
+    status = DoWrite();
+  } else if (result < 0) {
+    status = RequestFailed("sendmsg error", result);
+    YB_LOG_WITH_PREFIX_EVERY_N(WARNING, 50) << "Send failed: " << status;
+  } else {
+    DVLOG_WITH_PREFIX(4) << "Queued writes " << queued_bytes_to_send_ << " bytes. written "
+                         << result << ", sending_.size(): " << sending_.size();
+    context_->UpdateLastWrite();
+    IncrementCounterBy(bytes_sent_counter_, result);
+    DataSent(result);
+    status = DoWrite();
+  }
+
+  if (!status.ok()) {
+    context_->Destroy(status);
+  }
+}
+
+void IoUringStream::DataSent(size_t bytes) {
+  send_position_ += bytes;
+  while (!sending_.empty()) {
+    auto& front = sending_.front();
+    size_t full_size = front.bytes_size();
+    if (front.skipped) {
+      PopSending();
+      continue;
+    }
+    if (send_position_ < full_size) {
+      break;
+    }
+    auto data = front.data;
+    send_position_ -= full_size;
+    PopSending();
+    if (data) {
+      context_->Transferred(data, Status::OK());
+    }
+  }
+}
+
+void IoUringStream::PopSending() {
+  queued_bytes_to_send_ -= sending_.front().bytes_size();
+  sending_.pop_front();
+  ++data_blocks_sent_;
+}
+
+bool IoUringStream::Idle(std::string* reason_not_idle) {
+  bool result = true;
+  // Check if we're in the middle of receiving something.
+  if (!ReadBuffer().Empty()) {
+    if (reason_not_idle) {
+      AppendWithSeparator("read buffer not empty", reason_not_idle);
+    }
+    result = false;
+  }
+
+  // Check if we still need to send something.
+  if (!sending_.empty()) {
+    if (reason_not_idle) {
+      AppendWithSeparator("still sending", reason_not_idle);
+    }
+    result = false;
+  }
+
+  return result;
+}
+
+void IoUringStream::ClearSending(const Status& status) {
+  // Clear any outbound transfers.
+  for (auto& data : sending_) {
+    if (data.data) {
+      context_->Transferred(data.data, status);
+    }
+  }
+  sending_.clear();
+  queued_bytes_to_send_ = 0;
+}
+
+Result<size_t> IoUringStream::Send(OutboundDataPtr data) {
+  // Handle is absolute index of data block, since stream start, the same as in TcpStream.
+  size_t result = data_blocks_sent_ + sending_.size();
+
+  DVLOG_WITH_PREFIX(6) << "IoUringStream::Send queueing: " << AsString(*data);
+  sending_.emplace_back(std::move(data), mem_tracker_);
+  queued_bytes_to_send_ += sending_.back().bytes_size();
+  DVLOG_WITH_PREFIX(4) << "Queued data, sending_.size(): " << sending_.size()
+                       << ", queued_bytes_to_send_: " << queued_bytes_to_send_;
+
+  return result;
+}
+
+void IoUringStream::Cancelled(size_t handle) {
+  if (handle < data_blocks_sent_) {
+    return;
+  }
+  handle -= data_blocks_sent_;
+  LOG_IF_WITH_PREFIX(DFATAL, !sending_[handle].data->IsFinished())
+      << "Cancelling not finished data: " << sending_[handle].data->ToString();
+  auto& entry = sending_[handle];
+  if ((handle == 0 && send_position_ > 0) || handle < sending_in_flight_) {
+    // Transfer already started, cannot drop it.
+    return;
+  }
+
+  queued_bytes_to_send_ -= entry.bytes_size();
+  entry.ClearBytes();
+}
+
+void IoUringStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  auto call_in_flight = resp->add_calls_in_flight();
+  uint64_t sending_bytes = 0;
+  for (auto& entry : sending_) {
+    auto entry_bytes_size = entry.bytes_size();
+    sending_bytes += entry_bytes_size;
+    if (!entry.data) {
+      continue;
+    }
+    if (entry.data->DumpPB(req, call_in_flight)) {
+      call_in_flight->set_sending_bytes(entry_bytes_size);
+      call_in_flight = resp->add_calls_in_flight();
+    }
+  }
+  resp->set_sending_bytes(sending_bytes);
+  resp->mutable_calls_in_flight()->DeleteSubrange(resp->calls_in_flight_size() - 1, 1);
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,150 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_IO_URING_STREAM_H
+#define YB_RPC_IO_URING_STREAM_H
+
+#include <sys/socket.h>
+
+#include "yb/rpc/io_uring.h"
+#include "yb/rpc/tcp_stream.h"
+
+namespace yb {
+namespace rpc {
+
+// TCP stream that performs socket IO via io_uring of its reactor.
+//
+// Instead of waiting for readiness and issuing recvmsg/sendmsg system calls, the stream keeps a
+// receive request in flight all the time, and a send request while there is data to send. Requests
+// of all streams of the reactor are submitted in one batch per loop iteration.
+//
+// Uses the same protocol as TcpStream, so it is transparent for the remote side and for refined
+// streams layered on top of it.
+class IoUringStream : public Stream {
+ public:
+  explicit IoUringStream(const StreamCreateData& data);
+  ~IoUringStream();
+
+  size_t GetPendingWriteBytes() override {
+    return queued_bytes_to_send_ - send_position_;
+  }
+
+ private:
+  class Op final : public IoUringOp {
+   public:
+    using Handler = void (IoUringStream::*)(int32_t);
+
+    Op(IoUringStream* stream, Handler handler) : stream_(stream), handler_(handler) {}
+
+   private:
+    void Completed(int32_t result) override {
+      (stream_->*handler_)(result);
+    }
+
+    IoUringStream* const stream_;
+    const Handler handler_;
+  };
+
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  Result<size_t> Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void Cancelled(size_t handle) override;
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override { return connected_; }
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() const override { return remote_; }
+  const Endpoint& Local() const override { return local_; }
+
+  const Protocol* GetProtocol() override {
+    return TcpStream::StaticProtocol();
+  }
+
+  void ParseReceived() override;
+
+  // Submits receive request if there is no one in flight and the read buffer has space.
+  CHECKED_STATUS StartReceive();
+  // Submits send request if there is no one in flight and there is data to send.
+  CHECKED_STATUS DoWrite();
+
+  void ConnectCompleted(int32_t result);
+  void ReceiveCompleted(int32_t result);
+  void SendCompleted(int32_t result);
+
+  // Try to parse received data and process it.
+  Result<bool> TryProcessReceived();
+
+  // Advances send position by the specified number of bytes and notifies the context about
+  // transferred data.
+  void DataSent(size_t bytes);
+  void PopSending();
+  void ClearSending(const Status& status);
+
+  StreamReadBuffer& ReadBuffer() {
+    return context_->ReadBuffer();
+  }
+
+  // The socket we're communicating on.
+  Socket socket_;
+
+  // The remote address we're talking from.
+  Endpoint local_;
+
+  // The remote address we're talking to.
+  const Endpoint remote_;
+
+  IoUring* const io_uring_;
+
+  StreamContext* context_ = nullptr;
+
+  Op connect_op_{this, &IoUringStream::ConnectCompleted};
+  Op receive_op_{this, &IoUringStream::ReceiveCompleted};
+  Op send_op_{this, &IoUringStream::SendCompleted};
+
+  // Buffers of the requests in flight, should stay valid until the request is completed.
+  IoVecs receive_iov_;
+  msghdr receive_msg_;
+  static constexpr size_t kMaxIov = 16;
+  iovec send_iov_[kMaxIov];
+  msghdr send_msg_;
+
+  // Number of entries at the front of sending_ referenced by the send request in flight.
+  size_t sending_in_flight_ = 0;
+
+  // Whether the receive request in flight reads data that should be skipped.
+  bool receiving_skipped_ = false;
+
+  // Whether ParseReceived is waiting for the receive request in flight to be cancelled.
+  bool receive_paused_ = false;
+
+  bool started_ = false;
+  bool shutdown_ = false;
+  bool connected_ = false;
+
+  std::deque<TcpStreamSendingData> sending_;
+  size_t data_blocks_sent_ = 0;
+  size_t send_position_ = 0;
+  size_t queued_bytes_to_send_ = 0;
+  size_t inbound_bytes_to_skip_ = 0;
+  MemTrackerPtr mem_tracker_;
+  scoped_refptr<Counter> bytes_sent_counter_;
+  scoped_refptr<Counter> bytes_received_counter_;
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_IO_URING_STREAM_H
@@ -95,6 +95,10 @@ DEFINE_int32(rpc_workers_limit, 1024, "Workers limit for rpc server");
 
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
+DEFINE_bool(rpc_use_io_uring, false,
+            "Use io_uring for socket IO of RPC connections, when supported by the kernel.");
+TAG_FLAG(rpc_use_io_uring, experimental);
+
 namespace yb {
 namespace rpc {
 
@@ -112,7 +116,8 @@ MessengerBuilder::MessengerBuilder(std::string name)
       listen_protocol_(TcpStream::StaticProtocol()),
       queue_limit_(FLAGS_rpc_queue_limit),
       workers_limit_(FLAGS_rpc_workers_limit),
-      num_connections_to_server_(GetAtomicFlag(&FLAGS_num_connections_to_server)) {
+      num_connections_to_server_(GetAtomicFlag(&FLAGS_num_connections_to_server)),
+      use_io_uring_(FLAGS_rpc_use_io_uring) {
   AddStreamFactory(TcpStream::StaticProtocol(), TcpStream::Factory());
 }
 
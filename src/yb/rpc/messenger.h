@@ -157,6 +157,17 @@ class MessengerBuilder {
     return last_used_parent_mem_tracker_;
   }
 
+  // Perform socket IO of TCP streams via io_uring of reactors, instead of readiness notifications
+  // from libev. Falls back to libev when io_uring is not supported.
+  MessengerBuilder& set_use_io_uring(bool value) {
+    use_io_uring_ = value;
+    return *this;
+  }
+
+  bool use_io_uring() const {
+    return use_io_uring_;
+  }
+
  private:
   const std::string name_;
   CoarseMonoClock::Duration connection_keepalive_time_;
@@ -170,6 +181,7 @@ class MessengerBuilder {
   size_t workers_limit_;
   int num_connections_to_server_;
   std::shared_ptr<MemTracker> last_used_parent_mem_tracker_;
+  bool use_io_uring_;
 };
 
 // A Messenger is a container for the reactor threads which run event loops for the RPC services.
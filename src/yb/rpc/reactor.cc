@@ -52,6 +52,7 @@
 
 #include "yb/rpc/connection.h"
 #include "yb/rpc/connection_context.h"
+#include "yb/rpc/io_uring.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_introspection.pb.h"
@@ -60,6 +61,7 @@
 #include "yb/util/atomic.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory.h"
@@ -79,6 +81,9 @@ using namespace std::literals;
 
 DEFINE_uint64(rpc_read_buffer_size, 0,
               "RPC connection read buffer size. 0 to auto detect.");
+DEFINE_uint64(rpc_io_uring_queue_depth, 1024,
+              "Size of io_uring submission queue of each reactor, when reactors use io_uring.");
+TAG_FLAG(rpc_io_uring_queue_depth, advanced);
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int32(socket_receive_buffer_size);
@@ -142,7 +147,8 @@ Reactor::Reactor(Messenger* messenger,
       last_unused_tcp_scan_(cur_time_),
       connection_keepalive_time_(bld.connection_keepalive_time()),
       coarse_timer_granularity_(bld.coarse_timer_granularity()),
-      num_connections_to_server_(bld.num_connections_to_server()) {
+      num_connections_to_server_(bld.num_connections_to_server()),
+      use_io_uring_(bld.use_io_uring()) {
   static std::once_flag libev_once;
   std::call_once(libev_once, DoInitLibEv);
 
@@ -175,6 +181,17 @@ Status Reactor::Init() {
   timer_.start(ToSeconds(coarse_timer_granularity_),
                ToSeconds(coarse_timer_granularity_));
 
+  if (use_io_uring_) {
+    auto io_uring = IoUring::Create(
+        loop_, FLAGS_rpc_io_uring_queue_depth, messenger_->metric_entity());
+    if (io_uring.ok()) {
+      io_uring_ = std::move(*io_uring);
+    } else {
+      LOG_WITH_PREFIX(WARNING) << "Failed to create io_uring, using libev for socket IO: "
+                               << io_uring.status();
+    }
+  }
+
   // Create Reactor thread.
   const std::string group_name = messenger_->name() + "_reactor";
   return yb::Thread::Create(group_name, group_name, &Reactor::RunThread, this, &thread_);
@@ -591,6 +608,7 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
         .receive_buffer_size = receive_buffer_size,
         .mem_tracker = messenger_->connection_context_factory_->buffer_tracker(),
         .metric_entity = messenger_->metric_entity(),
+        .io_uring = io_uring_.get(),
       }));
   auto context = messenger_->connection_context_factory_->Create(receive_buffer_size);
 
@@ -913,7 +931,8 @@ void Reactor::RegisterInboundSocket(
         .socket = socket,
         .receive_buffer_size = receive_buffer_size,
         .mem_tracker = factory->buffer_tracker(),
-        .metric_entity = messenger_->metric_entity()
+        .metric_entity = messenger_->metric_entity(),
+        .io_uring = io_uring_.get(),
       });
   if (!stream.ok()) {
     LOG_WITH_PREFIX(DFATAL) << "Failed to create stream for " << remote << ": " << stream.status();
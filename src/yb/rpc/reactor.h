@@ -85,6 +85,7 @@ typedef std::list<ConnectionPtr> ConnectionList;
 
 class DumpRunningRpcsRequestPB;
 class DumpRunningRpcsResponsePB;
+class IoUring;
 class Messenger;
 class MessengerBuilder;
 class Reactor;
@@ -477,6 +478,9 @@ class Reactor {
   // Handles the periodic timer.
   ev::timer timer_;
 
+  // Socket IO of the connections is performed via io_uring when it is set.
+  std::unique_ptr<IoUring> io_uring_;
+
   // Scheduled (but not yet run) delayed tasks.
   std::set<std::shared_ptr<DelayedTask>> scheduled_tasks_;
 
@@ -523,6 +527,8 @@ class Reactor {
 
   // Number of outbound connections to create per each destination server address.
   int num_connections_to_server_;
+
+  const bool use_io_uring_;
 };
 
 }  // namespace rpc
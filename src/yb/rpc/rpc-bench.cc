@@ -35,12 +35,14 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/rpc/io_uring.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rtest.proxy.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
@@ -48,6 +50,10 @@
 
 using namespace std::literals; // NOLINT
 
+DECLARE_bool(rpc_use_io_uring);
+
+METRIC_DECLARE_counter(rpc_io_uring_submit_calls);
+
 using std::string;
 using std::shared_ptr;
 
@@ -61,6 +67,8 @@ class RpcBench : public RpcTestBase {
  protected:
   friend class ClientThread;
 
+  void RunBenchmark();
+
   HostPort server_hostport_;
   std::atomic<bool> should_run_{true};
 };
@@ -106,8 +114,7 @@ class ClientThread {
 };
 
 
-// Test making successful RPC calls.
-TEST_F(RpcBench, BenchmarkCalls) {
+void RpcBench::RunBenchmark() {
   TestServerOptions options;
   options.n_worker_threads = 1;
 
@@ -155,6 +162,22 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Test making successful RPC calls.
+TEST_F(RpcBench, BenchmarkCalls) {
+  RunBenchmark();
+}
+
+// The same as BenchmarkCalls, but socket IO of both server and clients is performed via io_uring.
+TEST_F(RpcBench, BenchmarkCallsIoUring) {
+  if (!IoUring::IsSupported()) {
+    LOG(INFO) << "io_uring is not supported, skipping benchmark";
+    return;
+  }
+  FLAGS_rpc_use_io_uring = true;
+  RunBenchmark();
+  ASSERT_GT(METRIC_rpc_io_uring_submit_calls.Instantiate(metric_entity())->value(), 0);
+}
+
 } // namespace rpc
 } // namespace yb
 
@@ -52,6 +52,7 @@
 #include "yb/gutil/strings/human_readable.h"
 
 #include "yb/rpc/compressed_stream.h"
+#include "yb/rpc/io_uring.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/secure_stream.h"
@@ -79,6 +80,7 @@ METRIC_DECLARE_histogram(rpc_incoming_queue_time);
 METRIC_DECLARE_counter(tcp_bytes_sent);
 METRIC_DECLARE_counter(tcp_bytes_received);
 METRIC_DECLARE_counter(rpcs_timed_out_early_in_queue);
+METRIC_DECLARE_counter(rpc_io_uring_submit_calls);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -86,6 +88,7 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_bool(rpc_use_io_uring);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int32(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
@@ -235,6 +238,32 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+// The same as TestCall and TestRpcSidecar, but socket IO is performed via io_uring, when the kernel
+// supports it.
+TEST_F(TestRpc, TestCallIoUring) {
+  if (!IoUring::IsSupported()) {
+    LOG(INFO) << "io_uring is not supported, skipping test";
+    return;
+  }
+  FLAGS_rpc_use_io_uring = true;
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  }
+
+  // Larger than the read buffer, so data is received by several requests.
+  DoTestSidecar(&p, {3_MB, 2_MB, 24_MB});
+
+  // Socket IO should not silently fall back to libev.
+  ASSERT_GT(METRIC_rpc_io_uring_submit_calls.Instantiate(metric_entity())->value(), 0);
+}
+
 TEST_F(TestRpc, BigTimeout) {
   // Set up server.
   TestServerOptions options;
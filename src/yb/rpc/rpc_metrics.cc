@@ -13,6 +13,11 @@
 
 #include "yb/rpc/rpc_metrics.h"
 
+#include "yb/rpc/circular_read_buffer.h"
+
+#include "yb/gutil/bind.h"
+
+#include "yb/util/metric_entity.h"
 #include "yb/util/metrics.h"
 
 METRIC_DEFINE_gauge_int64(server, rpc_connections_alive,
@@ -45,6 +50,20 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_gauge_int64(server, rpc_read_buffers_allocated,
+                          "Number of allocated RPC read buffers.",
+                          yb::MetricUnit::kUnits,
+                          "Number of RPC connection read buffers allocated from the heap, "
+                          "because there was no idle buffer in the pool.",
+                          yb::EXPOSE_AS_COUNTER);
+
+METRIC_DEFINE_gauge_int64(server, rpc_read_buffers_reused,
+                          "Number of reused RPC read buffers.",
+                          yb::MetricUnit::kUnits,
+                          "Number of RPC connection read buffers taken from the pool of buffers "
+                          "of closed connections.",
+                          yb::EXPOSE_AS_COUNTER);
+
 namespace yb {
 namespace rpc {
 
@@ -56,6 +75,11 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    // Read buffer pools are shared by all messengers of the process.
+    metric_entity->NeverRetire(METRIC_rpc_read_buffers_allocated.InstantiateFunctionGauge(
+        metric_entity, Bind(&ReadBufferPool::Allocated)));
+    metric_entity->NeverRetire(METRIC_rpc_read_buffers_reused.InstantiateFunctionGauge(
+        metric_entity, Bind(&ReadBufferPool::Reused)));
   }
 }
 
@@ -32,6 +32,8 @@ class MetricEntity;
 
 namespace rpc {
 
+class IoUring;
+
 class StreamReadBuffer {
  public:
   // Returns whether we could read appended data from this buffer. It is NOT always !Empty().
@@ -146,6 +148,8 @@ struct StreamCreateData {
   int32_t receive_buffer_size;
   std::shared_ptr<MemTracker> mem_tracker;
   scoped_refptr<MetricEntity> metric_entity;
+  // io_uring of the reactor, if the messenger was built to use it.
+  IoUring* io_uring = nullptr;
 };
 
 class StreamFactory {
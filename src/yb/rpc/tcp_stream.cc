@@ -13,6 +13,7 @@
 
 #include "yb/rpc/tcp_stream.h"
 
+#include "yb/rpc/io_uring_stream.h"
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_util.h"
@@ -517,6 +518,9 @@ StreamFactoryPtr TcpStream::Factory() {
   class TcpStreamFactory : public StreamFactory {
    private:
     std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      if (data.io_uring) {
+        return std::make_unique<IoUringStream>(data);
+      }
       return std::make_unique<TcpStream>(data);
     }
   };
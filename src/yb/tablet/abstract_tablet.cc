@@ -13,6 +13,7 @@
 
 #include "yb/tablet/abstract_tablet.h"
 
+#include "yb/common/pgsql_error.h"
 #include "yb/common/ql_resultset.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
@@ -22,6 +23,7 @@
 
 #include "yb/tablet/read_result.h"
 
+#include "yb/util/format.h"
 #include "yb/util/trace.h"
 
 namespace yb {
@@ -100,8 +102,19 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
       &result->rows_data, &result->restart_read_ht);
   TRACE("Done Execute");
   if (!fetched_rows.ok()) {
-    result->response.set_status(PgsqlResponsePB::PGSQL_STATUS_RUNTIME_ERROR);
     const auto& s = fetched_rows.status();
+    const auto request_status = PgsqlRequestStatus::ValueFromStatus(s);
+    if (request_status == PgsqlResponsePB::PGSQL_STATUS_SCHEMA_VERSION_MISMATCH) {
+      // A row was written with a newer schema than the one of the request. The message format
+      // is the same as for the request schema version check, so postgres refreshes its table
+      // cache and retries the statement.
+      result->response.set_status(PgsqlResponsePB::PGSQL_STATUS_SCHEMA_VERSION_MISMATCH);
+      result->response.set_error_message(Format(
+          "schema version mismatch for table $0: $1", pgsql_read_request.table_id(),
+          s.message().ToBuffer()));
+      return Status::OK();
+    }
+    result->response.set_status(PgsqlResponsePB::PGSQL_STATUS_RUNTIME_ERROR);
     result->response.set_error_message(s.message().cdata(), s.message().size());
     return Status::OK();
   }
@@ -0,0 +1,129 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/finished_transactions_cache.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+class FinishedTransactionsCacheTest : public YBTest {
+};
+
+TEST_F(FinishedTransactionsCacheTest, Simple) {
+  FinishedTransactionsCache cache(100);
+  ASSERT_EQ(128U, cache.num_slots());
+
+  auto committed_id = TransactionId::GenerateRandom();
+  auto aborted_id = TransactionId::GenerateRandom();
+  auto unknown_id = TransactionId::GenerateRandom();
+  cache.RecordCommitted(committed_id, HybridTime(1000), AbortedSubTransactionSet());
+  cache.RecordAborted(aborted_id, HybridTime(2000));
+
+  auto committed = cache.Get(committed_id);
+  ASSERT_TRUE(committed);
+  ASSERT_EQ(TransactionStatus::COMMITTED, committed->status);
+  ASSERT_EQ(HybridTime(1000), committed->status_time);
+
+  auto aborted = cache.Get(aborted_id);
+  ASSERT_TRUE(aborted);
+  ASSERT_EQ(TransactionStatus::ABORTED, aborted->status);
+  ASSERT_EQ(HybridTime(2000), aborted->status_time);
+
+  // Unknown transaction could map to the slot of one of the known, but should not be found anyway.
+  ASSERT_FALSE(cache.Get(unknown_id));
+  ASSERT_FALSE(cache.Get(TransactionId::Nil()));
+}
+
+TEST_F(FinishedTransactionsCacheTest, AbortedSubTransactions) {
+  FinishedTransactionsCache cache(16);
+  auto id = TransactionId::GenerateRandom();
+  AbortedSubTransactionSet aborted_subtxn_set;
+  ASSERT_OK(aborted_subtxn_set.SetRange(2, 3));
+  cache.RecordCommitted(id, HybridTime(1000), aborted_subtxn_set);
+  ASSERT_FALSE(cache.Get(id));
+}
+
+TEST_F(FinishedTransactionsCacheTest, Disabled) {
+  FinishedTransactionsCache cache(0);
+  ASSERT_EQ(0U, cache.num_slots());
+  auto id = TransactionId::GenerateRandom();
+  cache.RecordCommitted(id, HybridTime(1000), AbortedSubTransactionSet());
+  ASSERT_FALSE(cache.Get(id));
+}
+
+TEST_F(FinishedTransactionsCacheTest, Eviction) {
+  FinishedTransactionsCache cache(1);
+  auto first_id = TransactionId::GenerateRandom();
+  auto second_id = TransactionId::GenerateRandom();
+  cache.RecordCommitted(first_id, HybridTime(1000), AbortedSubTransactionSet());
+  cache.RecordAborted(second_id, HybridTime(2000));
+  ASSERT_FALSE(cache.Get(first_id));
+  ASSERT_TRUE(cache.Get(second_id));
+}
+
+// Concurrent readers should never see status that was recorded for other transaction.
+TEST_F(FinishedTransactionsCacheTest, Concurrent) {
+  constexpr size_t kNumTransactions = 64;
+  constexpr int kNumWriters = 4;
+  constexpr int kNumReaders = 4;
+
+  FinishedTransactionsCache cache(16);
+  std::vector<TransactionId> ids;
+  for (size_t i = 0; i != kNumTransactions; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+  }
+  // Commit time is derived from transaction index, so reader could check it.
+  auto commit_time = [](size_t idx) {
+    return HybridTime(1000 + idx);
+  };
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumWriters; ++i) {
+    thread_holder.AddThreadFunctor(
+        [&cache, &ids, &commit_time, &stop = thread_holder.stop_flag()] {
+      while (!stop.load(std::memory_order_acquire)) {
+        auto idx = RandomUniformInt<size_t>(0, kNumTransactions - 1);
+        cache.RecordCommitted(ids[idx], commit_time(idx), AbortedSubTransactionSet());
+      }
+    });
+  }
+  std::atomic<size_t> hits{0};
+  for (int i = 0; i != kNumReaders; ++i) {
+    thread_holder.AddThreadFunctor(
+        [&cache, &ids, &commit_time, &hits, &stop = thread_holder.stop_flag()] {
+      while (!stop.load(std::memory_order_acquire)) {
+        auto idx = RandomUniformInt<size_t>(0, kNumTransactions - 1);
+        auto status = cache.Get(ids[idx]);
+        if (status) {
+          ASSERT_EQ(TransactionStatus::COMMITTED, status->status);
+          ASSERT_EQ(commit_time(idx), status->status_time);
+          hits.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  thread_holder.WaitAndStop(3s);
+  LOG(INFO) << "Hits: " << hits.load();
+  ASSERT_GT(hits.load(), 0U);
+}
+
+} // namespace tablet
+} // namespace yb
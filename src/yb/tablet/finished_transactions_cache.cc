@@ -0,0 +1,137 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/finished_transactions_cache.h"
+
+#include <atomic>
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Status value of the slot that does not contain any transaction.
+constexpr uint32_t kEmptySlotStatus = 0;
+
+} // namespace
+
+// All fields are atomic to avoid data races, but they are written only while the version is odd,
+// and reader checks that the version did not change while it was reading them.
+struct FinishedTransactionsCache::Slot {
+  std::atomic<uint64_t> version{0};
+  std::atomic<uint64_t> id_first{0};
+  std::atomic<uint64_t> id_second{0};
+  std::atomic<uint32_t> status{kEmptySlotStatus};
+  std::atomic<uint64_t> status_time{0};
+
+  // Tries to start writing to the slot. Returns the version that should be passed to Unlock,
+  // or boost::none if slot is being written by someone else.
+  boost::optional<uint64_t> TryLock() {
+    auto current = version.load(std::memory_order_acquire);
+    if ((current & 1) ||
+        !version.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel)) {
+      return boost::none;
+    }
+    // Make sure that the odd version is visible before any of the following writes.
+    std::atomic_thread_fence(std::memory_order_release);
+    return current + 1;
+  }
+
+  void Unlock(uint64_t locked_version) {
+    version.store(locked_version + 1, std::memory_order_release);
+  }
+};
+
+FinishedTransactionsCache::FinishedTransactionsCache(size_t capacity) {
+  if (capacity == 0) {
+    return;
+  }
+  num_slots_ = 1;
+  while (num_slots_ < capacity) {
+    num_slots_ <<= 1;
+  }
+  slots_.reset(new Slot[num_slots_]);
+}
+
+FinishedTransactionsCache::~FinishedTransactionsCache() = default;
+
+FinishedTransactionsCache::Slot* FinishedTransactionsCache::FindSlot(
+    const TransactionId& id) const {
+  if (!num_slots_) {
+    return nullptr;
+  }
+  return &slots_[TransactionIdHash()(id) & (num_slots_ - 1)];
+}
+
+void FinishedTransactionsCache::RecordCommitted(
+    const TransactionId& id, HybridTime commit_time,
+    const AbortedSubTransactionSet& aborted_subtxn_set) {
+  if (!aborted_subtxn_set.IsEmpty()) {
+    return;
+  }
+  Record(id, TransactionStatus::COMMITTED, commit_time);
+}
+
+void FinishedTransactionsCache::RecordAborted(const TransactionId& id, HybridTime status_time) {
+  Record(id, TransactionStatus::ABORTED, status_time);
+}
+
+void FinishedTransactionsCache::Record(
+    const TransactionId& id, TransactionStatus status, HybridTime status_time) {
+  auto* slot = FindSlot(id);
+  if (!slot) {
+    return;
+  }
+  auto locked_version = slot->TryLock();
+  if (!locked_version) {
+    return;
+  }
+  auto id_pair = id.ToUInt64Pair();
+  slot->id_first.store(id_pair.first, std::memory_order_relaxed);
+  slot->id_second.store(id_pair.second, std::memory_order_relaxed);
+  slot->status.store(status, std::memory_order_relaxed);
+  slot->status_time.store(status_time.ToUint64(), std::memory_order_relaxed);
+  slot->Unlock(*locked_version);
+}
+
+boost::optional<FinishedTransactionStatus> FinishedTransactionsCache::Get(
+    const TransactionId& id) const {
+  auto* slot = FindSlot(id);
+  if (!slot) {
+    return boost::none;
+  }
+  auto version = slot->version.load(std::memory_order_acquire);
+  if (version & 1) {
+    return boost::none;
+  }
+  auto id_first = slot->id_first.load(std::memory_order_relaxed);
+  auto id_second = slot->id_second.load(std::memory_order_relaxed);
+  auto status = slot->status.load(std::memory_order_relaxed);
+  auto status_time = slot->status_time.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot->version.load(std::memory_order_relaxed) != version) {
+    return boost::none;
+  }
+
+  if (status == kEmptySlotStatus ||
+      std::make_pair(id_first, id_second) != id.ToUInt64Pair()) {
+    return boost::none;
+  }
+  return FinishedTransactionStatus {
+    .status = static_cast<TransactionStatus>(status),
+    .status_time = HybridTime(status_time),
+  };
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_FINISHED_TRANSACTIONS_CACHE_H
+#define YB_TABLET_FINISHED_TRANSACTIONS_CACHE_H
+
+#include <memory>
+
+#include <boost/optional/optional.hpp>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
+
+namespace yb {
+namespace tablet {
+
+struct FinishedTransactionStatus {
+  // Either COMMITTED or ABORTED.
+  TransactionStatus status;
+  // Commit time for committed transaction, last known status time for aborted transaction.
+  HybridTime status_time;
+};
+
+// Tablet wide cache of transactions with known final status, i.e. transactions committed locally
+// and transactions known to be aborted.
+//
+// Readers and conflict resolution check the status of the same transactions over and over again,
+// while the participant could answer those requests only under its mutex. This cache allows
+// answering them without locking.
+//
+// The cache has fixed number of slots, and transaction could be stored only in the slot selected
+// by the hash of its id, evicting previous entry. Each slot is protected by a sequence lock, so
+// lookups never block. A writer that finds the slot being written by another writer just skips
+// the update, since losing an entry only leads to a slower lookup.
+class FinishedTransactionsCache {
+ public:
+  // Number of slots is rounded up to a power of 2, zero capacity disables the cache.
+  explicit FinishedTransactionsCache(size_t capacity);
+  ~FinishedTransactionsCache();
+
+  // Committed transactions with aborted subtransactions are not cached, because readers also
+  // need the set of aborted subtransactions.
+  void RecordCommitted(const TransactionId& id, HybridTime commit_time,
+                       const AbortedSubTransactionSet& aborted_subtxn_set);
+  void RecordAborted(const TransactionId& id, HybridTime status_time);
+
+  boost::optional<FinishedTransactionStatus> Get(const TransactionId& id) const;
+
+  size_t num_slots() const {
+    return num_slots_;
+  }
+
+ private:
+  struct Slot;
+
+  void Record(const TransactionId& id, TransactionStatus status, HybridTime status_time);
+  Slot* FindSlot(const TransactionId& id) const;
+
+  size_t num_slots_ = 0;
+  std::unique_ptr<Slot[]> slots_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_FINISHED_TRANSACTIONS_CACHE_H
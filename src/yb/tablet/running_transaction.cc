@@ -40,6 +40,12 @@ DEFINE_int64(transaction_abort_check_interval_ms, 5000 * yb::kTimeMultiplier,
 DEFINE_int64(transaction_abort_check_timeout_ms, 30000 * yb::kTimeMultiplier,
              "Timeout used when checking for aborted transactions.");
 
+DEFINE_bool(transaction_batch_status_requests, true,
+            "Combine concurrent status requests for transactions with the same status tablet "
+            "into a single RPC.");
+TAG_FLAG(transaction_batch_status_requests, advanced);
+TAG_FLAG(transaction_batch_status_requests, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -84,6 +90,7 @@ void RunningTransaction::SetLocalCommitData(
   local_commit_time_ = time;
   last_known_status_hybrid_time_ = local_commit_time_;
   last_known_status_ = TransactionStatus::COMMITTED;
+  context_.finished_transactions_cache_.RecordCommitted(id(), time, aborted_subtxn_set);
 }
 
 void RunningTransaction::Aborted() {
@@ -91,6 +98,7 @@ void RunningTransaction::Aborted() {
 
   last_known_status_ = TransactionStatus::ABORTED;
   last_known_status_hybrid_time_ = HybridTime::kMax;
+  context_.finished_transactions_cache_.RecordAborted(id(), last_known_status_hybrid_time_);
 }
 
 void RunningTransaction::RequestStatusAt(const StatusRequest& request,
@@ -214,6 +222,12 @@ void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
   TRACE_FUNC();
   VTRACE(1, yb::ToString(metadata_.transaction_id));
+  if (FLAGS_transaction_batch_status_requests) {
+    context_.status_batcher_.Send(
+        metadata_.status_tablet, metadata_.transaction_id,
+        std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self));
+    return;
+  }
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
@@ -333,6 +347,7 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     auto did_abort_txn = UpdateStatus(
         transaction_status, time_of_status, coordinator_safe_time, aborted_subtxn_set);
     if (did_abort_txn) {
+      context_.finished_transactions_cache_.RecordAborted(id(), last_known_status_hybrid_time_);
       context_.EnqueueRemoveUnlocked(id(), RemoveReason::kStatusReceived, &min_running_notifier);
     }
 
@@ -114,12 +114,14 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   std::string LogPrefix() const;
 
- private:
+  // Returns status of the transaction at specified time, if it could be determined from the last
+  // known status.
   static boost::optional<TransactionStatus> GetStatusAt(
       HybridTime time,
       HybridTime last_known_status_hybrid_time,
       TransactionStatus last_known_status);
 
+ private:
   void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self);
 
   void StatusReceived(const Status& status,
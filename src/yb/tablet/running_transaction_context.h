@@ -27,8 +27,10 @@
 
 #include "yb/rpc/rpc.h"
 
+#include "yb/tablet/finished_transactions_cache.h"
 #include "yb/tablet/transaction_intent_applier.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/transaction_status_batcher.h"
 
 #include "yb/util/delayer.h"
 #include "yb/util/math_util.h"
@@ -66,8 +68,11 @@ YB_DEFINE_ENUM(RemoveReason,
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            size_t finished_transactions_cache_size)
+      : participant_context_(*participant_context), applier_(*applier),
+        finished_transactions_cache_(finished_transactions_cache_size),
+        status_batcher_(participant_context, &rpcs_) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -99,6 +104,10 @@ class RunningTransactionContext {
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Final statuses of transactions, that could be checked without locking mutex_.
+  FinishedTransactionsCache finished_transactions_cache_;
+  TransactionStatusBatcher status_batcher_;
+
   // Used only in tests.
   Delayer delayer_;
 };
@@ -59,6 +59,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.h"
@@ -88,6 +89,7 @@
 #include "yb/tablet/read_result.h"
 #include "yb/tablet/snapshot_coordinator.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
+#include "yb/tablet/tablet_load_tracker.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
@@ -257,6 +259,8 @@ DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
+DECLARE_string(regular_tablets_index_block_key_value_encoding);
+DECLARE_string(regular_tablets_memtable_rep);
 
 using namespace std::placeholders;
 
@@ -326,6 +330,35 @@ docdb::ConsensusFrontiers* InitFrontiers(
   return frontiers;
 }
 
+std::unique_ptr<TabletLoadTracker> CreateLoadTracker(const RaftGroupMetadata& metadata) {
+  // Hash codes of the tablet are in [start, end), empty partition key end means the end of the
+  // hash space. Range partitioned tablets do not record hash codes, so use the whole hash space.
+  uint32_t start = 0;
+  uint32_t end = PartitionSchema::kMaxPartitionKey + 1;
+  if (metadata.partition_schema()->IsHashPartitioning()) {
+    const auto& partition = *metadata.partition();
+    if (!partition.partition_key_start().empty()) {
+      start = PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+    }
+    if (!partition.partition_key_end().empty()) {
+      end = PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+    }
+  }
+  return std::make_unique<TabletLoadTracker>(start, end);
+}
+
+// Records read request in load tracker. Only the first page of a read, that is limited to a single
+// hash code, is recorded as a point read. Other reads are recorded as scans.
+template <class Request>
+void RecordReadLoad(const Request& request, TabletLoadTracker* load_tracker) {
+  if (request.has_hash_code() && !request.has_paging_state() &&
+      (!request.has_max_hash_code() || request.max_hash_code() == request.hash_code())) {
+    load_tracker->Record(TabletLoadType::kRead, request.hash_code());
+  } else {
+    load_tracker->Record(TabletLoadType::kRead);
+  }
+}
+
 template <class Data>
 docdb::ConsensusFrontiers* InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
   return InitFrontiers(data.op_id, data.log_ht, frontiers);
@@ -409,6 +442,7 @@ Tablet::Tablet(const TabletInitData& data)
              : rocksdb::CreateDBStatistics(table_metrics_entity_, nullptr, true));
 
     metrics_.reset(new TabletMetrics(table_metrics_entity_, tablet_metrics_entity_));
+    shared_lock_manager_.SetMetricEntity(tablet_metrics_entity_);
 
     mem_tracker_->SetMetricEntity(tablet_metrics_entity_);
   }
@@ -423,7 +457,8 @@ Tablet::Tablet(const TabletInitData& data)
       data.transaction_participant_context &&
       (is_sys_catalog_ || transactional)) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
-        data.transaction_participant_context, this, tablet_metrics_entity_);
+        data.transaction_participant_context, this, tablet_metrics_entity_,
+        data.tablet_options.wait_for_graph.get());
     // Create transaction manager for secondary index update.
     if (has_index) {
       transaction_manager_ = std::make_unique<client::TransactionManager>(
@@ -454,6 +489,8 @@ Tablet::Tablet(const TabletInitData& data)
 
   snapshots_ = std::make_unique<TabletSnapshots>(this);
 
+  load_tracker_ = CreateLoadTracker(*metadata_);
+
   snapshot_coordinator_ = data.snapshot_coordinator;
 
   if (metadata_->tablet_data_state() == TabletDataState::TABLET_DATA_SPLIT_COMPLETED) {
@@ -640,6 +677,9 @@ Status Tablet::OpenKeyValueTablet() {
     table_options.data_block_key_value_encoding_format =
         VERIFY_RESULT(docdb::GetConfiguredKeyValueEncodingFormat(
             FLAGS_regular_tablets_data_block_key_value_encoding));
+    table_options.index_block_key_value_encoding_format =
+        VERIFY_RESULT(docdb::GetConfiguredKeyValueEncodingFormat(
+            FLAGS_regular_tablets_index_block_key_value_encoding));
   }
   rocksdb::Options rocksdb_options;
   InitRocksDBOptions(
@@ -688,6 +728,9 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb_options.level0_stop_writes_trigger = std::numeric_limits<int>::max();
 
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
+  // Intents DB keeps the default skip list memtable, since it relies on in-memory erase.
+  regular_rocksdb_options.memtable_factory = VERIFY_RESULT(
+      docdb::GetConfiguredMemTableRepFactory(FLAGS_regular_tablets_memtable_rep));
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
 
@@ -1326,6 +1369,7 @@ Status Tablet::HandleQLReadRequest(
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  RecordReadLoad(ql_read_request, load_tracker_.get());
 
   if (!IsSchemaVersionCompatible(
           metadata()->schema_version(), ql_read_request.schema_version(),
@@ -1408,6 +1452,7 @@ Status Tablet::HandlePgsqlReadRequest(
   RETURN_NOT_OK(scoped_read_operation);
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
+  RecordReadLoad(pgsql_read_request, load_tracker_.get());
 
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -3433,6 +3478,19 @@ Result<std::string> Tablet::GetEncodedMiddleSplitKey() const {
   return middle_key;
 }
 
+Result<std::string> Tablet::GetEncodedLoadSplitKey() const {
+  if (metadata()->partition_schema()->IsHashPartitioning()) {
+    auto hash_code = load_tracker_->LoadMedianHashCode();
+    if (hash_code) {
+      docdb::KeyBytes split_key;
+      docdb::DocKeyEncoderAfterTableIdStep(&split_key).Hash(
+          *hash_code, std::vector<docdb::PrimitiveValue>());
+      return split_key.ToStringBuffer();
+    }
+  }
+  return GetEncodedMiddleSplitKey();
+}
+
 Status Tablet::TriggerPostSplitCompactionIfNeeded(
     std::function<std::unique_ptr<ThreadPoolToken>()> get_token_for_compaction) {
   if (post_split_compaction_task_pool_token_) {
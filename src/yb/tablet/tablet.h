@@ -551,6 +551,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // - for range-based partitions: encoded doc key in order to split by row.
   Result<std::string> GetEncodedMiddleSplitKey() const;
 
+  // Returns encoded hash code that splits recent read and write load of the tablet into halves.
+  // Falls back to GetEncodedMiddleSplitKey when load distribution is not known, e.g. for
+  // range-based partitions.
+  Result<std::string> GetEncodedLoadSplitKey() const;
+
   std::string TEST_DocDBDumpStr(IncludeIntents include_intents = IncludeIntents::kFalse);
 
   void TEST_DocDBDumpToContainer(
@@ -637,6 +642,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return *snapshots_;
   }
 
+  TabletLoadTracker& load_tracker() {
+    return *load_tracker_;
+  }
+
   SnapshotCoordinator* snapshot_coordinator() {
     return snapshot_coordinator_;
   }
@@ -957,6 +966,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<TabletSnapshots> snapshots_;
 
+  std::unique_ptr<TabletLoadTracker> load_tracker_;
+
   SnapshotCoordinator* snapshot_coordinator_ = nullptr;
 
   mutable std::mutex control_path_mutex_;
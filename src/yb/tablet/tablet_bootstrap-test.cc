@@ -227,6 +227,8 @@ class BootstrapTest : public LogTestBase {
       .append_pool = log_thread_pool_.get(),
       .allocation_pool = log_thread_pool_.get(),
       .retryable_requests = nullptr,
+      .read_ahead_pool = read_ahead_pool_,
+      .metrics = nullptr,
       .test_hooks = test_hooks_
     };
     RETURN_NOT_OK(BootstrapTablet(data, tablet, &log_, boot_info));
@@ -268,6 +270,7 @@ class BootstrapTest : public LogTestBase {
   }
 
   std::shared_ptr<BootstrapTestHooksImpl> test_hooks_;
+  ThreadPool* read_ahead_pool_ = nullptr;
 };
 
 // ===============================================================================================
@@ -511,6 +514,34 @@ TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
 }
 
+// Tests bootstrap that reads log segments ahead of their replay in a separate pool.
+TEST_F(BootstrapTest, ReadAheadSegments) {
+  constexpr int kNumSegments = 5;
+  constexpr int kEntriesPerSegment = 3;
+  BuildLog();
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    for (int i = 0; i != kEntriesPerSegment; ++i) {
+      AppendReplicateBatchToLog(1);
+    }
+    ASSERT_OK(RollLog());
+  }
+
+  std::unique_ptr<ThreadPool> read_ahead_pool;
+  ASSERT_OK(ThreadPoolBuilder("read-ahead").set_max_threads(2).Build(&read_ahead_pool));
+  read_ahead_pool_ = read_ahead_pool.get();
+
+  TabletPtr tablet;
+  ConsensusBootstrapInfo boot_info;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  OpIdPB last_opid;
+  last_opid.set_term(1);
+  last_opid.set_index(current_index_ - 1);
+  ASSERT_OPID_EQ(last_opid, boot_info.last_id);
+  ASSERT_OPID_EQ(last_opid, boot_info.last_committed_id);
+  ASSERT_EQ(test_hooks_->actual_report.replayed.size(),
+            static_cast<size_t>(kNumSegments * kEntriesPerSegment));
+}
+
 struct BootstrapInputEntry {
   const OpId& op_id() const { return batch_data.op_id; }
 
@@ -32,6 +32,8 @@
 
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <deque>
+#include <future>
 #include <map>
 #include <set>
 
@@ -50,6 +52,7 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -91,12 +94,14 @@
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/metric_entity.h"
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
@@ -130,6 +135,13 @@ DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
                  "Time (in ms) to delay tablet bootstrap by.");
 
+DEFINE_int32(tablet_bootstrap_read_ahead_segments, 2,
+             "Number of log segments that tablet bootstrap reads and decodes in the background "
+             "ahead of replaying them, so reading of the log overlaps with applying its entries. "
+             "0 disables read ahead.");
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, advanced);
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -176,6 +188,91 @@ static string DebugInfo(const string& tablet_id,
                     segment_path, debug_str);
 }
 
+// ================================================================================================
+// Class LogSegmentReadAhead.
+// ================================================================================================
+
+// Reads and decodes log segments in the provided pool ahead of replay, while the bootstrapping
+// thread validates and applies entries of the previously read segment. Results are returned in
+// the order of segments. Segments are read by the calling thread when there is no pool, or the
+// pool rejects the task.
+class LogSegmentReadAhead {
+ public:
+  LogSegmentReadAhead(
+      ThreadPool* pool, size_t max_segments_ahead, SegmentSequence::const_iterator begin,
+      SegmentSequence::const_iterator end)
+      : pool_(max_segments_ahead ? pool : nullptr), max_segments_ahead_(max_segments_ahead),
+        next_(begin), end_(end) {
+    Fill();
+  }
+
+  ~LogSegmentReadAhead() {
+    // Tasks that are still running could use the log, so wait for them before it is released.
+    for (auto& task : tasks_) {
+      task.wait();
+    }
+  }
+
+  // Returns the entries of the next segment. read_time is incremented by the time spent reading
+  // the segment, stall_time by the time the caller was blocked waiting for it.
+  log::ReadEntriesResult Next(MonoDelta* read_time, MonoDelta* stall_time) {
+    SegmentRead read;
+    if (tasks_.empty()) {
+      DCHECK(next_ != end_);
+      read = Read(next_->get());
+      ++next_;
+      *stall_time += read.read_time;
+    } else {
+      auto start = MonoTime::Now();
+      read = tasks_.front().get();
+      tasks_.pop_front();
+      *stall_time += MonoTime::Now() - start;
+    }
+    *read_time += read.read_time;
+    Fill();
+    return std::move(read.result);
+  }
+
+ private:
+  struct SegmentRead {
+    log::ReadEntriesResult result;
+    MonoDelta read_time;
+  };
+
+  static SegmentRead Read(ReadableLogSegment* segment) {
+    auto start = MonoTime::Now();
+    SegmentRead read;
+    read.result = segment->ReadEntries();
+    read.read_time = MonoTime::Now() - start;
+    return read;
+  }
+
+  void Fill() {
+    while (pool_ && tasks_.size() < max_segments_ahead_ && next_ != end_) {
+      auto promise = std::make_shared<std::promise<SegmentRead>>();
+      auto future = promise->get_future();
+      scoped_refptr<ReadableLogSegment> segment = *next_;
+      auto status = pool_->SubmitFunc([promise, segment] {
+        promise->set_value(Read(segment.get()));
+      });
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to submit log segment read ahead, reading synchronously: "
+                     << status;
+        pool_ = nullptr;
+        return;
+      }
+      tasks_.push_back(std::move(future));
+      ++next_;
+    }
+  }
+
+  ThreadPool* pool_;
+  const size_t max_segments_ahead_;
+  SegmentSequence::const_iterator next_;
+  const SegmentSequence::const_iterator end_;
+  std::deque<std::future<SegmentRead>> tasks_;
+};
+
 // ================================================================================================
 // Class ReplayState.
 // ================================================================================================
@@ -774,6 +871,9 @@ class TabletBootstrap {
     const auto& metadata = *tablet_->metadata();
     log_options.retention_secs = metadata.wal_retention_secs();
     log_options.env = GetEnv();
+    if (data_.log_sync_groups) {
+      log_options.sync_group = data_.log_sync_groups->Get(metadata.wal_root_dir());
+    }
     if (tablet_->metadata()->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
       auto log_segment_size = FLAGS_transaction_status_tablet_log_segment_size_bytes;
       if (log_segment_size) {
@@ -1019,7 +1119,9 @@ class TabletBootstrap {
     HandleRetryableRequest(*replicate, entry_time);
     VLOG_WITH_PREFIX_AND_FUNC(3) << "decision: " << AsString(decision);
     if (decision.should_replay) {
+      auto apply_start = MonoTime::Now();
       const auto status = PlayAnyRequest(replicate, decision.already_applied_to_regular_db);
+      stats_.apply_time += MonoTime::Now() - apply_start;
       if (!status.ok()) {
         return status.CloneAndAppend(Format(
             "Failed to play $0 request. ReplicateMsg: { $1 }",
@@ -1247,14 +1349,21 @@ class TabletBootstrap {
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
+    // Reading of the following segments overlaps with replay of the current one. Entries are
+    // still validated and applied by this thread, since they must be applied in the op id order.
+    LogSegmentReadAhead read_ahead(
+        data_.read_ahead_pool, std::max(FLAGS_tablet_bootstrap_read_ahead_segments, 0), iter,
+        segments.end());
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      auto read_result = read_ahead.Next(&stats_.read_time, &stats_.read_stall_time);
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
       }
+      const auto replay_start = MonoTime::Now();
+      const auto apply_time_before_replay = stats_.apply_time;
       for (size_t entry_idx = 0; entry_idx < read_result.entries.size(); ++entry_idx) {
         const Status s = HandleEntry(
             read_result.entry_metadata[entry_idx], &read_result.entries[entry_idx]);
@@ -1267,6 +1376,12 @@ class TabletBootstrap {
                                             read_result.entries[entry_idx].get()));
         }
       }
+      // Entries committed while handling this segment are applied inside HandleEntry, so apply
+      // time is excluded from the replay phase.
+      auto replay_time = MonoTime::Now() - replay_start;
+      replay_time -= stats_.apply_time;
+      replay_time += apply_time_before_replay;
+      stats_.replay_time += replay_time;
       if (!read_result.entry_metadata.empty()) {
         last_entry_time = read_result.entry_metadata.back().entry_time;
       }
@@ -1359,6 +1474,14 @@ class TabletBootstrap {
       data_.retryable_requests->Clock().Adjust(last_entry_time);
     }
 
+    LOG_WITH_PREFIX(INFO) << "Log replay finished: " << stats_;
+    if (data_.metrics) {
+      data_.metrics->read_time->Increment(stats_.read_time.ToMicroseconds());
+      data_.metrics->read_stall_time->Increment(stats_.read_stall_time.ToMicroseconds());
+      data_.metrics->replay_time->Increment(stats_.replay_time.ToMicroseconds());
+      data_.metrics->apply_time->Increment(stats_.apply_time.ToMicroseconds());
+    }
+
     return Status::OK();
   }
 
@@ -1627,6 +1750,12 @@ class TabletBootstrap {
 
     // Number of REPLICATE messages which were overwritten by later entries.
     int ops_overwritten = 0;
+
+    // Time spent in the respective phases of the log replay, see TabletBootstrapMetrics.
+    MonoDelta read_time = MonoDelta::kZero;
+    MonoDelta read_stall_time = MonoDelta::kZero;
+    MonoDelta replay_time = MonoDelta::kZero;
+    MonoDelta apply_time = MonoDelta::kZero;
   } stats_;
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
@@ -1651,8 +1780,9 @@ class TabletBootstrap {
 // ============================================================================
 
 string TabletBootstrap::Stats::ToString() const {
-  return Format("Read operations: $0, overwritten operations: $1",
-                ops_read, ops_overwritten);
+  return Format("Read operations: $0, overwritten operations: $1, read time: $2, "
+                "read stall time: $3, replay time: $4, apply time: $5",
+                ops_read, ops_overwritten, read_time, read_stall_time, replay_time, apply_time);
 }
 
 CHECKED_STATUS BootstrapTabletImpl(
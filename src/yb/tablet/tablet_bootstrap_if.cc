@@ -53,6 +53,25 @@
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/metrics.h"
+
+METRIC_DEFINE_coarse_histogram(server, tablet_bootstrap_read_time,
+                               "Tablet Bootstrap Read Time", yb::MetricUnit::kMicroseconds,
+                               "Time spent by tablet bootstrap reading and decoding log segments.");
+
+METRIC_DEFINE_coarse_histogram(server, tablet_bootstrap_read_stall_time,
+                               "Tablet Bootstrap Read Stall Time", yb::MetricUnit::kMicroseconds,
+                               "Time tablet bootstrap waited for log segments to be read. High "
+                               "values mean that replay is bound by the log read speed.");
+
+METRIC_DEFINE_coarse_histogram(server, tablet_bootstrap_replay_time,
+                               "Tablet Bootstrap Replay Time", yb::MetricUnit::kMicroseconds,
+                               "Time spent by tablet bootstrap validating log entries.");
+
+METRIC_DEFINE_coarse_histogram(server, tablet_bootstrap_apply_time,
+                               "Tablet Bootstrap Apply Time", yb::MetricUnit::kMicroseconds,
+                               "Time spent by tablet bootstrap applying replayed log entries to "
+                               "RocksDB.");
 
 namespace yb {
 namespace tablet {
@@ -117,6 +136,15 @@ Status BootstrapTablet(
   return Status::OK();
 }
 
+TabletBootstrapMetrics::TabletBootstrapMetrics(const scoped_refptr<MetricEntity>& entity)
+    : read_time(METRIC_tablet_bootstrap_read_time.Instantiate(entity)),
+      read_stall_time(METRIC_tablet_bootstrap_read_stall_time.Instantiate(entity)),
+      replay_time(METRIC_tablet_bootstrap_replay_time.Instantiate(entity)),
+      apply_time(METRIC_tablet_bootstrap_apply_time.Instantiate(entity)) {
+}
+
+TabletBootstrapMetrics::~TabletBootstrapMetrics() = default;
+
 string DocDbOpIds::ToString() const {
   return Format("{ regular: $0 intents: $1 }", regular, intents);
 }
@@ -49,6 +49,7 @@
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/tablet_options.h"
 
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/opid.h"
 #include "yb/util/shared_lock.h"
@@ -156,6 +157,25 @@ class TabletBootstrapTestHooksIf {
   virtual void FirstOpIdOfSegment(const std::string& path, OpId first_op_id) = 0;
 };
 
+// Server wide metrics of tablet bootstrap. Every bootstrapped tablet adds one sample to each
+// histogram, with the time it spent in the respective phase of the log replay.
+struct TabletBootstrapMetrics {
+  explicit TabletBootstrapMetrics(const scoped_refptr<MetricEntity>& entity);
+  ~TabletBootstrapMetrics();
+
+  // Time spent reading and decoding log segments, including the time of read ahead.
+  scoped_refptr<Histogram> read_time;
+
+  // Time replay was blocked waiting for the next log segment to be read.
+  scoped_refptr<Histogram> read_stall_time;
+
+  // Time spent validating entries and maintaining the replay state.
+  scoped_refptr<Histogram> replay_time;
+
+  // Time spent applying committed entries to RocksDB.
+  scoped_refptr<Histogram> apply_time;
+};
+
 struct BootstrapTabletData {
   TabletInitData tablet_init_data;
   TabletStatusListener* listener = nullptr;
@@ -163,6 +183,14 @@ struct BootstrapTabletData {
   ThreadPool* allocation_pool = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
 
+  // Pool used to read log segments ahead of replay. Segments are read by the bootstrapping thread
+  // itself if it is null.
+  ThreadPool* read_ahead_pool = nullptr;
+  TabletBootstrapMetrics* metrics = nullptr;
+
+  // Sync groups for the new log, the log syncs its segments on its own if it is null.
+  log::LogSyncGroups* log_sync_groups = nullptr;
+
   std::shared_ptr<TabletBootstrapTestHooksIf> test_hooks = nullptr;
 };
 
@@ -49,6 +49,7 @@ class OperationFilter;
 class SnapshotCoordinator;
 class SnapshotOperation;
 class SplitOperation;
+class TabletLoadTracker;
 class TabletSnapshots;
 class TabletSplitter;
 class TabletStatusListener;
@@ -70,6 +71,7 @@ struct DocDbOpIds;
 struct PgsqlReadRequestResult;
 struct QLReadRequestResult;
 struct RemoveIntentsData;
+struct TabletBootstrapMetrics;
 struct TabletInitData;
 struct TabletMetrics;
 struct TransactionApplyData;
@@ -0,0 +1,116 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/tablet_load_tracker.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(tablet_load_split_min_samples);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const uint32_t kStart = 0x4000;
+const uint32_t kEnd = 0x8000;
+// Width of the tracker bucket, the median could not be found with better precision.
+const uint32_t kPrecision = (kEnd - kStart) / TabletLoadTracker::kNumBuckets;
+
+} // namespace
+
+class TabletLoadTrackerTest : public YBTest {
+ protected:
+  void RecordUniform(TabletLoadTracker* tracker, uint32_t min, uint32_t max, int count) {
+    for (int i = 0; i != count; ++i) {
+      tracker->Record(TabletLoadType::kRead, RandomUniformInt<uint32_t>(min, max - 1));
+    }
+  }
+};
+
+TEST_F(TabletLoadTrackerTest, NumOps) {
+  TabletLoadTracker tracker(kStart, kEnd);
+  tracker.Record(TabletLoadType::kRead, kStart);
+  tracker.Record(TabletLoadType::kRead);
+  tracker.Record(TabletLoadType::kWrite, kEnd - 1);
+  ASSERT_EQ(2, tracker.num_ops(TabletLoadType::kRead));
+  ASSERT_EQ(1, tracker.num_ops(TabletLoadType::kWrite));
+
+  // Decay affects only the distribution, not the number of operations.
+  tracker.Decay();
+  ASSERT_EQ(2, tracker.num_ops(TabletLoadType::kRead));
+  ASSERT_EQ(1, tracker.num_ops(TabletLoadType::kWrite));
+}
+
+TEST_F(TabletLoadTrackerTest, NotEnoughSamples) {
+  FLAGS_tablet_load_split_min_samples = 100;
+  TabletLoadTracker tracker(kStart, kEnd);
+  RecordUniform(&tracker, kStart, kEnd, 99);
+  for (int i = 0; i != 100; ++i) {
+    tracker.Record(TabletLoadType::kWrite);
+  }
+  ASSERT_FALSE(tracker.LoadMedianHashCode());
+
+  tracker.Record(TabletLoadType::kWrite, kStart);
+  ASSERT_TRUE(tracker.LoadMedianHashCode());
+
+  tracker.Decay();
+  ASSERT_FALSE(tracker.LoadMedianHashCode());
+}
+
+TEST_F(TabletLoadTrackerTest, Median) {
+  FLAGS_tablet_load_split_min_samples = 1000;
+  {
+    TabletLoadTracker tracker(kStart, kEnd);
+    RecordUniform(&tracker, kStart, kEnd, 10000);
+    auto median = tracker.LoadMedianHashCode();
+    ASSERT_TRUE(median);
+    ASSERT_NEAR((kStart + kEnd) / 2, *median, 2 * kPrecision);
+  }
+  {
+    // Hot range in the first quarter of the tablet.
+    constexpr uint32_t kHotEnd = kStart + (kEnd - kStart) / 4;
+    TabletLoadTracker tracker(kStart, kEnd);
+    RecordUniform(&tracker, kStart, kHotEnd, 10000);
+    RecordUniform(&tracker, kHotEnd, kEnd, 100);
+    auto median = tracker.LoadMedianHashCode();
+    ASSERT_TRUE(median);
+    ASSERT_NEAR((kStart + kHotEnd) / 2, *median, 2 * kPrecision);
+  }
+}
+
+TEST_F(TabletLoadTrackerTest, FullRange) {
+  FLAGS_tablet_load_split_min_samples = 1000;
+  // Tablet that covers the whole hash space.
+  TabletLoadTracker tracker(0, 0x10000);
+  RecordUniform(&tracker, 0xf000, 0x10000, 10000);
+  auto median = tracker.LoadMedianHashCode();
+  ASSERT_TRUE(median);
+  ASSERT_NEAR(0xf800, *median, 0x10000 / TabletLoadTracker::kNumBuckets * 2);
+
+  // Split key should never be equal to the start of the tablet.
+  TabletLoadTracker hot_start_tracker(kStart, kEnd);
+  for (int i = 0; i != 10000; ++i) {
+    hot_start_tracker.Record(TabletLoadType::kWrite, kStart);
+  }
+  median = hot_start_tracker.LoadMedianHashCode();
+  ASSERT_TRUE(median);
+  ASSERT_GT(*median, kStart);
+  ASSERT_LT(*median, kEnd);
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/tablet_load_tracker.h"
+
+#include <glog/logging.h>
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(tablet_load_split_min_samples, 1000,
+             "Minimal number of recorded operations with hash code, required to pick split key "
+             "by the tablet load distribution.");
+TAG_FLAG(tablet_load_split_min_samples, advanced);
+TAG_FLAG(tablet_load_split_min_samples, runtime);
+
+namespace yb {
+namespace tablet {
+
+TabletLoadTracker::TabletLoadTracker(uint32_t hash_code_start, uint32_t hash_code_end)
+    : hash_code_start_(hash_code_start),
+      hash_code_end_(std::max(hash_code_end, hash_code_start + 1)) {
+  for (auto& num_ops : num_ops_) {
+    num_ops.store(0, std::memory_order_relaxed);
+  }
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t TabletLoadTracker::BucketIndex(uint32_t hash_code) const {
+  if (hash_code <= hash_code_start_) {
+    return 0;
+  }
+  if (hash_code >= hash_code_end_) {
+    return kNumBuckets - 1;
+  }
+  return static_cast<size_t>(hash_code - hash_code_start_) * kNumBuckets /
+         (hash_code_end_ - hash_code_start_);
+}
+
+void TabletLoadTracker::Record(TabletLoadType type, uint32_t hash_code) {
+  Record(type);
+  buckets_[BucketIndex(hash_code)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void TabletLoadTracker::Record(TabletLoadType type) {
+  num_ops_[to_underlying(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+boost::optional<uint16_t> TabletLoadTracker::LoadMedianHashCode() const {
+  std::array<uint64_t, kNumBuckets> buckets;
+  uint64_t total = 0;
+  for (size_t i = 0; i != kNumBuckets; ++i) {
+    buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  if (total < static_cast<uint64_t>(std::max(FLAGS_tablet_load_split_min_samples, 1))) {
+    return boost::none;
+  }
+
+  // Hash codes are assumed to be evenly distributed inside the bucket.
+  const double half = total / 2.0;
+  const double range = hash_code_end_ - hash_code_start_;
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i != kNumBuckets; ++i) {
+    if (cumulative + buckets[i] < half) {
+      cumulative += buckets[i];
+      continue;
+    }
+    const double position = i + (half - cumulative) / buckets[i];
+    // Split key is the first hash code of the second part, so it should be inside the range, but
+    // differ from its start.
+    auto result = std::max<uint32_t>(
+        hash_code_start_ + static_cast<uint32_t>(position * range / kNumBuckets),
+        hash_code_start_ + 1);
+    if (result >= hash_code_end_) {
+      return boost::none;
+    }
+    return static_cast<uint16_t>(result);
+  }
+  LOG(DFATAL) << "Load median not found, total: " << total;
+  return boost::none;
+}
+
+void TabletLoadTracker::Decay() {
+  for (auto& bucket : buckets_) {
+    // Concurrently recorded operations could be lost here, that is acceptable for load estimation.
+    bucket.store(bucket.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TABLET_LOAD_TRACKER_H
+#define YB_TABLET_TABLET_LOAD_TRACKER_H
+
+#include <atomic>
+#include <array>
+
+#include <boost/optional.hpp>
+
+#include "yb/util/enums.h"
+
+namespace yb {
+namespace tablet {
+
+YB_DEFINE_ENUM(TabletLoadType, (kRead)(kWrite));
+
+// Tracks number of read and write operations served by the tablet, and distribution of these
+// operations over hash codes of the tablet partition. Used to pick split key that splits
+// the load of a hot tablet into halves, instead of splitting its data into halves.
+class TabletLoadTracker {
+ public:
+  static constexpr size_t kNumBuckets = 64;
+
+  // Hash codes of the tablet belong to [hash_code_start, hash_code_end).
+  TabletLoadTracker(uint32_t hash_code_start, uint32_t hash_code_end);
+
+  // Records operation of specified type, that accessed a row with specified hash code.
+  void Record(TabletLoadType type, uint32_t hash_code);
+
+  // Records operation of specified type, that does not have a single hash code, i.e. a scan.
+  void Record(TabletLoadType type);
+
+  // Returns total number of operations of specified type.
+  uint64_t num_ops(TabletLoadType type) const {
+    return num_ops_[to_underlying(type)].load(std::memory_order_relaxed);
+  }
+
+  // Returns hash code that splits the recently recorded load into halves, or none if there are
+  // not enough samples or the hash code range of the tablet could not be split.
+  boost::optional<uint16_t> LoadMedianHashCode() const;
+
+  // Halves the collected distribution, so that it reflects recent load.
+  void Decay();
+
+ private:
+  size_t BucketIndex(uint32_t hash_code) const;
+
+  const uint32_t hash_code_start_;
+  const uint32_t hash_code_end_;
+  std::array<std::atomic<uint64_t>, kElementsInTabletLoadType> num_ops_;
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TABLET_LOAD_TRACKER_H
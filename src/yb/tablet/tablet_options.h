@@ -24,6 +24,8 @@
 
 #include "yb/consensus/log_fwd.h"
 
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/server/server_fwd.h"
 
 #include "yb/tablet/tablet_fwd.h"
@@ -52,6 +54,8 @@ struct TabletOptions {
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
+  // Graph of transactions blocked in wait queues of all tablets, used to detect deadlocks.
+  std::shared_ptr<docdb::WaitForGraph> wait_for_graph;
 };
 
 struct TabletInitData {
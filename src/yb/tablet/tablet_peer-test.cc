@@ -136,7 +136,8 @@ class TabletPeerTest : public YBTabletTest {
 
     multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(messenger_.get(),
                                                                         proxy_cache_.get(),
-                                                                        config_peer.cloud_info());
+                                                                        config_peer.cloud_info(),
+                                                                        nullptr);
 
     // "Bootstrap" and start the TabletPeer.
     tablet_peer_.reset(new TabletPeer(
@@ -935,6 +935,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
   }
 
   CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
+                           bool per_transaction_errors,
                            CoarseTimePoint deadline,
                            tserver::GetTransactionStatusResponsePB* response) {
     AtomicFlagSleepMs(&FLAGS_TEST_inject_txn_get_status_delay_ms);
@@ -945,21 +946,24 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
       HybridTime leader_safe_time;
       postponed_leader_actions_.leader_term = leader_term;
       for (const auto& transaction_id : transaction_ids) {
-        auto id = VERIFY_RESULT(FullyDecodeTransactionId(transaction_id));
+        auto id = FullyDecodeTransactionId(transaction_id);
+        if (!id.ok()) {
+          RETURN_NOT_OK(AddTransactionError(id.status(), per_transaction_errors, response));
+          continue;
+        }
 
-        auto it = managed_transactions_.find(id);
-        std::vector<ExpectedTabletBatches> expected_tablet_batches;
+        auto it = managed_transactions_.find(*id);
         bool known_txn = it != managed_transactions_.end();
         auto txn_status_with_ht = known_txn
-            ? VERIFY_RESULT(it->GetStatus(&expected_tablet_batches))
-            : TransactionStatusResult(TransactionStatus::ABORTED, HybridTime::kMax);
-        VLOG_WITH_PREFIX(4) << __func__ << ": " << id << " => " << txn_status_with_ht;
-        if (txn_status_with_ht.status == TransactionStatus::SEALED) {
-          // TODO(dtxn) Avoid concurrent resolve
-          txn_status_with_ht = VERIFY_RESULT(ResolveSealedStatus(
-              id, txn_status_with_ht.status_time, expected_tablet_batches,
-              /* abort_if_not_replicated = */ false, &lock));
+            ? ResolveStatus(*id, *it, &lock)
+            : Result<TransactionStatusResult>(
+                  TransactionStatusResult(TransactionStatus::ABORTED, HybridTime::kMax));
+        if (!txn_status_with_ht.ok()) {
+          RETURN_NOT_OK(AddTransactionError(
+              txn_status_with_ht.status(), per_transaction_errors, response));
+          continue;
         }
+        VLOG_WITH_PREFIX(4) << __func__ << ": " << *id << " => " << *txn_status_with_ht;
         if (!known_txn) {
           if (!leader_safe_time) {
             // We should pick leader safe time only after managed_mutex_ is locked.
@@ -972,11 +976,11 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
           response->mutable_coordinator_safe_time()->Resize(response->status().size(), 0);
           response->add_coordinator_safe_time(leader_safe_time.ToUint64());
         }
-        response->add_status(txn_status_with_ht.status);
-        response->add_status_hybrid_time(txn_status_with_ht.status_time.ToUint64());
+        response->add_status(txn_status_with_ht->status);
+        response->add_status_hybrid_time(txn_status_with_ht->status_time.ToUint64());
 
         auto mutable_aborted_set_pb = response->add_aborted_subtxn_set();
-        if (txn_status_with_ht.status == TransactionStatus::COMMITTED &&
+        if (txn_status_with_ht->status == TransactionStatus::COMMITTED &&
             it != managed_transactions_.end()) {
           *mutable_aborted_set_pb = it->GetAbortedSubTransactionSetPB();
         }
@@ -993,6 +997,40 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     return Status::OK();
   }
 
+  // Returns status of the managed transaction, resolving it when transaction is sealed.
+  Result<TransactionStatusResult> ResolveStatus(
+      const TransactionId& id, const TransactionState& transaction,
+      std::unique_lock<std::mutex>* lock) {
+    std::vector<ExpectedTabletBatches> expected_tablet_batches;
+    auto txn_status_with_ht = VERIFY_RESULT(transaction.GetStatus(&expected_tablet_batches));
+    if (txn_status_with_ht.status != TransactionStatus::SEALED) {
+      return txn_status_with_ht;
+    }
+    // TODO(dtxn) Avoid concurrent resolve
+    return ResolveSealedStatus(
+        id, txn_status_with_ht.status_time, expected_tablet_batches,
+        /* abort_if_not_replicated = */ false, lock);
+  }
+
+  // Reports that status of the transaction could not be resolved. When the client did not ask for
+  // per transaction errors, the whole request fails.
+  static CHECKED_STATUS AddTransactionError(
+      const Status& status, bool per_transaction_errors,
+      tserver::GetTransactionStatusResponsePB* response) {
+    if (!per_transaction_errors) {
+      return status;
+    }
+    auto& errors = *response->mutable_transaction_error();
+    while (errors.size() < response->status().size()) {
+      errors.Add()->set_code(AppStatusPB::OK);
+    }
+    StatusToPB(status, errors.Add());
+    response->add_status(TransactionStatus::PENDING);
+    response->add_status_hybrid_time(HybridTime::kInvalid.ToUint64());
+    response->add_aborted_subtxn_set();
+    return Status::OK();
+  }
+
   Result<TransactionStatusResult> ResolveSealedStatus(
       const TransactionId& transaction_id,
       HybridTime commit_time,
@@ -1546,9 +1584,10 @@ void TransactionCoordinator::Shutdown() {
 
 Status TransactionCoordinator::GetStatus(
     const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
+    bool per_transaction_errors,
     CoarseTimePoint deadline,
     tserver::GetTransactionStatusResponsePB* response) {
-  return impl_->GetStatus(transaction_ids, deadline, response);
+  return impl_->GetStatus(transaction_ids, per_transaction_errors, deadline, response);
 }
 
 void TransactionCoordinator::Abort(const std::string& transaction_id,
@@ -126,7 +126,10 @@ class TransactionCoordinator {
   // And like most of other Shutdowns in our codebase it wait until shutdown completes.
   void Shutdown();
 
+  // Fills statuses of specified transactions. When per_transaction_errors is true, failure to
+  // resolve status of some transaction is reported in response instead of failing whole request.
   CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
+                           bool per_transaction_errors,
                            CoarseTimePoint deadline,
                            tserver::GetTransactionStatusResponsePB* response);
 
@@ -29,8 +29,11 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/rpc/poller.h"
+#include "yb/rpc/scheduler.h"
+#include "yb/rpc/thread_pool.h"
 
 #include "yb/server/clock.h"
 
@@ -84,6 +87,11 @@ DEFINE_uint64(max_transactions_in_status_request, 128,
 
 DEFINE_uint64(transactions_cleanup_cache_size, 256, "Transactions cleanup cache size.");
 
+DEFINE_uint64(transactions_status_cache_size, 1024,
+              "Number of transactions with known final status, that participant caches to answer "
+              "status requests without locking. 0 disables the cache.");
+TAG_FLAG(transactions_status_cache_size, advanced);
+
 DEFINE_uint64(transactions_status_poll_interval_ms, 500 * yb::kTimeMultiplier,
               "Transactions poll interval.");
 
@@ -115,14 +123,56 @@ std::string TransactionApplyData::ToString() const {
       leader_term, transaction_id, op_id, commit_ht, log_ht, sealed, status_tablet, apply_state);
 }
 
+// Resumes waiter of the wait queue in the thread pool of the participant context.
+class ResumeWaiterTask : public rpc::ThreadPoolTask {
+ public:
+  ResumeWaiterTask(docdb::WaitDoneCallback callback, const Status& status)
+      : callback_(std::move(callback)), status_(status) {}
+
+  void Run() override {
+    auto callback = std::move(callback_);
+    callback_ = nullptr;
+    callback(status_);
+  }
+
+  void Done(const Status& status) override {
+    if (callback_) {
+      // Task was not executed, so resume waiter with failure.
+      callback_(status);
+    }
+    delete this;
+  }
+
+  virtual ~ResumeWaiterTask() = default;
+
+ private:
+  docdb::WaitDoneCallback callback_;
+  Status status_;
+};
+
 class TransactionParticipant::Impl
     : public RunningTransactionContext, public TransactionLoaderContext {
  public:
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
-       const scoped_refptr<MetricEntity>& entity)
-      : RunningTransactionContext(context, applier),
+       const scoped_refptr<MetricEntity>& entity, docdb::WaitForGraph* wait_for_graph)
+      : RunningTransactionContext(context, applier, FLAGS_transactions_status_cache_size),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
+        wait_queue_(
+            wait_for_graph,
+            [context](const docdb::WaitDoneCallback& callback, const Status& status,
+                      MonoDelta delay) {
+              if (delay <= MonoDelta::kZero) {
+                context->Enqueue(new ResumeWaiterTask(callback, status));
+                return;
+              }
+              context->scheduler().Schedule(
+                  [context, callback, status](const Status& scheduler_status) {
+                context->Enqueue(new ResumeWaiterTask(
+                    callback, scheduler_status.ok() ? status : scheduler_status));
+              }, delay.ToSteadyDuration());
+            },
+            entity, log_prefix_),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
@@ -145,6 +195,7 @@ class TransactionParticipant::Impl
     }
 
     poller_.Shutdown();
+    wait_queue_.StartShutdown();
 
     if (start_latch_.count()) {
       start_latch_.CountDown();
@@ -223,6 +274,10 @@ class TransactionParticipant::Impl
   }
 
   HybridTime LocalCommitTime(const TransactionId& id) {
+    auto finished = finished_transactions_cache_.Get(id);
+    if (finished && finished->status == TransactionStatus::COMMITTED) {
+      return finished->status_time;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -232,6 +287,14 @@ class TransactionParticipant::Impl
   }
 
   boost::optional<CommitMetadata> LocalCommitData(const TransactionId& id) {
+    auto finished = finished_transactions_cache_.Get(id);
+    if (finished && finished->status == TransactionStatus::COMMITTED) {
+      // Only transactions without aborted subtransactions are cached.
+      return CommitMetadata {
+        .commit_ht = finished->status_time,
+        .aborted_subtxn_set = AbortedSubTransactionSet(),
+      };
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -326,6 +389,17 @@ class TransactionParticipant::Impl
   }
 
   void RequestStatusAt(const StatusRequest& request) {
+    if (use_finished_transactions_cache_.load(std::memory_order_acquire)) {
+      auto finished = finished_transactions_cache_.Get(*request.id);
+      if (finished) {
+        auto status = RunningTransaction::GetStatusAt(
+            request.global_limit_ht, finished->status_time, finished->status);
+        if (status) {
+          request.callback(TransactionStatusResult{*status, finished->status_time});
+          return;
+        }
+      }
+    }
     auto lock_and_iterator = LockAndFind(*request.id, *request.reason, request.flags);
     if (!lock_and_iterator.found()) {
       request.callback(
@@ -687,6 +761,10 @@ class TransactionParticipant::Impl
     }
   }
 
+  docdb::WaitQueue& wait_queue() {
+    return wait_queue_;
+  }
+
   TransactionParticipantContext* participant_context() const {
     return &participant_context_;
   }
@@ -928,6 +1006,9 @@ class TransactionParticipant::Impl
   }
 
   void IgnoreAllTransactionsStartedBefore(HybridTime limit) {
+    // Finished transactions cache does not know start times of transactions, so it cannot filter
+    // out ignored transactions.
+    use_finished_transactions_cache_.store(false, std::memory_order_release);
     std::lock_guard<std::mutex> lock(mutex_);
     ignore_all_transactions_started_before_ =
         std::max(ignore_all_transactions_started_before_, limit);
@@ -1263,6 +1344,7 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    wait_queue_.SignalFinished(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1408,6 +1490,7 @@ class TransactionParticipant::Impl
       CleanTransactionsQueue(&graceful_cleanup_queue_, &min_running_notifier);
     }
     CleanupStatusResolvers();
+    wait_queue_.Poll(CoarseMonoClock::now());
   }
 
   void CheckForAbortedTransactions() REQUIRES(mutex_) {
@@ -1525,6 +1608,7 @@ class TransactionParticipant::Impl
   HybridTime last_safe_time_ = HybridTime::kMin;
 
   HybridTime ignore_all_transactions_started_before_ GUARDED_BY(mutex_) = HybridTime::kMin;
+  std::atomic<bool> use_finished_transactions_cache_{true};
 
   std::unordered_set<TransactionId, TransactionIdHash> recently_removed_transactions_;
   struct RecentlyRemovedTransaction {
@@ -1552,13 +1636,15 @@ class TransactionParticipant::Impl
 
   LRUCache<TransactionId> cleanup_cache_{FLAGS_transactions_cleanup_cache_size};
 
+  docdb::WaitQueue wait_queue_;
+
   rpc::Poller poller_;
 };
 
 TransactionParticipant::TransactionParticipant(
     TransactionParticipantContext* context, TransactionIntentApplier* applier,
-    const scoped_refptr<MetricEntity>& entity)
-    : impl_(new Impl(context, applier, entity)) {
+    const scoped_refptr<MetricEntity>& entity, docdb::WaitForGraph* wait_for_graph)
+    : impl_(new Impl(context, applier, entity, wait_for_graph)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -1656,6 +1742,10 @@ void TransactionParticipant::GetStatus(
   impl_->GetStatus(transaction_id, required_num_replicated_batches, term, response, context);
 }
 
+docdb::WaitQueue* TransactionParticipant::wait_queue() const {
+  return &impl_->wait_queue();
+}
+
 TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
@@ -104,7 +104,7 @@ class TransactionParticipant : public TransactionStatusManager {
  public:
   TransactionParticipant(
       TransactionParticipantContext* context, TransactionIntentApplier* applier,
-      const scoped_refptr<MetricEntity>& entity);
+      const scoped_refptr<MetricEntity>& entity, docdb::WaitForGraph* wait_for_graph);
   virtual ~TransactionParticipant();
 
   // Notify participant that this context is ready and it could start performing its requests.
@@ -171,6 +171,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Queue of transactional writes waiting for conflicting transactions of this tablet to finish.
+  docdb::WaitQueue* wait_queue() const;
+
   HybridTime MinRunningHybridTime() const override;
 
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
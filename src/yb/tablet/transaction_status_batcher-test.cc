@@ -0,0 +1,299 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/common/wire_protocol.h"
+#include "yb/common/wire_protocol.pb.h"
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(max_in_flight_transaction_status_requests);
+DECLARE_uint64(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const TabletId kStatusTablet = "status_tablet";
+
+struct SentRequest {
+  std::vector<TransactionId> transaction_ids;
+  bool per_transaction_errors;
+  TransactionStatusBatchCallback callback;
+};
+
+struct ReceivedStatus {
+  Status status;
+  tserver::GetTransactionStatusResponsePB response;
+};
+
+} // namespace
+
+class TransactionStatusBatcherTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    batcher_ = std::make_unique<TransactionStatusBatcher>(
+        [this](tserver::GetTransactionStatusRequestPB* req,
+               TransactionStatusBatchCallback callback) {
+          ASSERT_EQ(kStatusTablet, req->tablet_id());
+          SentRequest request;
+          for (const auto& id : req->transaction_id()) {
+            request.transaction_ids.push_back(ASSERT_RESULT(FullyDecodeTransactionId(id)));
+          }
+          request.per_transaction_errors = req->per_transaction_errors();
+          request.callback = std::move(callback);
+          sent_.push_back(std::move(request));
+        });
+  }
+
+  void Send(const TransactionId& id) {
+    batcher_->Send(kStatusTablet, id, [this, id](
+        const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+      received_[id].push_back(ReceivedStatus {
+        .status = status,
+        .response = response,
+      });
+    });
+  }
+
+  // Completes the oldest sent request, answering it with one status per requested transaction.
+  void Respond(const std::vector<TransactionStatus>& statuses) {
+    ASSERT_FALSE(sent_.empty());
+    auto request = std::move(sent_.front());
+    sent_.pop_front();
+    tserver::GetTransactionStatusResponsePB response;
+    response.set_propagated_hybrid_time(HybridTime(1000).ToUint64());
+    for (size_t i = 0; i != statuses.size(); ++i) {
+      response.add_status(statuses[i]);
+      response.add_status_hybrid_time(HybridTime(100 + i).ToUint64());
+      response.add_aborted_subtxn_set();
+    }
+    Respond(&request, Status::OK(), response);
+  }
+
+  void Respond(
+      SentRequest* request, const Status& status,
+      const tserver::GetTransactionStatusResponsePB& response) {
+    request->callback(status, response);
+  }
+
+  SentRequest PopSent() {
+    auto result = std::move(sent_.front());
+    sent_.pop_front();
+    return result;
+  }
+
+  std::unique_ptr<TransactionStatusBatcher> batcher_;
+  std::deque<SentRequest> sent_;
+  std::unordered_map<TransactionId, std::vector<ReceivedStatus>, TransactionIdHash> received_;
+};
+
+TEST_F(TransactionStatusBatcherTest, Coalesce) {
+  FLAGS_max_in_flight_transaction_status_requests = 1;
+  FLAGS_max_transactions_in_status_request = 2;
+
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 4; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    Send(ids.back());
+  }
+
+  // Only the first request is sent, the others wait for it.
+  ASSERT_EQ(1U, sent_.size());
+  ASSERT_EQ(std::vector<TransactionId>{ids[0]}, sent_.front().transaction_ids);
+  ASSERT_TRUE(sent_.front().per_transaction_errors);
+
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  ASSERT_EQ(1U, sent_.size());
+  ASSERT_EQ((std::vector<TransactionId>{ids[1], ids[2]}), sent_.front().transaction_ids);
+
+  ASSERT_NO_FATALS(Respond({TransactionStatus::PENDING, TransactionStatus::ABORTED}));
+  ASSERT_EQ(1U, sent_.size());
+  ASSERT_EQ(std::vector<TransactionId>{ids[3]}, sent_.front().transaction_ids);
+
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  ASSERT_TRUE(sent_.empty());
+
+  const TransactionStatus expected[] = {
+      TransactionStatus::COMMITTED, TransactionStatus::PENDING, TransactionStatus::ABORTED,
+      TransactionStatus::COMMITTED };
+  for (size_t i = 0; i != ids.size(); ++i) {
+    const auto& received = received_[ids[i]];
+    ASSERT_EQ(1U, received.size());
+    ASSERT_OK(received[0].status);
+    const auto& response = received[0].response;
+    ASSERT_EQ(1, response.status().size());
+    ASSERT_EQ(expected[i], response.status(0));
+    ASSERT_EQ(1, response.status_hybrid_time().size());
+    ASSERT_EQ(1, response.aborted_subtxn_set().size());
+    ASSERT_EQ(HybridTime(1000).ToUint64(), response.propagated_hybrid_time());
+  }
+  ASSERT_EQ(HybridTime(101).ToUint64(), received_[ids[2]][0].response.status_hybrid_time(0));
+}
+
+TEST_F(TransactionStatusBatcherTest, MultipleInFlight) {
+  FLAGS_max_in_flight_transaction_status_requests = 2;
+
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 4; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    Send(ids.back());
+  }
+
+  // Slow response to the first request does not delay the second one.
+  ASSERT_EQ(2U, sent_.size());
+  auto slow = PopSent();
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  ASSERT_EQ(1U, received_[ids[1]].size());
+  ASSERT_EQ(1U, sent_.size());
+  ASSERT_EQ((std::vector<TransactionId>{ids[2], ids[3]}), sent_.front().transaction_ids);
+
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED, TransactionStatus::COMMITTED}));
+  ASSERT_EQ(1U, received_[ids[2]].size());
+  ASSERT_EQ(1U, received_[ids[3]].size());
+  ASSERT_TRUE(received_[ids[0]].empty());
+
+  tserver::GetTransactionStatusResponsePB response;
+  response.add_status(TransactionStatus::ABORTED);
+  response.add_status_hybrid_time(HybridTime::kMax.ToUint64());
+  response.add_aborted_subtxn_set();
+  Respond(&slow, Status::OK(), response);
+  ASSERT_EQ(1U, received_[ids[0]].size());
+  ASSERT_TRUE(sent_.empty());
+
+  // Both in flight requests have completed, so the next status is sent immediately.
+  Send(TransactionId::GenerateRandom());
+  ASSERT_EQ(1U, sent_.size());
+}
+
+TEST_F(TransactionStatusBatcherTest, TransactionError) {
+  FLAGS_max_in_flight_transaction_status_requests = 1;
+
+  auto first_id = TransactionId::GenerateRandom();
+  Send(first_id);
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 3; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    Send(ids.back());
+  }
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  ASSERT_EQ(1U, sent_.size());
+  auto request = PopSent();
+  ASSERT_EQ(ids, request.transaction_ids);
+  ASSERT_TRUE(request.per_transaction_errors);
+
+  // Coordinator failed to resolve status of the second transaction only.
+  tserver::GetTransactionStatusResponsePB response;
+  for (size_t i = 0; i != ids.size(); ++i) {
+    response.add_status(i == 1 ? TransactionStatus::PENDING : TransactionStatus::COMMITTED);
+    response.add_status_hybrid_time(HybridTime(100 + i).ToUint64());
+    response.add_aborted_subtxn_set();
+  }
+  response.add_transaction_error()->set_code(AppStatusPB::OK);
+  StatusToPB(STATUS(TimedOut, "Resolve sealed status timed out"),
+             response.add_transaction_error());
+  Respond(&request, Status::OK(), response);
+
+  for (size_t i = 0; i != ids.size(); ++i) {
+    const auto& received = received_[ids[i]];
+    ASSERT_EQ(1U, received.size());
+    if (i == 1) {
+      ASSERT_TRUE(received[0].status.IsTimedOut()) << received[0].status;
+      ASSERT_EQ(0, received[0].response.status().size());
+    } else {
+      ASSERT_OK(received[0].status);
+      ASSERT_EQ(1, received[0].response.status().size());
+      ASSERT_EQ(TransactionStatus::COMMITTED, received[0].response.status(0));
+    }
+  }
+}
+
+TEST_F(TransactionStatusBatcherTest, RequestError) {
+  FLAGS_max_in_flight_transaction_status_requests = 1;
+
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 3; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    Send(ids.back());
+  }
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  auto request = PopSent();
+  Respond(&request, STATUS(NetworkError, "Connection reset"),
+          tserver::GetTransactionStatusResponsePB());
+
+  // Failure of the whole RPC is reported to every transaction of the batch.
+  for (size_t i = 1; i != ids.size(); ++i) {
+    const auto& received = received_[ids[i]];
+    ASSERT_EQ(1U, received.size());
+    ASSERT_TRUE(received[0].status.IsNetworkError()) << received[0].status;
+  }
+  ASSERT_TRUE(sent_.empty());
+}
+
+TEST_F(TransactionStatusBatcherTest, OldCoordinatorFallback) {
+  FLAGS_max_in_flight_transaction_status_requests = 1;
+
+  auto first_id = TransactionId::GenerateRandom();
+  Send(first_id);
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 3; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    Send(ids.back());
+  }
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  ASSERT_EQ(1U, sent_.size());
+  ASSERT_EQ(ids, sent_.front().transaction_ids);
+
+  // Coordinator of old version answers only for the first transaction of the batch.
+  ASSERT_NO_FATALS(Respond({TransactionStatus::COMMITTED}));
+  for (const auto& id : ids) {
+    ASSERT_TRUE(received_[id].empty());
+  }
+
+  // So statuses are requested one by one.
+  ASSERT_EQ(ids.size(), sent_.size());
+  for (size_t i = 0; i != ids.size(); ++i) {
+    ASSERT_EQ(std::vector<TransactionId>{ids[i]}, sent_[i].transaction_ids);
+  }
+  const TransactionStatus statuses[] = {
+      TransactionStatus::COMMITTED, TransactionStatus::ABORTED, TransactionStatus::PENDING };
+  for (auto status : statuses) {
+    ASSERT_NO_FATALS(Respond({status}));
+  }
+  ASSERT_TRUE(sent_.empty());
+  for (size_t i = 0; i != ids.size(); ++i) {
+    const auto& received = received_[ids[i]];
+    ASSERT_EQ(1U, received.size());
+    ASSERT_OK(received[0].status);
+    ASSERT_EQ(1, received[0].response.status().size());
+    ASSERT_EQ(statuses[i], received[0].response.status(0));
+  }
+
+  // Fallback requests are not queued, so the next status is sent immediately.
+  Send(TransactionId::GenerateRandom());
+  ASSERT_EQ(1U, sent_.size());
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,207 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/wire_protocol.h"
+#include "yb/common/wire_protocol.pb.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/tablet/transaction_participant_context.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/status.h"
+
+DEFINE_uint64(max_in_flight_transaction_status_requests, 4,
+              "Max number of batched transaction status requests to the same status tablet, "
+              "that could be in flight at the same time.");
+TAG_FLAG(max_in_flight_transaction_status_requests, advanced);
+TAG_FLAG(max_in_flight_transaction_status_requests, runtime);
+
+DECLARE_uint64(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+TransactionStatusRequestSender RpcSender(
+    TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs) {
+  return [participant_context, rpcs](
+      tserver::GetTransactionStatusRequestPB* req, TransactionStatusBatchCallback callback) {
+    auto handle = rpcs->Prepare();
+    if (handle == rpcs->InvalidHandle()) {
+      callback(STATUS(Aborted, "Aborted because of shutdown"),
+               tserver::GetTransactionStatusResponsePB());
+      return;
+    }
+    req->set_propagated_hybrid_time(participant_context->Now().ToUint64());
+    *handle = client::GetTransactionStatus(
+        TransactionRpcDeadline(),
+        nullptr /* tablet */,
+        participant_context->client_future().get(),
+        req,
+        [rpcs, handle, callback = std::move(callback)](
+            const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+          callback(status, response);
+          // Unregister after batch is processed, so shutdown would wait for it.
+          rpcs->Unregister(handle);
+        });
+    (**handle).SendRpc();
+  };
+}
+
+} // namespace
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs)
+    : TransactionStatusBatcher(RpcSender(participant_context, rpcs)) {
+}
+
+TransactionStatusBatcher::TransactionStatusBatcher(TransactionStatusRequestSender sender)
+    : sender_(std::move(sender)) {
+}
+
+TransactionStatusBatcher::~TransactionStatusBatcher() = default;
+
+void TransactionStatusBatcher::Send(
+    const TabletId& status_tablet, const TransactionId& transaction_id,
+    TransactionStatusBatchCallback callback) {
+  std::vector<Waiter> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = queues_[status_tablet];
+    queue.waiters.push_back(Waiter {
+      .transaction_id = transaction_id,
+      .callback = std::move(callback),
+    });
+    if (queue.in_flight >= std::max<uint64_t>(FLAGS_max_in_flight_transaction_status_requests, 1)) {
+      return;
+    }
+    ++queue.in_flight;
+    batch = TakeBatchUnlocked(&queue);
+  }
+  SendBatch(status_tablet, std::move(batch), /* queued= */ true);
+}
+
+std::vector<TransactionStatusBatcher::Waiter> TransactionStatusBatcher::TakeBatchUnlocked(
+    Queue* queue) {
+  auto batch_size = std::min<size_t>(
+      std::max<uint64_t>(FLAGS_max_transactions_in_status_request, 1), queue->waiters.size());
+  if (batch_size == queue->waiters.size()) {
+    return std::move(queue->waiters);
+  }
+  std::vector<Waiter> result(
+      std::make_move_iterator(queue->waiters.begin()),
+      std::make_move_iterator(queue->waiters.begin() + batch_size));
+  queue->waiters.erase(queue->waiters.begin(), queue->waiters.begin() + batch_size);
+  return result;
+}
+
+void TransactionStatusBatcher::SendBatch(
+    const TabletId& status_tablet, std::vector<Waiter> batch, bool queued) {
+  auto shared_batch = std::make_shared<std::vector<Waiter>>(std::move(batch));
+  tserver::GetTransactionStatusRequestPB req;
+  req.set_tablet_id(status_tablet);
+  for (const auto& waiter : *shared_batch) {
+    const auto& id = waiter.transaction_id;
+    req.add_transaction_id()->assign(pointer_cast<const char*>(id.data()), id.size());
+  }
+  req.set_per_transaction_errors(true);
+  sender_(
+      &req,
+      [this, status_tablet, shared_batch, queued](
+          const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+        BatchDone(status_tablet, shared_batch.get(), queued, status, response);
+      });
+}
+
+void TransactionStatusBatcher::BatchDone(
+    const TabletId& status_tablet, std::vector<Waiter>* batch, bool queued, const Status& status,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  if (queued) {
+    std::vector<Waiter> next_batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_[status_tablet];
+      if (queue.waiters.empty()) {
+        --queue.in_flight;
+      } else {
+        next_batch = TakeBatchUnlocked(&queue);
+      }
+    }
+    if (!next_batch.empty()) {
+      SendBatch(status_tablet, std::move(next_batch), /* queued= */ true);
+    }
+  }
+
+  if (!status.ok()) {
+    for (const auto& waiter : *batch) {
+      waiter.callback(status, response);
+    }
+    return;
+  }
+
+  const auto batch_size = batch->size();
+  if (static_cast<size_t>(response.status().size()) != batch_size ||
+      static_cast<size_t>(response.status_hybrid_time().size()) != batch_size ||
+      static_cast<size_t>(response.aborted_subtxn_set().size()) != batch_size) {
+    if (batch_size == 1) {
+      (*batch)[0].callback(status, response);
+      return;
+    }
+    // Coordinator with old software version returns only one status, so fall back to requesting
+    // statuses one by one.
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "Bad batched transaction status response size, expected " << batch_size
+        << " entries: " << response.ShortDebugString();
+    for (const auto& waiter : *batch) {
+      SendBatch(status_tablet, std::vector<Waiter>{waiter}, /* queued= */ false);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i != batch_size; ++i) {
+    tserver::GetTransactionStatusResponsePB waiter_response;
+    if (response.has_propagated_hybrid_time()) {
+      waiter_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+    }
+    // Coordinator fills errors only up to the last failed transaction.
+    if (i < static_cast<size_t>(response.transaction_error().size()) &&
+        response.transaction_error(i).code() != AppStatusPB::OK) {
+      (*batch)[i].callback(StatusFromPB(response.transaction_error(i)), waiter_response);
+      continue;
+    }
+    waiter_response.add_status(response.status(i));
+    waiter_response.add_status_hybrid_time(response.status_hybrid_time(i));
+    *waiter_response.add_aborted_subtxn_set() = response.aborted_subtxn_set(i);
+    // Coordinator fills safe time only up to the last unknown transaction.
+    if (i < static_cast<size_t>(response.coordinator_safe_time().size())) {
+      waiter_response.add_coordinator_safe_time(response.coordinator_safe_time(i));
+    }
+    (*batch)[i].callback(status, waiter_response);
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+#define YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/entity_ids_types.h"
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+namespace tserver {
+
+class GetTransactionStatusRequestPB;
+class GetTransactionStatusResponsePB;
+
+} // namespace tserver
+
+namespace tablet {
+
+class TransactionParticipantContext;
+
+using TransactionStatusBatchCallback = std::function<void(
+    const Status&, const tserver::GetTransactionStatusResponsePB&)>;
+
+// Sends GetTransactionStatus request and invokes callback with the response.
+using TransactionStatusRequestSender = std::function<void(
+    tserver::GetTransactionStatusRequestPB*, TransactionStatusBatchCallback)>;
+
+// Combines status requests for transactions with the same status tablet into a single
+// GetTransactionStatus RPC.
+//
+// At most --max_in_flight_transaction_status_requests requests per status tablet are in flight.
+// Requests that arrive while all of them are in flight are queued, and sent together in the next
+// RPC when one of the previous completes. So a burst of readers that need statuses of different
+// transactions results in a few RPCs to the coordinator, while a single slow response does not
+// delay all other status requests to the same status tablet.
+class TransactionStatusBatcher {
+ public:
+  TransactionStatusBatcher(TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs);
+
+  // Sends requests using provided sender instead of RPC, used in tests.
+  explicit TransactionStatusBatcher(TransactionStatusRequestSender sender);
+
+  ~TransactionStatusBatcher();
+
+  // Requests status of the transaction from its status tablet. Callback is always invoked, with
+  // response that contains only the entries for this transaction. Failure to resolve status of
+  // this transaction is passed to callback as error status.
+  void Send(const TabletId& status_tablet, const TransactionId& transaction_id,
+            TransactionStatusBatchCallback callback);
+
+ private:
+  struct Waiter {
+    TransactionId transaction_id;
+    TransactionStatusBatchCallback callback;
+  };
+
+  struct Queue {
+    size_t in_flight = 0;
+    std::vector<Waiter> waiters;
+  };
+
+  std::vector<Waiter> TakeBatchUnlocked(Queue* queue);
+
+  // Sends batch to the status tablet. When queued is true this batch was taken from the queue,
+  // so the next batch from the queue is sent when it completes.
+  void SendBatch(const TabletId& status_tablet, std::vector<Waiter> batch, bool queued);
+
+  void BatchDone(const TabletId& status_tablet, std::vector<Waiter>* batch, bool queued,
+                 const Status& status, const tserver::GetTransactionStatusResponsePB& response);
+
+  TransactionStatusRequestSender sender_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, Queue> queues_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_BATCHER_H
@@ -24,6 +24,7 @@
 #include "yb/common/index.h"
 #include "yb/common/row_mark.h"
 #include "yb/common/schema.h"
+#include "yb/common/transaction_error.h"
 
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/cql_operation.h"
@@ -34,6 +35,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_load_tracker.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/write_query_context.h"
@@ -76,6 +78,15 @@ void SetupKeyValueBatch(const tserver::WriteRequestPB& client_request, WritePB*
   }
 }
 
+template <class Request>
+void RecordWriteLoad(const Request& req, TabletLoadTracker* load_tracker) {
+  if (req.has_hash_code()) {
+    load_tracker->Record(TabletLoadType::kWrite, req.hash_code());
+  } else {
+    load_tracker->Record(TabletLoadType::kWrite);
+  }
+}
+
 } // namespace
 
 enum class WriteQuery::ExecuteMode {
@@ -286,6 +297,7 @@ Result<bool> WriteQuery::CqlPrepareExecute() {
       &request().write_batch().subtransaction()));
   auto table_info = metadata.primary_table_info();
   for (const auto& req : ql_write_batch) {
+    RecordWriteLoad(req, &tablet().load_tracker());
     QLResponsePB* resp = response_->add_ql_response_batch();
     if (!IsSchemaVersionCompatible(
             table_info->schema_version, req.schema_version(),
@@ -334,6 +346,7 @@ Result<bool> WriteQuery::PgsqlPrepareExecute() {
   bool colocated = metadata.colocated();
 
   for (const auto& req : pgsql_write_batch) {
+    RecordWriteLoad(req, &tablet().load_tracker());
     PgsqlResponsePB* resp = response_->add_pgsql_response_batch();
     // Table-level tombstones should not be requested for non-colocated tables.
     if ((req.stmt_type() == PgsqlWriteRequestPB::PGSQL_TRUNCATE_COLOCATED) && !colocated) {
@@ -466,8 +479,18 @@ CHECKED_STATUS WriteQuery::DoExecute() {
       read_time_ ? read_time_.read : HybridTime::kMax,
       tablet().doc_db(), partial_range_key_intents,
       transaction_participant, tablet().metrics()->transaction_conflicts.get(),
+      transaction_participant ? transaction_participant->wait_queue() : nullptr,
+      &prepare_result_.lock_batch, tablet().clock().get(), deadline(),
       [this](const Result<HybridTime>& result) {
         if (!result.ok()) {
+          if (TransactionError(result.status()) == TransactionErrorCode::kReadRestartRequired) {
+            // Conflicting transactions were committed after our read time, while we were waiting
+            // for them. So report read restart, for the operation to be restarted at a new time.
+            restart_read_ht_ = tablet().clock()->Now();
+            ExecuteDone(Status::OK());
+            TRACE("ExecuteDone");
+            return;
+          }
           ExecuteDone(result.status());
           TRACE("ExecuteDone");
           return;
@@ -13,6 +13,10 @@
 
 #include "yb/tserver/pg_client_service.h"
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -35,9 +39,13 @@
 #include "yb/rpc/scheduler.h"
 
 #include "yb/tserver/pg_client_session.h"
+#include "yb/tserver/tserver_shared_mem.h"
 
+#include "yb/util/cast.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/status.h"
@@ -47,6 +55,22 @@ using namespace std::literals;
 DEFINE_uint64(pg_client_session_expiration_ms, 60000,
               "Pg client session expiration time in milliseconds.");
 
+DEFINE_bool(pg_client_use_shared_memory, true,
+            "Pass large responses of PgClientService to local postgres backends through shared "
+            "memory instead of the socket.");
+TAG_FLAG(pg_client_use_shared_memory, advanced);
+TAG_FLAG(pg_client_use_shared_memory, runtime);
+
+DEFINE_uint64(pg_client_shared_memory_min_response_bytes, 4_KB,
+              "Minimal size of PgClientService response that is passed through shared memory. "
+              "Smaller responses are cheaper to send over the socket.");
+TAG_FLAG(pg_client_shared_memory_min_response_bytes, advanced);
+TAG_FLAG(pg_client_shared_memory_min_response_bytes, runtime);
+
+DEFINE_test_flag(bool, pg_client_overwrite_shared_mem_response, false,
+                 "Invalidate the response right after it was written to shared memory, as if it "
+                 "was overwritten by subsequent responses before the backend read it.");
+
 namespace yb {
 namespace tserver {
 
@@ -114,10 +138,17 @@ class PgClientServiceImpl::Impl {
   explicit Impl(
       const std::shared_future<client::YBClient*>& client_future,
       TransactionPoolProvider transaction_pool_provider,
+      TServerSharedData* shared_data,
       rpc::Scheduler* scheduler)
       : client_future_(client_future),
         transaction_pool_provider_(std::move(transaction_pool_provider)),
+        shared_data_(shared_data),
         check_expired_sessions_(scheduler) {
+    if (shared_data_) {
+      for (size_t slot = kPgClientSharedMemSlots; slot-- > 0;) {
+        free_shared_mem_slots_.push_back(slot);
+      }
+    }
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
 
@@ -137,6 +168,13 @@ class PgClientServiceImpl::Impl {
     sessions_.emplace(
         FLAGS_pg_client_session_expiration_ms * 1ms,
         std::make_shared<PgClientSession>(&client(), session_id));
+    if (req.use_shared_mem() && FLAGS_pg_client_use_shared_memory &&
+        !free_shared_mem_slots_.empty()) {
+      auto slot = free_shared_mem_slots_.back();
+      free_shared_mem_slots_.pop_back();
+      session_shared_mem_slots_.emplace(session_id, slot);
+      resp->mutable_shared_mem_slot()->set_index(static_cast<uint32_t>(slot));
+    }
     return Status::OK();
   }
 
@@ -154,6 +192,7 @@ class PgClientServiceImpl::Impl {
       *resp->mutable_partitions()->mutable_keys()->Add() = key;
     }
 
+    MoveResponseToSharedMem(req.session_id(), resp);
     return Status::OK();
   }
 
@@ -353,15 +392,64 @@ class PgClientServiceImpl::Impl {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& index = sessions_.get<ExpirationTag>();
     while (!sessions_.empty() && index.begin()->expiration() < now) {
+      auto it = session_shared_mem_slots_.find(index.begin()->value()->id());
+      if (it != session_shared_mem_slots_.end()) {
+        free_shared_mem_slots_.push_back(it->second);
+        session_shared_mem_slots_.erase(it);
+      }
       index.erase(index.begin());
     }
     ScheduleCheckExpiredSessions(now);
   }
 
+  // Serializes the response to the shared memory ring of the session, if the session has one and
+  // the response is large enough. Only the reference to the serialized response is left in resp.
+  template <class Resp>
+  void MoveResponseToSharedMem(uint64_t session_id, Resp* resp) {
+    if (!session_id || !FLAGS_pg_client_use_shared_memory) {
+      return;
+    }
+    const auto size = resp->ByteSizeLong();
+    if (size < FLAGS_pg_client_shared_memory_min_response_bytes) {
+      return;
+    }
+    size_t slot;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = session_shared_mem_slots_.find(session_id);
+      if (it == session_shared_mem_slots_.end()) {
+        return;
+      }
+      slot = it->second;
+    }
+
+    // Requests of the same session could overlap, when the client retries after timeout.
+    std::lock_guard<std::mutex> lock(shared_mem_write_mutexes_[slot]);
+    uint64_t position;
+    auto* out = shared_data_->pg_client_ring(slot).Allocate(size, &position);
+    if (!out) {
+      return;
+    }
+    resp->SerializeWithCachedSizesToArray(pointer_cast<uint8_t*>(out));
+    if (FLAGS_TEST_pg_client_overwrite_shared_mem_response) {
+      uint64_t overwrite_position;
+      shared_data_->pg_client_ring(slot).Allocate(kPgClientSharedMemRingSize, &overwrite_position);
+    }
+    resp->Clear();
+    auto& shared_mem_response = *resp->mutable_shared_mem_response();
+    shared_mem_response.set_position(position);
+    shared_mem_response.set_size(size);
+  }
+
   std::shared_future<client::YBClient*> client_future_;
   TransactionPoolProvider transaction_pool_provider_;
+  TServerSharedData* const shared_data_;
   std::mutex mutex_;
 
+  std::vector<size_t> free_shared_mem_slots_ GUARDED_BY(mutex_);
+  std::unordered_map<uint64_t, size_t> session_shared_mem_slots_ GUARDED_BY(mutex_);
+  std::array<std::mutex, kPgClientSharedMemSlots> shared_mem_write_mutexes_;
+
   class ExpirationTag;
 
   using SessionsEntry = Expirable<std::shared_ptr<PgClientSession>>;
@@ -390,9 +478,11 @@ PgClientServiceImpl::PgClientServiceImpl(
     const std::shared_future<client::YBClient*>& client_future,
     TransactionPoolProvider transaction_pool_provider,
     const scoped_refptr<MetricEntity>& entity,
+    TServerSharedData* shared_data,
     rpc::Scheduler* scheduler)
     : PgClientServiceIf(entity),
-      impl_(new Impl(client_future, std::move(transaction_pool_provider), scheduler)) {}
+      impl_(new Impl(
+          client_future, std::move(transaction_pool_provider), shared_data, scheduler)) {}
 
 PgClientServiceImpl::~PgClientServiceImpl() {}
 
@@ -21,6 +21,7 @@
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tserver/pg_client.service.h"
+#include "yb/tserver/tserver_util_fwd.h"
 
 namespace yb {
 namespace tserver {
@@ -40,6 +41,7 @@ class PgClientServiceImpl : public PgClientServiceIf {
       const std::shared_future<client::YBClient*>& client_future,
       TransactionPoolProvider transaction_pool_provider,
       const scoped_refptr<MetricEntity>& entity,
+      TServerSharedData* shared_data,
       rpc::Scheduler* scheduler);
 
   ~PgClientServiceImpl();
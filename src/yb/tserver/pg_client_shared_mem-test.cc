@@ -0,0 +1,78 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yb/tserver/pg_client_shared_mem.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tserver {
+
+class PgSharedMemRingTest : public YBTest {
+ protected:
+  // Writes value to the ring and returns its position.
+  uint64_t Write(const std::string& value) {
+    uint64_t position = 0;
+    auto* out = ring_->Allocate(value.size(), &position);
+    EXPECT_NE(out, nullptr);
+    memcpy(out, value.data(), value.size());
+    return position;
+  }
+
+  std::unique_ptr<PgSharedMemRing> ring_ = std::make_unique<PgSharedMemRing>();
+};
+
+TEST_F(PgSharedMemRingTest, ReadWrite) {
+  auto position1 = Write("first");
+  auto position2 = Write("second");
+  ASSERT_EQ(ASSERT_RESULT(ring_->Get(position1, 5)).ToBuffer(), "first");
+  ASSERT_EQ(ASSERT_RESULT(ring_->Get(position2, 6)).ToBuffer(), "second");
+  ASSERT_TRUE(ring_->IsValid(position1));
+}
+
+TEST_F(PgSharedMemRingTest, TooLarge) {
+  uint64_t position = 0;
+  ASSERT_EQ(ring_->Allocate(kPgClientSharedMemRingSize + 1, &position), nullptr);
+}
+
+TEST_F(PgSharedMemRingTest, Overwrite) {
+  const std::string large(kPgClientSharedMemRingSize / 2 + 1, 'x');
+  auto position1 = Write(large);
+  // Does not fit into the tail, so written from the beginning of the buffer.
+  auto position2 = Write(large);
+  ASSERT_EQ(position2 % kPgClientSharedMemRingSize, 0U);
+  ASSERT_FALSE(ring_->IsValid(position1));
+  auto status = ring_->Get(position1, large.size()).status();
+  ASSERT_TRUE(status.IsTryAgain()) << status;
+  ASSERT_EQ(ASSERT_RESULT(ring_->Get(position2, large.size())).ToBuffer(), large);
+}
+
+TEST_F(PgSharedMemRingTest, Wrap) {
+  const std::string value(1000, 'y');
+  uint64_t last_position = 0;
+  for (size_t i = 0; i != 3 * kPgClientSharedMemRingSize / value.size(); ++i) {
+    last_position = Write(value);
+    ASSERT_LE(last_position % kPgClientSharedMemRingSize + value.size(),
+              kPgClientSharedMemRingSize);
+  }
+  ASSERT_EQ(ASSERT_RESULT(ring_->Get(last_position, value.size())).ToBuffer(), value);
+  ASSERT_FALSE(ring_->IsValid(0));
+}
+
+}  // namespace tserver
+}  // namespace yb
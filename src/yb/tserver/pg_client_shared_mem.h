@@ -0,0 +1,114 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_CLIENT_SHARED_MEM_H
+#define YB_TSERVER_PG_CLIENT_SHARED_MEM_H
+
+#include <atomic>
+
+#include <glog/logging.h>
+
+#include "yb/util/atomic.h"
+#include "yb/util/result.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/slice.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace tserver {
+
+// Number of postgres backends that could simultaneously receive PgClientService responses via
+// shared memory. Backends that did not get a slot use regular RPC responses.
+constexpr size_t kPgClientSharedMemSlots = 64;
+
+// Size of the response ring of a single backend. Pages of the ring are allocated only when
+// touched, so slots that are not used do not consume memory.
+constexpr size_t kPgClientSharedMemRingSize = 512_KB;
+
+// Ring buffer of PgClientService responses, placed in memory shared between the tserver and a
+// single postgres backend.
+//
+// Only the tserver writes to the ring, the backend maps it read only. The tserver serializes a
+// response into the ring and returns its position in the RPC response, so the backend parses it
+// directly from shared memory instead of receiving it through the socket.
+//
+// Positions grow monotonically, the offset in the buffer is the position modulo ring size. The
+// writer does not wait for the reader, so a slow reader could have its response overwritten,
+// for instance when it timed out and issued the next request. To detect it, the writer advances
+// overwritten_ before writing the data, and the reader checks it after parsing the response.
+class PgSharedMemRing {
+ public:
+  PgSharedMemRing() {
+    LOG_IF(FATAL, !IsAcceptableAtomicImpl(overwritten_))
+        << "Shared memory atomics must be lock-free";
+  }
+
+  // Reserves size bytes for the next response and returns pointer to write it to, or nullptr when
+  // the response does not fit into the ring. position is set to the position of the response.
+  // Should be called by the tserver only, and calls should be serialized.
+  char* Allocate(size_t size, uint64_t* position) {
+    if (size > sizeof(data_)) {
+      return nullptr;
+    }
+    auto start = write_position_;
+    auto offset = start % sizeof(data_);
+    if (offset + size > sizeof(data_)) {
+      // Responses are stored contiguously, so skip the tail of the buffer.
+      start += sizeof(data_) - offset;
+      offset = 0;
+    }
+    auto end = start + size;
+    if (end > sizeof(data_)) {
+      overwritten_.store(end - sizeof(data_), std::memory_order_relaxed);
+      // Ensure that the reader observes the new value before any of the data written below.
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+    write_position_ = end;
+    *position = start;
+    return data_ + offset;
+  }
+
+  // Returns the response stored at the specified position. The writer could overwrite it while
+  // the caller is reading, so IsValid should be checked after the response was parsed.
+  Result<Slice> Get(uint64_t position, size_t size) const {
+    auto offset = position % sizeof(data_);
+    if (offset + size > sizeof(data_)) {
+      return STATUS_FORMAT(
+          Corruption, "Invalid shared memory response, position: $0, size: $1", position, size);
+    }
+    if (!IsValid(position)) {
+      return STATUS_FORMAT(TryAgain, "Shared memory response at $0 was overwritten", position);
+    }
+    return Slice(data_ + offset, size);
+  }
+
+  // Returns true if the response at the specified position was not overwritten yet.
+  bool IsValid(uint64_t position) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return overwritten_.load(std::memory_order_relaxed) <= position;
+  }
+
+ private:
+  // Data at positions below this value was overwritten.
+  std::atomic<uint64_t> overwritten_{0};
+
+  // Position of the next response, used by the writer only.
+  uint64_t write_position_ = 0;
+
+  char data_[kPgClientSharedMemRingSize];
+};
+
+}  // namespace tserver
+}  // namespace yb
+
+#endif // YB_TSERVER_PG_CLIENT_SHARED_MEM_H
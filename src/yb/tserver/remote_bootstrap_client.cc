@@ -390,6 +390,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   CHECK(started_);
   status_listener_ = CHECK_NOTNULL(status_listener);
+  downloader_.SetProgressCallback([this](const std::string& progress) {
+    UpdateStatusMessage("Downloading files, " + progress);
+  });
 
   VLOG_WITH_PREFIX(2) << "Fetching table_type: " << TableType_Name(meta_->table_type());
 
@@ -402,6 +405,7 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   for (const auto& component : components_) {
     RETURN_NOT_OK(component->Download());
   }
+  LOG_WITH_PREFIX(INFO) << "Downloaded all files, " << downloader_.ProgressString();
 
   // We sleep here to simulate the transfer of very large files.
   if (PREDICT_FALSE(FLAGS_TEST_simulate_long_remote_bootstrap_sec > 0)) {
@@ -652,14 +656,13 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   DataIdPB data_id;
   data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
-  }
+  const auto& rocksdb_files = new_superblock_.kv_store().rocksdb_files();
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(downloader_.DownloadFiles(rocksdb_files, rocksdb_dir, &data_id));
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  LOG_WITH_PREFIX(INFO)
+      << "Downloaded " << rocksdb_files.size() << " RocksDB files in " << elapsed.ToSeconds()
+      << " seconds, " << downloader_.ProgressString();
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
   auto intents_tmp_dir = JoinPathSegments(rocksdb_dir, tablet::kIntentsSubdir);
@@ -88,7 +88,7 @@ class RemoteBootstrapComponent {
 // This class is not thread-safe.
 //
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Download WAL segments concurrently, chunks of each segment are already pipelined.
 //
 class RemoteBootstrapClient {
  public:
@@ -13,17 +13,28 @@
 
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/fs/fs_manager.h"
 
+#include "yb/gutil/strings/human_readable.h"
+
 #include "yb/rpc/rpc_controller.h"
 
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
 #include "yb/util/crc.h"
+#include "yb/util/env.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/rate_limiter.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
@@ -50,9 +61,21 @@ DEFINE_int32(bytes_remote_bootstrap_durable_write_mb, 8,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
-// RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
-#define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
-  RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
+DEFINE_int32(remote_bootstrap_max_outstanding_fetches, 8,
+             "Maximum number of data chunk requests a remote bootstrap session keeps in flight.");
+TAG_FLAG(remote_bootstrap_max_outstanding_fetches, advanced);
+
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Maximum number of files a remote bootstrap session downloads at the same time.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+
+METRIC_DEFINE_counter(server, remote_bootstrap_bytes_fetched,
+                      "Remote Bootstrap Bytes Fetched", yb::MetricUnit::kBytes,
+                      "Number of bytes downloaded by remote bootstrap sessions of this server.");
+
+METRIC_DEFINE_coarse_histogram(server, remote_bootstrap_fetch_latency,
+                               "Remote Bootstrap Fetch Latency", yb::MetricUnit::kMicroseconds,
+                               "Latency of data chunk requests sent by remote bootstrap sessions.");
 
 namespace yb {
 namespace tserver {
@@ -74,13 +97,96 @@ CHECKED_STATUS ExtractRemoteError(
           " from remote service");
 }
 
+constexpr int kBytesReservedForMessageHeaders = 16384;
+constexpr int kProgressReportIntervalSec = 10;
+
 } // namespace
 
 extern std::atomic<int32_t> remote_bootstrap_clients_started_;
 
+struct RemoteBootstrapFileDownloader::ChunkFetch {
+  FetchTarget* target;
+  uint64_t offset;
+  int32_t length;
+  MonoTime start;
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+};
+
+// State of a file that is being downloaded.
+struct RemoteBootstrapFileDownloader::FetchTarget {
+  DataIdPB data_id;
+  // Path of the file to create, when file is not provided by the caller.
+  std::string path;
+  std::unique_ptr<WritableFile> owned_file;
+  WritableFile* file = nullptr;
+  // Whether the file size is already accounted in bytes_expected_.
+  bool size_accounted = false;
+
+  // Total size of the file, known after the first chunk is received.
+  bool size_known = false;
+  uint64_t total_size = 0;
+  // Offset of the next chunk to request.
+  uint64_t next_offset = 0;
+  // Number of bytes appended to the file.
+  uint64_t appended = 0;
+  size_t unsynced_bytes = 0;
+  size_t in_flight = 0;
+  // Chunks received ahead of the append position, keyed by offset.
+  std::map<uint64_t, std::unique_ptr<ChunkFetch>> received;
+
+  bool Done() const {
+    return size_known && appended == total_size;
+  }
+
+  // Whether a new chunk could be requested for this target.
+  bool CanSend() const {
+    return size_known ? next_offset < total_size : in_flight == 0;
+  }
+
+  std::string ToString() const {
+    return Format("$0 file $1", DataIdPB::IdType_Name(data_id.type()),
+                  path.empty() ? data_id.ShortDebugString() : path);
+  }
+};
+
+// Completed fetches, filled by RPC callbacks and consumed by the downloading thread.
+class RemoteBootstrapFileDownloader::FetchQueue {
+ public:
+  void Push(ChunkFetch* fetch) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_.push_back(fetch);
+    }
+    cond_.notify_one();
+  }
+
+  std::unique_ptr<ChunkFetch> Pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return !completed_.empty(); });
+    std::unique_ptr<ChunkFetch> result(completed_.front());
+    completed_.pop_front();
+    return result;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<ChunkFetch*> completed_;
+};
+
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
     const std::string* log_prefix, FsManager* fs_manager)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
+  const auto& metric_entity = fs_manager_.metric_entity();
+  if (metric_entity) {
+    bytes_fetched_ = METRIC_remote_bootstrap_bytes_fetched.Instantiate(metric_entity);
+    fetch_latency_ = METRIC_remote_bootstrap_fetch_latency.Instantiate(metric_entity);
+  }
+}
+
+RemoteBootstrapFileDownloader::~RemoteBootstrapFileDownloader() {
 }
 
 void RemoteBootstrapFileDownloader::Start(
@@ -89,6 +195,28 @@ void RemoteBootstrapFileDownloader::Start(
   proxy_ = std::move(proxy);
   session_id_ = std::move(session_id);
   session_idle_timeout_ = session_idle_timeout;
+  start_time_ = MonoTime::Now();
+  last_progress_report_time_ = start_time_;
+
+  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
+    static auto rate_updater = []() {
+      auto remote_bootstrap_clients_started =
+          remote_bootstrap_clients_started_.load(std::memory_order_acquire);
+      if (remote_bootstrap_clients_started < 1) {
+        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
+                                   << remote_bootstrap_clients_started;
+        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
+      }
+      return static_cast<uint64_t>(
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+    };
+
+    rate_limiter_ = std::make_unique<RateLimiter>(rate_updater);
+  } else {
+    // Inactive RateLimiter.
+    rate_limiter_ = std::make_unique<RateLimiter>();
+  }
+  rate_limiter_->Init();
 }
 
 Env& RemoteBootstrapFileDownloader::env() const {
@@ -97,127 +225,313 @@ Env& RemoteBootstrapFileDownloader::env() const {
 
 Status RemoteBootstrapFileDownloader::DownloadFile(
     const tablet::FilePB& file_pb, const std::string& dir, DataIdPB *data_id) {
-  auto file_path = JoinPathSegments(dir, file_pb.name());
-  RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
-
-  if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
-      VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
-      if (link_status.ok()) {
-        return Status::OK();
+  return DownloadFiles(std::vector<const tablet::FilePB*>{&file_pb}, dir, data_id);
+}
+
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+    DataIdPB* data_id) {
+  std::vector<const tablet::FilePB*> file_ptrs;
+  file_ptrs.reserve(files.size());
+  for (const auto& file_pb : files) {
+    file_ptrs.push_back(&file_pb);
+  }
+  return DownloadFiles(file_ptrs, dir, data_id);
+}
+
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const std::vector<const tablet::FilePB*>& files, const std::string& dir, DataIdPB* data_id) {
+  std::vector<std::unique_ptr<FetchTarget>> targets;
+  std::vector<FetchTarget*> target_ptrs;
+  // Files that share inode with a file that is being downloaded, linked after download.
+  std::vector<std::pair<std::string, uint64_t>> links;
+  std::unordered_map<uint64_t, std::string> downloading_inodes;
+
+  for (const auto* file_pb : files) {
+    auto file_path = JoinPathSegments(dir, file_pb->name());
+    RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
+
+    if (file_pb->inode() != 0) {
+      auto it = inode2file_.find(file_pb->inode());
+      if (it != inode2file_.end()) {
+        VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
+                            << " => " << it->second;
+        auto link_status = env().LinkFile(it->second, file_path);
+        if (link_status.ok()) {
+          continue;
+        }
+        // TODO fallback to copy.
+        LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+                               << ": " << link_status;
+      } else if (!downloading_inodes.emplace(file_pb->inode(), file_path).second) {
+        links.emplace_back(file_path, file_pb->inode());
+        continue;
       }
-      // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
-                             << ": " << link_status;
     }
+
+    data_id->set_file_name(file_pb->name());
+    auto target = std::make_unique<FetchTarget>();
+    target->data_id = *data_id;
+    target->path = std::move(file_path);
+    target->size_accounted = true;
+    bytes_expected_ += file_pb->size_bytes();
+    target_ptrs.push_back(target.get());
+    targets.push_back(std::move(target));
   }
 
-  WritableFileOptions opts;
-  opts.sync_on_close = true;
-  std::unique_ptr<WritableFile> file;
-  RETURN_NOT_OK(env().NewWritableFile(opts, file_path, &file));
+  RETURN_NOT_OK(Fetch(target_ptrs));
 
-  data_id->set_file_name(file_pb.name());
-  RETURN_NOT_OK_PREPEND(DownloadFile(*data_id, file.get()),
-                        Format("Unable to download $0 file $1",
-                               DataIdPB::IdType_Name(data_id->type()), file_path));
-  VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
+  for (auto& inode_and_path : downloading_inodes) {
+    inode2file_.emplace(inode_and_path.first, std::move(inode_and_path.second));
+  }
 
-  if (file_pb.inode() != 0) {
-    inode2file_.emplace(file_pb.inode(), file_path);
+  for (const auto& path_and_inode : links) {
+    const auto& source = inode2file_[path_and_inode.second];
+    VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << path_and_inode.first
+                        << " => " << source;
+    auto link_status = env().LinkFile(source, path_and_inode.first);
+    if (!link_status.ok()) {
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << path_and_inode.first << " => "
+                             << source << ": " << link_status;
+      return link_status;
+    }
   }
 
   return Status::OK();
 }
 
-template<class Appendable>
-Status RemoteBootstrapFileDownloader::DownloadFile(
-    const DataIdPB& data_id, Appendable* appendable) {
-  constexpr int kBytesReservedForMessageHeaders = 16384;
+Status RemoteBootstrapFileDownloader::DownloadFile(const DataIdPB& data_id, WritableFile* file) {
+  FetchTarget target;
+  target.data_id = data_id;
+  target.file = file;
+  return Fetch({&target});
+}
 
-  // For periodic sync, indicates number of bytes which need to be sync'ed.
-  size_t periodic_sync_unsynced_bytes = 0;
-  uint64_t offset = 0;
-  int32_t max_length = std::min(FLAGS_remote_bootstrap_max_chunk_size,
-                                FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
+Status RemoteBootstrapFileDownloader::Fetch(const std::vector<FetchTarget*>& targets) {
+  const size_t max_in_flight = std::max(FLAGS_remote_bootstrap_max_outstanding_fetches, 1);
+  const size_t max_active = std::max(FLAGS_remote_bootstrap_max_concurrent_files, 1);
+  const int32_t max_chunk_size = std::min(
+      FLAGS_remote_bootstrap_max_chunk_size,
+      FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
+
+  FetchQueue queue;
+  size_t in_flight = 0;
+  auto next_target = targets.begin();
+  std::vector<FetchTarget*> active;
+  size_t round_robin = 0;
+  // Ranges of chunks that were returned partially and should be requested again.
+  std::deque<std::tuple<FetchTarget*, uint64_t, int32_t>> gaps;
+  Status status;
+
+  for (;;) {
+    while (status.ok() && in_flight < max_in_flight) {
+      FetchTarget* target = nullptr;
+      uint64_t offset = 0;
+      int32_t length = max_chunk_size;
+      if (!gaps.empty()) {
+        std::tie(target, offset, length) = gaps.front();
+        gaps.pop_front();
+      } else {
+        if (active.size() < max_active && next_target != targets.end()) {
+          auto* new_target = *next_target++;
+          if (!new_target->file) {
+            WritableFileOptions opts;
+            opts.sync_on_close = true;
+            status = env().NewWritableFile(opts, new_target->path, &new_target->owned_file);
+            if (!status.ok()) {
+              status = status.CloneAndPrepend(
+                  Format("Unable to download $0", new_target->ToString()));
+              break;
+            }
+            new_target->file = new_target->owned_file.get();
+          }
+          active.push_back(new_target);
+        }
+        for (size_t i = 0; i != active.size(); ++i) {
+          auto* candidate = active[(round_robin + i) % active.size()];
+          if (candidate->CanSend()) {
+            target = candidate;
+            round_robin += i + 1;
+            break;
+          }
+        }
+        if (!target) {
+          break;
+        }
+        offset = target->next_offset;
+        if (rate_limiter_->active()) {
+          // Split the rate limiter budget for a time slot between fetches in flight.
+          auto max_size = rate_limiter_->GetMaxSizeForNextTransmission() / max_in_flight;
+          length = static_cast<int32_t>(
+              std::max<uint64_t>(std::min<uint64_t>(length, max_size), 1));
+        }
+        if (target->size_known) {
+          length = static_cast<int32_t>(
+              std::min<uint64_t>(length, target->total_size - offset));
+        }
+        target->next_offset = offset + length;
+      }
+      SendFetch(target, offset, length, &queue);
+      ++in_flight;
+    }
 
-  std::unique_ptr<RateLimiter> rate_limiter;
+    if (in_flight == 0) {
+      break;
+    }
 
-  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
-      auto remote_bootstrap_clients_started =
-          remote_bootstrap_clients_started_.load(std::memory_order_acquire);
-      if (remote_bootstrap_clients_started < 1) {
-        YB_LOG_EVERY_N(ERROR, 100) << "Invalid number of remote bootstrap sessions: "
-                                   << remote_bootstrap_clients_started;
-        return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
+    auto fetch = queue.Pop();
+    --in_flight;
+    auto* target = fetch->target;
+    --target->in_flight;
+    if (!status.ok()) {
+      // Just wait for requests that are still in flight.
+      continue;
+    }
+
+    auto fetch_status = UnwindRemoteError(fetch->controller.status(), fetch->controller);
+    if (!fetch_status.ok()) {
+      status = fetch_status.CloneAndPrepend(
+          Format("Unable to fetch data of $0 from remote", target->ToString()));
+      continue;
+    }
+    if (fetch_latency_) {
+      fetch_latency_->Increment(MonoTime::Now().GetDeltaSince(fetch->start).ToMicroseconds());
+    }
+    rate_limiter_->UpdateDataSizeAndMaybeSleep(fetch->resp.ByteSize());
+
+    const auto& chunk = fetch->resp.chunk();
+    auto chunk_end = fetch->offset + chunk.data().size();
+    if (!target->size_known) {
+      target->size_known = true;
+      target->total_size = chunk.total_data_length();
+      target->next_offset = chunk_end;
+      if (!target->size_accounted) {
+        bytes_expected_ += target->total_size;
+        target->size_accounted = true;
       }
-      return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
-    };
+    } else if (chunk_end < std::min<uint64_t>(fetch->offset + fetch->length, target->total_size)) {
+      // The remote side could return less data than requested, for instance because of its
+      // rate limiter, so request the rest of the range again.
+      if (chunk.data().empty()) {
+        status = STATUS_FORMAT(
+            IllegalState, "Received empty chunk of $0 at offset $1", target->ToString(),
+            fetch->offset);
+        continue;
+      }
+      gaps.emplace_back(
+          target, chunk_end, static_cast<int32_t>(fetch->offset + fetch->length - chunk_end));
+    }
 
-    rate_limiter = std::make_unique<RateLimiter>(rate_updater);
-  } else {
-    // Inactive RateLimiter.
-    rate_limiter = std::make_unique<RateLimiter>();
+    status = ChunkReceived(std::move(fetch));
+    if (!status.ok()) {
+      continue;
+    }
+
+    if (target->Done()) {
+      VLOG_WITH_PREFIX(2) << "Downloaded " << target->ToString();
+      if (target->owned_file) {
+        status = target->owned_file->Close();
+        target->owned_file.reset();
+        if (!status.ok()) {
+          continue;
+        }
+      }
+      active.erase(std::find(active.begin(), active.end(), target));
+    }
+    MaybeReportProgress();
   }
 
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
-  FetchDataRequestPB req;
+  VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter_->GetRate();
 
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    if (rate_limiter->active()) {
-      auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
-      if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
-        max_size = std::numeric_limits<decltype(max_length)>::max();
-      }
-      max_length = std::min(max_length, decltype(max_length)(max_size));
+  return status;
+}
+
+void RemoteBootstrapFileDownloader::SendFetch(
+    FetchTarget* target, uint64_t offset, int32_t length, FetchQueue* queue) {
+  auto fetch = new ChunkFetch;
+  fetch->target = target;
+  fetch->offset = offset;
+  fetch->length = length;
+  fetch->start = MonoTime::Now();
+  fetch->req.set_session_id(session_id_);
+  *fetch->req.mutable_data_id() = target->data_id;
+  fetch->req.set_offset(offset);
+  fetch->req.set_max_length(length);
+  fetch->controller.set_timeout(session_idle_timeout_);
+  ++target->in_flight;
+  proxy_->FetchDataAsync(
+      fetch->req, &fetch->resp, &fetch->controller, [queue, fetch] { queue->Push(fetch); });
+}
+
+Status RemoteBootstrapFileDownloader::ChunkReceived(std::unique_ptr<ChunkFetch> fetch) {
+  auto* target = fetch->target;
+  const auto& chunk = fetch->resp.chunk();
+  DCHECK_LE(chunk.data().size(), fetch->length);
+  VLOG_WITH_PREFIX(3)
+      << "resp size: " << fetch->resp.ByteSize() << ", chunk size: " << chunk.data().size();
+
+  // Sanity-check for corruption.
+  RETURN_NOT_OK_PREPEND(VerifyData(fetch->offset, chunk),
+                        Format("Error validating data item $0", target->data_id));
+
+  auto offset = fetch->offset;
+  target->received.emplace(offset, std::move(fetch));
+
+  // Write the data that is contiguous with the appended part of the file.
+  for (;;) {
+    auto it = target->received.begin();
+    if (it == target->received.end() || it->first != target->appended) {
+      break;
     }
-    req.set_max_length(max_length);
-
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
-
-    // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
-                          Format("Error validating data item $0", data_id));
-
-    // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
-    VLOG_WITH_PREFIX(3)
-        << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
-
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    const auto& data = it->second->resp.chunk().data();
+    RETURN_NOT_OK_PREPEND(target->file->Append(data),
+                          Format("Unable to download $0", target->ToString()));
+    target->appended += data.size();
+    bytes_downloaded_ += data.size();
+    if (bytes_fetched_) {
+      bytes_fetched_->IncrementBy(data.size());
     }
-    offset += resp.chunk().data().size();
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
-      if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
-        RETURN_NOT_OK(appendable->Sync());
-        periodic_sync_unsynced_bytes = 0;
+      target->unsynced_bytes += data.size();
+      if (target->unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
+        RETURN_NOT_OK(target->file->Sync());
+        target->unsynced_bytes = 0;
       }
     }
+    target->received.erase(it);
   }
 
-  VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
-
   return Status::OK();
 }
 
+void RemoteBootstrapFileDownloader::MaybeReportProgress() {
+  auto now = MonoTime::Now();
+  if (now.GetDeltaSince(last_progress_report_time_) <
+          MonoDelta::FromSeconds(kProgressReportIntervalSec)) {
+    return;
+  }
+  last_progress_report_time_ = now;
+  auto progress = ProgressString();
+  LOG_WITH_PREFIX(INFO) << "Remote bootstrap progress: " << progress;
+  if (progress_callback_) {
+    progress_callback_(progress);
+  }
+}
+
+std::string RemoteBootstrapFileDownloader::ProgressString() const {
+  auto elapsed = MonoTime::Now().GetDeltaSince(start_time_).ToSeconds();
+  auto rate = elapsed > 0 ? bytes_downloaded_ / elapsed : 0.0;
+  auto result = Format(
+      "downloaded $0 of $1 at $2/s", HumanReadableNumBytes::ToString(bytes_downloaded_),
+      HumanReadableNumBytes::ToString(std::max(bytes_downloaded_, bytes_expected_)),
+      HumanReadableNumBytes::DoubleToString(rate));
+  if (rate > 0 && bytes_expected_ > bytes_downloaded_) {
+    result += ", ETA " + HumanReadableElapsedTime::ToShortString(
+        (bytes_expected_ - bytes_downloaded_) / rate);
+  }
+  return result;
+}
+
 Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
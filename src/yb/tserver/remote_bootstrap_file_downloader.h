@@ -14,9 +14,13 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -29,17 +33,27 @@
 
 namespace yb {
 
+class Counter;
 class Env;
 class FsManager;
+class Histogram;
 class MonoDelta;
+class RateLimiter;
+class WritableFile;
 
 namespace tserver {
 
 class RemoteBootstrapServiceProxy;
 
+// Downloads files of a remote bootstrap session.
+//
+// Chunks are fetched with up to remote_bootstrap_max_outstanding_fetches requests in flight,
+// spread over up to remote_bootstrap_max_concurrent_files files. Received chunks are verified and
+// appended in order by the calling thread.
 class RemoteBootstrapFileDownloader {
  public:
   RemoteBootstrapFileDownloader(const std::string* log_prefix, FsManager* fs_manager);
+  ~RemoteBootstrapFileDownloader();
 
   void Start(
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
@@ -48,15 +62,24 @@ class RemoteBootstrapFileDownloader {
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Downloads the specified files into dir. Files are fetched concurrently, files that share an
+  // inode are downloaded once and hard-linked.
+  CHECKED_STATUS DownloadFiles(
+      const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+      DataIdPB* data_id);
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
-  //
-  // An Appendable is typically a WritableFile (WAL).
-  //
-  // Only used in one compilation unit, otherwise the implementation would
-  // need to be in the header.
-  template<class Appendable>
-  CHECKED_STATUS DownloadFile(const DataIdPB& data_id, Appendable* appendable);
+  CHECKED_STATUS DownloadFile(const DataIdPB& data_id, WritableFile* file);
+
+  // Callback that is periodically invoked with the progress of the session while files are being
+  // downloaded.
+  void SetProgressCallback(std::function<void(const std::string&)> callback) {
+    progress_callback_ = std::move(callback);
+  }
+
+  // Returns the number of downloaded bytes, the download rate and the estimated time left.
+  std::string ProgressString() const;
 
   FsManager& fs_manager() const {
     return fs_manager_;
@@ -67,8 +90,26 @@ class RemoteBootstrapFileDownloader {
   }
 
  private:
+  struct FetchTarget;
+  struct ChunkFetch;
+  class FetchQueue;
+
+  CHECKED_STATUS DownloadFiles(
+      const std::vector<const tablet::FilePB*>& files, const std::string& dir, DataIdPB* data_id);
+
+  // Fetches all chunks of the specified targets.
+  CHECKED_STATUS Fetch(const std::vector<FetchTarget*>& targets);
+
+  // Sends request for the specified range of the target.
+  void SendFetch(FetchTarget* target, uint64_t offset, int32_t length, FetchQueue* queue);
+
+  // Processes received chunk, appending it and subsequent received chunks to the target file.
+  CHECKED_STATUS ChunkReceived(std::unique_ptr<ChunkFetch> fetch);
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  void MaybeReportProgress();
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -82,6 +123,16 @@ class RemoteBootstrapFileDownloader {
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
   std::unordered_map<uint64_t, std::string> inode2file_;
+  std::unique_ptr<RateLimiter> rate_limiter_;
+
+  MonoTime start_time_;
+  MonoTime last_progress_report_time_;
+  uint64_t bytes_downloaded_ = 0;
+  uint64_t bytes_expected_ = 0;
+  std::function<void(const std::string&)> progress_callback_;
+
+  scoped_refptr<Counter> bytes_fetched_;
+  scoped_refptr<Histogram> fetch_latency_;
 };
 
 CHECKED_STATUS UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
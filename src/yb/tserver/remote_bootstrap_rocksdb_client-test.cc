@@ -17,7 +17,14 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+#include "yb/util/size_literals.h"
+
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
+DECLARE_int32(remote_bootstrap_max_outstanding_fetches);
+
 using std::shared_ptr;
+using namespace yb::size_literals;
 
 namespace yb {
 namespace tserver {
@@ -30,6 +37,44 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+  void CheckRocksDBFiles() {
+    auto tablet_peer_checkpoint_dir =
+        tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
+
+    vector<std::string> rocksdb_files;
+    LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
+    ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
+
+    vector<std::string> tablet_peer_checkpoint_files;
+    ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(
+        tablet_peer_checkpoint_dir, &tablet_peer_checkpoint_files));
+
+    std::sort(rocksdb_files.begin(), rocksdb_files.end());
+    std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
+
+    ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
+        << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
+
+    // Verify that the client has the same files that the leader has.
+    for (int i = 0; i < rocksdb_files.size(); ++i) {
+      auto local_rocksdb_file = rocksdb_files[i];
+      auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
+      ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+
+      if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
+        continue;
+      }
+
+      auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
+      auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
+                                                            tablet_peer_rocksdb_file);
+
+      LOG(INFO) << "Comparing file " << local_rocksdb_file_path
+                << " and file " << tablet_peer_rocksdb_file_path;
+      ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
+    }
+  }
 };
 
 // Basic begin / end remote bootstrap session.
@@ -43,41 +88,17 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
 TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->FetchAll(&listener));
-  auto tablet_peer_checkpoint_dir =
-      tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
-
-  vector<std::string> rocksdb_files;
-  LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
-  ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
-
-  vector<std::string> tablet_peer_checkpoint_files;
-  ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(tablet_peer_checkpoint_dir,
-                                                                   &tablet_peer_checkpoint_files));
-
-  std::sort(rocksdb_files.begin(), rocksdb_files.end());
-  std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-
-  ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
-      << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
-
-  // Verify that the client has the same files that the leader has.
-  for (int i = 0; i < rocksdb_files.size(); ++i) {
-    auto local_rocksdb_file = rocksdb_files[i];
-    auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
-    ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
-
-    if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
-      continue;
-    }
-
-    auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
-    auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
-                                                          tablet_peer_rocksdb_file);
+  ASSERT_NO_FATALS(CheckRocksDBFiles());
+}
 
-    LOG(INFO) << "Comparing file " << local_rocksdb_file_path
-              << " and file " << tablet_peer_rocksdb_file_path;
-    ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
-  }
+// Download files in small chunks, so multiple chunks of multiple files are in flight.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesPipelined) {
+  FLAGS_remote_bootstrap_max_chunk_size = 1_KB;
+  FLAGS_remote_bootstrap_max_outstanding_fetches = 16;
+  FLAGS_remote_bootstrap_max_concurrent_files = 3;
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_NO_FATALS(CheckRocksDBFiles());
 }
 
 } // namespace tserver
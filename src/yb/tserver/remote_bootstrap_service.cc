@@ -248,11 +248,9 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
     session = it->second.session;
   }
 
-  session->EnsureRateLimiterIsInitialized();
-
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  int64_t rate_limit = session->GetMaxSizeForNextTransmission();
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
@@ -268,7 +266,7 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
+  session->UpdateDataSizeAndMaybeSleep(info.data.size());
   uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
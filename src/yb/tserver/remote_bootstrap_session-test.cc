@@ -103,7 +103,8 @@ void RemoteBootstrapSessionTest::SetUpTabletPeer() {
   proxy_cache_ = std::make_unique<rpc::ProxyCache>(messenger_.get());
   multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(messenger_.get(),
                                                                       proxy_cache_.get(),
-                                                                      config_peer.cloud_info());
+                                                                      config_peer.cloud_info(),
+                                                                      nullptr);
 
   log_anchor_registry_.reset(new LogAnchorRegistry());
   ASSERT_OK(tablet_peer_->SetBootstrapping());
@@ -480,10 +480,32 @@ Status RemoteBootstrapSession::GetLogSegmentPiece(uint64_t segment_seqno, GetDat
 
 Status RemoteBootstrapSession::GetRocksDBFilePiece(
     const std::string& file_name, GetDataPieceInfo* info) {
-  return GetFilePiece(checkpoint_dir_, file_name, env(), info);
+  std::shared_ptr<RandomAccessFile> file;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = opened_rocksdb_files_.find(file_name);
+    if (it != opened_rocksdb_files_.end()) {
+      file = it->second.file;
+      info->data_size = it->second.size;
+    }
+  }
+  if (!file) {
+    file = VERIFY_RESULT(OpenFile(checkpoint_dir_, file_name, env(), info));
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_rocksdb_files_.emplace(file_name, OpenedFile{file, info->data_size});
+  }
+
+  RETURN_NOT_OK(ReadFileChunkToBuf(file.get(), Substitute("rocksdb file $0", file_name), info));
+
+  if (static_cast<int64_t>(info->offset + info->data.size()) >= info->data_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opened_rocksdb_files_.erase(file_name);
+  }
+
+  return Status::OK();
 }
 
-Status RemoteBootstrapSession::GetFilePiece(
+Result<std::shared_ptr<RandomAccessFile>> RemoteBootstrapSession::OpenFile(
     const std::string& path, const std::string& file_name, Env* env, GetDataPieceInfo* info) {
   auto file_path = JoinPathSegments(path, file_name);
   if (!env->FileExists(file_path)) {
@@ -498,13 +520,16 @@ Status RemoteBootstrapSession::GetFilePiece(
 
   info->data_size = VERIFY_RESULT(readable_file->Size());
   auto inode = VERIFY_RESULT(readable_file->INode());
-  VLOG(2) << "Reading RocksDB file. File path: " << file_path << ", file size: " << info->data_size
+  VLOG(2) << "Opened RocksDB file. File path: " << file_path << ", file size: " << info->data_size
           << ", inode: " << inode;
 
-  RETURN_NOT_OK(ReadFileChunkToBuf(
-      readable_file.get(), Substitute("rocksdb file $0", file_name), info));
+  return std::shared_ptr<RandomAccessFile>(std::move(readable_file));
+}
 
-  return Status::OK();
+Status RemoteBootstrapSession::GetFilePiece(
+    const std::string& path, const std::string& file_name, Env* env, GetDataPieceInfo* info) {
+  auto file = VERIFY_RESULT(OpenFile(path, file_name, env, info));
+  return ReadFileChunkToBuf(file.get(), Substitute("rocksdb file $0", file_name), info);
 }
 
 // Add a file to the cache and populate the given ImmutableRandomAcccessFileInfo
@@ -576,6 +601,18 @@ bool RemoteBootstrapSession::Succeeded() {
   return succeeded_;
 }
 
+uint64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  EnsureRateLimiterIsInitialized();
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  EnsureRateLimiterIsInitialized();
+  rate_limiter_.UpdateDataSizeAndMaybeSleep(data_size);
+}
+
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
   if (!rate_limiter_.IsInitialized()) {
     InitRateLimiter();
@@ -130,11 +130,14 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Change the peer's role to VOTER.
   CHECKED_STATUS ChangeRole();
 
-  void InitRateLimiter();
+  // Returns the max size of the next data chunk allowed by the rate limiter, 0 means unlimited.
+  // Several FetchData calls of the same session could run concurrently, so the rate limiter
+  // is accessed only under rate_limiter_mutex_.
+  uint64_t GetMaxSizeForNextTransmission();
 
-  void EnsureRateLimiterIsInitialized();
-
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Accounts the sent data chunk in the rate limiter, sleeping if the rate is exceeded.
+  // Rate-limited fetches of the same session are serialized while sleeping.
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -179,11 +182,21 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // This method is thread-safe.
   CHECKED_STATUS GetLogSegmentPiece(uint64_t segment_seqno, GetDataPieceInfo* info);
 
+  // Opens file for reading and fills info->data_size with its size.
+  static Result<std::shared_ptr<RandomAccessFile>> OpenFile(
+      const std::string& path, const std::string& file_name, Env* env, GetDataPieceInfo* info);
+
   // Get a piece of a RocksDB checkpoint file.
+  // Files are kept open between requests, so pipelined fetches of the same file don't reopen it
+  // for every chunk. A file is closed after its last chunk has been read.
   CHECKED_STATUS GetRocksDBFilePiece(const std::string& file_name, GetDataPieceInfo* info);
 
   Env* env() const;
 
+  void InitRateLimiter() REQUIRES(rate_limiter_mutex_);
+
+  void EnsureRateLimiterIsInitialized() REQUIRES(rate_limiter_mutex_);
+
   RemoteBootstrapSource* Source(DataIdPB::IdType id_type) const;
 
   std::shared_ptr<tablet::TabletPeer> tablet_peer_;
@@ -197,6 +210,14 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   uint64_t opened_log_segment_seqno_ GUARDED_BY(mutex_) = 0;
   bool opened_log_segment_active_ GUARDED_BY(mutex_) = false;
 
+  struct OpenedFile {
+    std::shared_ptr<RandomAccessFile> file;
+    int64_t size;
+  };
+
+  // RocksDB checkpoint files that are being sent, keyed by file name.
+  std::unordered_map<std::string, OpenedFile> opened_rocksdb_files_ GUARDED_BY(mutex_);
+
   tablet::RaftGroupReplicaSuperBlockPB tablet_superblock_;
 
   consensus::ConsensusStatePB initial_committed_cstate_;
@@ -218,8 +239,10 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
+  std::mutex rate_limiter_mutex_;
+
   // Used to limit the transmission rate.
-  RateLimiter rate_limiter_;
+  RateLimiter rate_limiter_ GUARDED_BY(rate_limiter_mutex_);
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
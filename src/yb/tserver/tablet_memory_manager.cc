@@ -76,6 +76,40 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_string(db_block_cache_admission_policy, "lru",
+              "Admission policy of the block cache. lru - every block is added to the cache, "
+              "tiny_lfu - block is added only if it is accessed more frequently than the block "
+              "it would evict, so large scans do not evict frequently read blocks.");
+TAG_FLAG(db_block_cache_admission_policy, advanced);
+
+namespace {
+
+bool ParseAdmissionPolicy(const std::string& value, rocksdb::CacheAdmissionPolicy* out) {
+  if (value == "lru") {
+    *out = rocksdb::CacheAdmissionPolicy::kAlways;
+  } else if (value == "tiny_lfu") {
+    *out = rocksdb::CacheAdmissionPolicy::kTinyLFU;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ValidateAdmissionPolicy(const char* flagname, const std::string& value) {
+  rocksdb::CacheAdmissionPolicy policy;
+  if (!ParseAdmissionPolicy(value, &policy)) {
+    LOG(ERROR) << "Invalid value for " << flagname << ": " << value
+               << ", expected lru or tiny_lfu";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(db_block_cache_admission_policy, &ValidateAdmissionPolicy);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -196,8 +230,11 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    auto admission_policy = rocksdb::CacheAdmissionPolicy::kAlways;
+    ParseAdmissionPolicy(FLAGS_db_block_cache_admission_policy, &admission_policy);
+    options->block_cache = rocksdb::NewLRUCache(
+        block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+        false /* strict_capacity_limit */, admission_policy);
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -209,6 +246,12 @@ void TabletMemoryManager::InitLogCacheGC() {
   log_cache_gc_ = std::make_shared<FunctorGC>(
       std::bind(&TabletMemoryManager::LogCacheGC, this, log_cache_mem_tracker.get(), _1));
   log_cache_mem_tracker->AddGarbageCollector(log_cache_gc_);
+
+  auto log_cache_compressed_mem_tracker =
+      consensus::LogCache::GetServerCompressedMemTracker(server_mem_tracker_);
+  log_cache_compressed_gc_ = std::make_shared<FunctorGC>(
+      std::bind(&TabletMemoryManager::LogCacheCompressedGC, this, _1));
+  log_cache_compressed_mem_tracker->AddGarbageCollector(log_cache_compressed_gc_);
 }
 
 void TabletMemoryManager::ConfigureBackgroundTask(tablet::TabletOptions* options) {
@@ -282,6 +325,52 @@ void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t b
             << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
 }
 
+void TabletMemoryManager::LogCacheCompressedGC(size_t bytes_to_evict) {
+  if (!FLAGS_enable_log_cache_gc) {
+    return;
+  }
+
+  auto peers = peers_fn_();
+  std::vector<std::pair<size_t, consensus::RaftConsensus*>> tiers;
+  for (const auto& peer : peers) {
+    auto* consensus = down_cast<consensus::RaftConsensus*>(peer->consensus());
+    if (!consensus) {
+      continue;
+    }
+    auto size = consensus->CompressedLogCacheSize();
+    if (size > 0) {
+      tiers.emplace_back(size, consensus);
+    }
+  }
+  std::sort(tiers.begin(), tiers.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  // Find the level, such that cutting the largest tiers down to it frees enough memory.
+  size_t num_tiers = 0;
+  size_t total_size = 0;
+  while (num_tiers < tiers.size()) {
+    total_size += tiers[num_tiers].first;
+    ++num_tiers;
+    size_t next_size = num_tiers < tiers.size() ? tiers[num_tiers].first : 0;
+    if (total_size - num_tiers * next_size >= bytes_to_evict) {
+      break;
+    }
+  }
+  size_t level = total_size > bytes_to_evict ? (total_size - bytes_to_evict) / num_tiers : 0;
+
+  size_t total_evicted = 0;
+  for (size_t i = 0; i != num_tiers; ++i) {
+    if (tiers[i].first > level) {
+      total_evicted += tiers[i].second->EvictCompressedLogCache(tiers[i].first - level);
+    }
+  }
+
+  VLOG(1) << "Evicted from compressed log cache: "
+          << HumanReadableNumBytes::ToString(total_evicted)
+          << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
+}
+
 void TabletMemoryManager::FlushTabletIfLimitExceeded() {
   int iteration = 0;
   while (memory_monitor_->Exceeded() ||
@@ -83,6 +83,10 @@ class TabletMemoryManager {
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
+  // Garbage collection function of compressed log cache tiers. Evicts from the largest tiers
+  // first, so the server-wide budget is shared fairly between tablets.
+  void LogCacheCompressedGC(size_t bytes_to_evict);
+
   // Determines which tablet has the oldest mutable memtable write time.  May return a null ptr
   // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
   tablet::TabletPeerPtr TabletToFlush();
@@ -101,6 +105,8 @@ class TabletMemoryManager {
 
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
+  std::shared_ptr<GarbageCollector> log_cache_compressed_gc_;
+
   std::unique_ptr<BackgroundTask> background_task_;
 
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor_;
@@ -380,6 +380,7 @@ Status TabletServer::RegisterServices() {
       std::make_unique<PgClientServiceImpl>(
           tablet_manager_->client_future(), std::bind(&TabletServer::TransactionPool, this),
           metric_entity(),
+          &shared_object(),
           &messenger()->scheduler())));
 
   return Status::OK();
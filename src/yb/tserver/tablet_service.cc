@@ -104,6 +104,7 @@
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/pgwrapper/ysql_upgrade.h"
@@ -1180,7 +1181,7 @@ void TabletServiceImpl::GetTransactionStatus(const GetTransactionStatusRequestPB
           tablet_peer.peer->tablet_id());
     }
     return transaction_coordinator->GetStatus(
-        req->transaction_id(), context.GetClientDeadline(), resp);
+        req->transaction_id(), req->per_transaction_errors(), context.GetClientDeadline(), resp);
   });
 }
 
@@ -2471,9 +2472,16 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
                                            TabletPeerLookupIf* tablet_manager)
     : ConsensusServiceIf(metric_entity),
       tablet_manager_(tablet_manager) {
+  // Updates wait for WAL writes, so the number of threads is bounded by the number of updates
+  // in flight rather than by the number of CPUs.
+  CHECK_OK(ThreadPoolBuilder("multi-raft-update")
+               .set_min_threads(0)
+               .unlimited_threads()
+               .Build(&multi_raft_update_pool_));
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
+  multi_raft_update_pool_->Shutdown();
 }
 
 void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
@@ -2486,57 +2494,110 @@ void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
 }
 
+void ConsensusServiceImpl::UpdateConsensusFromBatch(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, const std::string& requestor_string,
+    CoarseTimePoint deadline) {
+  auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", req, requestor_string);
+  if (!uuid_match_res.ok()) {
+    SetupError(resp->mutable_error(), uuid_match_res.status());
+    return;
+  }
+
+  auto peer_tablet_res = LookupTabletPeer(tablet_manager_, req->tablet_id());
+  if (!peer_tablet_res.ok()) {
+    SetupError(resp->mutable_error(), peer_tablet_res.status());
+    return;
+  }
+  auto tablet_peer = peer_tablet_res.get().tablet_peer;
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  auto consensus_res = GetConsensus(tablet_peer);
+  if (!consensus_res.ok()) {
+    SetupError(resp->mutable_error(), consensus_res.status());
+    return;
+  }
+  auto consensus = *consensus_res;
+
+  Status s = consensus->Update(req, resp, deadline);
+  if (PREDICT_FALSE(!s.ok())) {
+    // Clear the response first, since a partially-filled response could
+    // result in confusing a caller, or in having missing required fields
+    // in embedded optional messages.
+    resp->Clear();
+    SetupError(resp->mutable_error(), s);
+    return;
+  }
+
+  CompleteUpdateConsensusResponse(tablet_peer, resp);
+}
+
 void ConsensusServiceImpl::MultiRaftUpdateConsensus(
       const consensus::MultiRaftConsensusRequestPB *req,
       consensus::MultiRaftConsensusResponsePB *resp,
       rpc::RpcContext context) {
-    DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
-    // Effectively performs ConsensusServiceImpl::UpdateConsensus for
-    // each ConsensusRequestPB in the batch but does not fail the entire
-    // batch if a single request fails.
-    for (int i = 0; i < req->consensus_request_size(); i++) {
-      // Unfortunately, we have to use const_cast here,
-      // because the protobuf-generated interface only gives us a const request
-      // but we need to be able to move messages out of the request for efficiency.
-      auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
-      auto consensus_resp = resp->add_consensus_response();;
-
-      auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", consensus_req,
-                                           context.requestor_string());
-      if (!uuid_match_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), uuid_match_res.status());
-        continue;
-      }
-
-      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
-      if (!peer_tablet_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), peer_tablet_res.status());
-        continue;
+  DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
+  // Effectively performs ConsensusServiceImpl::UpdateConsensus for
+  // each ConsensusRequestPB in the batch but does not fail the entire
+  // batch if a single request fails.
+  //
+  // Updates that carry ops wait until those ops are written to the WAL, so they are performed
+  // concurrently in multi_raft_update_pool_. Otherwise a batch would take the sum of WAL latencies
+  // of its tablets, and a single slow tablet would delay replication of all others. Heartbeats and
+  // commit-only updates don't wait for the WAL and are performed inline.
+  struct BatchState {
+    explicit BatchState(rpc::RpcContext* rpc_context) : context(std::move(*rpc_context)) {}
+
+    rpc::RpcContext context;
+    // Number of updates that are not finished yet, plus one for the inline part of the batch.
+    std::atomic<size_t> pending{1};
+
+    void UpdateDone() {
+      if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        context.RespondSuccess();
       }
-      auto tablet_peer = peer_tablet_res.get().tablet_peer;
-
-      // Submit the update directly to the TabletPeer's Consensus instance.
-      auto consensus_res = GetConsensus(tablet_peer);
-      if (!consensus_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), consensus_res.status());
+    }
+  };
+
+  // Responses are allocated in advance, so concurrent updates don't modify the repeated field.
+  for (int i = 0; i < req->consensus_request_size(); i++) {
+    resp->add_consensus_response();
+  }
+
+  auto state = std::make_shared<BatchState>(&context);
+  const auto requestor_string = state->context.requestor_string();
+  const auto deadline = state->context.GetClientDeadline();
+  // The first data-bearing update is performed by this thread after the others are submitted.
+  int inline_data_request = -1;
+  for (int i = 0; i < req->consensus_request_size(); i++) {
+    // Unfortunately, we have to use const_cast here,
+    // because the protobuf-generated interface only gives us a const request
+    // but we need to be able to move messages out of the request for efficiency.
+    auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
+    auto consensus_resp = resp->mutable_consensus_response(i);
+    if (consensus_req->ops_size() != 0) {
+      if (inline_data_request < 0) {
+        inline_data_request = i;
         continue;
       }
-      auto consensus = *consensus_res;
-
-      Status s = consensus->Update(
-        consensus_req, consensus_resp, context.GetClientDeadline());
-      if (PREDICT_FALSE(!s.ok())) {
-        // Clear the response first, since a partially-filled response could
-        // result in confusing a caller, or in having missing required fields
-        // in embedded optional messages.
-        consensus_resp->Clear();
-        SetupError(consensus_resp->mutable_error(), s);
+      state->pending.fetch_add(1, std::memory_order_acq_rel);
+      auto submit_status = multi_raft_update_pool_->SubmitFunc(
+          [this, state, consensus_req, consensus_resp, requestor_string, deadline] {
+        UpdateConsensusFromBatch(consensus_req, consensus_resp, requestor_string, deadline);
+        state->UpdateDone();
+      });
+      if (submit_status.ok()) {
         continue;
       }
-
-      CompleteUpdateConsensusResponse(tablet_peer, consensus_resp);
+      state->pending.fetch_sub(1, std::memory_order_acq_rel);
     }
-    context.RespondSuccess();
+    UpdateConsensusFromBatch(consensus_req, consensus_resp, requestor_string, deadline);
+  }
+  if (inline_data_request >= 0) {
+    UpdateConsensusFromBatch(
+        const_cast<ConsensusRequestPB*>(&req->consensus_request(inline_data_request)),
+        resp->mutable_consensus_response(inline_data_request), requestor_string, deadline);
+  }
+  state->UpdateDone();
 }
 
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
@@ -3023,13 +3084,15 @@ void TabletServiceImpl::TakeTransaction(const TakeTransactionRequestPB* req,
 void TabletServiceImpl::GetSplitKey(
     const GetSplitKeyRequestPB* req, GetSplitKeyResponsePB* resp, RpcContext context) {
   PerformAtLeader(req, resp, &context,
-      [resp](const LeaderTabletPeer& leader_tablet_peer) -> Status {
+      [req, resp](const LeaderTabletPeer& leader_tablet_peer) -> Status {
         const auto& tablet = leader_tablet_peer.tablet;
 
         if (tablet->MayHaveOrphanedPostSplitData()) {
           return STATUS(IllegalState, "Tablet has orphaned post-split data");
         }
-        const auto split_encoded_key = VERIFY_RESULT(tablet->GetEncodedMiddleSplitKey());
+        const auto split_encoded_key = VERIFY_RESULT(
+            req->split_by_load() ? tablet->GetEncodedLoadSplitKey()
+                                 : tablet->GetEncodedMiddleSplitKey());
         resp->set_split_encoded_key(split_encoded_key);
         const auto doc_key_hash = VERIFY_RESULT(docdb::DecodeDocKeyHash(split_encoded_key));
         if (doc_key_hash.has_value()) {
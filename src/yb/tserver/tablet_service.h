@@ -58,10 +58,13 @@
 #include "yb/tserver/tserver_forward_service.service.h"
 #include "yb/tserver/tserver_service.service.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tserver {
 
@@ -342,7 +345,18 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
  private:
   void CompleteUpdateConsensusResponse(std::shared_ptr<tablet::TabletPeer> tablet_peer,
                                        consensus::ConsensusResponsePB* resp);
+
+  // Performs a single update from the multi-raft batch, filling its response.
+  void UpdateConsensusFromBatch(consensus::ConsensusRequestPB* req,
+                                consensus::ConsensusResponsePB* resp,
+                                const std::string& requestor_string,
+                                CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
+
+  // Runs data-bearing updates of multi-raft batches, so updates of different tablets wait for
+  // their WAL writes concurrently.
+  std::unique_ptr<ThreadPool> multi_raft_update_pool_;
 };
 
 class TabletServerForwardServiceImpl : public TabletServerForwardServiceIf {
@@ -53,6 +53,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
@@ -61,6 +62,7 @@
 #include "yb/consensus/state_change_context.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/fs/fs_manager.h"
 
@@ -218,6 +220,14 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
 DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_bool(bootstrap_largest_tablets_first, true,
+            "Set to true to bootstrap tablets in the order of decreasing size of their WAL on "
+            "startup, so tablets with long log replay do not delay the end of the startup while "
+            "other bootstrap threads are idle.");
+TAG_FLAG(bootstrap_largest_tablets_first, advanced);
+
+DECLARE_bool(log_group_sync_across_tablets);
+
 namespace yb {
 namespace tserver {
 
@@ -350,6 +360,9 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_min_threads(1)
                .unlimited_threads()
                .Build(&tablet_prepare_pool_));
+  if (FLAGS_log_group_sync_across_tablets) {
+    log_sync_groups_ = std::make_unique<log::LogSyncGroups>(server_->metric_entity());
+  }
   CHECK_OK(ThreadPoolBuilder("append")
                .set_min_threads(1)
                .unlimited_threads()
@@ -392,6 +405,26 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
 TSTabletManager::~TSTabletManager() {
 }
 
+namespace {
+
+// Estimates the amount of log that tablet bootstrap would have to replay by the size of WAL dir.
+uint64_t EstimateLogReplaySize(Env* env, const RaftGroupMetadata& meta) {
+  auto children = env->GetChildren(meta.wal_dir(), ExcludeDots::kTrue);
+  if (!children.ok()) {
+    return 0;
+  }
+  uint64_t result = 0;
+  for (const auto& child : *children) {
+    auto size = env->GetFileSize(JoinPathSegments(meta.wal_dir(), child));
+    if (size.ok()) {
+      result += *size;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 Status TSTabletManager::Init() {
   CHECK_EQ(state(), MANAGER_INITIALIZING);
 
@@ -411,6 +444,7 @@ Status TSTabletManager::Init() {
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
+  tablet_options_.wait_for_graph = std::make_shared<docdb::WaitForGraph>();
 
   // Start the threadpool we'll use to open tablets.
   // This has to be done in Init() instead of the constructor, since the
@@ -434,6 +468,10 @@ Status TSTabletManager::Init() {
                 .set_max_threads(max_bootstrap_threads)
                 .set_metrics(std::move(bootstrap_metrics))
                 .Build(&open_tablet_pool_));
+  RETURN_NOT_OK(ThreadPoolBuilder("bootstrap-read")
+                .set_max_threads(max_bootstrap_threads)
+                .Build(&bootstrap_read_ahead_pool_));
+  bootstrap_metrics_ = std::make_unique<tablet::TabletBootstrapMetrics>(server_->metric_entity());
 
   CleanupCheckpoints();
 
@@ -445,7 +483,8 @@ Status TSTabletManager::Init() {
 
   multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(server_->messenger(),
                                                                       &server_->proxy_cache(),
-                                                                      local_peer_pb_.cloud_info());
+                                                                      local_peer_pb_.cloud_info(),
+                                                                      server_->metric_entity());
 
   deque<RaftGroupMetadataPtr> metas;
 
@@ -476,6 +515,27 @@ Status TSTabletManager::Init() {
     }
   }
 
+  if (FLAGS_bootstrap_largest_tablets_first) {
+    std::unordered_map<const RaftGroupMetadata*, uint64_t> replay_sizes;
+    for (const auto& meta : metas) {
+      replay_sizes[meta.get()] = EstimateLogReplaySize(fs_manager_->env(), *meta);
+    }
+    const bool status_tablets_first = FLAGS_enable_restart_transaction_status_tablets_first;
+    std::stable_sort(
+        metas.begin(), metas.end(),
+        [&replay_sizes, status_tablets_first](
+            const RaftGroupMetadataPtr& lhs, const RaftGroupMetadataPtr& rhs) {
+      if (status_tablets_first) {
+        const bool lhs_status_tablet = lhs->table_type() == TRANSACTION_STATUS_TABLE_TYPE;
+        const bool rhs_status_tablet = rhs->table_type() == TRANSACTION_STATUS_TABLE_TYPE;
+        if (lhs_status_tablet != rhs_status_tablet) {
+          return lhs_status_tablet;
+        }
+      }
+      return replay_sizes[lhs.get()] > replay_sizes[rhs.get()];
+    });
+  }
+
   MonoDelta elapsed = MonoTime::Now().GetDeltaSince(start);
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
             << elapsed.ToMilliseconds() << " ms";
@@ -1378,6 +1438,9 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .append_pool = append_pool(),
       .allocation_pool = allocation_pool_.get(),
       .retryable_requests = &retryable_requests,
+      .read_ahead_pool = bootstrap_read_ahead_pool_.get(),
+      .metrics = bootstrap_metrics_.get(),
+      .log_sync_groups = log_sync_groups_.get(),
     };
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
     if (!s.ok()) {
@@ -1529,6 +1592,7 @@ void TSTabletManager::StartShutdown() {
 
   // Shut down the bootstrap pool, so new tablets are registered after this point.
   open_tablet_pool_->Shutdown();
+  bootstrap_read_ahead_pool_->Shutdown();
 
   // Take a snapshot of the peers list -- that way we don't have to hold
   // on to the lock while shutting them down, which might cause a lock
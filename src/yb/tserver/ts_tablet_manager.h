@@ -48,6 +48,7 @@
 #include "yb/common/snapshot.h"
 
 #include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/log_fwd.h"
 #include "yb/consensus/metadata.pb.h"
 
 #include "yb/gutil/macros.h"
@@ -544,6 +545,11 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool used to open the tablets async, whether bootstrap is required or not.
   std::unique_ptr<ThreadPool> open_tablet_pool_;
 
+  // Thread pool used by tablet bootstrap to read log segments ahead of replay.
+  std::unique_ptr<ThreadPool> bootstrap_read_ahead_pool_;
+
+  std::unique_ptr<tablet::TabletBootstrapMetrics> bootstrap_metrics_;
+
   // Thread pool for preparing transactions, shared between all tablets.
   std::unique_ptr<ThreadPool> tablet_prepare_pool_;
 
@@ -553,6 +559,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool for Raft-related operations, shared between all tablets.
   std::unique_ptr<ThreadPool> raft_pool_;
 
+  // Groups syncs of logs located on the same WAL disk, if enabled. Used by logs of all tablets, so
+  // it is destroyed after the thread pools they use.
+  std::unique_ptr<log::LogSyncGroups> log_sync_groups_;
+
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
@@ -18,6 +18,7 @@
 #include "yb/master/master_heartbeat.pb.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_load_tracker.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 
@@ -62,11 +63,24 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool should_add_tablet_data =
       FLAGS_tserver_heartbeat_metrics_add_drive_data && no_full_tablet_report;
 
+  // Calculate the read and write ops per second.
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
 
+  std::unordered_map<TabletId, TabletOps> tablet_ops;
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
       if (tablet) {
+        auto& load_tracker = tablet->load_tracker();
+        auto& ops = tablet_ops[tablet_peer->tablet_id()];
+        ops.reads = load_tracker.num_ops(tablet::TabletLoadType::kRead);
+        ops.writes = load_tracker.num_ops(tablet::TabletLoadType::kWrite);
+        auto prev_it = prev_tablet_ops_.find(tablet_peer->tablet_id());
+        TabletOps prev_ops = prev_it != prev_tablet_ops_.end() ? prev_it->second : TabletOps();
+        // Keep only the load distribution of recent operations.
+        load_tracker.Decay();
+
         auto sizes = tablet->GetCurrentVersionSstFilesAllSizes();
         total_file_sizes += sizes.first;
         uncompressed_file_sizes += sizes.second;
@@ -81,10 +95,17 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
           tablet_metadata->set_uncompressed_sst_file_size(sizes.second);
           tablet_metadata->set_may_have_orphaned_post_split_data(
                 tablet->MayHaveOrphanedPostSplitData());
+          if (div > 0) {
+            tablet_metadata->set_read_ops_per_sec(
+                static_cast<double>(ops.reads - prev_ops.reads) / div);
+            tablet_metadata->set_write_ops_per_sec(
+                static_cast<double>(ops.writes - prev_ops.writes) / div);
+          }
         }
       }
     }
   }
+  prev_tablet_ops_ = std::move(tablet_ops);
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
@@ -98,10 +119,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
       TabletServerServiceRpcMethodIndexes::kWrite);
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
-  // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
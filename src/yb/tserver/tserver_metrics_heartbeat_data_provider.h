@@ -15,6 +15,9 @@
 #define YB_TSERVER_TSERVER_METRICS_HEARTBEAT_DATA_PROVIDER_H
 
 #include <memory>
+#include <unordered_map>
+
+#include "yb/common/entity_ids_types.h"
 
 #include "yb/tserver/heartbeater.h"
 
@@ -36,6 +39,14 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
   // Stores the total read and writes ops for computing iops.
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
+
+  struct TabletOps {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+  };
+
+  // Stores the total read and write ops of each tablet for computing per tablet iops.
+  std::unordered_map<TabletId, TabletOps> prev_tablet_ops_;
 };
 
 } // namespace tserver
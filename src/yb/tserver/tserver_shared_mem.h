@@ -18,6 +18,7 @@
 
 #include <boost/asio/ip/tcp.hpp>
 
+#include "yb/tserver/pg_client_shared_mem.h"
 #include "yb/tserver/tserver_util_fwd.h"
 
 #include "yb/util/atomic.h"
@@ -72,6 +73,14 @@ class TServerSharedData {
     return postgres_auth_key_;
   }
 
+  PgSharedMemRing& pg_client_ring(size_t slot) {
+    return pg_client_rings_[slot];
+  }
+
+  const PgSharedMemRing& pg_client_ring(size_t slot) const {
+    return pg_client_rings_[slot];
+  }
+
  private:
   // Endpoint that should be used by local processes to access this tserver.
   Endpoint endpoint_;
@@ -79,6 +88,9 @@ class TServerSharedData {
 
   std::atomic<uint64_t> catalog_version_{0};
   uint64_t postgres_auth_key_;
+
+  // Response rings of postgres backends, assigned to PgClientService sessions.
+  PgSharedMemRing pg_client_rings_[kPgClientSharedMemSlots];
 };
 
 }  // namespace tserver
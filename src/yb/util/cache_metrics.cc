@@ -59,6 +59,11 @@ METRIC_DEFINE_counter(server, block_cache_hits_caching,
                       "Number of lookups that were expecting a block that found one."
                       "Use this number instead of cache_hits when trying to determine how "
                       "efficient the cache is");
+METRIC_DEFINE_counter(server, block_cache_admission_rejects,
+                      "Block Cache Admission Rejects", yb::MetricUnit::kBlocks,
+                      "Number of blocks that were not added to the cache by the admission policy, "
+                      "because they were accessed less frequently than the blocks they would "
+                      "evict");
 
 METRIC_DEFINE_gauge_uint64(server, block_cache_usage, "Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
@@ -83,6 +88,7 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(cache_hits_caching, block_cache_hits_caching),
     MINIT(cache_misses, block_cache_misses),
     MINIT(cache_misses_caching, block_cache_misses_caching),
+    MINIT(admission_rejects, block_cache_admission_rejects),
     GINIT(cache_usage, block_cache_usage),
     GINIT(single_touch_cache_usage, block_cache_single_touch_usage),
     GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage) {
@@ -54,6 +54,7 @@ struct CacheMetrics {
   scoped_refptr<Counter> cache_hits_caching;
   scoped_refptr<Counter> cache_misses;
   scoped_refptr<Counter> cache_misses_caching;
+  scoped_refptr<Counter> admission_rejects;
 
   scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
   scoped_refptr<AtomicGauge<uint64_t> > single_touch_cache_usage;
@@ -1293,7 +1293,8 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
     return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
   }
 
-  // Set the values for columns.
+  // Set the values for columns, from the execution template of the statement when possible.
+  bool templated = false;
   if (tnode->InsertingValue()->opcode() == TreeNodeOpcode::kPTInsertJsonClause) {
     // Error messages are already formatted and don't need additional wrap
     RETURN_NOT_OK(
@@ -1301,7 +1302,10 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
                              static_cast<PTInsertJsonClause*>(tnode->InsertingValue().get()),
                              req));
   } else {
-    s = ColumnArgsToPB(tnode, req);
+    s = WriteTemplateToPB(tnode, req, &templated);
+    if (s.ok() && !templated) {
+      s = ColumnArgsToPB(tnode, req);
+    }
     if (PREDICT_FALSE(!s.ok())) {
       // Note: INVALID_ARGUMENTS is retryable error code (due to mapping into STALE_METADATA),
       //       INVALID_REQUEST - non-retryable.
@@ -1314,9 +1318,11 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_conte
   }
 
   // Setup the column values that need to be read.
-  s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  if (!templated) {
+    s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   // Set the IF clause.
@@ -1355,22 +1361,32 @@ Status Executor::ExecPTNode(const PTDeleteStmt *tnode, TnodeContext* tnode_conte
     return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
   }
 
-  // Where clause - Hash, range, and regular columns.
-  // NOTE: Currently, where clause for write op doesn't allow regular columns.
-  s = WhereClauseToPB(req, tnode->key_where_ops(), tnode->where_ops(),
-                      tnode->subscripted_col_where_ops());
+  // Set the key, the deleted columns and the column values that need to be read from the
+  // execution template of the statement when possible.
+  bool templated = false;
+  s = WriteTemplateToPB(tnode, req, &templated);
   if (PREDICT_FALSE(!s.ok())) {
     return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
   }
 
-  // Setup the column values that need to be read.
-  s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
-  }
-  s = ColumnArgsToPB(tnode, req);
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  if (!templated) {
+    // Where clause - Hash, range, and regular columns.
+    // NOTE: Currently, where clause for write op doesn't allow regular columns.
+    s = WhereClauseToPB(req, tnode->key_where_ops(), tnode->where_ops(),
+                        tnode->subscripted_col_where_ops());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
+
+    // Setup the column values that need to be read.
+    s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
+    s = ColumnArgsToPB(tnode, req);
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   // Set the IF clause.
@@ -1403,10 +1419,17 @@ Status Executor::ExecPTNode(const PTUpdateStmt *tnode, TnodeContext* tnode_conte
   YBqlWriteOpPtr update_op(table->NewQLUpdate());
   QLWriteRequestPB *req = update_op->mutable_request();
 
+  // Set the key, the columns' new values and the column values that need to be read from the
+  // execution template of the statement when possible.
+  bool templated = false;
+  Status s = WriteTemplateToPB(tnode, req, &templated);
+
   // Where clause - Hash, range, and regular columns.
   // NOTE: Currently, where clause for write op doesn't allow regular columns.
-  Status s = WhereClauseToPB(req, tnode->key_where_ops(), tnode->where_ops(),
-                             tnode->subscripted_col_where_ops());
+  if (s.ok() && !templated) {
+    s = WhereClauseToPB(req, tnode->key_where_ops(), tnode->where_ops(),
+                        tnode->subscripted_col_where_ops());
+  }
   if (PREDICT_FALSE(!s.ok())) {
     return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
   }
@@ -1424,9 +1447,11 @@ Status Executor::ExecPTNode(const PTUpdateStmt *tnode, TnodeContext* tnode_conte
   }
 
   // Setup the columns' new values.
-  s = ColumnArgsToPB(tnode, update_op->mutable_request());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  if (!templated) {
+    s = ColumnArgsToPB(tnode, update_op->mutable_request());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   if (req->column_values_size() == 0) {
@@ -1474,9 +1499,11 @@ Status Executor::ExecPTNode(const PTUpdateStmt *tnode, TnodeContext* tnode_conte
   }
 
   // Setup the column values that need to be read.
-  s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  if (!templated) {
+    s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+    }
   }
 
   // Set the IF clause.
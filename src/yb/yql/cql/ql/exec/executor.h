@@ -36,6 +36,7 @@
 #include "yb/util/memory/mc_types.h"
 
 #include "yb/yql/cql/ql/exec/exec_fwd.h"
+#include "yb/yql/cql/ql/exec/write_template.h"
 #include "yb/yql/cql/ql/ptree/ptree_fwd.h"
 #include "yb/yql/cql/ql/ptree/pt_expr_types.h"
 #include "yb/yql/cql/ql/util/util_fwd.h"
@@ -368,6 +369,24 @@ class Executor : public QLExprExecutor {
                                       const PTInsertJsonClause *json_clause,
                                       QLWriteRequestPB *req);
 
+  //------------------------------------------------------------------------------------------------
+  // Write templates.
+
+  // Fill the key and column values and the referenced columns of the write request from the
+  // execution template of the statement. Sets applied to false when the template could not be used
+  // and the request should be filled by the regular path.
+  CHECKED_STATUS WriteTemplateToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req, bool *applied);
+
+  // Build the execution template of the statement.
+  std::shared_ptr<const WriteTemplate> BuildWriteTemplate(const PTDmlStmt *tnode);
+
+  // Convert the value expression to protobuf in the template, registering a bind slot for bind
+  // variables. Returns false when the expression could not be a part of the template.
+  bool WriteTemplateExprToPB(const PTExprPtr& expr,
+                             const WriteTemplate::BindSlot& slot,
+                             QLExpressionPB *expr_pb,
+                             WriteTemplate *write_template);
+
   //------------------------------------------------------------------------------------------------
   // Where clause evaluation.
 
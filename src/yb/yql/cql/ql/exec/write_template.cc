@@ -0,0 +1,229 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/cql/ql/exec/write_template.h"
+
+#include "yb/common/ql_value.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/result.h"
+
+#include "yb/yql/cql/ql/exec/exec_context.h"
+#include "yb/yql/cql/ql/exec/executor.h"
+#include "yb/yql/cql/ql/ptree/column_arg.h"
+#include "yb/yql/cql/ql/ptree/column_desc.h"
+#include "yb/yql/cql/ql/ptree/pt_dml.h"
+#include "yb/yql/cql/ql/ptree/pt_expr.h"
+#include "yb/yql/cql/ql/ptree/pt_insert.h"
+#include "yb/yql/cql/ql/util/statement_params.h"
+
+DEFINE_bool(ycql_use_write_template, true,
+            "Build the write request of INSERT, UPDATE and DELETE statements with bind variables "
+            "from an execution template cached with the statement, patching only the bound "
+            "values on each execution.");
+TAG_FLAG(ycql_use_write_template, advanced);
+TAG_FLAG(ycql_use_write_template, runtime);
+
+namespace yb {
+namespace ql {
+
+namespace {
+
+QLExpressionPB* SlotExpr(const WriteTemplate::BindSlot& slot, QLWriteRequestPB* req) {
+  switch (slot.kind) {
+    case WriteTemplate::SlotKind::kHashedColumn:
+      return req->mutable_hashed_column_values(slot.index);
+    case WriteTemplate::SlotKind::kRangeColumn:
+      return req->mutable_range_column_values(slot.index);
+    case WriteTemplate::SlotKind::kColumnValue:
+      return req->mutable_column_values(slot.index)->mutable_expr();
+  }
+  FATAL_INVALID_ENUM_VALUE(WriteTemplate::SlotKind, slot.kind);
+}
+
+// Returns the slot of the expression just added to the request for the specified column.
+WriteTemplate::BindSlot LastSlot(const ColumnDesc& col_desc, const QLWriteRequestPB& req) {
+  WriteTemplate::BindSlot slot;
+  if (col_desc.is_hash()) {
+    slot.kind = WriteTemplate::SlotKind::kHashedColumn;
+    slot.index = req.hashed_column_values_size() - 1;
+  } else if (col_desc.is_primary()) {
+    slot.kind = WriteTemplate::SlotKind::kRangeColumn;
+    slot.index = req.range_column_values_size() - 1;
+  } else {
+    slot.kind = WriteTemplate::SlotKind::kColumnValue;
+    slot.index = req.column_values_size() - 1;
+  }
+  slot.bind_var = nullptr;
+  slot.column_arg = false;
+  slot.not_null = false;
+  return slot;
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+
+bool Executor::WriteTemplateExprToPB(const PTExprPtr& expr,
+                                     const WriteTemplate::BindSlot& slot,
+                                     QLExpressionPB *expr_pb,
+                                     WriteTemplate *write_template) {
+  if (expr == nullptr) {
+    // Column deleted by DELETE statement, there is no value to set.
+    return true;
+  }
+  if (expr->index_desc() != nullptr) {
+    return false;
+  }
+
+  switch (expr->expr_op()) {
+    case ExprOperator::kBindVar: {
+      const PTBindVar* bind_pt = static_cast<const PTBindVar*>(expr.get());
+      if (!bind_pt->name()) {
+        return false;
+      }
+      write_template->bind_slots.push_back(slot);
+      write_template->bind_slots.back().bind_var = bind_pt;
+      return true;
+    }
+
+    case ExprOperator::kConst:
+      // Constants are converted once. Null primary key values are left for the regular path, that
+      // reports the error.
+      if (!PTExprToPB(expr, expr_pb).ok()) {
+        return false;
+      }
+      return !slot.not_null || !expr_pb->has_value() || !IsNull(expr_pb->value());
+
+    default:
+      // Other expressions, e.g. function calls or operators on the old column value, could be
+      // different on every execution.
+      return false;
+  }
+}
+
+std::shared_ptr<const WriteTemplate> Executor::BuildWriteTemplate(const PTDmlStmt *tnode) {
+  auto write_template = std::make_shared<WriteTemplate>();
+
+  // Statements without bind variables are usually executed once, so the template is not worth
+  // building.
+  if (tnode->bind_variables().empty() ||
+      !tnode->where_ops().empty() ||
+      !tnode->subscripted_col_where_ops().empty() ||
+      !tnode->subscripted_col_args().empty() ||
+      !tnode->json_col_args().empty()) {
+    return write_template;
+  }
+  if (tnode->opcode() == TreeNodeOpcode::kPTInsertStmt &&
+      static_cast<const PTInsertStmt*>(tnode)->InsertingValue()->opcode() ==
+          TreeNodeOpcode::kPTInsertJsonClause) {
+    return write_template;
+  }
+
+  QLWriteRequestPB *req = &write_template->request;
+
+  // Key columns of UPDATE and DELETE statements.
+  for (const auto& op : tnode->key_where_ops()) {
+    const ColumnDesc *col_desc = op.desc();
+    QLExpressionPB *col_expr_pb;
+    if (col_desc->is_hash()) {
+      col_expr_pb = req->add_hashed_column_values();
+    } else if (col_desc->is_primary()) {
+      col_expr_pb = req->add_range_column_values();
+    } else {
+      return write_template;
+    }
+    if (!WriteTemplateExprToPB(op.expr(), LastSlot(*col_desc, *req), col_expr_pb,
+                               write_template.get())) {
+      return write_template;
+    }
+  }
+
+  // Values assigned to columns.
+  for (const ColumnArg& col : tnode->column_args()) {
+    if (!col.IsInitialized()) {
+      continue;
+    }
+    const ColumnDesc *col_desc = col.desc();
+    QLExpressionPB *expr_pb = CreateQLExpression(req, *col_desc);
+    auto slot = LastSlot(*col_desc, *req);
+    slot.column_arg = true;
+    slot.not_null = col_desc->is_primary();
+    if (!WriteTemplateExprToPB(col.expr(), slot, expr_pb, write_template.get())) {
+      return write_template;
+    }
+  }
+
+  if (!ColumnRefsToPB(tnode, req->mutable_column_refs()).ok()) {
+    return write_template;
+  }
+
+  VLOG(3) << "Built write template: " << req->ShortDebugString()
+          << ", bind slots: " << write_template->bind_slots.size();
+  write_template->supported = true;
+  return write_template;
+}
+
+Status Executor::WriteTemplateToPB(const PTDmlStmt *tnode, QLWriteRequestPB *req, bool *applied) {
+  *applied = false;
+  if (!FLAGS_ycql_use_write_template) {
+    return Status::OK();
+  }
+
+  auto write_template = tnode->write_template();
+  if (!write_template) {
+    // Concurrent executions of the same statement could build the template simultaneously, the
+    // templates they build are the same.
+    write_template = BuildWriteTemplate(tnode);
+    tnode->set_write_template(write_template);
+  }
+  if (!write_template->supported) {
+    return Status::OK();
+  }
+
+  // Unset values are skipped by the request, so fall back to the regular path in this case.
+  const StatementParameters& params = exec_context_->params();
+  for (const auto& slot : write_template->bind_slots) {
+    if (slot.column_arg &&
+        VERIFY_RESULT(params.IsBindVariableUnset(slot.bind_var->name()->c_str(),
+                                                 slot.bind_var->pos()))) {
+      return Status::OK();
+    }
+  }
+
+  req->MergeFrom(write_template->request);
+  for (const auto& slot : write_template->bind_slots) {
+    QLValue ql_bind;
+    RETURN_NOT_OK(params.GetBindVariable(slot.bind_var->name()->c_str(),
+                                         slot.bind_var->pos(),
+                                         slot.bind_var->ql_type(),
+                                         &ql_bind));
+    QLExpressionPB *expr_pb = SlotExpr(slot, req);
+    *expr_pb->mutable_value() = std::move(*ql_bind.mutable_value());
+
+    // Null values not allowed for primary key: checking here catches nulls introduced by bind.
+    if (slot.not_null && IsNull(expr_pb->value())) {
+      LOG(INFO) << "Unexpected null value. Current request: " << req->DebugString();
+      return exec_context_->Error(tnode, ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY);
+    }
+  }
+
+  *applied = true;
+  return Status::OK();
+}
+
+}  // namespace ql
+}  // namespace yb
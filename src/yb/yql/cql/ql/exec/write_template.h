@@ -0,0 +1,74 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// Execution template of an INSERT, UPDATE or DELETE statement.
+//
+// Executing a write statement walks the parse tree to build the write request protobuf. For
+// statements whose key and column values are all constants or bind variables, the request is the
+// same for every execution except for the bound values. So the executor builds the request once,
+// when the statement is executed the first time, and keeps it with the parse tree together with
+// the positions of the bind variables in it. Following executions copy the prebuilt request and
+// only patch the bound values, without walking the expressions of the parse tree.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_YQL_CQL_QL_EXEC_WRITE_TEMPLATE_H_
+#define YB_YQL_CQL_QL_EXEC_WRITE_TEMPLATE_H_
+
+#include <vector>
+
+#include "yb/common/ql_protocol.pb.h"
+
+#include "yb/yql/cql/ql/ptree/ptree_fwd.h"
+
+namespace yb {
+namespace ql {
+
+struct WriteTemplate {
+  // Repeated field of the request that contains a bound value.
+  enum class SlotKind {
+    kHashedColumn,
+    kRangeColumn,
+    kColumnValue,
+  };
+
+  struct BindSlot {
+    SlotKind kind;
+
+    // Index of the value in the repeated field.
+    int index;
+
+    const PTBindVar* bind_var;
+
+    // Whether the value is assigned to a column, so could be left unset by the client.
+    bool column_arg;
+
+    // Whether null values should be rejected, i.e. the value is a primary key column assigned by
+    // INSERT.
+    bool not_null;
+  };
+
+  // Whether the statement could be executed using the template. When false, the template only
+  // marks the statement as already checked.
+  bool supported = false;
+
+  // Request with everything but the bound values filled in.
+  QLWriteRequestPB request;
+
+  std::vector<BindSlot> bind_slots;
+};
+
+}  // namespace ql
+}  // namespace yb
+
+#endif  // YB_YQL_CQL_QL_EXEC_WRITE_TEMPLATE_H_
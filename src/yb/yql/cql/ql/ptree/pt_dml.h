@@ -19,6 +19,7 @@
 #define YB_YQL_CQL_QL_PTREE_PT_DML_H_
 
 #include <iosfwd>
+#include <memory>
 
 #include "yb/client/client_fwd.h"
 
@@ -376,6 +377,16 @@ class PTDmlStmt : public PTCollection {
     return select_has_primary_keys_set_;
   }
 
+  // Execution template of the write request, built by the executor on the first execution of the
+  // statement and shared by all its executions afterwards. The parse tree is read-only during
+  // execution, so the template is cached through a mutable atomically accessed pointer.
+  std::shared_ptr<const WriteTemplate> write_template() const {
+    return std::atomic_load(&write_template_);
+  }
+  void set_write_template(std::shared_ptr<const WriteTemplate> write_template) const {
+    std::atomic_store(&write_template_, std::move(write_template));
+  }
+
  protected:
 
   template <typename T>
@@ -506,6 +517,8 @@ class PTDmlStmt : public PTCollection {
   // key columns set with '=' or 'IN' conditions.
   bool select_has_primary_keys_set_ = false;
   bool has_incomplete_hash_ = false;
+
+  mutable std::shared_ptr<const WriteTemplate> write_template_;
 };
 
 }  // namespace ql
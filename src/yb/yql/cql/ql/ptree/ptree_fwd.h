@@ -86,6 +86,8 @@ class TreeNode;
 class WhereExprState;
 class YBLocation;
 
+struct WriteTemplate;
+
 template<typename NodeType = TreeNode>
 class TreeListNode;
 
@@ -13,10 +13,14 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include "yb/common/ql_value.h"
+
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/util/async_util.h"
+#include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
+#include "yb/util/stopwatch.h"
 
 #include "yb/yql/cql/ql/statement.h"
 #include "yb/yql/cql/ql/test/ql-test-base.h"
@@ -27,9 +31,67 @@ using std::unique_ptr;
 using std::shared_ptr;
 using strings::Substitute;
 
+DECLARE_bool(ycql_use_write_template);
+
 namespace yb {
 namespace ql {
 
+// Positional bind values for executing prepared statements.
+class TestBindParameters : public StatementParameters {
+ public:
+  void Add(QLValue value) {
+    values_.push_back(std::move(value));
+    unset_.push_back(false);
+  }
+
+  void AddUnset() {
+    values_.emplace_back();
+    unset_.push_back(true);
+  }
+
+  void Clear() {
+    values_.clear();
+    unset_.clear();
+  }
+
+  Result<bool> IsBindVariableUnset(const std::string& name, int64_t pos) const override {
+    RETURN_NOT_OK(CheckPosition(pos));
+    return unset_[pos];
+  }
+
+  CHECKED_STATUS GetBindVariable(const std::string& name,
+                                 int64_t pos,
+                                 const std::shared_ptr<QLType>& type,
+                                 QLValue* value) const override {
+    RETURN_NOT_OK(CheckPosition(pos));
+    *value = values_[pos];
+    return Status::OK();
+  }
+
+ private:
+  CHECKED_STATUS CheckPosition(int64_t pos) const {
+    if (pos < 0 || pos >= static_cast<int64_t>(values_.size())) {
+      return STATUS_FORMAT(InvalidArgument, "Bind variable $0 not found", pos);
+    }
+    return Status::OK();
+  }
+
+  std::vector<QLValue> values_;
+  std::vector<bool> unset_;
+};
+
+QLValue Int32Value(int32_t value) {
+  QLValue result;
+  result.set_int32_value(value);
+  return result;
+}
+
+QLValue StringValue(const std::string& value) {
+  QLValue result;
+  result.set_string_value(value);
+  return result;
+}
+
 class TestQLStatement : public QLTestBase {
  public:
   TestQLStatement() : QLTestBase() {
@@ -125,5 +187,124 @@ TEST_F(TestQLStatement, TestPKIndices) {
   LOG(INFO) << "Done.";
 }
 
+TEST_F(TestQLStatement, TestPreparedWriteTemplate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("create table t (h int, r int, c1 int, c2 text, primary key ((h), r));");
+
+  Statement insert_stmt(processor->CurrentKeyspace(),
+                        "insert into t (h, r, c1, c2) values (?, ?, ?, 'x');");
+  ASSERT_OK(insert_stmt.Prepare(&processor->ql_processor()));
+  Statement update_stmt(processor->CurrentKeyspace(),
+                        "update t set c1 = ?, c2 = ? where h = ? and r = ?;");
+  ASSERT_OK(update_stmt.Prepare(&processor->ql_processor()));
+  Statement delete_stmt(processor->CurrentKeyspace(), "delete c2 from t where h = ? and r = 1;");
+  ASSERT_OK(delete_stmt.Prepare(&processor->ql_processor()));
+
+  // Execute the statements several times, so following executions use the template built by
+  // the first one.
+  TestBindParameters params;
+  for (int i = 0; i != 3; ++i) {
+    params.Clear();
+    params.Add(Int32Value(i));
+    params.Add(Int32Value(1));
+    params.Add(Int32Value(i * 10));
+    ASSERT_OK(processor->Run(insert_stmt, params));
+  }
+  ASSERT_OK(processor->Run("select c1, c2 from t where h = 2 and r = 1;"));
+  auto row_block = processor->row_block();
+  ASSERT_EQ(row_block->row_count(), 1);
+  EXPECT_EQ(20, row_block->row(0).column(0).int32_value());
+  EXPECT_EQ("x", row_block->row(0).column(1).string_value());
+
+  // Unset value should leave the column intact.
+  params.Clear();
+  params.Add(Int32Value(2));
+  params.Add(Int32Value(1));
+  params.AddUnset();
+  ASSERT_OK(processor->Run(insert_stmt, params));
+  ASSERT_OK(processor->Run("select c1 from t where h = 2 and r = 1;"));
+  row_block = processor->row_block();
+  ASSERT_EQ(row_block->row_count(), 1);
+  EXPECT_EQ(20, row_block->row(0).column(0).int32_value());
+
+  // Null primary key value should be rejected.
+  params.Clear();
+  params.Add(Int32Value(3));
+  params.Add(QLValue());
+  params.Add(Int32Value(30));
+  Status s = processor->Run(insert_stmt, params);
+  ASSERT_NOK(s);
+  ASSERT_STR_CONTAINS(s.ToString(), "Null Argument for Primary Key");
+
+  for (int i = 0; i != 3; ++i) {
+    params.Clear();
+    params.Add(Int32Value(i * 100));
+    params.Add(StringValue(Format("v$0", i)));
+    params.Add(Int32Value(i));
+    params.Add(Int32Value(1));
+    ASSERT_OK(processor->Run(update_stmt, params));
+  }
+  ASSERT_OK(processor->Run("select c1, c2 from t where h = 1 and r = 1;"));
+  row_block = processor->row_block();
+  ASSERT_EQ(row_block->row_count(), 1);
+  EXPECT_EQ(100, row_block->row(0).column(0).int32_value());
+  EXPECT_EQ("v1", row_block->row(0).column(1).string_value());
+
+  for (int i = 0; i != 2; ++i) {
+    params.Clear();
+    params.Add(Int32Value(i));
+    ASSERT_OK(processor->Run(delete_stmt, params));
+  }
+  ASSERT_OK(processor->Run("select c1, c2 from t where h = 1 and r = 1;"));
+  row_block = processor->row_block();
+  ASSERT_EQ(row_block->row_count(), 1);
+  EXPECT_EQ(100, row_block->row(0).column(0).int32_value());
+  EXPECT_TRUE(row_block->row(0).column(1).IsNull());
+}
+
+// Compares CPU time per execution of a prepared INSERT with and without the write template.
+TEST_F(TestQLStatement, YB_DISABLE_TEST_IN_SANITIZERS(PreparedWriteBenchmark)) {
+  constexpr int kNumOps = 5000;
+
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("create table bench (h int, r int, c1 int, c2 text, c3 int, c4 text, "
+                  "primary key ((h), r));");
+  Statement stmt(processor->CurrentKeyspace(),
+                 "insert into bench (h, r, c1, c2, c3, c4) values (?, ?, ?, ?, ?, ?);");
+  ASSERT_OK(stmt.Prepare(&processor->ql_processor()));
+
+  TestBindParameters params;
+  for (bool use_template : {false, true}) {
+    FLAGS_ycql_use_write_template = use_template;
+    Stopwatch stopwatch(Stopwatch::ALL_THREADS);
+    stopwatch.start();
+    for (int i = 0; i != kNumOps; ++i) {
+      params.Clear();
+      params.Add(Int32Value(i));
+      params.Add(Int32Value(i));
+      params.Add(Int32Value(i));
+      params.Add(StringValue("value"));
+      params.Add(Int32Value(i));
+      params.Add(StringValue("value"));
+      ASSERT_OK(processor->Run(stmt, params));
+    }
+    stopwatch.stop();
+    const auto times = stopwatch.elapsed();
+    LOG(INFO) << "Write template " << (use_template ? "enabled" : "disabled") << ": "
+              << kNumOps << " ops, per op: wall " << times.wall / kNumOps << " ns, user "
+              << times.user / kNumOps << " ns, system " << times.system / kNumOps << " ns";
+  }
+}
+
 } // namespace ql
 } // namespace yb
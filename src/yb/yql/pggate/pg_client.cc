@@ -29,6 +29,7 @@
 #include "yb/util/result.h"
 #include "yb/util/shared_mem.h"
 #include "yb/util/status.h"
+#include "yb/util/status_format.h"
 
 #include "yb/yql/pggate/pg_tabledesc.h"
 
@@ -58,11 +59,11 @@ class PgClient::Impl {
                        const tserver::TServerSharedObject& tserver_shared_object) {
     CHECK_NOTNULL(&tserver_shared_object);
     MonoDelta resolve_cache_timeout;
-    const auto& tserver_shared_data_ = *tserver_shared_object;
-    HostPort host_port(tserver_shared_data_.endpoint());
+    tserver_shared_data_ = tserver_shared_object.get();
+    HostPort host_port(tserver_shared_data_->endpoint());
     if (FLAGS_use_node_hostname_for_local_tserver) {
-      host_port = HostPort(tserver_shared_data_.host().ToBuffer(),
-                           tserver_shared_data_.endpoint().port());
+      host_port = HostPort(tserver_shared_data_->host().ToBuffer(),
+                           tserver_shared_data_->endpoint().port());
       resolve_cache_timeout = MonoDelta::kMax;
     }
     LOG(INFO) << "Using TServer host_port: " << host_port;
@@ -92,6 +93,8 @@ class PgClient::Impl {
     tserver::PgHeartbeatRequestPB req;
     if (!create) {
       req.set_session_id(session_id_);
+    } else {
+      req.set_use_shared_mem(true);
     }
     proxy_->HeartbeatAsync(
         req, &heartbeat_resp_, PrepareHeartbeatController(),
@@ -101,6 +104,14 @@ class PgClient::Impl {
         if (!status.ok()) {
           create_session_promise_.set_value(status);
         } else {
+          if (heartbeat_resp_.has_shared_mem_slot()) {
+            auto slot = heartbeat_resp_.shared_mem_slot().index();
+            if (slot < tserver::kPgClientSharedMemSlots) {
+              shared_mem_ring_ = &tserver_shared_data_->pg_client_ring(slot);
+            } else {
+              LOG(DFATAL) << "Invalid shared memory slot: " << slot;
+            }
+          }
           create_session_promise_.set_value(heartbeat_resp_.session_id());
         }
       }
@@ -114,10 +125,23 @@ class PgClient::Impl {
   Result<PgTableDescPtr> OpenTable(const PgObjectId& table_id) {
     tserver::PgOpenTableRequestPB req;
     req.set_table_id(table_id.GetYBTableId());
+    req.set_session_id(session_id_);
     tserver::PgOpenTableResponsePB resp;
 
     RETURN_NOT_OK(proxy_->OpenTable(req, &resp, PrepareAdminController()));
     RETURN_NOT_OK(ResponseStatus(resp));
+    auto status = FetchSharedMemResponse(&resp);
+    if (status.IsTryAgain()) {
+      // Response was overwritten in shared memory before we read it, so request it again. Without
+      // session tserver does not use shared memory, so the response is sent over the socket.
+      VLOG(1) << "Retry OpenTable " << table_id << " without shared memory: " << status;
+      req.set_session_id(0);
+      resp.Clear();
+      RETURN_NOT_OK(proxy_->OpenTable(req, &resp, PrepareAdminController()));
+      RETURN_NOT_OK(ResponseStatus(resp));
+      status = FetchSharedMemResponse(&resp);
+    }
+    RETURN_NOT_OK(status);
 
     client::YBTableInfo info;
     RETURN_NOT_OK(client::CreateTableInfoFromTableSchemaResp(resp.info(), &info));
@@ -256,6 +280,28 @@ class PgClient::Impl {
   BOOST_PP_SEQ_FOR_EACH(YB_PG_CLIENT_SIMPLE_METHOD_IMPL, ~, YB_PG_CLIENT_SIMPLE_METHODS);
 
  private:
+  // Replaces the reference to a response stored in the shared memory ring with the response
+  // itself. It is parsed directly from shared memory, without copying it to a local buffer.
+  template <class Resp>
+  CHECKED_STATUS FetchSharedMemResponse(Resp* resp) {
+    if (!resp->has_shared_mem_response()) {
+      return Status::OK();
+    }
+    SCHECK(shared_mem_ring_ != nullptr, IllegalState,
+           "Response in shared memory, while shared memory slot was not assigned");
+    const auto position = resp->shared_mem_response().position();
+    auto data = VERIFY_RESULT(shared_mem_ring_->Get(
+        position, resp->shared_mem_response().size()));
+    Resp result;
+    bool parsed = result.ParseFromArray(data.data(), static_cast<int>(data.size()));
+    if (!shared_mem_ring_->IsValid(position)) {
+      return STATUS_FORMAT(TryAgain, "Shared memory response at $0 was overwritten", position);
+    }
+    SCHECK(parsed, Corruption, "Failed to parse shared memory response");
+    resp->Swap(&result);
+    return Status::OK();
+  }
+
   static rpc::RpcController* SetupAdminController(
       rpc::RpcController* controller, CoarseTimePoint deadline = CoarseTimePoint()) {
     if (deadline != CoarseTimePoint()) {
@@ -281,6 +327,9 @@ class PgClient::Impl {
   std::unique_ptr<tserver::PgClientServiceProxy> proxy_;
   rpc::RpcController controller_;
   uint64_t session_id_ = 0;
+  const tserver::TServerSharedData* tserver_shared_data_ = nullptr;
+  // Ring of this session in tserver shared memory, null if tserver did not assign it.
+  const tserver::PgSharedMemRing* shared_mem_ring_ = nullptr;
 
   rpc::Poller heartbeat_poller_;
   std::atomic<bool> heartbeat_running_{false};
@@ -48,6 +48,23 @@ using yb::client::YBPgsqlWriteOp;
 namespace yb {
 namespace pggate {
 
+uint64_t GrowPrefetchLimit(
+    uint64_t current_limit, uint64_t initial_limit, uint64_t received_rows,
+    uint64_t received_bytes, const boost::optional<uint64_t>& statement_limit) {
+  auto max_limit = std::max<uint64_t>(FLAGS_ysql_adaptive_prefetch_max_rows, initial_limit);
+  if (received_rows > 0) {
+    const auto row_width = std::max<uint64_t>(received_bytes / received_rows, 1);
+    max_limit = std::min(
+        max_limit, std::max(FLAGS_ysql_adaptive_prefetch_max_bytes / row_width, initial_limit));
+  }
+  if (statement_limit) {
+    // Rows beyond LIMIT + OFFSET would be read and sent only to be discarded by postgres.
+    max_limit = std::min(
+        max_limit, *statement_limit > received_rows ? *statement_limit - received_rows : 0);
+  }
+  return std::max(std::min(current_limit * 2, max_limit), current_limit);
+}
+
 PgDocResult::PgDocResult(string&& data) : data_(move(data)) {
   PgDocData::LoadCache(data_, &row_count_, &row_iterator_);
 }
@@ -174,6 +191,7 @@ Result<RequestSent> PgDocOp::Execute(bool force_non_bufferable) {
   // This refers to the sequence of operations between this layer and the underlying tablet
   // server / DocDB layer, not to the sequence of operations between the PostgreSQL layer and this
   // layer.
+  response_prefetched_ = false;
   exec_status_ = SendRequest(force_non_bufferable);
   RETURN_NOT_OK(exec_status_);
   return RequestSent(response_.InProgress());
@@ -186,18 +204,23 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
   if (!end_of_data_) {
     // Send request now in case prefetching was suppressed.
     if (suppress_next_result_prefetching_ && !response_.InProgress()) {
+      response_prefetched_ = false;
       exec_status_ = SendRequest(true /* force_non_bufferable */);
       RETURN_NOT_OK(exec_status_);
     }
 
     DCHECK(response_.InProgress());
-    auto rows = VERIFY_RESULT(ProcessResponse(response_.GetStatus(pg_session_.get())));
+    auto wait_start = MonoTime::Now();
+    auto status = response_.GetStatus(pg_session_.get());
+    response_wait_time_ = MonoTime::Now() - wait_start;
+    auto rows = VERIFY_RESULT(ProcessResponse(status));
     // In case ProcessResponse doesn't fail with an error
     // it should return non empty rows and/or set end_of_data_.
     DCHECK(!rows.empty() || end_of_data_);
     rowsets->splice(rowsets->end(), rows);
     // Prefetch next portion of data if needed.
     if (!(end_of_data_ || suppress_next_result_prefetching_)) {
+      response_prefetched_ = true;
       exec_status_ = SendRequest(true /* force_non_bufferable */);
       RETURN_NOT_OK(exec_status_);
     }
@@ -395,6 +418,7 @@ Result<std::list<PgDocResult>> PgDocReadOp::ProcessResponseImpl() {
 
   // Process paging state and check status.
   RETURN_NOT_OK(ProcessResponseReadStates());
+  AdaptRequestPrefetchLimit(result);
   return result;
 }
 
@@ -918,6 +942,46 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
           << " predicted_limit=" << predicted_limit
           << " limit=" << limit;
   req->set_limit(limit);
+  initial_prefetch_limit_ = limit;
+  prefetch_limit_ = limit;
+}
+
+void PgDocReadOp::AdaptRequestPrefetchLimit(const std::list<PgDocResult>& rowsets) {
+  for (const auto& rowset : rowsets) {
+    received_rows_ += rowset.row_count();
+    received_bytes_ += rowset.data_size();
+  }
+
+  const bool stalled = response_prefetched_ &&
+      response_wait_time_.ToMicroseconds() >= FLAGS_ysql_adaptive_prefetch_stall_threshold_us;
+
+  // A statement LIMIT below the prefetch limit and sampling define the page size themselves.
+  if (!FLAGS_ysql_enable_adaptive_prefetch || !stalled || end_of_data_ ||
+      active_op_count_ == 0 || suppress_next_result_prefetching_ ||
+      template_op_->request().has_sampling_state()) {
+    return;
+  }
+
+  // Postgres consumed the previous page faster than the next one was fetched, so a bigger page
+  // amortizes the round trip better.
+  boost::optional<uint64_t> statement_limit;
+  if (!exec_params_.limit_use_default) {
+    statement_limit = exec_params_.limit_count + exec_params_.limit_offset;
+  }
+  const auto limit = GrowPrefetchLimit(
+      prefetch_limit_, initial_prefetch_limit_, received_rows_, received_bytes_, statement_limit);
+  if (limit <= prefetch_limit_) {
+    return;
+  }
+
+  VLOG(3) << __func__ << " wait=" << response_wait_time_ << " received_rows=" << received_rows_
+          << " received_bytes=" << received_bytes_ << " limit: " << prefetch_limit_ << " -> "
+          << limit;
+  prefetch_limit_ = limit;
+  for (int op_index = 0; op_index < active_op_count_; op_index++) {
+    GetReadOp(op_index)->mutable_request()->set_limit(limit);
+  }
+  template_op_->mutable_request()->set_limit(limit);
 }
 
 void PgDocReadOp::SetRowMark() {
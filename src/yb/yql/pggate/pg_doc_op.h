@@ -20,6 +20,7 @@
 #include <boost/optional.hpp>
 
 #include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/client/yb_op.h"
 #include "yb/yql/pggate/pg_session.h"
 
@@ -73,6 +74,11 @@ class PgDocResult {
     return row_count_;
   }
 
+  // Size of the data selected from DocDB.
+  size_t data_size() const {
+    return data_.size();
+  }
+
  private:
   // Data selected from DocDB.
   string data_;
@@ -94,6 +100,16 @@ class PgDocResult {
   bool syscol_processed_ = false;
 };
 
+//--------------------------------------------------------------------------------------------------
+// Returns the row limit of the next page of a scan that stalled waiting for the prefetched page:
+// current_limit doubled, but at most ysql_adaptive_prefetch_max_rows rows and
+// ysql_adaptive_prefetch_max_bytes bytes, estimated from the average width of the rows received so
+// far. statement_limit is LIMIT + OFFSET of the statement, if any, and the page never asks for more
+// rows than the statement still needs. Returns current_limit if the page should not grow.
+uint64_t GrowPrefetchLimit(
+    uint64_t current_limit, uint64_t initial_limit, uint64_t received_rows,
+    uint64_t received_bytes, const boost::optional<uint64_t>& statement_limit);
+
 //--------------------------------------------------------------------------------------------------
 // Doc operation API
 // Classes
@@ -315,6 +331,11 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Next request will be sent in case upper level will ask for additional data.
   bool suppress_next_result_prefetching_ = false;
 
+  // Whether the last response was prefetched, i.e. its request was sent right after the previous
+  // response was processed, and how long GetResult waited for it.
+  bool response_prefetched_ = false;
+  MonoDelta response_wait_time_;
+
   // Populated protobuf request.
   std::vector<std::shared_ptr<client::YBPgsqlOp>> pgsql_ops_;
 
@@ -460,6 +481,11 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Grow the prefetch limit of active operators when postgres had to wait for the prefetched page.
+  // The limit is bounded by the number of rows and by the page size, estimated using the average
+  // width of rows received so far.
+  void AdaptRequestPrefetchLimit(const std::list<PgDocResult>& rowsets);
+
   // Set the backfill_spec field of our read request.
   void SetBackfillSpec();
 
@@ -487,6 +513,14 @@ class PgDocReadOp : public PgDocOp {
   // Template operation, used to fill in pgsql_ops_ by either assigning or cloning.
   std::shared_ptr<client::YBPgsqlReadOp> template_op_;
 
+  // Row limit that SetRequestPrefetchLimit picked, and the current one after adaptation.
+  uint64_t initial_prefetch_limit_ = 0;
+  uint64_t prefetch_limit_ = 0;
+
+  // Rows and bytes received by this operator, used to estimate row width.
+  uint64_t received_rows_ = 0;
+  uint64_t received_bytes_ = 0;
+
   // While sampling is in progress, number of scanned row is accumulated in this variable.
   // After completion the value is extrapolated to account for not scanned partitions and estimate
   // total number of rows in the table.
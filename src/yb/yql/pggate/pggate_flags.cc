@@ -18,8 +18,11 @@
 #include <gflags/gflags.h>
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -53,6 +56,24 @@ DEFINE_uint64(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_bool(ysql_enable_adaptive_prefetch, true,
+            "Grow the number of rows requested per page of a scan when postgres has to wait for "
+            "the prefetched page");
+TAG_FLAG(ysql_enable_adaptive_prefetch, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_max_rows, 16384,
+              "Maximum number of rows adaptive prefetch could request per page");
+TAG_FLAG(ysql_adaptive_prefetch_max_rows, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_max_bytes, 4_MB,
+              "Adaptive prefetch does not grow the page beyond this size, estimated using the "
+              "average row width of previous pages");
+TAG_FLAG(ysql_adaptive_prefetch_max_bytes, advanced);
+
+DEFINE_int32(ysql_adaptive_prefetch_stall_threshold_us, 500,
+             "Wait for a prefetched page longer than this is considered a read pipeline stall");
+TAG_FLAG(ysql_adaptive_prefetch_stall_threshold_us, advanced);
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
@@ -15,8 +15,11 @@
 
 #include "yb/common/ybc-internal.h"
 
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 
+#include "yb/yql/pggate/pg_doc_op.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/test/pggate_test.h"
 #include "yb/yql/pggate/ybc_pggate.h"
 
@@ -269,5 +272,39 @@ TEST_F(PggateTestSelect, TestSelectOneTablet) {
   pg_stmt = nullptr;
 }
 
+// The page of a stalled scan grows up to the configured bounds, but never asks for more rows than
+// LIMIT + OFFSET of the statement still needs.
+TEST_F(PggateTestSelect, GrowPrefetchLimit) {
+  FLAGS_ysql_adaptive_prefetch_max_rows = 16384;
+  FLAGS_ysql_adaptive_prefetch_max_bytes = 4_MB;
+  constexpr uint64_t kInitialLimit = 1024;
+  constexpr uint64_t kRowWidth = 100;
+
+  // Without LIMIT the page doubles up to ysql_adaptive_prefetch_max_rows.
+  ASSERT_EQ(2048U, GrowPrefetchLimit(
+      kInitialLimit, kInitialLimit, 1024, 1024 * kRowWidth, boost::none));
+  ASSERT_EQ(16384U, GrowPrefetchLimit(
+      16384, kInitialLimit, 30000, 30000 * kRowWidth, boost::none));
+
+  // Wide rows are bounded by ysql_adaptive_prefetch_max_bytes.
+  ASSERT_EQ(4096U, GrowPrefetchLimit(
+      4096, kInitialLimit, 1000, 1000 * 1_KB, boost::none));
+
+  // Small LIMIT: the statement limit is the initial page, which does not grow.
+  ASSERT_EQ(100U, GrowPrefetchLimit(100, 100, 100, 100 * kRowWidth, 100U));
+
+  // Large LIMIT: the page grows only up to the rows the statement still needs.
+  ASSERT_EQ(2048U, GrowPrefetchLimit(
+      kInitialLimit, kInitialLimit, 1024, 1024 * kRowWidth, 5000U));
+  ASSERT_EQ(3000U, GrowPrefetchLimit(2048, kInitialLimit, 2000, 2000 * kRowWidth, 5000U));
+  ASSERT_EQ(2048U, GrowPrefetchLimit(2048, kInitialLimit, 3072, 3072 * kRowWidth, 5000U));
+
+  // OFFSET rows are read by the scan too, so they are counted as needed.
+  ASSERT_EQ(1500U, GrowPrefetchLimit(
+      kInitialLimit, kInitialLimit, 1500, 1500 * kRowWidth, 1000U + 2000U));
+  ASSERT_EQ(kInitialLimit, GrowPrefetchLimit(
+      kInitialLimit, kInitialLimit, 3000, 3000 * kRowWidth, 1000U + 2000U));
+}
+
 } // namespace pggate
 } // namespace yb
@@ -83,6 +83,8 @@ DECLARE_int64(db_filter_block_size_bytes);
 DECLARE_int64(db_index_block_size_bytes);
 DECLARE_int64(tablet_force_split_threshold_bytes);
 DECLARE_int64(TEST_inject_random_delay_on_txn_status_response_ms);
+DECLARE_bool(TEST_pg_client_overwrite_shared_mem_response);
+DECLARE_uint64(pg_client_shared_memory_min_response_bytes);
 
 namespace yb {
 namespace pgwrapper {
@@ -441,6 +443,21 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(Simple)) {
   ASSERT_EQ(value, "hello");
 }
 
+// Every response passed through shared memory is overwritten before the backend reads it, so the
+// backend should request it again over the socket.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(OverwrittenSharedMemResponse)) {
+  FLAGS_pg_client_shared_memory_min_response_bytes = 0;
+  FLAGS_TEST_pg_client_overwrite_shared_mem_response = true;
+
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value TEXT)"));
+  ASSERT_OK(conn.Execute("INSERT INTO t (key, value) VALUES (1, 'hello')"));
+
+  auto value = ASSERT_RESULT(conn.FetchValue<std::string>("SELECT value FROM t WHERE key = 1"));
+  ASSERT_EQ(value, "hello");
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(WriteRetry)) {
   constexpr int kKeys = 100;
   auto conn = ASSERT_RESULT(Connect());
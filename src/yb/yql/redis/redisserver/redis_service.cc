@@ -88,6 +88,17 @@ METRIC_DEFINE_gauge_uint64(
     server, redis_monitoring_clients, "Number of clients running monitor", yb::MetricUnit::kUnits,
     "Number of clients running monitor ");
 
+METRIC_DEFINE_coarse_histogram(
+    server, redis_pipeline_size, "Redis Pipeline Size", yb::MetricUnit::kOperations,
+    "Number of commands received from a connection and processed as a single batch.");
+METRIC_DEFINE_coarse_histogram(
+    server, redis_tablet_batch_size, "Redis Tablet Batch Size", yb::MetricUnit::kOperations,
+    "Number of commands of a batch grouped into a single read or write request to a tablet.");
+METRIC_DEFINE_counter(
+    server, redis_batch_conflicts, "Redis Batch Conflicts", yb::MetricUnit::kOperations,
+    "Number of times commands of a batch sent to the same tablet were split into sequential "
+    "requests, because read and write commands accessed the same key.");
+
 #if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
 constexpr int32_t kDefaultRedisServiceTimeoutMs = 600000;
 #else
@@ -371,10 +382,12 @@ class Block : public std::enable_shared_from_this<Block> {
 
   Block(const BatchContextPtr& context,
         Ops::allocator_type allocator,
-        rpc::RpcMethodMetrics metrics_internal)
+        rpc::RpcMethodMetrics metrics_internal,
+        Histogram* batch_size_histogram)
       : context_(context),
         ops_(allocator),
         metrics_internal_(std::move(metrics_internal)),
+        batch_size_histogram_(batch_size_histogram),
         start_(MonoTime::Now()) {
   }
 
@@ -396,11 +409,18 @@ class Block : public std::enable_shared_from_this<Block> {
       client::FlushStatus flush_status = {status, {}};
       callback(&flush_status);
     };
+    size_t num_applied_operations = 0;
     for (auto* op : ops_) {
+      applied_operations = false;
       has_ok = op->Apply(session_.get(), status_callback, &applied_operations) || has_ok;
+      num_applied_operations += applied_operations;
     }
     if (has_ok) {
-      if (applied_operations) {
+      if (num_applied_operations) {
+        // All applied operations belong to the same tablet, so they are sent in a single request.
+        if (batch_size_histogram_) {
+          batch_size_histogram_->Increment(num_applied_operations);
+        }
         // Allow local calls in this thread only if no one is waiting behind us.
         session_->set_allow_local_calls_in_curr_thread(
             allow_local_calls_in_curr_thread && this->next_ == nullptr);
@@ -542,6 +562,7 @@ class Block : public std::enable_shared_from_this<Block> {
   BatchContextPtr context_;
   Ops ops_;
   rpc::RpcMethodMetrics metrics_internal_;
+  Histogram* batch_size_histogram_;
   MonoTime start_;
   SessionPool* session_pool_;
   std::shared_ptr<client::YBSession> session_;
@@ -551,6 +572,12 @@ class Block : public std::enable_shared_from_this<Block> {
 
 typedef std::array<rpc::RpcMethodMetrics, kOperationTypeMapSize> InternalMetrics;
 
+struct BatchMetrics {
+  InternalMetrics internal;
+  scoped_refptr<Histogram> tablet_batch_size;
+  scoped_refptr<Counter> conflicts;
+};
+
 struct BlockData {
   explicit BlockData(Arena* arena) : used_keys(UsedKeys::allocator_type(arena)) {}
 
@@ -599,20 +626,21 @@ class TabletOperations {
   void Process(const BatchContextPtr& context,
                Arena* arena,
                Operation* operation,
-               const InternalMetrics& metrics_internal) {
+               const BatchMetrics& metrics) {
     auto type = operation->type();
     if (type == OperationType::kLocal) {
-      ProcessLocalOperation(context, arena, operation, metrics_internal);
+      ProcessLocalOperation(context, arena, operation, metrics);
       return;
     }
     boost::container::small_vector<Slice, RedisClientCommand::static_capacity> keys;
     operation->GetKeys(&keys);
-    CheckConflicts(type, keys);
+    CheckConflicts(type, keys, metrics);
     auto& data = this->data(type);
     if (!data.block) {
       ArenaAllocator<Block> alloc(arena);
       data.block = std::allocate_shared<Block>(
-          alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kRead)]);
+          alloc, context, alloc, metrics.internal[static_cast<size_t>(type)],
+          metrics.tablet_batch_size.get());
       if (last_conflict_type_ == OperationType::kLocal) {
         last_local_block_->SetNext(data.block);
         last_conflict_type_ = type;
@@ -638,10 +666,11 @@ class TabletOperations {
   void ProcessLocalOperation(const BatchContextPtr& context,
                              Arena* arena,
                              Operation* operation,
-                             const InternalMetrics& metrics_internal) {
+                             const BatchMetrics& metrics) {
     ArenaAllocator<Block> alloc(arena);
     auto block = std::allocate_shared<Block>(
-        alloc, context, alloc, metrics_internal[static_cast<size_t>(OperationType::kLocal)]);
+        alloc, context, alloc, metrics.internal[static_cast<size_t>(OperationType::kLocal)],
+        nullptr /* batch_size_histogram */);
     switch (last_conflict_type_) {
       case OperationType::kNone:
         if (read_data_.block) {
@@ -699,7 +728,7 @@ class TabletOperations {
     last_conflict_type_ = type;
   }
 
-  void CheckConflicts(OperationType type, const RedisKeyList& keys) {
+  void CheckConflicts(OperationType type, const RedisKeyList& keys, const BatchMetrics& metrics) {
     if (last_conflict_type_ == type) {
       return;
     }
@@ -715,6 +744,9 @@ class TabletOperations {
       }
     }
     if (conflict) {
+      if (metrics.conflicts) {
+        metrics.conflicts->Increment();
+      }
       ConflictFound(type);
     }
   }
@@ -784,7 +816,8 @@ struct RedisServiceImplData : public RedisServiceData {
   std::string yb_tier_master_addresses_;
 
   yb::rpc::RpcMethodMetrics metrics_error_;
-  InternalMetrics metrics_internal_;
+  BatchMetrics batch_metrics_;
+  scoped_refptr<Histogram> pipeline_size_;
 
   // Mutex that protects the creation of client_ and populating db_to_opened_table_.
   std::mutex yb_mutex_;
@@ -956,7 +989,7 @@ class BatchContextImpl : public BatchContext {
         if (it == tablets_.end()) {
           it = tablets_.emplace(operation.tablet()->tablet_id(), TabletOperations(&arena_)).first;
         }
-        it->second.Process(self, &arena_, &operation, impl_data_->metrics_internal_);
+        it->second.Process(self, &arena_, &operation, impl_data_->batch_metrics_);
       }
     }
 
@@ -1393,12 +1426,18 @@ void RedisServiceImpl::Impl::PopulateHandlers() {
 
   // Set up metrics for erroneous calls.
   data_.metrics_error_.handler_latency = YB_REDIS_METRIC(error).Instantiate(metric_entity);
-  data_.metrics_internal_[static_cast<size_t>(OperationType::kWrite)].handler_latency =
+  auto& metrics_internal = data_.batch_metrics_.internal;
+  metrics_internal[static_cast<size_t>(OperationType::kWrite)].handler_latency =
       YB_REDIS_METRIC(set_internal).Instantiate(metric_entity);
-  data_.metrics_internal_[static_cast<size_t>(OperationType::kRead)].handler_latency =
+  metrics_internal[static_cast<size_t>(OperationType::kRead)].handler_latency =
       YB_REDIS_METRIC(get_internal).Instantiate(metric_entity);
-  data_.metrics_internal_[static_cast<size_t>(OperationType::kLocal)].handler_latency =
-      data_.metrics_internal_[static_cast<size_t>(OperationType::kRead)].handler_latency;
+  metrics_internal[static_cast<size_t>(OperationType::kLocal)].handler_latency =
+      metrics_internal[static_cast<size_t>(OperationType::kRead)].handler_latency;
+
+  data_.batch_metrics_.tablet_batch_size =
+      METRIC_redis_tablet_batch_size.Instantiate(metric_entity);
+  data_.batch_metrics_.conflicts = METRIC_redis_batch_conflicts.Instantiate(metric_entity);
+  data_.pipeline_size_ = METRIC_redis_pipeline_size.Instantiate(metric_entity);
 
   auto* proto = &METRIC_redis_monitoring_clients;
   data_.num_clients_monitoring_ = proto->Instantiate(metric_entity, 0);
@@ -1466,9 +1505,13 @@ void RedisServiceImpl::Impl::Handle(rpc::InboundCallPtr call_ptr) {
 
   // Call could contain several commands, i.e. batch.
   // We process them as follows:
-  // Each read commands are processed individually.
-  // Sequential write commands use single session and the same batcher.
+  // Commands are grouped by tablet, and reads and writes of the same tablet are sent as a single
+  // read request and a single write request respectively, so all writes of the batch to a tablet
+  // are replicated in one Raft round.
+  // When read and write commands of the same tablet access the same key, the groups are split
+  // into blocks that are executed sequentially, preserving the order of the commands.
   const auto& batch = call->client_batch();
+  data_.pipeline_size_->Increment(batch.size());
   auto conn = call->connection();
   const string remote = yb::ToString(conn->remote());
   RedisConnectionContext* conn_context = &(call->connection_context());
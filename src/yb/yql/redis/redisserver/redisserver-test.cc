@@ -80,6 +80,8 @@ DEFINE_uint64(test_redis_max_batch, 250,
 METRIC_DECLARE_gauge_uint64(redis_available_sessions);
 METRIC_DECLARE_gauge_uint64(redis_allocated_sessions);
 METRIC_DECLARE_gauge_uint64(redis_monitoring_clients);
+METRIC_DECLARE_histogram(redis_pipeline_size);
+METRIC_DECLARE_histogram(redis_tablet_batch_size);
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -1358,6 +1360,26 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+TEST_F_EX(TestRedisService, PipelineTabletBatches, TestRedisServiceSafeBatch) {
+  auto pipeline_size = server_->metric_entity()->FindOrCreateHistogram(
+      &METRIC_redis_pipeline_size);
+  auto tablet_batch_size = server_->metric_entity()->FindOrCreateHistogram(
+      &METRIC_redis_tablet_batch_size);
+  auto commands_before = pipeline_size->histogram()->TotalSum();
+  auto batched_commands_before = tablet_batch_size->histogram()->TotalSum();
+  auto batches_before = tablet_batch_size->TotalCount();
+
+  SendCommandAndExpectResponse(__LINE__, PipelineSetCommand(), PipelineSetResponse());
+
+  auto batched_commands = tablet_batch_size->histogram()->TotalSum() - batched_commands_before;
+  auto batches = tablet_batch_size->TotalCount() - batches_before;
+  LOG(INFO) << "Pipelined commands: " << kPipelineKeys << ", tablet batches: " << batches;
+  ASSERT_EQ(pipeline_size->histogram()->TotalSum() - commands_before, kPipelineKeys);
+  ASSERT_EQ(batched_commands, kPipelineKeys);
+  // Commands for the same tablet should be grouped into the same request.
+  ASSERT_LT(batches, kPipelineKeys);
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,